@@ -67,15 +67,31 @@ function(compile_shader shader_file output_dir)
     # Include directory for shader includes
     set(include_dir "${CMAKE_SOURCE_DIR}/shaders/include")
     
+    # Recompile when any included file changes, not just the top-level shader. glslc
+    # writes the includes it resolved to a depfile; generators without depfile support
+    # fall back to depending on every file in the include directory.
+    if(CMAKE_GENERATOR MATCHES "Ninja|Makefiles" OR CMAKE_VERSION VERSION_GREATER_EQUAL 3.21)
+        set(depfile "${output_file}.d")
+        set(depfile_args -MD -MF ${depfile})
+        set(depfile_option DEPFILE ${depfile})
+        set(include_depends "")
+    else()
+        set(depfile_args "")
+        set(depfile_option "")
+        file(GLOB_RECURSE include_depends CONFIGURE_DEPENDS "${include_dir}/*.glsl")
+    endif()
+    
     # Compile shader
     add_custom_command(
         OUTPUT ${output_file}
         COMMAND ${GLSLC}
             -fshader-stage=${stage}
             -I${include_dir}
+            ${depfile_args}
             ${CMAKE_SOURCE_DIR}/${shader_file}
             -o ${output_file}
-        DEPENDS ${CMAKE_SOURCE_DIR}/${shader_file}
+        DEPENDS ${CMAKE_SOURCE_DIR}/${shader_file} ${include_depends}
+        ${depfile_option}
         COMMENT "Compiling shader: ${shader_file} -> ${output_file}"
         VERBATIM
     )
@@ -137,6 +153,12 @@ function(setup_shader_compilation)
         # Set output directory as a property for use in code
         set_property(GLOBAL PROPERTY SHADER_OUTPUT_DIR "${SHADER_OUTPUT_DIR}")
         
+        # Development builds find the GLSL sources and glslc at runtime to hot-reload shaders
+        target_compile_definitions(StellarAliaRuntime PRIVATE
+            "$<$<CONFIG:Debug,RelWithDebInfo>:SA_SHADER_SOURCE_DIR=\"${CMAKE_SOURCE_DIR}/shaders\">"
+            "$<$<CONFIG:Debug,RelWithDebInfo>:SA_SHADER_COMPILER=\"${GLSLC}\">"
+        )
+        
         message(STATUS "Shader compilation enabled. Output directory: ${SHADER_OUTPUT_DIR}")
     else()
         message(STATUS "No shaders found to compile")
@@ -0,0 +1,159 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "core/logs/Log.hpp"
+#include "function/graphics/RenderSystem.hpp"
+#include "function/graphics/RenderGraph.hpp"
+
+using namespace StellarAlia::Function::Graphics;
+
+namespace {
+    struct BenchmarkOptions {
+        uint32_t width = 1920;
+        uint32_t height = 1080;
+        uint32_t warmupFrames = 60;
+        uint32_t frames = 600;
+        bool subpassLighting = false;
+        std::string shaderDirectory = "shaders";
+    };
+
+    struct BenchmarkResult {
+        GBufferLayout layout = GBufferLayout::Standard;
+        uint32_t bytesPerPixel = 0;
+        double gbufferMs = 0.0;
+        double lightingMs = 0.0;
+        double cpuFrameMs = 0.0;
+        uint32_t samples = 0;
+    };
+
+    bool RunLayout(const BenchmarkOptions& options, GBufferLayout layout, BenchmarkResult& result) {
+        RenderSystemCreateInfo createInfo;
+        createInfo.headless = true;
+        createInfo.enableValidation = false;
+        createInfo.width = options.width;
+        createInfo.height = options.height;
+        createInfo.shaderDirectory = options.shaderDirectory;
+        createInfo.pipelineCachePath.clear();
+        createInfo.subpassLighting = options.subpassLighting;
+        createInfo.gbufferLayout = layout;
+
+        RenderSystem renderSystem;
+        if (!renderSystem.Initialize(createInfo)) {
+            SA_LOG_ERROR("Failed to initialize the render system for the {} layout", GBufferLayoutToString(layout));
+            return false;
+        }
+        if (!renderSystem.GetRenderGraph()->SetTimingEnabled(true)) {
+            SA_LOG_WARN("GPU timestamps unavailable; only CPU frame times will be reported");
+        }
+
+        result = {};
+        result.layout = layout;
+        result.bytesPerPixel = renderSystem.GetDeferredRenderer()->GetGBufferBytesPerPixel();
+
+        const uint32_t totalFrames = options.warmupFrames + options.frames;
+        std::chrono::steady_clock::time_point measureStart;
+        for (uint32_t frame = 0; frame < totalFrames; frame++) {
+            if (frame == options.warmupFrames) {
+                measureStart = std::chrono::steady_clock::now();
+            }
+
+            renderSystem.BeginFrame();
+            renderSystem.Render();
+            renderSystem.EndFrame();
+            renderSystem.Present();
+
+            if (frame < options.warmupFrames) {
+                continue;
+            }
+            const auto& timings = renderSystem.GetRenderGraph()->GetPassTimings();
+            if (timings.empty()) {
+                continue;
+            }
+            for (const RenderGraphPassTiming& timing : timings) {
+                if (timing.name == "GBuffer") {
+                    result.gbufferMs += timing.gpuMs;
+                } else if (timing.name == "DeferredLighting") {
+                    result.lightingMs += timing.gpuMs;
+                }
+            }
+            result.samples++;
+        }
+        renderSystem.WaitIdle();
+
+        const double elapsedMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - measureStart).count();
+        result.cpuFrameMs = options.frames > 0 ? elapsedMs / options.frames : 0.0;
+        if (result.samples > 0) {
+            result.gbufferMs /= result.samples;
+            result.lightingMs /= result.samples;
+        }
+
+        renderSystem.Shutdown();
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    StellarAlia::Core::Log::Initialize();
+
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--width") == 0 && hasValue) {
+            options.width = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--height") == 0 && hasValue) {
+            options.height = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            options.frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue) {
+            options.warmupFrames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--shaders") == 0 && hasValue) {
+            options.shaderDirectory = argv[++i];
+        } else if (std::strcmp(argv[i], "--subpass") == 0) {
+            options.subpassLighting = true;
+        } else {
+            SA_LOG_INFO("Usage: {} [--width N] [--height N] [--frames N] [--warmup N] [--shaders DIR] [--subpass]",
+                        argv[0]);
+            StellarAlia::Core::Log::Shutdown();
+            return 1;
+        }
+    }
+
+    SA_LOG_INFO("=== G-buffer layout benchmark ===");
+    SA_LOG_INFO("{}x{}, {} frames after {} warm-up, {} lighting", options.width, options.height, options.frames,
+                options.warmupFrames, options.subpassLighting ? "subpass" : "sampled");
+
+    std::vector<BenchmarkResult> results;
+    for (GBufferLayout layout : { GBufferLayout::Standard, GBufferLayout::Compact }) {
+        BenchmarkResult result;
+        if (!RunLayout(options, layout, result)) {
+            StellarAlia::Core::Log::Shutdown();
+            return 1;
+        }
+        results.push_back(result);
+    }
+
+    const double pixels = static_cast<double>(options.width) * options.height;
+    SA_LOG_INFO("{:<10} {:>8} {:>12} {:>12} {:>14} {:>12}", "layout", "B/pixel", "G-buffer MiB", "gbuffer ms",
+                "lighting ms", "cpu frame ms");
+    for (const BenchmarkResult& result : results) {
+        SA_LOG_INFO("{:<10} {:>8} {:>12.1f} {:>12.3f} {:>14.3f} {:>12.3f}", GBufferLayoutToString(result.layout),
+                    result.bytesPerPixel, result.bytesPerPixel * pixels / (1024.0 * 1024.0), result.gbufferMs,
+                    result.lightingMs, result.cpuFrameMs);
+    }
+    if (results.size() == 2) {
+        const double footprint = 100.0 * results[1].bytesPerPixel / results[0].bytesPerPixel;
+        if (results[0].lightingMs > 0.0 && results[1].lightingMs > 0.0) {
+            SA_LOG_INFO("Compact: {:.0f}% of the standard footprint, lighting pass {:.2f}x", footprint,
+                        results[0].lightingMs / results[1].lightingMs);
+        } else {
+            SA_LOG_INFO("Compact: {:.0f}% of the standard footprint (no lighting pass timings)", footprint);
+        }
+    }
+
+    StellarAlia::Core::Log::Shutdown();
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "core/logs/Log.hpp"
+#include "core/math/Math.hpp"
+
+using namespace StellarAlia::Core::Math;
+
+namespace {
+    struct BenchmarkOptions {
+        size_t count = 65536;
+        uint32_t iterations = 200;
+    };
+
+    struct BenchmarkData {
+        std::vector<Vec4> translations;
+        std::vector<Quat> rotations;
+        std::vector<Vec4> scales;
+        std::vector<Vec4> points;
+        std::vector<Vec4> pointsOut;
+        std::vector<Mat4> models;
+        std::vector<Mat4> matricesOut;
+    };
+
+    // Reference implementations on plain float arrays, the way the code looked before the math library
+    void ScalarTransformPoints(const float* m, const float* points, float* out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            const float* p = points + i * 4;
+            for (int r = 0; r < 4; r++) {
+                out[i * 4 + r] = m[r] * p[0] + m[4 + r] * p[1] + m[8 + r] * p[2] + m[12 + r] * p[3];
+            }
+        }
+    }
+
+    void ScalarTransformMatrices(const float* parent, const float* matrices, float* out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            ScalarTransformPoints(parent, matrices + i * 16, out + i * 16, 4);
+        }
+    }
+
+    void ScalarBuildModelMatrices(const float* translations, const float* rotations, const float* scales,
+                                  float* out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            const float* t = translations + i * 4;
+            const float* q = rotations + i * 4;
+            const float* s = scales + i * 4;
+            float* m = out + i * 16;
+            const float x = q[0], y = q[1], z = q[2], w = q[3];
+            m[0] = (1.0f - 2.0f * (y * y + z * z)) * s[0];
+            m[1] = 2.0f * (x * y + z * w) * s[0];
+            m[2] = 2.0f * (x * z - y * w) * s[0];
+            m[3] = 0.0f;
+            m[4] = 2.0f * (x * y - z * w) * s[1];
+            m[5] = (1.0f - 2.0f * (x * x + z * z)) * s[1];
+            m[6] = 2.0f * (y * z + x * w) * s[1];
+            m[7] = 0.0f;
+            m[8] = 2.0f * (x * z + y * w) * s[2];
+            m[9] = 2.0f * (y * z - x * w) * s[2];
+            m[10] = (1.0f - 2.0f * (x * x + y * y)) * s[2];
+            m[11] = 0.0f;
+            m[12] = t[0];
+            m[13] = t[1];
+            m[14] = t[2];
+            m[15] = 1.0f;
+        }
+    }
+
+    void ScalarBuildNormalMatrices(const float* models, float* out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            const float* c0 = models + i * 16;
+            const float* c1 = c0 + 4;
+            const float* c2 = c0 + 8;
+            float* n = out + i * 16;
+            const auto cross = [](const float* a, const float* b, float* result) {
+                result[0] = a[1] * b[2] - a[2] * b[1];
+                result[1] = a[2] * b[0] - a[0] * b[2];
+                result[2] = a[0] * b[1] - a[1] * b[0];
+                result[3] = 0.0f;
+            };
+            cross(c1, c2, n);
+            cross(c2, c0, n + 4);
+            cross(c0, c1, n + 8);
+            const float det = c0[0] * n[0] + c0[1] * n[1] + c0[2] * n[2];
+            const float invDet = std::abs(det) > 1e-12f ? 1.0f / det : 1.0f;
+            for (int k = 0; k < 12; k++) {
+                n[k] *= invDet;
+            }
+            n[12] = 0.0f;
+            n[13] = 0.0f;
+            n[14] = 0.0f;
+            n[15] = 1.0f;
+        }
+    }
+
+    void FillData(size_t count, BenchmarkData& data) {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+        data.translations.resize(count);
+        data.rotations.resize(count);
+        data.scales.resize(count);
+        data.points.resize(count);
+        data.pointsOut.resize(count);
+        data.models.resize(count);
+        data.matricesOut.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            data.translations[i] = { position(random), position(random), position(random), 1.0f };
+            data.rotations[i] = Normalize(Quat{ unit(random), unit(random), unit(random), unit(random) });
+            data.scales[i] = { scale(random), scale(random), scale(random), 0.0f };
+            data.points[i] = { position(random), position(random), position(random), 1.0f };
+        }
+        BuildModelMatrices(data.translations.data(), data.rotations.data(), data.scales.data(), data.models.data(),
+                           count);
+    }
+
+    // Average nanoseconds per element over all iterations
+    template <typename Function>
+    double Measure(const BenchmarkOptions& options, Function&& function) {
+        function();  // warm-up
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < options.iterations; i++) {
+            function();
+        }
+        const double elapsedNs =
+            std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return elapsedNs / (static_cast<double>(options.iterations) * static_cast<double>(options.count));
+    }
+
+    // Keeps the optimizer from discarding the results
+    volatile float g_sink = 0.0f;
+
+    void Report(const char* name, double scalarNs, double simdNs, const float* result) {
+        g_sink = g_sink + result[0];
+        SA_LOG_INFO("{:<22} {:>12.2f} {:>12.2f} {:>9.2f}x", name, scalarNs, simdNs, scalarNs / simdNs);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    StellarAlia::Core::Log::Initialize();
+
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--count") == 0 && hasValue) {
+            options.count = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--iterations") == 0 && hasValue) {
+            options.iterations = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            SA_LOG_INFO("Usage: {} [--count N] [--iterations N]", argv[0]);
+            StellarAlia::Core::Log::Shutdown();
+            return 1;
+        }
+    }
+    if (options.count == 0 || options.iterations == 0) {
+        SA_LOG_ERROR("--count and --iterations must be greater than zero");
+        StellarAlia::Core::Log::Shutdown();
+        return 1;
+    }
+
+#if defined(SA_MATH_AVX2)
+    const char* instructionSet = "AVX2";
+#elif defined(SA_MATH_SSE)
+    const char* instructionSet = "SSE2";
+#else
+    const char* instructionSet = "scalar";
+#endif
+#if defined(SA_MATH_FMA)
+    const char* fma = " with FMA";
+#else
+    const char* fma = "";
+#endif
+    SA_LOG_INFO("=== Math kernel benchmark ===");
+    SA_LOG_INFO("{} elements, {} iterations, {} kernels{}", options.count, options.iterations, instructionSet, fma);
+
+    BenchmarkData data;
+    FillData(options.count, data);
+    const size_t count = options.count;
+    const float* translations = &data.translations[0].x;
+    const float* rotations = &data.rotations[0].x;
+    const float* scales = &data.scales[0].x;
+    const float* points = &data.points[0].x;
+    const float* models = &data.models[0][0].x;
+    float* pointsOut = &data.pointsOut[0].x;
+    float* matricesOut = &data.matricesOut[0][0].x;
+
+    SA_LOG_INFO("{:<22} {:>12} {:>12} {:>10}", "kernel", "scalar ns", "simd ns", "speedup");
+
+    double scalarNs = Measure(options, [&] { ScalarTransformPoints(models, points, pointsOut, count); });
+    double simdNs = Measure(options, [&] {
+        TransformPoints(data.models[0], data.points.data(), data.pointsOut.data(), count);
+    });
+    Report("TransformPoints", scalarNs, simdNs, pointsOut);
+
+    scalarNs = Measure(options, [&] { ScalarTransformMatrices(models, models, matricesOut, count); });
+    simdNs = Measure(options, [&] {
+        TransformMatrices(data.models[0], data.models.data(), data.matricesOut.data(), count);
+    });
+    Report("TransformMatrices", scalarNs, simdNs, matricesOut);
+
+    scalarNs = Measure(options, [&] { ScalarBuildModelMatrices(translations, rotations, scales, matricesOut, count); });
+    simdNs = Measure(options, [&] {
+        BuildModelMatrices(data.translations.data(), data.rotations.data(), data.scales.data(),
+                           data.matricesOut.data(), count);
+    });
+    Report("BuildModelMatrices", scalarNs, simdNs, matricesOut);
+
+    scalarNs = Measure(options, [&] { ScalarBuildNormalMatrices(models, matricesOut, count); });
+    simdNs = Measure(options, [&] { BuildNormalMatrices(data.models.data(), data.matricesOut.data(), count); });
+    Report("BuildNormalMatrices", scalarNs, simdNs, matricesOut);
+
+    StellarAlia::Core::Log::Shutdown();
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <chrono>
+#include <cstring>
 #include <memory>
 
 #include "resource/config_manager/ConfigManager.hpp"
@@ -18,6 +19,14 @@ int main(int argc, char* argv[]) {
     // Initialize the logging system
     StellarAlia::Core::Log::Initialize();
     
+    // --headless renders into offscreen images (CI / render farm machines without a display)
+    bool headless = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        }
+    }
+
     SA_LOG_INFO("=== StellarAlia Graphics Framework Test ===");
     SA_LOG_INFO("Testing window and graphics context initialization");
     
@@ -34,18 +43,23 @@ int main(int argc, char* argv[]) {
     windowInfo.resizable = true;
     
     // Shared ownership so we can pass the window to the render system safely
-    std::shared_ptr<WindowType> window = std::make_shared<WindowType>();
-    SA_LOG_INFO("Using GLFW window backend");
-    
-    if (!window->Initialize(windowInfo)) {
-        SA_LOG_ERROR("Failed to initialize window!");
-        StellarAlia::Core::Log::Shutdown();
-        return 1;
+    std::shared_ptr<WindowType> window;
+    if (headless) {
+        SA_LOG_INFO("Headless mode: skipping window creation");
+    } else {
+        window = std::make_shared<WindowType>();
+        SA_LOG_INFO("Using GLFW window backend");
+
+        if (!window->Initialize(windowInfo)) {
+            SA_LOG_ERROR("Failed to initialize window!");
+            StellarAlia::Core::Log::Shutdown();
+            return 1;
+        }
+
+        SA_LOG_INFO("Window created successfully!");
+        SA_LOG_INFO("  Backend: GLFW");
+        SA_LOG_INFO("  Size: {}x{}", window->GetWidth(), window->GetHeight());
     }
-    
-    SA_LOG_INFO("Window created successfully!");
-    SA_LOG_INFO("  Backend: GLFW");
-    SA_LOG_INFO("  Size: {}x{}", window->GetWidth(), window->GetHeight());
 
     // ============================================================================
     // Test 2: Render System Creation (graphics context)
@@ -55,23 +69,40 @@ int main(int argc, char* argv[]) {
     GraphicsContextCreateInfo contextInfo;
     contextInfo.enableValidation = true;
     contextInfo.window = window;  // Pass shared window to graphics context
+    contextInfo.headless = headless;
+    contextInfo.width = windowInfo.width;
+    contextInfo.height = windowInfo.height;
+    contextInfo.framesInFlight = appConfig.framesInFlight;
+    contextInfo.preferredDevice = appConfig.gpuDevice;
+    contextInfo.enableBindless = appConfig.bindlessTextures;
+    contextInfo.uploadRingSize = static_cast<uint64_t>(appConfig.uploadRingMB) * 1024 * 1024;
+    contextInfo.uploadBudgetPerFrame = static_cast<uint64_t>(appConfig.uploadBudgetMB) * 1024 * 1024;
+    if (!ParsePresentMode(appConfig.presentMode, contextInfo.presentPolicy.mode)) {
+        SA_LOG_WARN("Unknown present_mode '{}'; using fifo", appConfig.presentMode);
+    }
+    contextInfo.presentPolicy.imageCount = appConfig.swapchainImageCount;
+    contextInfo.presentPolicy.maxQueuedFrames = appConfig.maxQueuedFrames;
+    contextInfo.presentPolicy.targetFrameRate = appConfig.targetFrameRate;
     
     // Verify window is valid before proceeding
-    if (!contextInfo.window) {
+    if (!contextInfo.window && !headless) {
         SA_LOG_ERROR("Window pointer is null! Cannot create graphics context.");
-        window->Shutdown();
         StellarAlia::Core::Log::Shutdown();
         return 1;
     }
     
-    SA_LOG_INFO("Window pointer is valid: {}", static_cast<void*>(contextInfo.window.get()));
+    if (contextInfo.window) {
+        SA_LOG_INFO("Window pointer is valid: {}", static_cast<void*>(contextInfo.window.get()));
+    }
     
     // Shared render system so lifetime can be managed alongside the window
     std::shared_ptr<GraphicsContext> graphicsContext = std::make_shared<VulkanGraphicsContext>();
 
     if (!graphicsContext) {
         SA_LOG_ERROR("Failed to create VulkanGraphicsContext instance!");
-        window->Shutdown();
+        if (window) {
+            window->Shutdown();
+        }
         StellarAlia::Core::Log::Shutdown();
         return 1;
     }
@@ -79,7 +110,9 @@ int main(int argc, char* argv[]) {
     SA_LOG_INFO("About to initialize graphics context...");
     if (!graphicsContext->Initialize(contextInfo)) {
         SA_LOG_ERROR("Failed to initialize graphics context!");
-        window->Shutdown();
+        if (window) {
+            window->Shutdown();
+        }
         StellarAlia::Core::Log::Shutdown();
         return 1;
     }
@@ -90,6 +123,7 @@ int main(int argc, char* argv[]) {
     SA_LOG_INFO("  Resolution: {}x{}", 
         graphicsContext->GetWidth(), graphicsContext->GetHeight());
     SA_LOG_INFO("  Initialized: {}", graphicsContext->IsInitialized());
+    SA_LOG_INFO("  Headless: {}", graphicsContext->IsHeadless());
     
     // ============================================================================
     // Test 3: Render Loop
@@ -104,7 +138,7 @@ int main(int argc, char* argv[]) {
     
     while (running) {
         // Check if window should close
-        if (!window->PollEvents() || window->ShouldClose()) {
+        if (window && (!window->PollEvents() || window->ShouldClose())) {
             SA_LOG_INFO("Window close requested");
             running = false;
             break;
@@ -130,7 +164,9 @@ int main(int argc, char* argv[]) {
             currentTime - startTime).count();
         if (elapsed > 0 && frameCount % 60 == 0) {
             float fps = (frameCount * 1000.0f) / elapsed;
-            SA_LOG_DEBUG("FPS: {:.2f} (Frame: {})", fps, frameCount);
+            const auto& stats = graphicsContext->GetFrameStats();
+            SA_LOG_DEBUG("FPS: {:.2f} (Frame: {}, frame time: {:.3f} ms, recreate: {:.3f} ms)",
+                         fps, frameCount, stats.cpuFrameTimeMs, stats.swapchainRecreateMs);
         }
     }
     
@@ -142,6 +178,7 @@ int main(int argc, char* argv[]) {
     SA_LOG_INFO("  Total frames: {}", frameCount);
     SA_LOG_INFO("  Total time: {:.2f} seconds", totalTime);
     SA_LOG_INFO("  Average FPS: {:.2f}", avgFps);
+    SA_LOG_INFO("  Swapchain recreations: {}", graphicsContext->GetFrameStats().swapchainRecreateCount);
     
     // ============================================================================
     // Test 4: Cleanup
@@ -152,8 +189,10 @@ int main(int argc, char* argv[]) {
     graphicsContext->Shutdown();
     SA_LOG_INFO("Graphics context shut down");
     
-    window->Shutdown();
-    SA_LOG_INFO("Window shut down");
+    if (window) {
+        window->Shutdown();
+        SA_LOG_INFO("Window shut down");
+    }
     
     // ============================================================================
     // Test Summary
@@ -0,0 +1,62 @@
+#version 450
+
+#include "common.glsl"
+#include "shader_features.glsl"
+
+// Compact G-buffer: no position target (reconstructed from depth), octahedral normals and
+// metallic/roughness/AO packed into one target
+
+layout(location = 0) in vec3 fragPosition;
+layout(location = 1) in vec3 fragNormal;
+layout(location = 2) in vec2 fragTexCoord;
+layout(location = 3) in vec3 fragTangent;
+layout(location = 4) in vec3 fragBitangent;
+
+// G-Buffer outputs
+layout(location = 0) out vec2 outNormal;   // Octahedral normal (RG16 SNORM)
+layout(location = 1) out vec4 outAlbedo;   // RGB = albedo, A = unused
+layout(location = 2) out vec4 outMaterial; // R = metallic, G = roughness, B = AO, A = unused
+
+layout(set = 1, binding = 0) uniform sampler2D texAlbedo;
+layout(set = 1, binding = 1) uniform sampler2D texNormal;
+layout(set = 1, binding = 2) uniform sampler2D texMetallicRoughness;
+layout(set = 1, binding = 3) uniform sampler2D texAO;
+
+layout(set = 1, binding = 4) uniform MaterialUniforms {
+    vec4 baseColorFactor;
+    float metallicFactor;
+    float roughnessFactor;
+    float normalScale;
+    float aoStrength;
+} material;
+
+void main() {
+    // Sample textures
+    vec4 albedo = texture(texAlbedo, fragTexCoord) * material.baseColorFactor;
+    float ao = texture(texAO, fragTexCoord).r;
+    
+    // Decode normal from normal map (tangent space to world space)
+    vec3 N = normalize(fragNormal);
+    if (FEATURE_NORMAL_MAP) {
+        vec3 T = normalize(fragTangent);
+        vec3 B = normalize(fragBitangent);
+        mat3 TBN = mat3(T, B, N);
+
+        // Unpack normal from [0,1] to [-1,1]
+        vec3 normalMap = texture(texNormal, fragTexCoord).rgb;
+        vec3 normalMapUnpacked = normalMap * 2.0 - 1.0;
+        normalMapUnpacked.xy *= material.normalScale;
+        N = normalize(TBN * normalMapUnpacked);
+    }
+
+    // Metallic (B) and roughness (G) from the texture, or the factors alone
+    vec2 metallicRoughness = vec2(material.metallicFactor, material.roughnessFactor);
+    if (FEATURE_METALLIC_ROUGHNESS_MAP) {
+        metallicRoughness *= texture(texMetallicRoughness, fragTexCoord).bg;
+    }
+    
+    // Write to G-Buffer
+    outNormal = encodeNormal(N);
+    outAlbedo = vec4(albedo.rgb, 1.0);
+    outMaterial = vec4(metallicRoughness, mix(1.0, ao, material.aoStrength), 0.0);
+}
@@ -0,0 +1,38 @@
+#version 450
+
+// GPU-driven variant of deferred_geometry.vert: the same vertex inputs from the shared
+// vertex buffer, with the transform and material taken from the instance record that
+// gpu_culling.comp put in firstInstance.
+
+#include "gpu_scene.glsl"
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in vec3 inTangent;
+
+layout(location = 0) out vec3 fragPosition;
+layout(location = 1) out vec3 fragNormal;
+layout(location = 2) out vec2 fragTexCoord;
+layout(location = 3) out vec3 fragTangent;
+layout(location = 4) out vec3 fragBitangent;
+layout(location = 5) flat out uint fragMaterialIndex;
+
+void main() {
+    GpuInstance instance = instances[gl_InstanceIndex];
+    mat3 normalMatrix = mat3(instance.normalMatrix[0].xyz, instance.normalMatrix[1].xyz, instance.normalMatrix[2].xyz);
+
+    // Transform position to world space
+    vec4 worldPos = instance.model * vec4(inPosition, 1.0);
+    fragPosition = worldPos.xyz;
+    
+    // Transform normal and tangent frame to world space
+    fragNormal = normalize(normalMatrix * inNormal);
+    fragTexCoord = inTexCoord;
+    fragTangent = normalize(normalMatrix * inTangent);
+    fragBitangent = cross(fragNormal, fragTangent);
+    fragMaterialIndex = instance.material;
+    
+    // Transform to clip space
+    gl_Position = scene.viewProjection * worldPos;
+}
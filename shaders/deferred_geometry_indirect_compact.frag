@@ -0,0 +1,54 @@
+#version 450
+
+// GPU-driven geometry shader for the compact G-buffer (see deferred_geometry_compact.frag
+// and deferred_geometry_indirect.frag)
+
+#include "bindless_material.glsl"
+#include "common.glsl"
+#include "shader_features.glsl"
+
+layout(location = 0) in vec3 fragPosition;
+layout(location = 1) in vec3 fragNormal;
+layout(location = 2) in vec2 fragTexCoord;
+layout(location = 3) in vec3 fragTangent;
+layout(location = 4) in vec3 fragBitangent;
+layout(location = 5) flat in uint fragMaterialIndex;
+
+// G-Buffer outputs
+layout(location = 0) out vec2 outNormal;   // Octahedral normal (RG16 SNORM)
+layout(location = 1) out vec4 outAlbedo;   // RGB = albedo, A = unused
+layout(location = 2) out vec4 outMaterial; // R = metallic, G = roughness, B = AO, A = unused
+
+void main() {
+    Material material = materials[fragMaterialIndex];
+
+    // Sample textures (the material varies within a draw batch, hence nonuniformEXT)
+    vec4 albedo = texture(textures[nonuniformEXT(material.albedoTexture)], fragTexCoord) * material.baseColorFactor;
+    float ao = texture(textures[nonuniformEXT(material.aoTexture)], fragTexCoord).r;
+
+    // Decode normal from normal map (tangent space to world space)
+    vec3 N = normalize(fragNormal);
+    // The permutation can trail a material edit by a frame; never index with a cleared texture
+    if (FEATURE_NORMAL_MAP && material.normalTexture != INVALID_BINDLESS_INDEX) {
+        vec3 T = normalize(fragTangent);
+        vec3 B = normalize(fragBitangent);
+        mat3 TBN = mat3(T, B, N);
+
+        // Unpack normal from [0,1] to [-1,1]
+        vec3 normalMap = texture(textures[nonuniformEXT(material.normalTexture)], fragTexCoord).rgb;
+        vec3 normalMapUnpacked = normalMap * 2.0 - 1.0;
+        normalMapUnpacked.xy *= material.normalScale;
+        N = normalize(TBN * normalMapUnpacked);
+    }
+
+    // Metallic (B) and roughness (G) from the texture, or the factors alone
+    vec2 metallicRoughness = vec2(material.metallicFactor, material.roughnessFactor);
+    if (FEATURE_METALLIC_ROUGHNESS_MAP && material.metallicRoughnessTexture != INVALID_BINDLESS_INDEX) {
+        metallicRoughness *= texture(textures[nonuniformEXT(material.metallicRoughnessTexture)], fragTexCoord).bg;
+    }
+
+    // Write to G-Buffer
+    outNormal = encodeNormal(N);
+    outAlbedo = vec4(albedo.rgb, 1.0);
+    outMaterial = vec4(metallicRoughness, mix(1.0, ao, material.aoStrength), 0.0);
+}
@@ -0,0 +1,23 @@
+#version 450
+
+#include "deferred_shading.glsl"
+
+layout(location = 0) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+// Compact G-Buffer inputs
+layout(set = 0, binding = 0) uniform sampler2D gDepth;
+layout(set = 0, binding = 1) uniform sampler2D gNormal;
+layout(set = 0, binding = 2) uniform sampler2D gAlbedo;
+layout(set = 0, binding = 3) uniform sampler2D gMaterial;
+
+void main() {
+    float depth = texture(gDepth, fragTexCoord).r;
+    vec3 position = reconstructPosition(fragTexCoord, depth, lighting.inverseViewProjection);
+    vec3 normal = decodeNormal(texture(gNormal, fragTexCoord).rg);
+    vec3 albedo = texture(gAlbedo, fragTexCoord).rgb;
+    vec3 material = texture(gMaterial, fragTexCoord).rgb;
+    
+    outColor = vec4(shadeGBuffer(position, normal, albedo, material.r, material.g, material.b), 1.0);
+}
@@ -0,0 +1,25 @@
+#version 450
+
+// Compact G-buffer lighting as the second subpass of the G-buffer render pass
+
+#include "deferred_shading.glsl"
+
+layout(location = 0) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+// Compact G-Buffer inputs (same bindings as the sampled path)
+layout(input_attachment_index = 0, set = 0, binding = 0) uniform subpassInput gDepth;
+layout(input_attachment_index = 1, set = 0, binding = 1) uniform subpassInput gNormal;
+layout(input_attachment_index = 2, set = 0, binding = 2) uniform subpassInput gAlbedo;
+layout(input_attachment_index = 3, set = 0, binding = 3) uniform subpassInput gMaterial;
+
+void main() {
+    float depth = subpassLoad(gDepth).r;
+    vec3 position = reconstructPosition(fragTexCoord, depth, lighting.inverseViewProjection);
+    vec3 normal = decodeNormal(subpassLoad(gNormal).rg);
+    vec3 albedo = subpassLoad(gAlbedo).rgb;
+    vec3 material = subpassLoad(gMaterial).rgb;
+    
+    outColor = vec4(shadeGBuffer(position, normal, albedo, material.r, material.g, material.b), 1.0);
+}
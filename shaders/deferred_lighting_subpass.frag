@@ -0,0 +1,25 @@
+#version 450
+
+// Deferred lighting as the second subpass of the G-buffer render pass: the G-buffer is
+// read from tile memory through input attachments instead of being sampled
+
+#include "deferred_shading.glsl"
+
+layout(location = 0) in vec2 fragTexCoord;
+
+layout(location = 0) out vec4 outColor;
+
+// G-Buffer inputs (same bindings as the sampled path)
+layout(input_attachment_index = 0, set = 0, binding = 0) uniform subpassInput gPosition;
+layout(input_attachment_index = 1, set = 0, binding = 1) uniform subpassInput gNormal;
+layout(input_attachment_index = 2, set = 0, binding = 2) uniform subpassInput gAlbedo;
+layout(input_attachment_index = 3, set = 0, binding = 3) uniform subpassInput gMetallicRoughness;
+
+void main() {
+    vec3 position = subpassLoad(gPosition).rgb;
+    vec3 normal = decodeNormal(subpassLoad(gNormal).rg);
+    vec3 albedo = subpassLoad(gAlbedo).rgb;
+    vec2 metallicRoughness = subpassLoad(gMetallicRoughness).rg;
+
+    outColor = vec4(shadeGBuffer(position, normal, albedo, metallicRoughness.r, metallicRoughness.g, 1.0), 1.0);
+}
@@ -0,0 +1,31 @@
+// bindless_material.glsl
+// Global texture array and material buffer (set 1 of the bindless geometry shaders)
+
+#ifndef BINDLESS_MATERIAL_GLSL
+#define BINDLESS_MATERIAL_GLSL
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+
+// Matches INVALID_BINDLESS_INDEX in VulkanBindlessRegistry.hpp: "no texture"
+const uint INVALID_BINDLESS_INDEX = 0xFFFFFFFFu;
+
+// Matches BindlessMaterial in VulkanBindlessRegistry.hpp
+struct Material {
+    vec4 baseColorFactor;
+    float metallicFactor;
+    float roughnessFactor;
+    float normalScale;
+    float aoStrength;
+    uint albedoTexture;
+    uint normalTexture;
+    uint metallicRoughnessTexture;
+    uint aoTexture;
+};
+
+layout(std430, set = 1, binding = 1) readonly buffer MaterialBuffer {
+    Material materials[];
+};
+
+#endif // BINDLESS_MATERIAL_GLSL
@@ -0,0 +1,60 @@
+// clustered_lighting.glsl
+// Light list and cluster grid shared by light_clustering.comp and the deferred lighting passes
+
+#ifndef CLUSTERED_LIGHTING_GLSL
+#define CLUSTERED_LIGHTING_GLSL
+
+// Point light (std430, matches PointLight in DeferredRenderer.hpp)
+struct PointLight {
+    vec3 position;
+    float radius;
+    vec3 color;
+    float intensity;
+};
+
+// Lighting uniform (std140, matches LightingUniforms in DeferredRenderer.hpp)
+layout(set = 0, binding = 4) uniform LightingUniforms {
+    mat4 view;
+    mat4 inverseProjection;     // Cluster bounds
+    mat4 inverseViewProjection; // Compact layout: position from depth
+    vec3 viewPosition;
+    uint lightCount;
+    vec3 ambientColor;
+    float ambientIntensity;
+    float zNear;
+    float zFar;
+    float sliceScale;           // slice = log(viewDepth) * sliceScale + sliceBias
+    float sliceBias;
+    uvec3 clusterCount;
+    uint maxLightsPerCluster;
+    vec2 tileSize;              // Pixels covered by one cluster column
+    vec2 screenSize;
+} lighting;
+
+layout(std430, set = 0, binding = 5) readonly buffer LightBuffer {
+    PointLight lights[];
+};
+
+// Light count per cluster
+layout(std430, set = 0, binding = 6) buffer ClusterGrid {
+    uint clusterLightCounts[];
+};
+
+// maxLightsPerCluster light indices per cluster
+layout(std430, set = 0, binding = 7) buffer ClusterLightIndices {
+    uint clusterLightIndices[];
+};
+
+uint clusterIndex(uvec3 cluster) {
+    return cluster.x + lighting.clusterCount.x * (cluster.y + lighting.clusterCount.y * cluster.z);
+}
+
+// Cluster containing a pixel at a given world position
+uint clusterIndexAt(vec2 fragCoord, vec3 worldPosition) {
+    float viewDepth = -(lighting.view * vec4(worldPosition, 1.0)).z;
+    uint slice = uint(max(log(max(viewDepth, lighting.zNear)) * lighting.sliceScale + lighting.sliceBias, 0.0));
+    uvec2 tile = uvec2(fragCoord / lighting.tileSize);
+    return clusterIndex(min(uvec3(tile, slice), lighting.clusterCount - 1u));
+}
+
+#endif // CLUSTERED_LIGHTING_GLSL
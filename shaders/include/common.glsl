@@ -34,18 +34,28 @@ float linearizeDepth(float depth, float near, float far) {
 }
 
 // Encode/decode functions for G-Buffer
+// Octahedral mapping of a unit normal to [-1,1]^2 (store in an SNORM target)
+vec2 octWrap(vec2 v) {
+    return (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
 vec2 encodeNormal(vec3 n) {
-    return n.xy * 0.5 + 0.5;
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    return n.z >= 0.0 ? n.xy : octWrap(n.xy);
 }
 
 vec3 decodeNormal(vec2 enc) {
-    vec2 fenc = enc * 4.0 - 2.0;
-    float f = dot(fenc, fenc);
-    float g = sqrt(1.0 - f / 4.0);
-    vec3 n;
-    n.xy = fenc * g;
-    n.z = 1.0 - f / 2.0;
-    return n;
+    vec3 n = vec3(enc, 1.0 - abs(enc.x) - abs(enc.y));
+    float t = clamp(-n.z, 0.0, 1.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
+// World position from a [0,1] depth value and screen UV (Vulkan clip space)
+vec3 reconstructPosition(vec2 uv, float depth, mat4 inverseViewProjection) {
+    vec4 clip = vec4(uv * 2.0 - 1.0, depth, 1.0);
+    vec4 world = inverseViewProjection * clip;
+    return world.xyz / world.w;
 }
 
 #endif // COMMON_GLSL
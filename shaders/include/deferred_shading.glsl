@@ -0,0 +1,66 @@
+// deferred_shading.glsl
+// Clustered lighting shared by the sampled and subpass-input deferred lighting passes
+
+#ifndef DEFERRED_SHADING_GLSL
+#define DEFERRED_SHADING_GLSL
+
+#include "pbr.glsl"
+#include "clustered_lighting.glsl"
+
+// Cook-Torrance contribution of one point light
+vec3 shadePointLight(PointLight light, vec3 position, vec3 N, vec3 V, vec3 albedo, float metallic, float roughness,
+                     vec3 F0) {
+    vec3 L = light.position - position;
+    float distance = length(L);
+    L /= max(distance, EPSILON);
+    
+    // Attenuation (simple inverse square with radius cutoff)
+    float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
+    attenuation *= smoothstep(light.radius, light.radius * 0.5, distance);
+    vec3 radiance = light.color * light.intensity * attenuation;
+    
+    vec3 H = normalize(V + L);
+    float NDF = distributionGGX(N, H, roughness);
+    float G = geometrySmith(N, V, L, roughness);
+    vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+    
+    vec3 kD = vec3(1.0) - F;
+    kD *= 1.0 - metallic;
+    
+    vec3 numerator = NDF * G * F;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + EPSILON;
+    vec3 specular = numerator / max(denominator, EPSILON);
+    
+    float NdotL = max(dot(N, L), 0.0);
+    return (kD * albedo / PI + specular) * radiance * NdotL;
+}
+
+// Shade one G-buffer texel with the lights binned into its cluster
+vec3 shadeGBuffer(vec3 position, vec3 normal, vec3 albedo, float metallic, float roughness, float ao) {
+    // View direction
+    vec3 V = normalize(lighting.viewPosition - position);
+    vec3 N = normalize(normal);
+    
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, albedo, metallic);
+    
+    // Direct lighting (Cook-Torrance BRDF), only the lights overlapping this cluster
+    uint cluster = clusterIndexAt(gl_FragCoord.xy, position);
+    uint count = clusterLightCounts[cluster];
+    uint first = cluster * lighting.maxLightsPerCluster;
+    vec3 Lo = vec3(0.0);
+    for (uint i = 0; i < count; i++) {
+        Lo += shadePointLight(lights[clusterLightIndices[first + i]], position, N, V, albedo, metallic, roughness, F0);
+    }
+    
+    // Ambient lighting
+    vec3 F = fresnelSchlickRoughness(max(dot(N, V), 0.0), F0, roughness);
+    vec3 kD = 1.0 - F;
+    kD *= 1.0 - metallic;
+    vec3 ambient = lighting.ambientColor * lighting.ambientIntensity * albedo * kD * ao;
+    
+    // Final color, tone mapped and encoded per the pipeline's features
+    return encodeOutputColor(ambient + Lo);
+}
+
+#endif // DEFERRED_SHADING_GLSL
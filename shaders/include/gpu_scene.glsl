@@ -0,0 +1,43 @@
+// gpu_scene.glsl
+// Instance and mesh records of the GPU-driven path (gpu_culling.comp, deferred_geometry_indirect.vert)
+
+#ifndef GPU_SCENE_GLSL
+#define GPU_SCENE_GLSL
+
+// Per-instance record (std430, matches GpuInstance in GpuDrivenRenderer.hpp)
+struct GpuInstance {
+    mat4 model;
+    vec4 normalMatrix[3]; // Columns of the inverse transpose of mat3(model)
+    uint mesh;
+    uint material;        // Bindless material index
+    uint permutation;     // Geometry shader permutation; selects the draw range
+    uint _pad;
+};
+
+// Per-mesh record (std430, matches GpuMesh in GpuDrivenRenderer.hpp)
+struct GpuMesh {
+    vec3 boundsCenter;    // Object-space bounding sphere
+    float boundsRadius;
+    uint indexCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint _pad;
+};
+
+// Scene uniform (std140, matches GpuSceneUniforms in GpuDrivenRenderer.hpp)
+layout(set = 0, binding = 0) uniform GpuSceneUniforms {
+    mat4 viewProjection;
+    vec4 frustumPlanes[6];  // xyz = inward normal, w = distance
+    uint instanceCount;
+    uint residentMeshCount; // Meshes whose data has reached the GPU
+    uint compactDraws;      // 1 = append visible draws behind a count, 0 = one slot per instance
+    uint _pad;
+    uvec4 permutationFirst; // Instance slots of each permutation, drawn with that permutation's pipeline
+    uvec4 permutationCount;
+} scene;
+
+layout(std430, set = 0, binding = 1) readonly buffer InstanceBuffer {
+    GpuInstance instances[];
+};
+
+#endif // GPU_SCENE_GLSL
@@ -5,6 +5,7 @@
 #define PBR_GLSL
 
 #include "common.glsl"
+#include "shader_features.glsl"
 
 // PBR material properties
 struct PBRMaterial {
@@ -113,5 +114,17 @@ vec3 calculateAmbient(vec3 N, vec3 V, vec3 albedo, float metallic, float roughne
     return ambient;
 }
 
+// Map linear radiance to the output target: Reinhard tone mapping, then gamma unless the
+// target is sRGB and encodes on write
+vec3 encodeOutputColor(vec3 color) {
+    if (FEATURE_TONEMAP) {
+        color = color / (color + vec3(1.0));
+    }
+    if (FEATURE_GAMMA_CORRECTION) {
+        color = pow(color, vec3(1.0 / 2.2));
+    }
+    return color;
+}
+
 #endif // PBR_GLSL
 
@@ -0,0 +1,14 @@
+// shader_features.glsl
+// Feature toggles shared by every shader, set per pipeline as specialization constants.
+// Constant i is bit i of ShaderFeatures in PipelineManager.hpp; the defaults are the full
+// path, and the compiler drops the code behind a disabled toggle.
+
+#ifndef SHADER_FEATURES_GLSL
+#define SHADER_FEATURES_GLSL
+
+layout(constant_id = 0) const bool FEATURE_NORMAL_MAP = true;              // Perturb normals with the normal texture
+layout(constant_id = 1) const bool FEATURE_METALLIC_ROUGHNESS_MAP = true;  // Scale the factors by the texture
+layout(constant_id = 2) const bool FEATURE_TONEMAP = true;                 // Reinhard before writing the target
+layout(constant_id = 3) const bool FEATURE_GAMMA_CORRECTION = true;        // pow gamma; off for sRGB targets
+
+#endif // SHADER_FEATURES_GLSL
@@ -0,0 +1,269 @@
+#include "core/ecs/World.hpp"
+#include "core/logs/Log.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace StellarAlia::Core::ECS {
+
+    namespace {
+        constexpr std::align_val_t CHUNK_ALIGNMENT{ 64 };
+
+        struct ComponentRegistry {
+            std::mutex mutex;
+            std::array<ComponentTypeInfo, MAX_COMPONENT_TYPES> types{};
+            uint32_t count = 0;
+        };
+
+        ComponentRegistry& GetRegistry() {
+            static ComponentRegistry registry;
+            return registry;
+        }
+
+        size_t AlignUp(size_t value, size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    ComponentTypeId RegisterComponentType(size_t size, size_t alignment) {
+        ComponentRegistry& registry = GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        if (registry.count >= MAX_COMPONENT_TYPES) {
+            SA_LOG_ERROR("Too many component types; at most {} are supported", MAX_COMPONENT_TYPES);
+            return UINT32_MAX;
+        }
+        registry.types[registry.count] = { size, alignment };
+        return registry.count++;
+    }
+
+    const ComponentTypeInfo& GetComponentTypeInfo(ComponentTypeId type) {
+        return GetRegistry().types[type];
+    }
+
+    World::~World() {
+        for (const std::unique_ptr<Archetype>& archetype : m_archetypes) {
+            for (const Chunk& chunk : archetype->chunks) {
+                ::operator delete(chunk.data, CHUNK_ALIGNMENT);
+            }
+        }
+    }
+
+    Entity World::CreateEntity(ComponentMask mask) {
+        Entity entity;
+        if (!m_freeIndices.empty()) {
+            entity.index = m_freeIndices.back();
+            m_freeIndices.pop_back();
+        } else {
+            entity.index = static_cast<uint32_t>(m_records.size());
+            m_records.emplace_back();
+        }
+        entity.generation = m_records[entity.index].generation;
+
+        AppendRow(GetArchetype(mask), entity);
+        m_entityCount++;
+        return entity;
+    }
+
+    void World::Destroy(Entity entity) {
+        if (!FindRecord(entity)) {
+            return;
+        }
+
+        EntityRecord& record = m_records[entity.index];
+        RemoveRow(record.archetype, record.chunk, record.row);
+        record.archetype = nullptr;
+        record.generation++;
+        m_freeIndices.push_back(entity.index);
+        m_entityCount--;
+    }
+
+    bool World::IsAlive(Entity entity) const {
+        return FindRecord(entity) != nullptr;
+    }
+
+    void* World::GetComponent(Entity entity, ComponentTypeId type) {
+        const EntityRecord* record = FindRecord(entity);
+        if (!record || type >= MAX_COMPONENT_TYPES || !(record->archetype->mask & GetComponentBit(type))) {
+            return nullptr;
+        }
+        const Archetype& archetype = *record->archetype;
+        return archetype.chunks[record->chunk].data + archetype.columnOffsets[type] +
+               static_cast<size_t>(record->row) * GetComponentTypeInfo(type).size;
+    }
+
+    void World::AddComponent(Entity entity, ComponentTypeId type, const void* value) {
+        const EntityRecord* record = FindRecord(entity);
+        if (!record || type >= MAX_COMPONENT_TYPES) {
+            return;
+        }
+        if (!(record->archetype->mask & GetComponentBit(type))) {
+            MoveEntity(entity, GetAddTarget(record->archetype, type));
+        }
+
+        void* component = GetComponent(entity, type);
+        const size_t size = GetComponentTypeInfo(type).size;
+        if (value) {
+            std::memcpy(component, value, size);
+        } else {
+            std::memset(component, 0, size);
+        }
+    }
+
+    void World::RemoveComponent(Entity entity, ComponentTypeId type) {
+        const EntityRecord* record = FindRecord(entity);
+        if (!record || type >= MAX_COMPONENT_TYPES || !(record->archetype->mask & GetComponentBit(type))) {
+            return;
+        }
+        MoveEntity(entity, GetRemoveTarget(record->archetype, type));
+    }
+
+    ComponentMask World::GetMask(Entity entity) const {
+        const EntityRecord* record = FindRecord(entity);
+        return record ? record->archetype->mask : 0;
+    }
+
+    World::Archetype* World::GetArchetype(ComponentMask mask) {
+        const auto it = m_archetypeByMask.find(mask);
+        if (it != m_archetypeByMask.end()) {
+            return it->second;
+        }
+
+        auto archetype = std::make_unique<Archetype>();
+        archetype->mask = mask;
+        size_t rowSize = sizeof(Entity);
+        for (ComponentMask bits = mask; bits != 0; bits &= bits - 1) {
+            const auto type = static_cast<ComponentTypeId>(std::countr_zero(bits));
+            archetype->types.push_back(type);
+            rowSize += GetComponentTypeInfo(type).size;
+        }
+
+        // Bytes used by the columns of `rows` entities, each column aligned for its type
+        const auto layoutSize = [&](uint32_t rows) {
+            size_t offset = static_cast<size_t>(rows) * sizeof(Entity);
+            for (ComponentTypeId type : archetype->types) {
+                const ComponentTypeInfo& info = GetComponentTypeInfo(type);
+                offset = AlignUp(offset, info.alignment) + static_cast<size_t>(rows) * info.size;
+            }
+            return offset;
+        };
+
+        // Largest row count that fits in one chunk; a single row that does not fit gets a chunk of its own size
+        uint32_t capacity = std::max(static_cast<uint32_t>(CHUNK_SIZE / rowSize), 1u);
+        while (capacity > 1 && layoutSize(capacity) > CHUNK_SIZE) {
+            capacity--;
+        }
+        const size_t singleRowSize = layoutSize(1);
+        if (capacity == 1 && singleRowSize > CHUNK_SIZE) {
+            archetype->chunkSize = AlignUp(singleRowSize, static_cast<size_t>(CHUNK_ALIGNMENT));
+            SA_LOG_WARN("Component set of {} bytes per entity exceeds the {} byte chunk; using {} byte chunks",
+                        rowSize, CHUNK_SIZE, archetype->chunkSize);
+        }
+
+        size_t offset = static_cast<size_t>(capacity) * sizeof(Entity);
+        for (ComponentTypeId type : archetype->types) {
+            const ComponentTypeInfo& info = GetComponentTypeInfo(type);
+            offset = AlignUp(offset, info.alignment);
+            archetype->columnOffsets[type] = static_cast<uint32_t>(offset);
+            offset += static_cast<size_t>(capacity) * info.size;
+        }
+        archetype->capacity = capacity;
+
+        Archetype* result = archetype.get();
+        m_archetypes.push_back(std::move(archetype));
+        m_archetypeByMask.emplace(mask, result);
+        return result;
+    }
+
+    World::Archetype* World::GetAddTarget(Archetype* archetype, ComponentTypeId type) {
+        if (!archetype->addEdges[type]) {
+            archetype->addEdges[type] = GetArchetype(archetype->mask | GetComponentBit(type));
+        }
+        return archetype->addEdges[type];
+    }
+
+    World::Archetype* World::GetRemoveTarget(Archetype* archetype, ComponentTypeId type) {
+        if (!archetype->removeEdges[type]) {
+            archetype->removeEdges[type] = GetArchetype(archetype->mask & ~GetComponentBit(type));
+        }
+        return archetype->removeEdges[type];
+    }
+
+    void World::AppendRow(Archetype* archetype, Entity entity) {
+        if (archetype->chunks.empty() || archetype->chunks.back().count == archetype->capacity) {
+            Chunk chunk;
+            chunk.data = static_cast<std::byte*>(::operator new(archetype->chunkSize, CHUNK_ALIGNMENT));
+            archetype->chunks.push_back(chunk);
+        }
+
+        Chunk& chunk = archetype->chunks.back();
+        const uint32_t row = chunk.count++;
+        std::memcpy(chunk.data + row * sizeof(Entity), &entity, sizeof(Entity));
+        for (ComponentTypeId type : archetype->types) {
+            const size_t size = GetComponentTypeInfo(type).size;
+            std::memset(chunk.data + archetype->columnOffsets[type] + row * size, 0, size);
+        }
+
+        EntityRecord& record = m_records[entity.index];
+        record.archetype = archetype;
+        record.chunk = static_cast<uint32_t>(archetype->chunks.size() - 1);
+        record.row = row;
+    }
+
+    void World::RemoveRow(Archetype* archetype, uint32_t chunkIndex, uint32_t row) {
+        // Fill the hole with the archetype's last row so every chunk but the last stays full
+        Chunk& last = archetype->chunks.back();
+        const uint32_t lastRow = last.count - 1;
+        Chunk& chunk = archetype->chunks[chunkIndex];
+        if (&chunk != &last || row != lastRow) {
+            Entity moved;
+            std::memcpy(&moved, last.data + lastRow * sizeof(Entity), sizeof(Entity));
+            std::memcpy(chunk.data + row * sizeof(Entity), &moved, sizeof(Entity));
+            for (ComponentTypeId type : archetype->types) {
+                const size_t size = GetComponentTypeInfo(type).size;
+                const uint32_t column = archetype->columnOffsets[type];
+                std::memcpy(chunk.data + column + row * size, last.data + column + lastRow * size, size);
+            }
+            m_records[moved.index].chunk = chunkIndex;
+            m_records[moved.index].row = row;
+        }
+
+        if (--last.count == 0) {
+            ::operator delete(last.data, CHUNK_ALIGNMENT);
+            archetype->chunks.pop_back();
+        }
+    }
+
+    void World::MoveEntity(Entity entity, Archetype* target) {
+        EntityRecord& record = m_records[entity.index];
+        Archetype* source = record.archetype;
+        const uint32_t sourceChunk = record.chunk;
+        const uint32_t sourceRow = record.row;
+
+        AppendRow(target, entity);
+
+        // Components present in both archetypes keep their values; new ones stay zeroed
+        const Chunk& from = source->chunks[sourceChunk];
+        const Chunk& to = target->chunks[record.chunk];
+        for (ComponentTypeId type : target->types) {
+            if (source->mask & GetComponentBit(type)) {
+                const size_t size = GetComponentTypeInfo(type).size;
+                std::memcpy(to.data + target->columnOffsets[type] + record.row * size,
+                            from.data + source->columnOffsets[type] + sourceRow * size, size);
+            }
+        }
+
+        RemoveRow(source, sourceChunk, sourceRow);
+    }
+
+    const World::EntityRecord* World::FindRecord(Entity entity) const {
+        if (entity.index >= m_records.size()) {
+            return nullptr;
+        }
+        const EntityRecord& record = m_records[entity.index];
+        return record.archetype && record.generation == entity.generation ? &record : nullptr;
+    }
+
+} // namespace StellarAlia::Core::ECS
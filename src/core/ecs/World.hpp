@@ -0,0 +1,305 @@
+#pragma once
+
+/**
+ * @file World.hpp
+ * @brief Archetype-based entity-component storage
+ *
+ * Entities with the same set of component types share an archetype. An archetype
+ * stores its entities in fixed 16 KB chunks, each laid out as structure-of-arrays: the
+ * entity ids, then one tightly packed array per component type. Queries visit the
+ * matching archetypes and walk their chunks linearly, so iterating tens of thousands
+ * of entities touches contiguous memory only.
+ *
+ * Chunks stay densely packed: removing an entity moves the archetype's last entity
+ * into its row. Adding or removing a component moves the entity to another archetype.
+ * Entity ids are generational, so ids of destroyed entities are detected as stale
+ * even after their index has been reused.
+ *
+ * Components must be trivially copyable and destructible, since rows are moved with
+ * memcpy. At most MAX_COMPONENT_TYPES component types can be registered.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace StellarAlia::Core::ECS {
+
+    using ComponentTypeId = uint32_t;
+    using ComponentMask = uint64_t;
+
+    constexpr uint32_t MAX_COMPONENT_TYPES = 64;
+    constexpr size_t CHUNK_SIZE = 16 * 1024;  // Archetypes whose single row is larger get chunks of their own size
+
+    /**
+     * @brief Generational entity id
+     */
+    struct Entity {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+
+        bool IsValid() const { return index != UINT32_MAX; }
+        bool operator==(const Entity&) const = default;
+    };
+
+    /**
+     * @brief Size and alignment of a registered component type
+     */
+    struct ComponentTypeInfo {
+        size_t size = 0;
+        size_t alignment = 0;
+    };
+
+    /**
+     * @brief Register a component type (thread-safe)
+     * @param size sizeof the component
+     * @param alignment alignof the component
+     * @return New type id, or UINT32_MAX once MAX_COMPONENT_TYPES are registered
+     */
+    ComponentTypeId RegisterComponentType(size_t size, size_t alignment);
+
+    /**
+     * @brief Get a registered component type's layout
+     * @param type Type id
+     * @return Size and alignment
+     */
+    const ComponentTypeInfo& GetComponentTypeInfo(ComponentTypeId type);
+
+    /**
+     * @brief Get the id of a component type, registering it on first use
+     * @return Type id
+     */
+    template <typename T>
+    ComponentTypeId GetComponentType() {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                      "Components are moved with memcpy and never destroyed");
+        static const ComponentTypeId type = RegisterComponentType(sizeof(T), alignof(T));
+        return type;
+    }
+
+    /**
+     * @brief Get the mask bit of a component type
+     * @param type Type id
+     * @return Bit, or 0 for an invalid id
+     */
+    constexpr ComponentMask GetComponentBit(ComponentTypeId type) {
+        return type < MAX_COMPONENT_TYPES ? ComponentMask{ 1 } << type : 0;
+    }
+
+    /**
+     * @brief Get the mask of a set of component types
+     * @return One bit per type
+     */
+    template <typename... Ts>
+    ComponentMask GetComponentMask() {
+        return (ComponentMask{ 0 } | ... | GetComponentBit(GetComponentType<Ts>()));
+    }
+
+    /**
+     * @brief Entities and their components
+     *
+     * Not thread-safe for structural changes (creating or destroying entities, adding or
+     * removing components). Those must not happen inside ForEach/ForEachChunk callbacks.
+     * Reads and writes of existing components from several threads are fine as long as
+     * they touch different entities or component types.
+     */
+    class World {
+    public:
+        World() = default;
+        ~World();
+
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+        /**
+         * @brief Create an entity with zero-initialized components
+         * @param mask Component types of the entity
+         * @return Entity id
+         */
+        Entity CreateEntity(ComponentMask mask = 0);
+
+        /**
+         * @brief Create an entity from component values
+         * @param components Initial component values (distinct types)
+         * @return Entity id
+         */
+        template <typename... Ts>
+        Entity Create(const Ts&... components) {
+            const Entity entity = CreateEntity(GetComponentMask<Ts...>());
+            ((*static_cast<Ts*>(GetComponent(entity, GetComponentType<Ts>())) = components), ...);
+            return entity;
+        }
+
+        /**
+         * @brief Destroy an entity; its id becomes stale
+         * @param entity Entity id
+         */
+        void Destroy(Entity entity);
+
+        /**
+         * @brief Check whether an id refers to a live entity
+         * @param entity Entity id
+         * @return True if alive
+         */
+        bool IsAlive(Entity entity) const;
+
+        /**
+         * @brief Get the number of live entities
+         * @return Entity count
+         */
+        uint32_t GetEntityCount() const { return m_entityCount; }
+
+        /**
+         * @brief Get the number of archetypes created so far
+         * @return Archetype count
+         */
+        uint32_t GetArchetypeCount() const { return static_cast<uint32_t>(m_archetypes.size()); }
+
+        /**
+         * @brief Get a component by type id
+         * @param entity Entity id
+         * @param type Component type id
+         * @return Component, or nullptr if the entity is stale or lacks the component
+         */
+        void* GetComponent(Entity entity, ComponentTypeId type);
+
+        /**
+         * @brief Add or overwrite a component by type id
+         * @param entity Entity id
+         * @param type Component type id
+         * @param value Component bytes, or nullptr to zero-initialize
+         */
+        void AddComponent(Entity entity, ComponentTypeId type, const void* value);
+
+        /**
+         * @brief Remove a component by type id (no-op if absent)
+         * @param entity Entity id
+         * @param type Component type id
+         */
+        void RemoveComponent(Entity entity, ComponentTypeId type);
+
+        /**
+         * @brief Get the component mask of an entity
+         * @param entity Entity id
+         * @return Mask, or 0 if the entity is stale
+         */
+        ComponentMask GetMask(Entity entity) const;
+
+        /**
+         * @brief Get a component
+         * @param entity Entity id
+         * @return Component, or nullptr if the entity is stale or lacks it
+         */
+        template <typename T>
+        T* Get(Entity entity) {
+            return static_cast<T*>(GetComponent(entity, GetComponentType<T>()));
+        }
+
+        /**
+         * @brief Check whether an entity has a component
+         * @param entity Entity id
+         * @return True if the entity is alive and has it
+         */
+        template <typename T>
+        bool Has(Entity entity) const {
+            return (GetMask(entity) & GetComponentMask<T>()) != 0;
+        }
+
+        /**
+         * @brief Add or overwrite a component
+         * @param entity Entity id
+         * @param value Component value
+         */
+        template <typename T>
+        void Add(Entity entity, const T& value = {}) {
+            AddComponent(entity, GetComponentType<T>(), &value);
+        }
+
+        /**
+         * @brief Remove a component (no-op if absent)
+         * @param entity Entity id
+         */
+        template <typename T>
+        void Remove(Entity entity) {
+            RemoveComponent(entity, GetComponentType<T>());
+        }
+
+        /**
+         * @brief Visit every chunk holding all of Ts
+         * @param callback Called as callback(count, const Entity*, Ts*...) with one array per
+         *                 component, each count long
+         */
+        template <typename... Ts, typename F>
+        void ForEachChunk(F&& callback) {
+            if (((GetComponentType<Ts>() >= MAX_COMPONENT_TYPES) || ...)) {
+                return;
+            }
+            const ComponentMask required = GetComponentMask<Ts...>();
+            for (const std::unique_ptr<Archetype>& archetype : m_archetypes) {
+                if ((archetype->mask & required) != required) {
+                    continue;
+                }
+                for (const Chunk& chunk : archetype->chunks) {
+                    callback(chunk.count, reinterpret_cast<const Entity*>(chunk.data),
+                             reinterpret_cast<Ts*>(chunk.data + archetype->columnOffsets[GetComponentType<Ts>()])...);
+                }
+            }
+        }
+
+        /**
+         * @brief Visit every entity holding all of Ts
+         * @param callback Called as callback(Ts&...)
+         */
+        template <typename... Ts, typename F>
+        void ForEach(F&& callback) {
+            ForEachChunk<Ts...>([&callback](uint32_t count, const Entity*, Ts*... columns) {
+                for (uint32_t i = 0; i < count; i++) {
+                    callback(columns[i]...);
+                }
+            });
+        }
+
+    private:
+        struct Chunk {
+            std::byte* data = nullptr;  // chunkSize bytes: entities, then one array per component
+            uint32_t count = 0;
+        };
+
+        struct Archetype {
+            ComponentMask mask = 0;
+            std::vector<ComponentTypeId> types;
+            std::array<uint32_t, MAX_COMPONENT_TYPES> columnOffsets{};  // Byte offset per type in a chunk
+            uint32_t capacity = 0;                                       // Entities per chunk
+            size_t chunkSize = CHUNK_SIZE;                               // Larger only for rows over CHUNK_SIZE
+            std::vector<Chunk> chunks;                                   // All full except the last
+            std::array<Archetype*, MAX_COMPONENT_TYPES> addEdges{};      // Archetype with one more type
+            std::array<Archetype*, MAX_COMPONENT_TYPES> removeEdges{};   // Archetype with one type less
+        };
+
+        struct EntityRecord {
+            Archetype* archetype = nullptr;  // nullptr while the index is free
+            uint32_t chunk = 0;
+            uint32_t row = 0;
+            uint32_t generation = 0;
+        };
+
+        std::vector<std::unique_ptr<Archetype>> m_archetypes;
+        std::unordered_map<ComponentMask, Archetype*> m_archetypeByMask;
+        std::vector<EntityRecord> m_records;
+        std::vector<uint32_t> m_freeIndices;
+        uint32_t m_entityCount = 0;
+
+        Archetype* GetArchetype(ComponentMask mask);
+        Archetype* GetAddTarget(Archetype* archetype, ComponentTypeId type);
+        Archetype* GetRemoveTarget(Archetype* archetype, ComponentTypeId type);
+        void AppendRow(Archetype* archetype, Entity entity);
+        void RemoveRow(Archetype* archetype, uint32_t chunk, uint32_t row);
+        void MoveEntity(Entity entity, Archetype* target);
+        const EntityRecord* FindRecord(Entity entity) const;
+    };
+
+} // namespace StellarAlia::Core::ECS
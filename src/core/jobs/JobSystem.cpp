@@ -0,0 +1,388 @@
+#include "core/jobs/JobSystem.hpp"
+#include "core/logs/Log.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace StellarAlia::Core::Jobs {
+
+    namespace {
+        // Failed steal rounds before an idle worker goes to sleep
+        constexpr uint32_t IDLE_ROUNDS_BEFORE_SLEEP = 64;
+
+        // ParallelFor starts from ranges of count / (threads * this); splitting goes no finer
+        constexpr uint32_t BATCHES_PER_THREAD = 32;
+
+        thread_local uint32_t t_threadIndex = INVALID_THREAD_INDEX;
+        thread_local JobSystem* t_system = nullptr;
+
+        bool PinCurrentThread(uint32_t core) {
+#if defined(_WIN32)
+            if (core >= 64) {
+                return false;  // Beyond the first processor group
+            }
+            return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << core) != 0;
+#elif defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(core, &set);
+            return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+            (void)core;
+            return false;
+#endif
+        }
+
+        uint32_t NextRandom(uint32_t& state) {
+            // xorshift32
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+    }
+
+    WorkStealingDeque::WorkStealingDeque(uint32_t capacity)
+        : m_buffer(std::make_unique<std::atomic<Job*>[]>(capacity)),
+          m_mask(static_cast<int64_t>(capacity) - 1) {}
+
+    bool WorkStealingDeque::Push(Job* job) {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_top.load(std::memory_order_acquire);
+        if (bottom - top > m_mask) {
+            return false;
+        }
+        m_buffer[bottom & m_mask].store(job, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_release);  // Publishes the job to thieves
+        return true;
+    }
+
+    Job* WorkStealingDeque::Pop() {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = m_buffer[bottom & m_mask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last job: race the thieves for it
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                job = nullptr;
+            }
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* WorkStealingDeque::Steal() {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        Job* job = m_buffer[top & m_mask].load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return job;
+    }
+
+    uint32_t WorkStealingDeque::GetSize() const {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<uint32_t>(bottom - top) : 0;
+    }
+
+    JobSystem::~JobSystem() {
+        Shutdown();
+    }
+
+    bool JobSystem::Initialize(const JobSystemCreateInfo& createInfo) {
+        if (IsInitialized()) {
+            SA_LOG_WARN("JobSystem already initialized");
+            return false;
+        }
+        if (t_system) {
+            SA_LOG_ERROR("The calling thread already belongs to another job system");
+            return false;
+        }
+
+        const uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        const uint32_t workerCount = createInfo.workerCount > 0 ? createInfo.workerCount : hardwareThreads - 1;
+
+        m_threads.reserve(static_cast<size_t>(workerCount) + 1);
+        for (uint32_t i = 0; i <= workerCount; i++) {
+            auto thread = std::make_unique<ThreadState>(MAX_JOBS_PER_THREAD);
+            thread->jobs = std::make_unique<Job[]>(MAX_JOBS_PER_THREAD);
+            thread->random = 0x9E3779B9u * (i + 1);
+            m_threads.push_back(std::move(thread));
+        }
+
+        t_threadIndex = 0;
+        t_system = this;
+        m_running.store(true, std::memory_order_release);
+
+        m_workers.reserve(workerCount);
+        for (uint32_t i = 1; i <= workerCount; i++) {
+            const bool pin = createInfo.pinThreads;
+            m_workers.emplace_back([this, i, pin, hardwareThreads] {
+                if (pin && !PinCurrentThread(i % hardwareThreads)) {
+                    SA_LOG_WARN("Failed to pin job worker {} to core {}", i, i % hardwareThreads);
+                }
+                WorkerLoop(i);
+            });
+        }
+
+        SA_LOG_INFO("Job system started: {} workers + main thread{}", workerCount,
+                    createInfo.pinThreads ? ", workers pinned per core" : "");
+        return true;
+    }
+
+    void JobSystem::Shutdown() {
+        if (!IsInitialized()) {
+            return;
+        }
+
+        m_running.store(false, std::memory_order_release);
+        m_wakeEpoch.fetch_add(1, std::memory_order_release);
+        m_wakeEpoch.notify_all();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+        m_workers.clear();
+
+        uint32_t dropped = 0;
+        for (const auto& thread : m_threads) {
+            dropped += thread->deque.GetSize();
+        }
+        if (dropped > 0) {
+            SA_LOG_WARN("Job system shut down with {} queued jobs", dropped);
+        }
+        m_threads.clear();
+
+        if (t_system == this) {
+            t_system = nullptr;
+            t_threadIndex = INVALID_THREAD_INDEX;
+        }
+    }
+
+    uint32_t JobSystem::GetCurrentThreadIndex() {
+        return t_threadIndex;
+    }
+
+    void JobSystem::Run(Job* job) {
+        if (!job) {
+            return;
+        }
+        if (t_system != this) {
+            SA_LOG_ERROR("Jobs can only be run from the main thread or a job worker");
+            return;
+        }
+
+        if (!m_threads[t_threadIndex]->deque.Push(job)) {
+            Execute(job);  // Deque full: run it now rather than drop it
+            return;
+        }
+
+        // Pairs with the fence in the sleep path of WorkerLoop: either the sleeper sees the
+        // job, or this sees the sleeper and wakes it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleepingWorkers.load(std::memory_order_relaxed) > 0) {
+            m_wakeEpoch.fetch_add(1, std::memory_order_release);
+            m_wakeEpoch.notify_one();
+        }
+    }
+
+    void JobSystem::Wait(const Job* job) {
+        while (!IsFinished(job)) {
+            if (!RunPendingJob()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool JobSystem::RunPendingJob() {
+        if (t_system != this) {
+            return false;
+        }
+        Job* job = FindJob(*m_threads[t_threadIndex]);
+        if (!job) {
+            return false;
+        }
+        Execute(job);
+        return true;
+    }
+
+    Job* JobSystem::AllocateJob(Job* parent) {
+        if (t_system != this) {
+            SA_LOG_ERROR("Jobs can only be created from the main thread or a job worker");
+            return nullptr;
+        }
+
+        ThreadState& thread = *m_threads[t_threadIndex];
+        Job* job = &thread.jobs[thread.nextJob++ & (MAX_JOBS_PER_THREAD - 1)];
+
+        // The ring wrapped onto a job still in flight; help until it retires
+        while (!IsFinished(job)) {
+            if (!RunPendingJob()) {
+                std::this_thread::yield();
+            }
+        }
+
+        job->function = nullptr;
+        job->parent = parent;
+        job->unfinished.store(1, std::memory_order_relaxed);
+        if (parent) {
+            parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* JobSystem::FindJob(ThreadState& thread) {
+        if (Job* job = thread.deque.Pop()) {
+            return job;
+        }
+
+        // Steal from the other threads, starting at a random victim
+        const auto threadCount = static_cast<uint32_t>(m_threads.size());
+        const uint32_t start = NextRandom(thread.random) % threadCount;
+        for (uint32_t i = 0; i < threadCount; i++) {
+            const uint32_t victim = (start + i) % threadCount;
+            if (victim == t_threadIndex) {
+                continue;
+            }
+            if (Job* job = m_threads[victim]->deque.Steal()) {
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    void JobSystem::Execute(Job* job) {
+        if (job->function) {
+            job->function(*job);
+        }
+        Finish(job);
+    }
+
+    void JobSystem::Finish(Job* job) {
+        // Read the parent first: once the count reaches zero the slot may be reused
+        while (job) {
+            Job* parent = job->parent;
+            if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            job = parent;
+        }
+    }
+
+    void JobSystem::WorkerLoop(uint32_t threadIndex) {
+        t_threadIndex = threadIndex;
+        t_system = this;
+        ThreadState& thread = *m_threads[threadIndex];
+
+        uint32_t idleRounds = 0;
+        while (m_running.load(std::memory_order_acquire)) {
+            if (Job* job = FindJob(thread)) {
+                Execute(job);
+                idleRounds = 0;
+                continue;
+            }
+            if (++idleRounds < IDLE_ROUNDS_BEFORE_SLEEP) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Announce the sleep, then look once more so a job queued in between is not missed
+            m_sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+            const uint32_t epoch = m_wakeEpoch.load(std::memory_order_seq_cst);
+            Job* job = FindJob(thread);
+            if (!job && m_running.load(std::memory_order_acquire)) {
+                m_wakeEpoch.wait(epoch, std::memory_order_acquire);
+            }
+            m_sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+            if (job) {
+                Execute(job);
+            }
+            idleRounds = 0;
+        }
+
+        t_system = nullptr;
+        t_threadIndex = INVALID_THREAD_INDEX;
+    }
+
+    void JobSystem::ParallelForImpl(uint32_t count, uint32_t minBatchSize, RangeFunction function,
+                                    const void* context) {
+        if (count == 0) {
+            return;
+        }
+
+        // Run serially outside the system's threads (including before Initialize()) or without workers
+        if (!IsInitialized() || GetThreadCount() <= 1 || t_system != this) {
+            function(context, 0, count);
+            return;
+        }
+
+        const uint32_t grain = std::max({ minBatchSize, count / (GetThreadCount() * BATCHES_PER_THREAD), 1u });
+        if (count <= grain) {
+            function(context, 0, count);
+            return;
+        }
+
+        static_assert(sizeof(RangeJobData) <= Job::PAYLOAD_SIZE, "Range job data must fit a job payload");
+        const RangeJobData data{ this, function, context, 0, count, grain };
+        Job* root = AllocateJob(nullptr);
+        std::memcpy(root->payload, &data, sizeof(data));
+        root->function = &JobSystem::RunRange;
+
+        // Run the root here; the halves it splits off are stolen by the other threads
+        Execute(root);
+        Wait(root);
+    }
+
+    void JobSystem::RunRange(Job& job) {
+        RangeJobData data;
+        std::memcpy(&data, job.payload, sizeof(data));
+        JobSystem& system = *data.system;
+        const WorkStealingDeque& deque = system.m_threads[t_threadIndex]->deque;
+
+        while (data.end - data.begin > data.grain) {
+            if (deque.GetSize() == 0) {
+                // Everything offered so far has been taken: offer the upper half
+                RangeJobData upper = data;
+                upper.begin = data.begin + (data.end - data.begin) / 2;
+                data.end = upper.begin;
+
+                Job* child = system.AllocateJob(&job);
+                std::memcpy(child->payload, &upper, sizeof(upper));
+                child->function = &JobSystem::RunRange;
+                system.Run(child);
+            } else {
+                data.function(data.context, data.begin, data.begin + data.grain);
+                data.begin += data.grain;
+            }
+        }
+        data.function(data.context, data.begin, data.end);
+    }
+
+} // namespace StellarAlia::Core::Jobs
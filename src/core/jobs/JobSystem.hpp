@@ -0,0 +1,246 @@
+#pragma once
+
+/**
+ * @file JobSystem.hpp
+ * @brief Work-stealing job scheduler
+ *
+ * A fixed pool of worker threads, one per hardware thread besides the main thread and
+ * optionally pinned to it. Every thread owns a Chase-Lev deque: it pushes and pops
+ * jobs at the bottom, and idle threads steal from the top of the others.
+ *
+ * Jobs form fork-join trees: a job created with a parent keeps the parent unfinished
+ * until it completes, so waiting on the root waits for the whole tree. Waiting never
+ * blocks the waiting thread; it runs pending jobs until the awaited one finishes.
+ *
+ * Only the thread that called Initialize() (the main thread) and the workers may
+ * create, run or wait for jobs.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace StellarAlia::Core::Jobs {
+
+    constexpr uint32_t MAX_JOBS_PER_THREAD = 4096;  // Job slots per thread (power of two)
+    constexpr uint32_t INVALID_THREAD_INDEX = UINT32_MAX;
+
+    /**
+     * @brief A unit of work; created with JobSystem::CreateJob and owned by the system
+     *
+     * Slots are recycled in creation order per thread, so a Job pointer is only valid
+     * until MAX_JOBS_PER_THREAD more jobs have been created on the same thread.
+     */
+    struct alignas(64) Job {
+        static constexpr size_t PAYLOAD_SIZE = 96;
+
+        void (*function)(Job&) = nullptr;
+        Job* parent = nullptr;
+        std::atomic<int32_t> unfinished{ 0 };  // This job plus its unfinished children
+        alignas(16) unsigned char payload[PAYLOAD_SIZE];
+    };
+    static_assert(sizeof(Job) == 128, "Job should span exactly two cache lines");
+
+    /**
+     * @brief Job system creation parameters
+     */
+    struct JobSystemCreateInfo {
+        uint32_t workerCount = 0;  // 0 = one per hardware thread, minus the main thread
+        bool pinThreads = true;    // Pin worker i to logical core i (the main thread is left alone)
+    };
+
+    /**
+     * @brief Fixed-capacity Chase-Lev work-stealing deque
+     * The owner pushes and pops at the bottom; any thread may steal from the top.
+     */
+    class WorkStealingDeque {
+    public:
+        explicit WorkStealingDeque(uint32_t capacity);
+
+        /**
+         * @brief Push a job (owner only)
+         * @return False if the deque is full
+         */
+        bool Push(Job* job);
+
+        /**
+         * @brief Pop the most recently pushed job (owner only)
+         * @return Job, or nullptr if empty
+         */
+        Job* Pop();
+
+        /**
+         * @brief Take the oldest job (any thread)
+         * @return Job, or nullptr if empty or another thread won the race
+         */
+        Job* Steal();
+
+        /**
+         * @brief Approximate number of queued jobs
+         */
+        uint32_t GetSize() const;
+
+    private:
+        alignas(64) std::atomic<int64_t> m_top{ 0 };
+        alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+        std::unique_ptr<std::atomic<Job*>[]> m_buffer;
+        int64_t m_mask = 0;
+    };
+
+    class JobSystem {
+    public:
+        JobSystem() = default;
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * @brief Start the worker threads; the calling thread becomes thread 0
+         * @param createInfo Creation parameters
+         * @return True if successful
+         */
+        bool Initialize(const JobSystemCreateInfo& createInfo = {});
+
+        /**
+         * @brief Stop and join the workers; jobs still queued are dropped
+         */
+        void Shutdown();
+
+        bool IsInitialized() const { return !m_threads.empty(); }
+
+        /**
+         * @brief Number of worker threads, excluding the main thread
+         */
+        uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+        /**
+         * @brief Number of threads that execute jobs, including the main thread
+         */
+        uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+
+        /**
+         * @brief Index of the calling thread: 0 for the main thread, 1..GetWorkerCount() for workers
+         * @return Index, or INVALID_THREAD_INDEX for threads outside the system
+         */
+        static uint32_t GetCurrentThreadIndex();
+
+        /**
+         * @brief Create a job without starting it
+         * @param function Callable taking no arguments; stored in the job, so it must be
+         *                 trivially copyable and fit in Job::PAYLOAD_SIZE (capture by reference)
+         * @param parent Job that stays unfinished until this one completes, or nullptr
+         * @return Job to pass to Run()
+         */
+        template <typename Function>
+        Job* CreateJob(Function&& function, Job* parent = nullptr);
+
+        /**
+         * @brief Queue a job on the calling thread's deque
+         * @param job Job from CreateJob
+         */
+        void Run(Job* job);
+
+        /**
+         * @brief Run pending jobs until the job and all of its children have finished
+         * @param job Job to wait for
+         */
+        void Wait(const Job* job);
+
+        /**
+         * @brief Check whether a job and all of its children have finished
+         */
+        static bool IsFinished(const Job* job) { return job->unfinished.load(std::memory_order_acquire) == 0; }
+
+        /**
+         * @brief Execute one pending job from the calling thread's deque or a stolen one
+         * Lets the main thread do useful work while it waits on something outside the
+         * job system (a fence, I/O).
+         * @return True if a job was executed
+         */
+        bool RunPendingJob();
+
+        /**
+         * @brief Call function(begin, end) over disjoint ranges covering [0, count) and wait
+         *
+         * Ranges are split lazily: a job only splits off half of its remaining range when its
+         * thread's deque has run dry, i.e. when other threads have stolen what it offered.
+         * Batches therefore stay large while every thread is busy and shrink toward
+         * minBatchSize as threads go idle.
+         * @param count Number of elements
+         * @param function Callable taking (uint32_t begin, uint32_t end)
+         * @param minBatchSize Smallest range handed to a single call
+         */
+        template <typename Function>
+        void ParallelFor(uint32_t count, Function&& function, uint32_t minBatchSize = 1);
+
+    private:
+        struct alignas(64) ThreadState {
+            explicit ThreadState(uint32_t dequeCapacity) : deque(dequeCapacity) {}
+
+            WorkStealingDeque deque;
+            std::unique_ptr<Job[]> jobs;  // Ring of MAX_JOBS_PER_THREAD slots
+            uint32_t nextJob = 0;
+            uint32_t random = 0;          // Victim selection state
+        };
+
+        using RangeFunction = void (*)(const void* context, uint32_t begin, uint32_t end);
+
+        struct RangeJobData {
+            JobSystem* system;
+            RangeFunction function;
+            const void* context;
+            uint32_t begin;
+            uint32_t end;
+            uint32_t grain;
+        };
+
+        Job* AllocateJob(Job* parent);
+        Job* FindJob(ThreadState& thread);
+        void Execute(Job* job);
+        void Finish(Job* job);
+        void WorkerLoop(uint32_t threadIndex);
+        void ParallelForImpl(uint32_t count, uint32_t minBatchSize, RangeFunction function, const void* context);
+        static void RunRange(Job& job);
+
+        std::vector<std::unique_ptr<ThreadState>> m_threads;
+        std::vector<std::thread> m_workers;
+        std::atomic<bool> m_running{ false };
+        std::atomic<uint32_t> m_wakeEpoch{ 0 };     // Bumped (and notified) when work is queued
+        std::atomic<uint32_t> m_sleepingWorkers{ 0 };
+    };
+
+    template <typename Function>
+    Job* JobSystem::CreateJob(Function&& function, Job* parent) {
+        using Stored = std::decay_t<Function>;
+        static_assert(sizeof(Stored) <= Job::PAYLOAD_SIZE, "Job function too large; capture by reference");
+        static_assert(alignof(Stored) <= 16, "Job function over-aligned");
+        static_assert(std::is_trivially_copyable_v<Stored> && std::is_trivially_destructible_v<Stored>,
+                      "Job functions must be trivially copyable; capture by reference or pointer");
+
+        Job* job = AllocateJob(parent);
+        if (!job) {
+            return nullptr;
+        }
+        new (job->payload) Stored(std::forward<Function>(function));
+        job->function = [](Job& self) { (*std::launder(reinterpret_cast<Stored*>(self.payload)))(); };
+        return job;
+    }
+
+    template <typename Function>
+    void JobSystem::ParallelFor(uint32_t count, Function&& function, uint32_t minBatchSize) {
+        using Stored = std::remove_reference_t<Function>;
+        ParallelForImpl(count, minBatchSize,
+                        [](const void* context, uint32_t begin, uint32_t end) {
+                            (*static_cast<Stored*>(const_cast<void*>(context)))(begin, end);
+                        },
+                        &function);
+    }
+
+} // namespace StellarAlia::Core::Jobs
@@ -0,0 +1,160 @@
+#include "core/math/Batch.hpp"
+
+namespace StellarAlia::Core::Math {
+
+    namespace {
+#if defined(SA_MATH_AVX2)
+        // The four columns of a matrix, each broadcast to both 128-bit halves
+        struct BroadcastColumns {
+            __m256 c0, c1, c2, c3;
+
+            explicit BroadcastColumns(const Mat4& m)
+                : c0(_mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.columns[0].x))),
+                  c1(_mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.columns[1].x))),
+                  c2(_mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.columns[2].x))),
+                  c3(_mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m.columns[3].x))) {}
+        };
+
+        inline __m256 MulAdd(__m256 a, __m256 b, __m256 c) {
+#if defined(SA_MATH_FMA)
+            return _mm256_fmadd_ps(a, b, c);
+#else
+            return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+        }
+
+        // m * v for the two vectors packed in one 256-bit register
+        inline __m256 TransformPair(const BroadcastColumns& m, __m256 v) {
+            __m256 result = _mm256_mul_ps(m.c0, _mm256_permute_ps(v, 0x00));
+            result = MulAdd(m.c1, _mm256_permute_ps(v, 0x55), result);
+            result = MulAdd(m.c2, _mm256_permute_ps(v, 0xAA), result);
+            return MulAdd(m.c3, _mm256_permute_ps(v, 0xFF), result);
+        }
+
+        // Math types are only 16-byte aligned, hence the unaligned 256-bit loads and stores
+        inline void MultiplyMatrix(const BroadcastColumns& a, const Mat4& b, Mat4& out) {
+            const __m256 b01 = _mm256_loadu_ps(&b.columns[0].x);
+            const __m256 b23 = _mm256_loadu_ps(&b.columns[2].x);
+            _mm256_storeu_ps(&out.columns[0].x, TransformPair(a, b01));
+            _mm256_storeu_ps(&out.columns[2].x, TransformPair(a, b23));
+        }
+#endif
+    }
+
+    void TransformPoints(const Mat4& m, const Vec4* points, Vec4* out, size_t count) {
+        size_t i = 0;
+#if defined(SA_MATH_AVX2)
+        const BroadcastColumns columns(m);
+        for (; i + 2 <= count; i += 2) {
+            _mm256_storeu_ps(&out[i].x, TransformPair(columns, _mm256_loadu_ps(&points[i].x)));
+        }
+#endif
+        for (; i < count; i++) {
+            out[i] = m * points[i];
+        }
+    }
+
+    void TransformMatrices(const Mat4& parent, const Mat4* matrices, Mat4* out, size_t count) {
+#if defined(SA_MATH_AVX2)
+        const BroadcastColumns columns(parent);
+        for (size_t i = 0; i < count; i++) {
+            MultiplyMatrix(columns, matrices[i], out[i]);
+        }
+#else
+        for (size_t i = 0; i < count; i++) {
+            out[i] = parent * matrices[i];
+        }
+#endif
+    }
+
+    void MultiplyMatrices(const Mat4* a, const Mat4* b, Mat4* out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+#if defined(SA_MATH_AVX2)
+            // Both halves of a are in registers before out[i] is written, so out may alias a
+            MultiplyMatrix(BroadcastColumns(a[i]), b[i], out[i]);
+#else
+            out[i] = a[i] * b[i];
+#endif
+        }
+    }
+
+    void BuildModelMatrices(const Vec4* translations, const Quat* rotations, const Vec4* scales, Mat4* out,
+                            size_t count) {
+        size_t i = 0;
+#if defined(SA_MATH_SSE)
+        // Four matrices at a time: transpose the inputs so each register holds one
+        // component of four elements, evaluate the rotation terms lane-wise, then
+        // transpose the results back into columns
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        // Translation column: xyz from the input, w forced to 1
+        const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+        const __m128 wOne = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+        for (; i + 4 <= count; i += 4) {
+            __m128 qx = _mm_load_ps(&rotations[i].x);
+            __m128 qy = _mm_load_ps(&rotations[i + 1].x);
+            __m128 qz = _mm_load_ps(&rotations[i + 2].x);
+            __m128 qw = _mm_load_ps(&rotations[i + 3].x);
+            _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+
+            __m128 sx = _mm_load_ps(&scales[i].x);
+            __m128 sy = _mm_load_ps(&scales[i + 1].x);
+            __m128 sz = _mm_load_ps(&scales[i + 2].x);
+            __m128 sw = _mm_load_ps(&scales[i + 3].x);
+            _MM_TRANSPOSE4_PS(sx, sy, sz, sw);
+
+            const __m128 x2 = _mm_mul_ps(qx, two);
+            const __m128 y2 = _mm_mul_ps(qy, two);
+            const __m128 z2 = _mm_mul_ps(qz, two);
+            const __m128 xx = _mm_mul_ps(qx, x2);
+            const __m128 yy = _mm_mul_ps(qy, y2);
+            const __m128 zz = _mm_mul_ps(qz, z2);
+            const __m128 xy = _mm_mul_ps(qx, y2);
+            const __m128 xz = _mm_mul_ps(qx, z2);
+            const __m128 yz = _mm_mul_ps(qy, z2);
+            const __m128 wx = _mm_mul_ps(qw, x2);
+            const __m128 wy = _mm_mul_ps(qw, y2);
+            const __m128 wz = _mm_mul_ps(qw, z2);
+
+            // mCR is row R of column C, one lane per matrix
+            __m128 m00 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx);
+            __m128 m01 = _mm_mul_ps(_mm_add_ps(xy, wz), sx);
+            __m128 m02 = _mm_mul_ps(_mm_sub_ps(xz, wy), sx);
+            __m128 m03 = _mm_setzero_ps();
+            __m128 m10 = _mm_mul_ps(_mm_sub_ps(xy, wz), sy);
+            __m128 m11 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy);
+            __m128 m12 = _mm_mul_ps(_mm_add_ps(yz, wx), sy);
+            __m128 m13 = _mm_setzero_ps();
+            __m128 m20 = _mm_mul_ps(_mm_add_ps(xz, wy), sz);
+            __m128 m21 = _mm_mul_ps(_mm_sub_ps(yz, wx), sz);
+            __m128 m22 = _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz);
+            __m128 m23 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(m00, m01, m02, m03);
+            _MM_TRANSPOSE4_PS(m10, m11, m12, m13);
+            _MM_TRANSPOSE4_PS(m20, m21, m22, m23);
+
+            const __m128 columns0[4] = { m00, m01, m02, m03 };
+            const __m128 columns1[4] = { m10, m11, m12, m13 };
+            const __m128 columns2[4] = { m20, m21, m22, m23 };
+            for (size_t k = 0; k < 4; k++) {
+                Mat4& m = out[i + k];
+                _mm_store_ps(&m.columns[0].x, columns0[k]);
+                _mm_store_ps(&m.columns[1].x, columns1[k]);
+                _mm_store_ps(&m.columns[2].x, columns2[k]);
+                const __m128 translation = _mm_and_ps(_mm_load_ps(&translations[i + k].x), xyzMask);
+                _mm_store_ps(&m.columns[3].x, _mm_or_ps(translation, wOne));
+            }
+        }
+#endif
+        for (; i < count; i++) {
+            out[i] = Mat4::FromTRS(translations[i], rotations[i], scales[i]);
+        }
+    }
+
+    void BuildNormalMatrices(const Mat4* models, Mat4* out, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = NormalMatrix(models[i]);
+        }
+    }
+
+} // namespace StellarAlia::Core::Math
@@ -0,0 +1,67 @@
+#pragma once
+
+/**
+ * @file Batch.hpp
+ * @brief Batched transform kernels
+ *
+ * Each kernel processes an array at a time so the loop stays in registers: points and
+ * matrix products run two columns per 256-bit operation with AVX2, and model matrices
+ * are built four at a time in transposed (SoA) form with SSE. All arrays use the
+ * aligned Math types; inputs and outputs may not overlap unless stated.
+ */
+
+#include <cstddef>
+
+#include "core/math/Matrix.hpp"
+#include "core/math/Quaternion.hpp"
+#include "core/math/Vector.hpp"
+
+namespace StellarAlia::Core::Math {
+
+    /**
+     * @brief out[i] = m * points[i]
+     * @param m Transform
+     * @param points Input vectors (w is used as-is: 1 for points, 0 for directions)
+     * @param out Output vectors; may alias points
+     * @param count Number of vectors
+     */
+    void TransformPoints(const Mat4& m, const Vec4* points, Vec4* out, size_t count);
+
+    /**
+     * @brief out[i] = parent * matrices[i]
+     * @param parent Matrix applied after each input
+     * @param matrices Input matrices
+     * @param out Output matrices; may alias matrices
+     * @param count Number of matrices
+     */
+    void TransformMatrices(const Mat4& parent, const Mat4* matrices, Mat4* out, size_t count);
+
+    /**
+     * @brief out[i] = a[i] * b[i]
+     * @param a Left operands
+     * @param b Right operands
+     * @param out Output matrices; may alias a or b
+     * @param count Number of products
+     */
+    void MultiplyMatrices(const Mat4* a, const Mat4* b, Mat4* out, size_t count);
+
+    /**
+     * @brief out[i] = Translation(translations[i]) * Rotation(rotations[i]) * Scale(scales[i])
+     * @param translations Translations (xyz)
+     * @param rotations Unit quaternions
+     * @param scales Per-axis scales (xyz)
+     * @param out Model matrices
+     * @param count Number of matrices
+     */
+    void BuildModelMatrices(const Vec4* translations, const Quat* rotations, const Vec4* scales, Mat4* out,
+                            size_t count);
+
+    /**
+     * @brief out[i] = NormalMatrix(models[i])
+     * @param models Model matrices
+     * @param out Normal matrices (columns 0-2); may alias models
+     * @param count Number of matrices
+     */
+    void BuildNormalMatrices(const Mat4* models, Mat4* out, size_t count);
+
+} // namespace StellarAlia::Core::Math
@@ -0,0 +1,12 @@
+#pragma once
+
+/**
+ * @file Math.hpp
+ * @brief Math library umbrella header: aligned Vec4 / Quat / Mat4 and batched kernels
+ */
+
+#include "core/math/Simd.hpp"
+#include "core/math/Vector.hpp"
+#include "core/math/Quaternion.hpp"
+#include "core/math/Matrix.hpp"
+#include "core/math/Batch.hpp"
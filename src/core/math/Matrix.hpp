@@ -0,0 +1,205 @@
+#pragma once
+
+/**
+ * @file Matrix.hpp
+ * @brief 16-byte aligned column-major 4x4 matrix
+ *
+ * Conventions match the shaders: column-major storage, column vectors (M * v), and a
+ * product A * B that applies B first.
+ */
+
+#include "core/math/Quaternion.hpp"
+#include "core/math/Vector.hpp"
+
+namespace StellarAlia::Core::Math {
+
+    /**
+     * @brief Column-major 4x4 matrix; defaults to identity
+     */
+    struct alignas(16) Mat4 {
+        Vec4 columns[4] = { { 1.0f, 0.0f, 0.0f, 0.0f },
+                            { 0.0f, 1.0f, 0.0f, 0.0f },
+                            { 0.0f, 0.0f, 1.0f, 0.0f },
+                            { 0.0f, 0.0f, 0.0f, 1.0f } };
+
+        Vec4& operator[](int column) { return columns[column]; }
+        const Vec4& operator[](int column) const { return columns[column]; }
+
+        /**
+         * @brief Get the 16 floats in column-major order
+         */
+        const float* Data() const { return &columns[0].x; }
+
+        static Mat4 Identity() { return {}; }
+
+        static Mat4 Translation(const Vec4& t) {
+            Mat4 m;
+            m.columns[3] = { t.x, t.y, t.z, 1.0f };
+            return m;
+        }
+
+        static Mat4 Scale(const Vec4& s) {
+            Mat4 m;
+            m.columns[0].x = s.x;
+            m.columns[1].y = s.y;
+            m.columns[2].z = s.z;
+            return m;
+        }
+
+        /**
+         * @brief Rotation matrix of a unit quaternion
+         */
+        static Mat4 Rotation(const Quat& q) {
+            const float x = q.x, y = q.y, z = q.z, w = q.w;
+            Mat4 m;
+            m.columns[0] = { 1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + z * w), 2.0f * (x * z - y * w), 0.0f };
+            m.columns[1] = { 2.0f * (x * y - z * w), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + x * w), 0.0f };
+            m.columns[2] = { 2.0f * (x * z + y * w), 2.0f * (y * z - x * w), 1.0f - 2.0f * (x * x + y * y), 0.0f };
+            return m;
+        }
+
+        /**
+         * @brief Translation * Rotation * Scale
+         * @param translation Translation (xyz)
+         * @param rotation Unit quaternion
+         * @param scale Per-axis scale (xyz)
+         */
+        static Mat4 FromTRS(const Vec4& translation, const Quat& rotation, const Vec4& scale) {
+            Mat4 m = Rotation(rotation);
+            m.columns[0] *= scale.x;
+            m.columns[1] *= scale.y;
+            m.columns[2] *= scale.z;
+            m.columns[3] = { translation.x, translation.y, translation.z, 1.0f };
+            return m;
+        }
+
+        /**
+         * @brief Load from 16 unaligned column-major floats
+         */
+        static Mat4 Load(const float* values) {
+            Mat4 m;
+            for (int c = 0; c < 4; c++) {
+                m.columns[c] = Vec4::Load4(values + c * 4);
+            }
+            return m;
+        }
+
+        /**
+         * @brief Store 16 column-major floats (unaligned destination)
+         */
+        void Store(float* values) const {
+            for (int c = 0; c < 4; c++) {
+                values[c * 4 + 0] = columns[c].x;
+                values[c * 4 + 1] = columns[c].y;
+                values[c * 4 + 2] = columns[c].z;
+                values[c * 4 + 3] = columns[c].w;
+            }
+        }
+    };
+    static_assert(sizeof(Mat4) == 64, "Mat4 must be sixteen packed floats");
+
+    inline Vec4 operator*(const Mat4& m, const Vec4& v) {
+#if defined(SA_MATH_SSE)
+        const __m128 vec = Simd::Load(v);
+        __m128 result = _mm_mul_ps(Simd::Load(m.columns[0]), Simd::Splat<0>(vec));
+        result = Simd::MulAdd(Simd::Load(m.columns[1]), Simd::Splat<1>(vec), result);
+        result = Simd::MulAdd(Simd::Load(m.columns[2]), Simd::Splat<2>(vec), result);
+        result = Simd::MulAdd(Simd::Load(m.columns[3]), Simd::Splat<3>(vec), result);
+        return Simd::Store(result);
+#else
+        return m.columns[0] * v.x + m.columns[1] * v.y + m.columns[2] * v.z + m.columns[3] * v.w;
+#endif
+    }
+
+    inline Mat4 operator*(const Mat4& a, const Mat4& b) {
+        Mat4 result;
+        for (int c = 0; c < 4; c++) {
+            result.columns[c] = a * b.columns[c];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Transform a point (w treated as 1)
+     */
+    inline Vec4 TransformPoint(const Mat4& m, const Vec4& p) {
+        return m * Vec4{ p.x, p.y, p.z, 1.0f };
+    }
+
+    /**
+     * @brief Transform a direction (w treated as 0)
+     */
+    inline Vec4 TransformVector(const Mat4& m, const Vec4& v) {
+        return m * Vec4{ v.x, v.y, v.z, 0.0f };
+    }
+
+    inline Mat4 Transpose(const Mat4& m) {
+#if defined(SA_MATH_SSE)
+        __m128 c0 = Simd::Load(m.columns[0]);
+        __m128 c1 = Simd::Load(m.columns[1]);
+        __m128 c2 = Simd::Load(m.columns[2]);
+        __m128 c3 = Simd::Load(m.columns[3]);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        Mat4 result;
+        _mm_store_ps(&result.columns[0].x, c0);
+        _mm_store_ps(&result.columns[1].x, c1);
+        _mm_store_ps(&result.columns[2].x, c2);
+        _mm_store_ps(&result.columns[3].x, c3);
+        return result;
+#else
+        Mat4 result;
+        for (int c = 0; c < 4; c++) {
+            for (int r = 0; r < 4; r++) {
+                result.columns[c][r] = m.columns[r][c];
+            }
+        }
+        return result;
+#endif
+    }
+
+    /**
+     * @brief Inverse transpose of the upper 3x3, for transforming normals
+     * Columns 0-2 hold the result with w = 0, column 3 is (0, 0, 0, 1). A singular
+     * matrix yields its (unscaled) cofactor matrix.
+     */
+    inline Mat4 NormalMatrix(const Mat4& m) {
+#if defined(SA_MATH_SSE)
+        const __m128 c0 = Simd::Load(m.columns[0]);
+        const __m128 c1 = Simd::Load(m.columns[1]);
+        const __m128 c2 = Simd::Load(m.columns[2]);
+        const __m128 r0 = Simd::Cross3(c1, c2);
+        const __m128 r1 = Simd::Cross3(c2, c0);
+        const __m128 r2 = Simd::Cross3(c0, c1);
+        const float det = _mm_cvtss_f32(Simd::Dot3(c0, r0));
+        const __m128 invDet = _mm_set1_ps(std::abs(det) > 1e-12f ? 1.0f / det : 1.0f);
+        Mat4 result;
+        _mm_store_ps(&result.columns[0].x, _mm_mul_ps(r0, invDet));
+        _mm_store_ps(&result.columns[1].x, _mm_mul_ps(r1, invDet));
+        _mm_store_ps(&result.columns[2].x, _mm_mul_ps(r2, invDet));
+        return result;
+#else
+        const Vec4 r0 = Cross3(m.columns[1], m.columns[2]);
+        const Vec4 r1 = Cross3(m.columns[2], m.columns[0]);
+        const Vec4 r2 = Cross3(m.columns[0], m.columns[1]);
+        const float det = Dot3(m.columns[0], r0);
+        const float invDet = std::abs(det) > 1e-12f ? 1.0f / det : 1.0f;
+        Mat4 result;
+        result.columns[0] = r0 * invDet;
+        result.columns[1] = r1 * invDet;
+        result.columns[2] = r2 * invDet;
+        return result;
+#endif
+    }
+
+    /**
+     * @brief Inverse of an affine matrix (bottom row 0, 0, 0, 1)
+     */
+    inline Mat4 InverseAffine(const Mat4& m) {
+        // Rows of the inverse 3x3 are the columns of the normal matrix
+        Mat4 result = Transpose(NormalMatrix(m));
+        const Vec4 t = result * Vec4{ m.columns[3].x, m.columns[3].y, m.columns[3].z, 0.0f };
+        result.columns[3] = { -t.x, -t.y, -t.z, 1.0f };
+        return result;
+    }
+
+} // namespace StellarAlia::Core::Math
@@ -0,0 +1,89 @@
+#pragma once
+
+/**
+ * @file Quaternion.hpp
+ * @brief 16-byte aligned rotation quaternion
+ */
+
+#include <cmath>
+
+#include "core/math/Vector.hpp"
+
+namespace StellarAlia::Core::Math {
+
+    /**
+     * @brief Rotation quaternion (x, y, z, w), w being the scalar part
+     */
+    struct alignas(16) Quat {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float w = 1.0f;
+
+        constexpr Quat() = default;
+        constexpr Quat(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+        /**
+         * @brief Rotation about an axis
+         * @param axis Unit axis (xyz)
+         * @param radians Angle, counter-clockwise looking down the axis
+         * @return Quaternion
+         */
+        static Quat FromAxisAngle(const Vec4& axis, float radians) {
+            const float s = std::sin(radians * 0.5f);
+            return { axis.x * s, axis.y * s, axis.z * s, std::cos(radians * 0.5f) };
+        }
+
+        /**
+         * @brief Load from four unaligned floats (x, y, z, w)
+         */
+        static Quat Load(const float* values) { return { values[0], values[1], values[2], values[3] }; }
+    };
+    static_assert(sizeof(Quat) == 16, "Quat must be four packed floats");
+
+    /**
+     * @brief Hamilton product: rotating by the result applies b, then a
+     */
+    inline Quat operator*(const Quat& a, const Quat& b) {
+        return { a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                 a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                 a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                 a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z };
+    }
+
+    inline Quat Conjugate(const Quat& q) {
+        return { -q.x, -q.y, -q.z, q.w };
+    }
+
+    inline Quat Normalize(const Quat& q) {
+        const float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        if (length <= 0.0f) {
+            return {};
+        }
+        const float inv = 1.0f / length;
+        return { q.x * inv, q.y * inv, q.z * inv, q.w * inv };
+    }
+
+    /**
+     * @brief Rotate the xyz of a vector; w is kept
+     */
+    inline Vec4 Rotate(const Quat& q, const Vec4& v) {
+        // v' = v + 2w (q x v) + 2 q x (q x v)
+        const Vec4 axis{ q.x, q.y, q.z, 0.0f };
+        const Vec4 t = Cross3(axis, v) * 2.0f;
+        Vec4 result = v + t * q.w + Cross3(axis, t);
+        result.w = v.w;
+        return result;
+    }
+
+    /**
+     * @brief Normalized linear interpolation along the shorter arc
+     */
+    inline Quat Nlerp(const Quat& a, const Quat& b, float t) {
+        const float sign = (a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w) < 0.0f ? -1.0f : 1.0f;
+        const float s = 1.0f - t;
+        const float u = t * sign;
+        return Normalize({ a.x * s + b.x * u, a.y * s + b.y * u, a.z * s + b.z * u, a.w * s + b.w * u });
+    }
+
+} // namespace StellarAlia::Core::Math
@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+ * @file Simd.hpp
+ * @brief Instruction set selection for the math library
+ *
+ * SA_MATH_SSE is defined on x86 targets with SSE2 (always true on x86-64), and
+ * SA_MATH_AVX2 additionally when the compiler targets AVX2 (STELLARALIA_ENABLE_AVX2).
+ * SA_MATH_FMA follows the compiler's FMA setting. Without SA_MATH_SSE every
+ * operation uses its scalar fallback.
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SA_MATH_SSE 1
+#endif
+
+#if defined(SA_MATH_SSE) && defined(__AVX2__)
+#define SA_MATH_AVX2 1
+#endif
+
+#if defined(SA_MATH_SSE) && (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#define SA_MATH_FMA 1
+#endif
+
+#if defined(SA_MATH_SSE)
+#include <immintrin.h>
+
+namespace StellarAlia::Core::Math::Simd {
+
+    /**
+     * @brief a * b + c, fused when the target has FMA
+     */
+    inline __m128 MulAdd(__m128 a, __m128 b, __m128 c) {
+#if defined(SA_MATH_FMA)
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+    }
+
+    /**
+     * @brief Broadcast one lane to all four
+     */
+    template <int Lane>
+    inline __m128 Splat(__m128 v) {
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+    }
+
+    /**
+     * @brief Cross product of the xyz lanes; w is 0
+     */
+    inline __m128 Cross3(__m128 a, __m128 b) {
+        const __m128 aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYzx), _mm_mul_ps(aYzx, b));
+        return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    /**
+     * @brief Dot product of the xyz lanes, broadcast to all four
+     */
+    inline __m128 Dot3(__m128 a, __m128 b) {
+        const __m128 m = _mm_mul_ps(a, b);
+        return _mm_add_ps(_mm_add_ps(Splat<0>(m), Splat<1>(m)), Splat<2>(m));
+    }
+
+    /**
+     * @brief Dot product of all four lanes, broadcast to all four
+     */
+    inline __m128 Dot4(__m128 a, __m128 b) {
+        __m128 m = _mm_mul_ps(a, b);
+        m = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+} // namespace StellarAlia::Core::Math::Simd
+#endif
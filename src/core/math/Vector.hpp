@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * @file Vector.hpp
+ * @brief 16-byte aligned four-component vector
+ */
+
+#include <cmath>
+
+#include "core/math/Simd.hpp"
+
+namespace StellarAlia::Core::Math {
+
+    /**
+     * @brief Four floats, aligned for one SSE register
+     *
+     * Used for points (w = 1), directions (w = 0) and plain 4-vectors; the 3D helpers
+     * ignore w.
+     */
+    struct alignas(16) Vec4 {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float w = 0.0f;
+
+        constexpr Vec4() = default;
+        constexpr Vec4(float x, float y, float z, float w = 0.0f) : x(x), y(y), z(z), w(w) {}
+        constexpr explicit Vec4(float s) : x(s), y(s), z(s), w(s) {}
+
+        float& operator[](int i) { return (&x)[i]; }
+        float operator[](int i) const { return (&x)[i]; }
+
+        /**
+         * @brief Load xyz from three unaligned floats
+         */
+        static Vec4 Load3(const float* values, float w = 0.0f) { return { values[0], values[1], values[2], w }; }
+
+        /**
+         * @brief Load from four unaligned floats
+         */
+        static Vec4 Load4(const float* values) { return { values[0], values[1], values[2], values[3] }; }
+    };
+    static_assert(sizeof(Vec4) == 16, "Vec4 must be four packed floats");
+
+#if defined(SA_MATH_SSE)
+    namespace Simd {
+        inline __m128 Load(const Vec4& v) { return _mm_load_ps(&v.x); }
+
+        inline Vec4 Store(__m128 v) {
+            Vec4 result;
+            _mm_store_ps(&result.x, v);
+            return result;
+        }
+    }
+#endif
+
+    inline Vec4 operator+(const Vec4& a, const Vec4& b) {
+#if defined(SA_MATH_SSE)
+        return Simd::Store(_mm_add_ps(Simd::Load(a), Simd::Load(b)));
+#else
+        return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w };
+#endif
+    }
+
+    inline Vec4 operator-(const Vec4& a, const Vec4& b) {
+#if defined(SA_MATH_SSE)
+        return Simd::Store(_mm_sub_ps(Simd::Load(a), Simd::Load(b)));
+#else
+        return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w };
+#endif
+    }
+
+    inline Vec4 operator*(const Vec4& a, const Vec4& b) {
+#if defined(SA_MATH_SSE)
+        return Simd::Store(_mm_mul_ps(Simd::Load(a), Simd::Load(b)));
+#else
+        return { a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w };
+#endif
+    }
+
+    inline Vec4 operator*(const Vec4& a, float s) {
+#if defined(SA_MATH_SSE)
+        return Simd::Store(_mm_mul_ps(Simd::Load(a), _mm_set1_ps(s)));
+#else
+        return { a.x * s, a.y * s, a.z * s, a.w * s };
+#endif
+    }
+
+    inline Vec4 operator*(float s, const Vec4& a) { return a * s; }
+    inline Vec4 operator-(const Vec4& a) { return a * -1.0f; }
+    inline Vec4& operator+=(Vec4& a, const Vec4& b) { return a = a + b; }
+    inline Vec4& operator-=(Vec4& a, const Vec4& b) { return a = a - b; }
+    inline Vec4& operator*=(Vec4& a, float s) { return a = a * s; }
+
+    inline Vec4 Min(const Vec4& a, const Vec4& b) {
+#if defined(SA_MATH_SSE)
+        return Simd::Store(_mm_min_ps(Simd::Load(a), Simd::Load(b)));
+#else
+        return { std::fmin(a.x, b.x), std::fmin(a.y, b.y), std::fmin(a.z, b.z), std::fmin(a.w, b.w) };
+#endif
+    }
+
+    inline Vec4 Max(const Vec4& a, const Vec4& b) {
+#if defined(SA_MATH_SSE)
+        return Simd::Store(_mm_max_ps(Simd::Load(a), Simd::Load(b)));
+#else
+        return { std::fmax(a.x, b.x), std::fmax(a.y, b.y), std::fmax(a.z, b.z), std::fmax(a.w, b.w) };
+#endif
+    }
+
+    inline float Dot3(const Vec4& a, const Vec4& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    inline float Dot4(const Vec4& a, const Vec4& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    }
+
+    /**
+     * @brief Cross product of xyz; w of the result is 0
+     */
+    inline Vec4 Cross3(const Vec4& a, const Vec4& b) {
+#if defined(SA_MATH_SSE)
+        return Simd::Store(Simd::Cross3(Simd::Load(a), Simd::Load(b)));
+#else
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x, 0.0f };
+#endif
+    }
+
+    inline float Length3(const Vec4& v) {
+        return std::sqrt(Dot3(v, v));
+    }
+
+    /**
+     * @brief Normalize xyz, keeping w; zero vectors are returned unchanged
+     */
+    inline Vec4 Normalize3(const Vec4& v) {
+        const float length = Length3(v);
+        if (length <= 0.0f) {
+            return v;
+        }
+        const float inv = 1.0f / length;
+        return { v.x * inv, v.y * inv, v.z * inv, v.w };
+    }
+
+    inline Vec4 Lerp(const Vec4& a, const Vec4& b, float t) {
+        return a + (b - a) * t;
+    }
+
+} // namespace StellarAlia::Core::Math
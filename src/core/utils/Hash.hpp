@@ -0,0 +1,70 @@
+#pragma once
+
+/**
+ * @file Hash.hpp
+ * @brief Small, stable hashing helpers for cache keys
+ *
+ * Hashes are used for in-memory deduplication and on-disk cache validation, so they
+ * must not depend on std::hash (which is implementation-defined).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace StellarAlia::Core::Hash {
+
+    constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+    constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+    /**
+     * @brief FNV-1a over a byte range
+     * @param data Bytes to hash
+     * @param size Byte count
+     * @param seed Running hash to continue from
+     * @return 64-bit hash
+     */
+    inline uint64_t Fnv1a(const void* data, size_t size, uint64_t seed = FNV_OFFSET_BASIS) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        uint64_t hash = seed;
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Mix a value into a running hash
+     * Hashes the object representation, so use it for scalars and enums rather than
+     * structs with padding.
+     * @param seed Running hash (updated in place)
+     * @param value Trivially copyable value
+     */
+    template <typename T>
+    inline void Combine(uint64_t& seed, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Combine hashes the object representation");
+        seed = Fnv1a(&value, sizeof(T), seed);
+    }
+
+    /**
+     * @brief Mix a string into a running hash (length-prefixed so "ab"+"c" != "a"+"bc")
+     * @param seed Running hash (updated in place)
+     * @param value String
+     */
+    inline void Combine(uint64_t& seed, std::string_view value) {
+        Combine(seed, value.size());
+        seed = Fnv1a(value.data(), value.size(), seed);
+    }
+
+    inline void Combine(uint64_t& seed, const std::string& value) {
+        Combine(seed, std::string_view(value));
+    }
+
+    inline void Combine(uint64_t& seed, const char* value) {
+        Combine(seed, std::string_view(value));
+    }
+
+} // namespace StellarAlia::Core::Hash
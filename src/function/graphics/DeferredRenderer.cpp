@@ -0,0 +1,517 @@
+#include "function/graphics/DeferredRenderer.hpp"
+#include "function/graphics/GpuDrivenRenderer.hpp"
+#include "function/graphics/PipelineManager.hpp"
+#include "function/graphics/vulkan/VulkanGraphicsContext.hpp"
+#include "core/logs/Log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace StellarAlia::Function::Graphics {
+
+    namespace {
+        constexpr VkFormat GBUFFER_POSITION_FORMAT = VK_FORMAT_R16G16B16A16_SFLOAT;
+        constexpr VkFormat GBUFFER_NORMAL_FORMAT = VK_FORMAT_R16G16B16A16_SFLOAT;
+        constexpr VkFormat GBUFFER_ALBEDO_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+        constexpr VkFormat GBUFFER_METALLIC_ROUGHNESS_FORMAT = VK_FORMAT_R8G8_UNORM;
+
+        constexpr VkFormat COMPACT_NORMAL_FORMAT = VK_FORMAT_R16G16_SNORM;  // Octahedral
+        constexpr VkFormat COMPACT_ALBEDO_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+        constexpr VkFormat COMPACT_MATERIAL_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+
+        // Cluster grid: 16x9 screen tiles by 24 exponential depth slices
+        constexpr uint32_t CLUSTER_COUNT_X = 16;
+        constexpr uint32_t CLUSTER_COUNT_Y = 9;
+        constexpr uint32_t CLUSTER_COUNT_Z = 24;
+        constexpr uint32_t CLUSTER_COUNT = CLUSTER_COUNT_X * CLUSTER_COUNT_Y * CLUSTER_COUNT_Z;
+        constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 128;
+        constexpr uint32_t CLUSTER_GROUP_SIZE = 64;  // local_size_x of light_clustering.comp
+        constexpr const char* CLUSTER_SHADER = "light_clustering.comp.spv";
+
+        // Bindings shared by the clustering and lighting sets (see clustered_lighting.glsl)
+        constexpr uint32_t LIGHTING_UNIFORM_BINDING = 4;
+        constexpr uint32_t LIGHT_BUFFER_BINDING = 5;
+        constexpr uint32_t CLUSTER_COUNTS_BINDING = 6;
+        constexpr uint32_t CLUSTER_INDICES_BINDING = 7;
+
+        VkWriteDescriptorSet MakeBufferWrite(VkDescriptorSet set, uint32_t binding, VkDescriptorType type,
+                                             const VkDescriptorBufferInfo* info) {
+            VkWriteDescriptorSet write{};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = set;
+            write.dstBinding = binding;
+            write.descriptorCount = 1;
+            write.descriptorType = type;
+            write.pBufferInfo = info;
+            return write;
+        }
+
+        uint32_t GetFormatSize(VkFormat format) {
+            switch (format) {
+                case VK_FORMAT_R8G8_UNORM:
+                case VK_FORMAT_D16_UNORM:
+                    return 2;
+                case VK_FORMAT_R8G8B8A8_UNORM:
+                case VK_FORMAT_R16G16_SNORM:
+                case VK_FORMAT_D32_SFLOAT:
+                case VK_FORMAT_D24_UNORM_S8_UINT:
+                case VK_FORMAT_X8_D24_UNORM_PACK32:
+                    return 4;
+                case VK_FORMAT_D32_SFLOAT_S8_UINT:
+                    return 5;
+                case VK_FORMAT_R16G16B16A16_SFLOAT:
+                    return 8;
+                default:
+                    return 0;
+            }
+        }
+
+        // Fragment shader per layout and lighting mode
+        const char* GetLightingShader(GBufferLayout layout, bool subpassLighting) {
+            if (layout == GBufferLayout::Compact) {
+                return subpassLighting ? "deferred_lighting_compact_subpass.frag.spv"
+                                       : "deferred_lighting_compact.frag.spv";
+            }
+            return subpassLighting ? "deferred_lighting_subpass.frag.spv" : "deferred_lighting.frag.spv";
+        }
+
+        // Lighting permutation per target: float targets keep linear HDR values, sRGB targets
+        // gamma-encode on write, and UNORM targets need both steps in the shader
+        ShaderFeatures GetOutputFeatures(VkFormat format) {
+            switch (format) {
+                case VK_FORMAT_R16G16B16A16_SFLOAT:
+                case VK_FORMAT_R32G32B32A32_SFLOAT:
+                case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+                    return 0;
+                case VK_FORMAT_R8G8B8A8_SRGB:
+                case VK_FORMAT_B8G8R8A8_SRGB:
+                case VK_FORMAT_A8B8G8R8_SRGB_PACK32:
+                    return SHADER_FEATURE_TONEMAP;
+                default:
+                    return SHADER_FEATURE_TONEMAP | SHADER_FEATURE_GAMMA_CORRECTION;
+            }
+        }
+    }
+
+    const char* GBufferLayoutToString(GBufferLayout layout) {
+        switch (layout) {
+            case GBufferLayout::Standard: return "standard";
+            case GBufferLayout::Compact:  return "compact";
+        }
+        return "unknown";
+    }
+
+    DeferredRenderer::~DeferredRenderer() {
+        Shutdown();
+    }
+
+    bool DeferredRenderer::Initialize(VulkanGraphicsContext& context, PipelineManager& pipelines,
+                                      const DeferredRendererCreateInfo& createInfo) {
+        if (m_device != VK_NULL_HANDLE) {
+            SA_LOG_WARN("DeferredRenderer already initialized");
+            return false;
+        }
+
+        m_context = &context;
+        m_pipelines = &pipelines;
+        m_device = context.GetDevice();
+        m_layout = createInfo.layout;
+        m_subpassLighting = createInfo.subpassLighting;
+        m_maxLights = std::max(createInfo.maxLights, 1u);
+        SA_LOG_INFO("Deferred lighting: {} G-buffer ({} bytes/pixel), {}", GBufferLayoutToString(m_layout),
+                    GetGBufferBytesPerPixel(),
+                    m_subpassLighting ? "subpass inputs (single render pass)" : "sampled");
+        SA_LOG_INFO("Clustered lighting: {}x{}x{} clusters, up to {} lights ({} per cluster)", CLUSTER_COUNT_X,
+                    CLUSTER_COUNT_Y, CLUSTER_COUNT_Z, m_maxLights, MAX_LIGHTS_PER_CLUSTER);
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = 0.0f;
+        VkResult result = vkCreateSampler(m_device, &samplerInfo, nullptr, &m_sampler);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create G-buffer sampler: VkResult = {}", static_cast<int>(result));
+            Shutdown();
+            return false;
+        }
+
+        // Set 0: four G-buffer inputs (position or depth, normal, albedo, material), LightingUniforms,
+        // lights, per-cluster light counts and light indices
+        const VkDescriptorType gbufferType =
+            m_subpassLighting ? VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        std::array<VkDescriptorSetLayoutBinding, 8> bindings{};
+        for (uint32_t i = 0; i < 4; i++) {
+            bindings[i] = { i, gbufferType, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr };
+        }
+        bindings[4] = { LIGHTING_UNIFORM_BINDING, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT,
+                        nullptr };
+        for (uint32_t binding : { LIGHT_BUFFER_BINDING, CLUSTER_COUNTS_BINDING, CLUSTER_INDICES_BINDING }) {
+            bindings[binding] = { binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr };
+        }
+        m_lightingSetLayout = context.GetDescriptorLayoutCache().GetLayout(bindings);
+        m_lightingLayout = m_lightingSetLayout != VK_NULL_HANDLE ? pipelines.GetPipelineLayout({ m_lightingSetLayout })
+                                                                  : VK_NULL_HANDLE;
+        if (m_lightingLayout == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("Failed to create the deferred lighting layout");
+            Shutdown();
+            return false;
+        }
+
+        // Clustering set: the same uniform and buffer bindings, visible to compute
+        const std::array<VkDescriptorSetLayoutBinding, 4> clusterBindings = {{
+            { LIGHTING_UNIFORM_BINDING, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { LIGHT_BUFFER_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { CLUSTER_COUNTS_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { CLUSTER_INDICES_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        }};
+        m_clusterSetLayout = context.GetDescriptorLayoutCache().GetLayout(clusterBindings);
+        m_clusterLayout = m_clusterSetLayout != VK_NULL_HANDLE ? pipelines.GetPipelineLayout({ m_clusterSetLayout })
+                                                                : VK_NULL_HANDLE;
+        if (m_clusterLayout != VK_NULL_HANDLE) {
+            ComputePipelineDesc clusterDesc;
+            clusterDesc.stage = { VK_SHADER_STAGE_COMPUTE_BIT, CLUSTER_SHADER };
+            clusterDesc.layout = m_clusterLayout;
+            m_clusterPipeline = pipelines.GetComputePipeline(clusterDesc);
+            m_pipelineGeneration = pipelines.GetGeneration();
+        }
+        if (m_clusterPipeline == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("Failed to create the light clustering pipeline");
+            Shutdown();
+            return false;
+        }
+
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = sizeof(LightingUniforms);
+        bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        // One buffer per frame in flight so the CPU never writes uniforms the GPU is reading
+        m_frameUniforms.resize(context.GetFramesInFlight());
+        for (FrameUniforms& frame : m_frameUniforms) {
+            if (!context.GetMemoryManager().CreateBuffer(MemoryCategory::Staging, bufferInfo, allocInfo, frame.buffer,
+                                                         frame.allocation)) {
+                SA_LOG_ERROR("Failed to create lighting uniform buffer");
+                Shutdown();
+                return false;
+            }
+            VmaAllocationInfo allocationInfo{};
+            vmaGetAllocationInfo(context.GetAllocator(), frame.allocation, &allocationInfo);
+            frame.mapped = allocationInfo.pMappedData;
+        }
+
+        // Lights are rewritten every frame, so they share the per-frame ring
+        VkBufferCreateInfo lightBufferInfo = bufferInfo;
+        lightBufferInfo.size = static_cast<VkDeviceSize>(m_maxLights) * sizeof(PointLight);
+        lightBufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        for (FrameUniforms& frame : m_frameUniforms) {
+            if (!context.GetMemoryManager().CreateBuffer(MemoryCategory::Staging, lightBufferInfo, allocInfo,
+                                                         frame.lightBuffer, frame.lightAllocation)) {
+                SA_LOG_ERROR("Failed to create light buffer");
+                Shutdown();
+                return false;
+            }
+            VmaAllocationInfo allocationInfo{};
+            vmaGetAllocationInfo(context.GetAllocator(), frame.lightAllocation, &allocationInfo);
+            frame.lightsMapped = allocationInfo.pMappedData;
+        }
+
+        return true;
+    }
+
+    void DeferredRenderer::Shutdown() {
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        for (FrameUniforms& frame : m_frameUniforms) {
+            if (frame.buffer != VK_NULL_HANDLE) {
+                m_context->GetMemoryManager().DestroyBuffer(frame.buffer, frame.allocation);
+            }
+            if (frame.lightBuffer != VK_NULL_HANDLE) {
+                m_context->GetMemoryManager().DestroyBuffer(frame.lightBuffer, frame.lightAllocation);
+            }
+        }
+        m_frameUniforms.clear();
+
+        if (m_sampler != VK_NULL_HANDLE) {
+            vkDestroySampler(m_device, m_sampler, nullptr);
+            m_sampler = VK_NULL_HANDLE;
+        }
+
+        m_layout = GBufferLayout::Standard;
+        m_subpassLighting = false;
+        m_maxLights = 0;
+        m_lightOverflowReported = false;
+        m_clusterSetLayout = VK_NULL_HANDLE;
+        m_clusterLayout = VK_NULL_HANDLE;
+        m_clusterPipeline = VK_NULL_HANDLE;
+        m_lightingSetLayout = VK_NULL_HANDLE;
+        m_lightingLayout = VK_NULL_HANDLE;
+        m_lightingRenderPass = VK_NULL_HANDLE;
+        m_lightingPipeline = VK_NULL_HANDLE;
+        m_pipelineGeneration = 0;
+        m_pipelines = nullptr;
+        m_context = nullptr;
+        m_device = VK_NULL_HANDLE;
+    }
+
+    GBufferResources DeferredRenderer::AddPasses(RenderGraph& graph, RenderGraphResource target) {
+        GBufferResources gbuffer;
+        ClusterResources clusters;
+
+        // Shader hot reload dropped our pipelines; fetch their replacements
+        if (m_pipelines->GetGeneration() != m_pipelineGeneration) {
+            m_pipelineGeneration = m_pipelines->GetGeneration();
+            ComputePipelineDesc clusterDesc;
+            clusterDesc.stage = { VK_SHADER_STAGE_COMPUTE_BIT, CLUSTER_SHADER };
+            clusterDesc.layout = m_clusterLayout;
+            m_clusterPipeline = m_pipelines->GetComputePipeline(clusterDesc);
+            m_lightingRenderPass = VK_NULL_HANDLE;
+        }
+
+        const FrameUniforms& frame = m_frameUniforms[m_context->GetCurrentFrameIndex()];
+        RenderGraphImportedBuffer lightBuffer;
+        lightBuffer.buffer = frame.lightBuffer;
+        lightBuffer.size = static_cast<VkDeviceSize>(m_maxLights) * sizeof(PointLight);
+        lightBuffer.initialStage = VK_PIPELINE_STAGE_HOST_BIT;
+        lightBuffer.initialAccess = VK_ACCESS_HOST_WRITE_BIT;
+        clusters.lights = graph.ImportBuffer("Lights", lightBuffer);
+
+        // The G-buffer targets use the backbuffer extent, and so does the cluster grid
+        const VkExtent2D extent = m_context->GetCurrentBackbuffer().extent;
+        graph.AddPass(
+            "LightClustering",
+            [&](RenderGraphBuilder& builder) {
+                clusters.lightCounts = builder.CreateBuffer("ClusterLightCounts", { CLUSTER_COUNT * sizeof(uint32_t) });
+                clusters.lightIndices = builder.CreateBuffer(
+                    "ClusterLightIndices", { CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER * sizeof(uint32_t) });
+                builder.Read(clusters.lights, RenderGraphAccess::StorageReadCompute);
+                builder.Write(clusters.lightCounts, RenderGraphAccess::StorageWriteCompute);
+                builder.Write(clusters.lightIndices, RenderGraphAccess::StorageWriteCompute);
+                m_clusters = clusters;
+            },
+            [this, extent](RenderGraphPassContext& pass) {
+                UploadFrameData(extent);
+                RecordClustering(pass, m_clusters);
+            });
+
+        GpuDrawResources draws;
+        if (m_gpuDriven) {
+            draws = m_gpuDriven->AddCullingPasses(graph);
+        }
+
+        graph.AddPass(
+            "GBuffer",
+            [&](RenderGraphBuilder& builder) {
+                // Color attachment order matches the output locations of the geometry shader
+                std::vector<RenderGraphResource> colors;
+                if (m_layout == GBufferLayout::Compact) {
+                    gbuffer.normal = builder.CreateTexture("GBufferNormal", { 0, 0, COMPACT_NORMAL_FORMAT });
+                    gbuffer.albedo = builder.CreateTexture("GBufferAlbedo", { 0, 0, COMPACT_ALBEDO_FORMAT });
+                    gbuffer.material = builder.CreateTexture("GBufferMaterial", { 0, 0, COMPACT_MATERIAL_FORMAT });
+                    colors = { gbuffer.normal, gbuffer.albedo, gbuffer.material };
+                } else {
+                    gbuffer.position = builder.CreateTexture("GBufferPosition", { 0, 0, GBUFFER_POSITION_FORMAT });
+                    gbuffer.normal = builder.CreateTexture("GBufferNormal", { 0, 0, GBUFFER_NORMAL_FORMAT });
+                    gbuffer.albedo = builder.CreateTexture("GBufferAlbedo", { 0, 0, GBUFFER_ALBEDO_FORMAT });
+                    gbuffer.material =
+                        builder.CreateTexture("GBufferMetallicRoughness", { 0, 0, GBUFFER_METALLIC_ROUGHNESS_FORMAT });
+                    colors = { gbuffer.position, gbuffer.normal, gbuffer.albedo, gbuffer.material };
+                }
+                gbuffer.depth = builder.CreateTexture("GBufferDepth", { 0, 0, m_context->GetDepthFormat() });
+
+                const VkClearValue clearColor{ { { 0.0f, 0.0f, 0.0f, 0.0f } } };
+                VkClearValue clearDepth{};
+                clearDepth.depthStencil = { 1.0f, 0 };
+                for (RenderGraphResource color : colors) {
+                    builder.Write(color, RenderGraphAccess::ColorAttachment);
+                    builder.Clear(color, clearColor);
+                }
+                builder.Write(gbuffer.depth, RenderGraphAccess::DepthAttachment);
+                builder.Clear(gbuffer.depth, clearDepth);
+                if (m_gpuDriven) {
+                    m_gpuDriven->DeclareDrawReads(builder, draws);
+                    builder.SetParallelRecording();
+                }
+            },
+            [this, draws](RenderGraphPassContext& pass) {
+                if (m_gpuDriven) {
+                    m_gpuDriven->RecordDraws(pass, draws, m_layout);
+                }
+            });
+
+        graph.AddPass(
+            "DeferredLighting",
+            [&](RenderGraphBuilder& builder) {
+                // Input attachment order matches input_attachment_index in the subpass shaders
+                const RenderGraphAccess access =
+                    m_subpassLighting ? RenderGraphAccess::InputAttachment : RenderGraphAccess::SampledFragment;
+                builder.Read(m_layout == GBufferLayout::Compact ? gbuffer.depth : gbuffer.position, access);
+                builder.Read(gbuffer.normal, access);
+                builder.Read(gbuffer.albedo, access);
+                builder.Read(gbuffer.material, access);
+                builder.Read(clusters.lights, RenderGraphAccess::StorageReadFragment);
+                builder.Read(clusters.lightCounts, RenderGraphAccess::StorageReadFragment);
+                builder.Read(clusters.lightIndices, RenderGraphAccess::StorageReadFragment);
+                builder.Write(target, RenderGraphAccess::ColorAttachment);
+            },
+            [this, gbuffer, clusters, target](RenderGraphPassContext& pass) {
+                RecordLighting(pass, gbuffer, clusters, target);
+            });
+
+        return gbuffer;
+    }
+
+    void DeferredRenderer::UploadFrameData(VkExtent2D extent) {
+        const FrameUniforms& frame = m_frameUniforms[m_context->GetCurrentFrameIndex()];
+
+        uint32_t lightCount = static_cast<uint32_t>(m_lights.size());
+        if (lightCount > m_maxLights) {
+            if (!m_lightOverflowReported) {
+                SA_LOG_WARN("{} point lights exceed the light buffer capacity of {}; the rest are dropped", lightCount,
+                            m_maxLights);
+                m_lightOverflowReported = true;
+            }
+            lightCount = m_maxLights;
+        }
+        std::memcpy(frame.lightsMapped, m_lights.data(), lightCount * sizeof(PointLight));
+
+        // Exponential slices: slice = log(z / zNear) / log(zFar / zNear) * CLUSTER_COUNT_Z
+        const float zNear = std::max(m_lighting.zNear, 1e-4f);
+        const float zFar = std::max(m_lighting.zFar, zNear * 1.001f);
+        const float logDepthRange = std::log(zFar / zNear);
+        m_lighting.lightCount = lightCount;
+        m_lighting.zNear = zNear;
+        m_lighting.zFar = zFar;
+        m_lighting.sliceScale = static_cast<float>(CLUSTER_COUNT_Z) / logDepthRange;
+        m_lighting.sliceBias = -static_cast<float>(CLUSTER_COUNT_Z) * std::log(zNear) / logDepthRange;
+        m_lighting.clusterCount[0] = CLUSTER_COUNT_X;
+        m_lighting.clusterCount[1] = CLUSTER_COUNT_Y;
+        m_lighting.clusterCount[2] = CLUSTER_COUNT_Z;
+        m_lighting.maxLightsPerCluster = MAX_LIGHTS_PER_CLUSTER;
+        m_lighting.tileSize[0] = static_cast<float>(extent.width) / CLUSTER_COUNT_X;
+        m_lighting.tileSize[1] = static_cast<float>(extent.height) / CLUSTER_COUNT_Y;
+        m_lighting.screenSize[0] = static_cast<float>(extent.width);
+        m_lighting.screenSize[1] = static_cast<float>(extent.height);
+        std::memcpy(frame.mapped, &m_lighting, sizeof(LightingUniforms));
+    }
+
+    void DeferredRenderer::RecordClustering(RenderGraphPassContext& pass, const ClusterResources& clusters) {
+        if (m_clusterPipeline == VK_NULL_HANDLE) {
+            return;
+        }
+
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        if (!m_context->GetFrameDescriptorAllocator().Allocate(m_clusterSetLayout, set)) {
+            return;
+        }
+
+        const FrameUniforms& frame = m_frameUniforms[m_context->GetCurrentFrameIndex()];
+        const VkDescriptorBufferInfo bufferInfos[4] = {
+            { frame.buffer, 0, sizeof(LightingUniforms) },
+            { pass.GetBuffer(clusters.lights), 0, VK_WHOLE_SIZE },
+            { pass.GetBuffer(clusters.lightCounts), 0, VK_WHOLE_SIZE },
+            { pass.GetBuffer(clusters.lightIndices), 0, VK_WHOLE_SIZE },
+        };
+        const VkWriteDescriptorSet writes[4] = {
+            MakeBufferWrite(set, LIGHTING_UNIFORM_BINDING, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, &bufferInfos[0]),
+            MakeBufferWrite(set, LIGHT_BUFFER_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &bufferInfos[1]),
+            MakeBufferWrite(set, CLUSTER_COUNTS_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &bufferInfos[2]),
+            MakeBufferWrite(set, CLUSTER_INDICES_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &bufferInfos[3]),
+        };
+        vkUpdateDescriptorSets(m_device, 4, writes, 0, nullptr);
+
+        VkCommandBuffer cmd = pass.GetCommandBuffer();
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_clusterPipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_clusterLayout, 0, 1, &set, 0, nullptr);
+        vkCmdDispatch(cmd, (CLUSTER_COUNT + CLUSTER_GROUP_SIZE - 1) / CLUSTER_GROUP_SIZE, 1, 1);
+    }
+
+    void DeferredRenderer::RecordLighting(RenderGraphPassContext& pass, const GBufferResources& gbuffer,
+                                          const ClusterResources& clusters, RenderGraphResource target) {
+        if (pass.GetRenderPass() != m_lightingRenderPass) {
+            GraphicsPipelineDesc desc;
+            desc.stages = { { VK_SHADER_STAGE_VERTEX_BIT, "deferred_lighting.vert.spv" },
+                            { VK_SHADER_STAGE_FRAGMENT_BIT, GetLightingShader(m_layout, m_subpassLighting) } };
+            desc.cullMode = VK_CULL_MODE_NONE;
+            desc.depthTest = false;
+            desc.depthWrite = false;
+            desc.blendEnable = { 0 };
+            desc.layout = m_lightingLayout;
+            desc.renderPass = pass.GetRenderPass();
+            desc.subpass = pass.GetSubpass();
+            desc.features = GetOutputFeatures(pass.GetFormat(target));  // The render pass changes with the format
+            m_lightingPipeline = m_pipelines->GetGraphicsPipeline(desc);
+            m_lightingRenderPass = pass.GetRenderPass();
+        }
+        if (m_lightingPipeline == VK_NULL_HANDLE) {
+            return;
+        }
+
+        const FrameUniforms& uniforms = m_frameUniforms[m_context->GetCurrentFrameIndex()];
+
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        if (!m_context->GetFrameDescriptorAllocator().Allocate(m_lightingSetLayout, set)) {
+            return;
+        }
+
+        const bool compact = m_layout == GBufferLayout::Compact;
+        const RenderGraphResource inputs[4] = { compact ? gbuffer.depth : gbuffer.position, gbuffer.normal,
+                                                gbuffer.albedo, gbuffer.material };
+        VkDescriptorImageInfo imageInfos[4];
+        VkWriteDescriptorSet writes[8]{};
+        for (uint32_t i = 0; i < 4; i++) {
+            // A depth input attachment stays in the read-only depth layout the render pass put it in
+            const VkImageLayout layout = compact && i == 0 && m_subpassLighting
+                                             ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+                                             : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            imageInfos[i] = { m_subpassLighting ? VK_NULL_HANDLE : m_sampler, pass.GetImageView(inputs[i]), layout };
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = set;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType =
+                m_subpassLighting ? VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[i].pImageInfo = &imageInfos[i];
+        }
+        const VkDescriptorBufferInfo bufferInfos[4] = {
+            { uniforms.buffer, 0, sizeof(LightingUniforms) },
+            { pass.GetBuffer(clusters.lights), 0, VK_WHOLE_SIZE },
+            { pass.GetBuffer(clusters.lightCounts), 0, VK_WHOLE_SIZE },
+            { pass.GetBuffer(clusters.lightIndices), 0, VK_WHOLE_SIZE },
+        };
+        writes[4] = MakeBufferWrite(set, LIGHTING_UNIFORM_BINDING, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, &bufferInfos[0]);
+        writes[5] = MakeBufferWrite(set, LIGHT_BUFFER_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &bufferInfos[1]);
+        writes[6] = MakeBufferWrite(set, CLUSTER_COUNTS_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &bufferInfos[2]);
+        writes[7] = MakeBufferWrite(set, CLUSTER_INDICES_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &bufferInfos[3]);
+        vkUpdateDescriptorSets(m_device, 8, writes, 0, nullptr);
+
+        VkCommandBuffer cmd = pass.GetCommandBuffer();
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_lightingPipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_lightingLayout, 0, 1, &set, 0, nullptr);
+        vkCmdDraw(cmd, 3, 1, 0, 0);
+    }
+
+    uint32_t DeferredRenderer::GetGBufferBytesPerPixel() const {
+        const uint32_t depth = m_context ? GetFormatSize(m_context->GetDepthFormat()) : 0;
+        if (m_layout == GBufferLayout::Compact) {
+            return GetFormatSize(COMPACT_NORMAL_FORMAT) + GetFormatSize(COMPACT_ALBEDO_FORMAT) +
+                   GetFormatSize(COMPACT_MATERIAL_FORMAT) + depth;
+        }
+        return GetFormatSize(GBUFFER_POSITION_FORMAT) + GetFormatSize(GBUFFER_NORMAL_FORMAT) +
+               GetFormatSize(GBUFFER_ALBEDO_FORMAT) + GetFormatSize(GBUFFER_METALLIC_ROUGHNESS_FORMAT) + depth;
+    }
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,236 @@
+#pragma once
+
+/**
+ * @file DeferredRenderer.hpp
+ * @brief Deferred shading expressed as render graph passes
+ *
+ * A G-buffer pass fills position, normal, albedo and metallic/roughness targets, and a
+ * fullscreen lighting pass (deferred_lighting.vert/.frag) resolves them into the
+ * backbuffer. The G-buffer targets are graph transients. The lighting shader only tone
+ * maps and gamma-encodes as far as the target's format requires.
+ *
+ * Lighting is clustered: a compute pass (light_clustering.comp) bins the point lights
+ * into a view-space grid of screen tiles and exponential depth slices, and the lighting
+ * pass only evaluates the lights binned into each pixel's cluster, so its cost follows
+ * local light density rather than the total light count.
+ *
+ * GBufferLayout::Compact drops the position target (reconstructed from depth and the
+ * inverse view-projection), stores octahedral normals in RG16 and packs metallic,
+ * roughness and AO into one RGBA8 target.
+ *
+ * With subpassLighting the lighting pass reads the G-buffer as input attachments instead,
+ * so the graph merges both passes into one render pass and the G-buffer never has to
+ * leave tile memory on tile-based GPUs.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "function/graphics/RenderGraph.hpp"
+
+namespace StellarAlia::Function::Graphics {
+
+    class VulkanGraphicsContext;
+    class PipelineManager;
+    class GpuDrivenRenderer;
+
+    /**
+     * @brief G-buffer target layout
+     */
+    enum class GBufferLayout : uint32_t {
+        Standard,  // RGBA16F position, RGBA16F normal, RGBA8 albedo, RG8 metallic/roughness
+        Compact,   // RG16 octahedral normal, RGBA8 albedo, RGBA8 metallic/roughness/AO; position from depth
+    };
+
+    /**
+     * @brief Get a printable layout name
+     * @param layout G-buffer layout
+     * @return Name
+     */
+    const char* GBufferLayoutToString(GBufferLayout layout);
+
+    /**
+     * @brief Point light (std430, matches PointLight in clustered_lighting.glsl)
+     */
+    struct PointLight {
+        float position[3] = { 0.0f, 5.0f, 0.0f };
+        float radius = 25.0f;
+        float color[3] = { 1.0f, 1.0f, 1.0f };
+        float intensity = 10.0f;
+    };
+    static_assert(sizeof(PointLight) == 32, "PointLight must match the std430 shader layout");
+
+    /**
+     * @brief Lighting uniforms (std140, matches LightingUniforms in clustered_lighting.glsl)
+     *
+     * Matrices are column-major. Fields marked "renderer" are overwritten every frame.
+     */
+    struct LightingUniforms {
+        float view[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                           0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+        float inverseProjection[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                                        0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+        float inverseViewProjection[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                                            0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };  // Compact only
+        float viewPosition[3] = { 0.0f, 0.0f, 5.0f };
+        uint32_t lightCount = 0;         // Renderer
+        float ambientColor[3] = { 1.0f, 1.0f, 1.0f };
+        float ambientIntensity = 0.03f;
+        float zNear = 0.1f;              // Depth range covered by the cluster slices
+        float zFar = 100.0f;
+        float sliceScale = 0.0f;         // Renderer
+        float sliceBias = 0.0f;          // Renderer
+        uint32_t clusterCount[3] = {};   // Renderer
+        uint32_t maxLightsPerCluster = 0;  // Renderer
+        float tileSize[2] = {};          // Renderer
+        float screenSize[2] = {};        // Renderer
+    };
+    static_assert(sizeof(LightingUniforms) == 272, "LightingUniforms must match the std140 shader layout");
+
+    /**
+     * @brief G-buffer targets declared by the geometry pass
+     */
+    struct GBufferResources {
+        RenderGraphResource position;  // Standard only
+        RenderGraphResource normal;
+        RenderGraphResource albedo;
+        RenderGraphResource material;  // Metallic/roughness (Standard) or metallic/roughness/AO (Compact)
+        RenderGraphResource depth;
+    };
+
+    /**
+     * @brief Deferred renderer creation parameters
+     */
+    struct DeferredRendererCreateInfo {
+        GBufferLayout layout = GBufferLayout::Standard;
+        bool subpassLighting = false;  // Read the G-buffer as subpass inputs in a single render pass
+        uint32_t maxLights = 4096;     // Capacity of the per-frame light buffer
+    };
+
+    /**
+     * @brief Deferred shading passes
+     */
+    class DeferredRenderer {
+    public:
+        DeferredRenderer() = default;
+        ~DeferredRenderer();
+
+        DeferredRenderer(const DeferredRenderer&) = delete;
+        DeferredRenderer& operator=(const DeferredRenderer&) = delete;
+
+        /**
+         * @brief Create the lighting sampler, descriptor layout and uniform buffers
+         * @param context Initialized Vulkan context
+         * @param pipelines Pipeline manager used for the pass pipelines
+         * @param createInfo Creation parameters
+         * @return True on success
+         */
+        bool Initialize(VulkanGraphicsContext& context, PipelineManager& pipelines,
+                        const DeferredRendererCreateInfo& createInfo = {});
+
+        /**
+         * @brief Release resources (the GPU must be idle)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Declare the G-buffer and lighting passes
+         * @param graph Graph being built for this frame
+         * @param target Texture the lighting pass writes
+         * @return G-buffer resources, for passes added afterwards
+         */
+        GBufferResources AddPasses(RenderGraph& graph, RenderGraphResource target);
+
+        /**
+         * @brief Draw the G-buffer from GPU-culled indirect draws
+         * @param gpuDriven GPU-driven renderer whose passes are added before the G-buffer pass,
+         *                  or nullptr to leave the G-buffer empty
+         */
+        void SetGpuDrivenRenderer(GpuDrivenRenderer* gpuDriven) { m_gpuDriven = gpuDriven; }
+
+        /**
+         * @brief Get the lighting parameters used by the next frame
+         * @return Lighting uniforms
+         */
+        LightingUniforms& GetLighting() { return m_lighting; }
+
+        /**
+         * @brief Get the point lights uploaded each frame
+         * @return Light list; lights beyond DeferredRendererCreateInfo::maxLights are dropped
+         */
+        std::vector<PointLight>& GetLights() { return m_lights; }
+
+        /**
+         * @brief Get the G-buffer layout
+         * @return Layout
+         */
+        GBufferLayout GetLayout() const { return m_layout; }
+
+        /**
+         * @brief Get the G-buffer footprint, depth included
+         * @return Bytes written per pixel by the geometry pass
+         */
+        uint32_t GetGBufferBytesPerPixel() const;
+
+    private:
+        struct FrameUniforms {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VmaAllocation allocation = VK_NULL_HANDLE;
+            void* mapped = nullptr;
+            VkBuffer lightBuffer = VK_NULL_HANDLE;
+            VmaAllocation lightAllocation = VK_NULL_HANDLE;
+            void* lightsMapped = nullptr;
+        };
+
+        // Buffers written by the clustering pass and read by the lighting pass
+        struct ClusterResources {
+            RenderGraphResource lights;
+            RenderGraphResource lightCounts;
+            RenderGraphResource lightIndices;
+        };
+
+        VulkanGraphicsContext* m_context = nullptr;
+        PipelineManager* m_pipelines = nullptr;
+        VkDevice m_device = VK_NULL_HANDLE;
+        GBufferLayout m_layout = GBufferLayout::Standard;
+        bool m_subpassLighting = false;
+        uint32_t m_maxLights = 0;
+
+        VkSampler m_sampler = VK_NULL_HANDLE;
+        VkDescriptorSetLayout m_lightingSetLayout = VK_NULL_HANDLE;  // Owned by the layout cache
+        VkPipelineLayout m_lightingLayout = VK_NULL_HANDLE;          // Owned by the pipeline manager
+        std::vector<FrameUniforms> m_frameUniforms;
+
+        VkDescriptorSetLayout m_clusterSetLayout = VK_NULL_HANDLE;  // Owned by the layout cache
+        VkPipelineLayout m_clusterLayout = VK_NULL_HANDLE;          // Owned by the pipeline manager
+        VkPipeline m_clusterPipeline = VK_NULL_HANDLE;
+
+        // Rebuilt only when the graph hands out a different render pass
+        VkRenderPass m_lightingRenderPass = VK_NULL_HANDLE;
+        VkPipeline m_lightingPipeline = VK_NULL_HANDLE;
+        uint32_t m_pipelineGeneration = 0;  // PipelineManager generation the pipelines were fetched at
+
+        GpuDrivenRenderer* m_gpuDriven = nullptr;
+
+        // The clustering pass's execute callback is bound before its setup creates the buffers
+        ClusterResources m_clusters;
+
+        LightingUniforms m_lighting;
+        std::vector<PointLight> m_lights = { PointLight{} };
+        bool m_lightOverflowReported = false;
+
+        void UploadFrameData(VkExtent2D extent);
+        void RecordClustering(RenderGraphPassContext& pass, const ClusterResources& clusters);
+        void RecordLighting(RenderGraphPassContext& pass, const GBufferResources& gbuffer,
+                            const ClusterResources& clusters, RenderGraphResource target);
+    };
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,51 @@
+#include "function/graphics/FramePacer.hpp"
+
+#include <thread>
+
+namespace StellarAlia::Function::Graphics {
+
+    // Remaining time below which Wait() spins instead of sleeping
+    constexpr auto SPIN_THRESHOLD = std::chrono::microseconds(1500);
+
+    void FramePacer::SetTargetFrameRate(float framesPerSecond) {
+        if (framesPerSecond <= 0.0f) {
+            m_targetFrameRate = 0.0f;
+            m_interval = Clock::duration::zero();
+        } else {
+            m_targetFrameRate = framesPerSecond;
+            m_interval = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / framesPerSecond));
+        }
+        m_started = false;
+    }
+
+    void FramePacer::Wait() {
+        if (m_interval == Clock::duration::zero()) {
+            return;
+        }
+
+        auto now = Clock::now();
+        if (!m_started) {
+            m_started = true;
+            m_nextFrame = now + m_interval;
+            return;
+        }
+
+        if (now < m_nextFrame) {
+            if (m_nextFrame - now > SPIN_THRESHOLD) {
+                std::this_thread::sleep_for(m_nextFrame - now - SPIN_THRESHOLD);
+            }
+            while (Clock::now() < m_nextFrame) {
+                std::this_thread::yield();
+            }
+            m_nextFrame += m_interval;
+        } else if (now - m_nextFrame < m_interval) {
+            // Slightly late: keep the cadence
+            m_nextFrame += m_interval;
+        } else {
+            // Missed a whole interval: restart the schedule rather than bursting to catch up
+            m_nextFrame = now + m_interval;
+        }
+    }
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * @file FramePacer.hpp
+ * @brief CPU-side frame rate limiter
+ *
+ * Sleeps the calling thread so frames start at a fixed interval. Used to cap
+ * the frame rate independently of the present mode.
+ */
+
+#include <chrono>
+
+namespace StellarAlia::Function::Graphics {
+
+    /**
+     * @brief Caps the frame rate by delaying the start of each frame
+     */
+    class FramePacer {
+    public:
+        /**
+         * @brief Set the target frame rate
+         * @param framesPerSecond Target rate in Hz; 0 or less disables pacing
+         */
+        void SetTargetFrameRate(float framesPerSecond);
+
+        /**
+         * @brief Get the target frame rate
+         * @return Target rate in Hz, or 0 if uncapped
+         */
+        float GetTargetFrameRate() const { return m_targetFrameRate; }
+
+        /**
+         * @brief Block until the next frame may start
+         * Sleeps for most of the remaining interval and spins for the last fraction
+         * to avoid OS timer granularity. Returns immediately when uncapped.
+         */
+        void Wait();
+
+        /**
+         * @brief Forget the previous frame deadline (e.g. after a long stall)
+         */
+        void Reset() { m_started = false; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        float m_targetFrameRate = 0.0f;
+        Clock::duration m_interval = Clock::duration::zero();
+        Clock::time_point m_nextFrame;
+        bool m_started = false;
+    };
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,807 @@
+#include "function/graphics/GpuDrivenRenderer.hpp"
+#include "function/graphics/PipelineManager.hpp"
+#include "function/graphics/Scene.hpp"
+#include "function/graphics/vulkan/VulkanBindlessRegistry.hpp"
+#include "function/graphics/vulkan/VulkanGraphicsContext.hpp"
+#include "core/logs/Log.hpp"
+#include "core/math/Math.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <unordered_map>
+
+namespace StellarAlia::Function::Graphics {
+
+    namespace {
+        constexpr uint32_t CULLING_GROUP_SIZE = 64;  // local_size_x of gpu_culling.comp
+        constexpr VkDeviceSize DRAW_COMMAND_SIZE = sizeof(VkDrawIndexedIndirectCommand);
+        constexpr const char* CULLING_SHADER = "gpu_culling.comp.spv";
+        constexpr uint32_t DRAWS_PER_RECORDING_BUCKET = 2048;  // Per-instance fallback draws per secondary buffer
+
+        static_assert(SHADER_FEATURE_NORMAL_MAP == 1 && SHADER_FEATURE_METALLIC_ROUGHNESS_MAP == 2,
+                      "Geometry permutation indices are their ShaderFeatures masks");
+
+        void ComputeNormalMatrix(const float (&model)[16], float (&normalMatrix)[12]) {
+            const Core::Math::Mat4 normal = Core::Math::NormalMatrix(Core::Math::Mat4::Load(model));
+            std::memcpy(normalMatrix, normal.Data(), sizeof(normalMatrix));
+        }
+    }
+
+    GpuDrivenRenderer::~GpuDrivenRenderer() {
+        Shutdown();
+    }
+
+    bool GpuDrivenRenderer::Initialize(VulkanGraphicsContext& context, PipelineManager& pipelines,
+                                       const GpuDrivenRendererCreateInfo& createInfo) {
+        if (m_device != VK_NULL_HANDLE) {
+            SA_LOG_WARN("GpuDrivenRenderer already initialized");
+            return false;
+        }
+        if (!context.GetBindlessRegistry()) {
+            SA_LOG_ERROR("GPU-driven rendering needs bindless materials; create the context with enableBindless");
+            return false;
+        }
+        if (!context.GetEnabledFeatures().drawIndirectFirstInstance) {
+            SA_LOG_ERROR("GPU-driven rendering needs the drawIndirectFirstInstance feature");
+            return false;
+        }
+
+        m_context = &context;
+        m_pipelines = &pipelines;
+        m_device = context.GetDevice();
+        m_createInfo = createInfo;
+        m_createInfo.maxInstances = std::max(createInfo.maxInstances, 1u);
+        m_createInfo.maxMeshes = std::max(createInfo.maxMeshes, 1u);
+        m_createInfo.instanceUploadsPerFrame = std::max(createInfo.instanceUploadsPerFrame, 1u);
+        m_drawIndirectCount = context.IsDrawIndirectCountEnabled();
+        m_multiDrawIndirect = context.GetEnabledFeatures().multiDrawIndirect == VK_TRUE;
+
+        const GpuDrivenRendererCreateInfo& info = m_createInfo;
+        if (!CreateBuffer(static_cast<VkDeviceSize>(info.maxVertices) * sizeof(GpuVertex),
+                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, m_vertexBuffer) ||
+            !CreateBuffer(static_cast<VkDeviceSize>(info.maxIndices) * sizeof(uint32_t),
+                          VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, m_indexBuffer) ||
+            !CreateBuffer(static_cast<VkDeviceSize>(info.maxMeshes) * sizeof(GpuMesh),
+                          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, m_meshBuffer) ||
+            !CreateBuffer(static_cast<VkDeviceSize>(info.maxInstances) * sizeof(GpuInstance),
+                          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, m_instanceBuffer)) {
+            SA_LOG_ERROR("Failed to create GPU-driven geometry buffers");
+            Shutdown();
+            return false;
+        }
+
+        // Per frame: scene uniforms and a staging area for changed instances
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        m_frames.resize(context.GetFramesInFlight());
+        for (FrameData& frame : m_frames) {
+            VmaAllocationInfo allocationInfo{};
+            bufferInfo.size = sizeof(GpuSceneUniforms);
+            bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+            if (!context.GetMemoryManager().CreateBuffer(MemoryCategory::Staging, bufferInfo, allocInfo,
+                                                         frame.uniformBuffer, frame.uniformAllocation)) {
+                SA_LOG_ERROR("Failed to create GPU scene uniform buffer");
+                Shutdown();
+                return false;
+            }
+            vmaGetAllocationInfo(context.GetAllocator(), frame.uniformAllocation, &allocationInfo);
+            frame.uniformsMapped = allocationInfo.pMappedData;
+
+            bufferInfo.size = static_cast<VkDeviceSize>(info.instanceUploadsPerFrame) * sizeof(GpuInstance);
+            bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            if (!context.GetMemoryManager().CreateBuffer(MemoryCategory::Staging, bufferInfo, allocInfo,
+                                                         frame.stagingBuffer, frame.stagingAllocation)) {
+                SA_LOG_ERROR("Failed to create instance staging buffer");
+                Shutdown();
+                return false;
+            }
+            vmaGetAllocationInfo(context.GetAllocator(), frame.stagingAllocation, &allocationInfo);
+            frame.stagingMapped = allocationInfo.pMappedData;
+        }
+
+        // Culling: scene uniforms, instances, meshes, draw commands, draw count
+        const std::array<VkDescriptorSetLayoutBinding, 5> cullingBindings = {{
+            { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+            { 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr },
+        }};
+        m_cullingSetLayout = context.GetDescriptorLayoutCache().GetLayout(cullingBindings);
+        m_cullingLayout = m_cullingSetLayout != VK_NULL_HANDLE ? pipelines.GetPipelineLayout({ m_cullingSetLayout })
+                                                                : VK_NULL_HANDLE;
+        if (m_cullingLayout != VK_NULL_HANDLE) {
+            ComputePipelineDesc cullingDesc;
+            cullingDesc.stage = { VK_SHADER_STAGE_COMPUTE_BIT, CULLING_SHADER };
+            cullingDesc.layout = m_cullingLayout;
+            m_cullingPipeline = pipelines.GetComputePipeline(cullingDesc);
+            m_pipelineGeneration = pipelines.GetGeneration();
+        }
+        if (m_cullingPipeline == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("Failed to create the GPU culling pipeline");
+            Shutdown();
+            return false;
+        }
+
+        // Drawing: set 0 holds scene uniforms and instances, set 1 is the bindless set
+        const std::array<VkDescriptorSetLayoutBinding, 2> drawBindings = {{
+            { 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr },
+            { 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr },
+        }};
+        m_drawSetLayout = context.GetDescriptorLayoutCache().GetLayout(drawBindings);
+        m_drawLayout = m_drawSetLayout != VK_NULL_HANDLE
+                           ? pipelines.GetPipelineLayout({ m_drawSetLayout, context.GetBindlessRegistry()->GetSetLayout() })
+                           : VK_NULL_HANDLE;
+        if (m_drawLayout == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("Failed to create the GPU-driven draw layout");
+            Shutdown();
+            return false;
+        }
+
+        m_meshes.reserve(info.maxMeshes);
+        m_slotDirty.assign(info.maxInstances, 0);
+        SA_LOG_INFO("GPU-driven rendering: up to {} instances, {}", info.maxInstances,
+                    m_drawIndirectCount   ? "compacted multi-draw indirect with GPU count"
+                    : m_multiDrawIndirect ? "multi-draw indirect"
+                                          : "one indirect draw per instance (no multiDrawIndirect)");
+        return true;
+    }
+
+    void GpuDrivenRenderer::Shutdown() {
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        for (FrameData& frame : m_frames) {
+            if (frame.uniformBuffer != VK_NULL_HANDLE) {
+                m_context->GetMemoryManager().DestroyBuffer(frame.uniformBuffer, frame.uniformAllocation);
+            }
+            if (frame.stagingBuffer != VK_NULL_HANDLE) {
+                m_context->GetMemoryManager().DestroyBuffer(frame.stagingBuffer, frame.stagingAllocation);
+            }
+        }
+        m_frames.clear();
+        DestroyBuffer(m_vertexBuffer);
+        DestroyBuffer(m_indexBuffer);
+        DestroyBuffer(m_meshBuffer);
+        DestroyBuffer(m_instanceBuffer);
+
+        m_meshes.clear();
+        m_pendingMeshes.clear();
+        m_instances.clear();
+        m_slotToId.clear();
+        m_idToSlot.clear();
+        m_freeIds.clear();
+        m_slotDirty.clear();
+        m_dirtySlots.clear();
+        m_copyRegions.clear();
+        m_vertexCount = 0;
+        m_indexCount = 0;
+        m_residentMeshes = 0;
+        m_uploadedSlots = 0;
+        m_uniforms = {};
+        m_draws = {};
+        m_stats = {};
+
+        m_cullingSetLayout = VK_NULL_HANDLE;
+        m_cullingLayout = VK_NULL_HANDLE;
+        m_cullingPipeline = VK_NULL_HANDLE;
+        m_drawSetLayout = VK_NULL_HANDLE;
+        m_drawLayout = VK_NULL_HANDLE;
+        m_permutationEnd = {};
+        m_drawDesc = {};
+        m_drawRenderPass = VK_NULL_HANDLE;
+        m_drawPipelines = {};
+        m_pipelineGeneration = 0;
+        m_materialGeneration = 0;
+        m_drawIndirectCount = false;
+        m_multiDrawIndirect = false;
+        m_pipelines = nullptr;
+        m_context = nullptr;
+        m_device = VK_NULL_HANDLE;
+    }
+
+    GpuMeshHandle GpuDrivenRenderer::AddMesh(const GpuVertex* vertices, uint32_t vertexCount,
+                                             const uint32_t* indices, uint32_t indexCount) {
+        if (m_device == VK_NULL_HANDLE || vertexCount == 0 || indexCount == 0) {
+            return {};
+        }
+        if (m_meshes.size() >= m_createInfo.maxMeshes ||
+            vertexCount > m_createInfo.maxVertices - m_vertexCount ||
+            indexCount > m_createInfo.maxIndices - m_indexCount) {
+            SA_LOG_ERROR("GPU-driven geometry buffers are full ({} meshes, {} vertices, {} indices)", m_meshes.size(),
+                         m_vertexCount, m_indexCount);
+            return {};
+        }
+
+        // Bounding sphere around the box center
+        float boxMin[3] = { vertices[0].position[0], vertices[0].position[1], vertices[0].position[2] };
+        float boxMax[3] = { boxMin[0], boxMin[1], boxMin[2] };
+        for (uint32_t v = 1; v < vertexCount; v++) {
+            for (int axis = 0; axis < 3; axis++) {
+                boxMin[axis] = std::min(boxMin[axis], vertices[v].position[axis]);
+                boxMax[axis] = std::max(boxMax[axis], vertices[v].position[axis]);
+            }
+        }
+        MeshState& mesh = m_meshes.emplace_back();
+        float radiusSquared = 0.0f;
+        for (int axis = 0; axis < 3; axis++) {
+            mesh.record.boundsCenter[axis] = 0.5f * (boxMin[axis] + boxMax[axis]);
+        }
+        for (uint32_t v = 0; v < vertexCount; v++) {
+            float distanceSquared = 0.0f;
+            for (int axis = 0; axis < 3; axis++) {
+                const float d = vertices[v].position[axis] - mesh.record.boundsCenter[axis];
+                distanceSquared += d * d;
+            }
+            radiusSquared = std::max(radiusSquared, distanceSquared);
+        }
+        mesh.record.boundsRadius = std::sqrt(radiusSquared);
+        mesh.record.indexCount = indexCount;
+        mesh.record.firstIndex = m_indexCount;
+        mesh.record.vertexOffset = static_cast<int32_t>(m_vertexCount);
+        m_vertexCount += vertexCount;
+        m_indexCount += indexCount;
+
+        PendingMesh pending;
+        pending.index = static_cast<uint32_t>(m_meshes.size() - 1);
+        pending.vertices.assign(vertices, vertices + vertexCount);
+        pending.indices.assign(indices, indices + indexCount);
+
+        // Keep upload order so residency can advance as a prefix
+        if (!m_pendingMeshes.empty() || !QueueMeshUpload(pending)) {
+            m_pendingMeshes.push_back(std::move(pending));
+        }
+        return { pending.index };
+    }
+
+    GpuInstanceHandle GpuDrivenRenderer::AddInstance(GpuMeshHandle mesh, const float (&model)[16], uint32_t material) {
+        if (m_device == VK_NULL_HANDLE || !mesh.IsValid() || mesh.index >= m_meshes.size()) {
+            return {};
+        }
+        if (m_instances.size() >= m_createInfo.maxInstances) {
+            SA_LOG_ERROR("GPU-driven instance buffer is full ({} instances)", m_instances.size());
+            return {};
+        }
+
+        uint32_t id;
+        if (!m_freeIds.empty()) {
+            id = m_freeIds.back();
+            m_freeIds.pop_back();
+        } else {
+            id = static_cast<uint32_t>(m_idToSlot.size());
+            m_idToSlot.push_back(UINT32_MAX);
+        }
+
+        GpuInstance instance;
+        std::memcpy(instance.model, model, sizeof(instance.model));
+        ComputeNormalMatrix(instance.model, instance.normalMatrix);
+        instance.mesh = mesh.index;
+        instance.material = material;
+        instance.permutation = GetMaterialPermutation(material);
+
+        const uint32_t slot = InsertSlot(instance.permutation);
+        m_instances[slot] = instance;
+        m_slotToId[slot] = id;
+        m_idToSlot[id] = slot;
+        MarkDirty(slot);
+        return { id };
+    }
+
+    void GpuDrivenRenderer::SetInstanceTransform(GpuInstanceHandle instance, const float (&model)[16]) {
+        if (!instance.IsValid() || instance.id >= m_idToSlot.size() || m_idToSlot[instance.id] == UINT32_MAX) {
+            return;
+        }
+        const uint32_t slot = m_idToSlot[instance.id];
+        std::memcpy(m_instances[slot].model, model, sizeof(GpuInstance::model));
+        ComputeNormalMatrix(m_instances[slot].model, m_instances[slot].normalMatrix);
+        MarkDirty(slot);
+    }
+
+    void GpuDrivenRenderer::SetInstanceMaterial(GpuInstanceHandle instance, uint32_t material) {
+        if (!instance.IsValid() || instance.id >= m_idToSlot.size() || m_idToSlot[instance.id] == UINT32_MAX) {
+            return;
+        }
+        const uint32_t slot = m_idToSlot[instance.id];
+        const uint32_t permutation = GetMaterialPermutation(material);
+        if (permutation == m_instances[slot].permutation) {
+            m_instances[slot].material = material;
+            MarkDirty(slot);
+            return;
+        }
+
+        // Move the instance into its new permutation's range
+        GpuInstance record = m_instances[slot];
+        record.material = material;
+        record.permutation = permutation;
+        EraseSlot(slot);
+        const uint32_t newSlot = InsertSlot(permutation);
+        m_instances[newSlot] = record;
+        m_slotToId[newSlot] = instance.id;
+        m_idToSlot[instance.id] = newSlot;
+        MarkDirty(newSlot);
+    }
+
+    void GpuDrivenRenderer::RemoveInstance(GpuInstanceHandle instance) {
+        if (!instance.IsValid() || instance.id >= m_idToSlot.size() || m_idToSlot[instance.id] == UINT32_MAX) {
+            return;
+        }
+        const uint32_t slot = m_idToSlot[instance.id];
+        EraseSlot(slot);
+        m_idToSlot[instance.id] = UINT32_MAX;
+        m_freeIds.push_back(instance.id);
+        m_uploadedSlots = std::min(m_uploadedSlots, static_cast<uint32_t>(m_instances.size()));
+    }
+
+    void GpuDrivenRenderer::SetViewProjection(const float (&viewProjection)[16]) {
+        std::memcpy(m_uniforms.viewProjection, viewProjection, sizeof(m_uniforms.viewProjection));
+        const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+        std::memcpy(m_uniforms.frustumPlanes, frustum.planes, sizeof(m_uniforms.frustumPlanes));
+    }
+
+    GpuDrawResources GpuDrivenRenderer::AddCullingPasses(RenderGraph& graph) {
+        GpuDrawResources draws;
+        if (m_device == VK_NULL_HANDLE) {
+            return draws;
+        }
+
+        UpdateResidency();
+
+        // Shader hot reload dropped our pipelines; fetch their replacements
+        if (m_pipelines->GetGeneration() != m_pipelineGeneration) {
+            m_pipelineGeneration = m_pipelines->GetGeneration();
+            ComputePipelineDesc cullingDesc;
+            cullingDesc.stage = { VK_SHADER_STAGE_COMPUTE_BIT, CULLING_SHADER };
+            cullingDesc.layout = m_cullingLayout;
+            m_cullingPipeline = m_pipelines->GetComputePipeline(cullingDesc);
+            m_drawRenderPass = VK_NULL_HANDLE;
+        }
+
+        // Materials whose textures were added or cleared move their instances to another permutation
+        const uint64_t materialGeneration = m_context->GetBindlessRegistry()->GetMaterialGeneration();
+        if (materialGeneration != m_materialGeneration) {
+            m_materialGeneration = materialGeneration;
+            RefreshPermutations();
+        }
+
+        // Changed instances are staged now; the copy is recorded by the upload pass
+        const FrameData& frame = m_frames[m_context->GetCurrentFrameIndex()];
+        m_stats.instancesUploadedLastFrame = StageInstances(frame);
+        m_uniforms.instanceCount = m_uploadedSlots;
+        m_uniforms.residentMeshCount = m_residentMeshes;
+        m_uniforms.compactDraws = m_drawIndirectCount ? 1 : 0;
+        uint32_t rangeFirst = 0;
+        for (uint32_t p = 0; p < GPU_GEOMETRY_PERMUTATIONS; p++) {
+            // Only the uploaded prefix is culled and drawn
+            const uint32_t first = std::min(rangeFirst, m_uploadedSlots);
+            m_uniforms.permutationFirst[p] = first;
+            m_uniforms.permutationCount[p] = std::min(m_permutationEnd[p], m_uploadedSlots) - first;
+            rangeFirst = m_permutationEnd[p];
+        }
+        std::memcpy(frame.uniformsMapped, &m_uniforms, sizeof(GpuSceneUniforms));
+
+        m_stats.instances = static_cast<uint32_t>(m_instances.size());
+        m_stats.meshes = static_cast<uint32_t>(m_meshes.size());
+        m_stats.residentMeshes = m_residentMeshes;
+        m_stats.pendingInstanceUploads = static_cast<uint32_t>(m_dirtySlots.size());
+
+        // Last frame's culling and vertex shaders may still read the instances
+        RenderGraphImportedBuffer instances;
+        instances.buffer = m_instanceBuffer.buffer;
+        instances.size = static_cast<VkDeviceSize>(m_createInfo.maxInstances) * sizeof(GpuInstance);
+        instances.initialStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+        instances.initialAccess = 0;
+        draws.instances = graph.ImportBuffer("Instances", instances);
+
+        const VkBuffer stagingBuffer = frame.stagingBuffer;
+        graph.AddPass(
+            "InstanceUpload",
+            [&](RenderGraphBuilder& builder) {
+                draws.drawCount = builder.CreateBuffer("DrawCount", { GPU_GEOMETRY_PERMUTATIONS * sizeof(uint32_t) });
+                builder.Write(draws.instances, RenderGraphAccess::TransferDst);
+                builder.Write(draws.drawCount, RenderGraphAccess::TransferDst);
+            },
+            [this, stagingBuffer](RenderGraphPassContext& pass) {
+                VkCommandBuffer cmd = pass.GetCommandBuffer();
+                if (!m_copyRegions.empty()) {
+                    vkCmdCopyBuffer(cmd, stagingBuffer, pass.GetBuffer(m_draws.instances),
+                                    static_cast<uint32_t>(m_copyRegions.size()), m_copyRegions.data());
+                }
+                vkCmdFillBuffer(cmd, pass.GetBuffer(m_draws.drawCount), 0, VK_WHOLE_SIZE, 0);
+            });
+
+        graph.AddPass(
+            "GpuCulling",
+            [&](RenderGraphBuilder& builder) {
+                draws.drawCommands = builder.CreateBuffer(
+                    "DrawCommands", { static_cast<VkDeviceSize>(m_createInfo.maxInstances) * DRAW_COMMAND_SIZE });
+                builder.Read(draws.instances, RenderGraphAccess::StorageReadCompute);
+                builder.Write(draws.drawCommands, RenderGraphAccess::StorageWriteCompute);
+                builder.Write(draws.drawCount, RenderGraphAccess::StorageWriteCompute);
+                m_draws = draws;
+            },
+            [this](RenderGraphPassContext& pass) { RecordCulling(pass, m_draws); });
+
+        return draws;
+    }
+
+    void GpuDrivenRenderer::DeclareDrawReads(RenderGraphBuilder& builder, const GpuDrawResources& draws) const {
+        builder.Read(draws.instances, RenderGraphAccess::StorageReadVertex);
+        builder.Read(draws.drawCommands, RenderGraphAccess::IndirectBuffer);
+        if (m_drawIndirectCount) {
+            builder.Read(draws.drawCount, RenderGraphAccess::IndirectBuffer);
+        }
+    }
+
+    void GpuDrivenRenderer::RecordCulling(RenderGraphPassContext& pass, const GpuDrawResources& draws) {
+        if (m_uniforms.instanceCount == 0 || m_cullingPipeline == VK_NULL_HANDLE) {
+            return;
+        }
+
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        if (!m_context->GetFrameDescriptorAllocator().Allocate(m_cullingSetLayout, set)) {
+            return;
+        }
+
+        const FrameData& frame = m_frames[m_context->GetCurrentFrameIndex()];
+        const VkDescriptorBufferInfo bufferInfos[5] = {
+            { frame.uniformBuffer, 0, sizeof(GpuSceneUniforms) },
+            { pass.GetBuffer(draws.instances), 0, VK_WHOLE_SIZE },
+            { m_meshBuffer.buffer, 0, VK_WHOLE_SIZE },
+            { pass.GetBuffer(draws.drawCommands), 0, VK_WHOLE_SIZE },
+            { pass.GetBuffer(draws.drawCount), 0, VK_WHOLE_SIZE },
+        };
+        VkWriteDescriptorSet writes[5]{};
+        for (uint32_t i = 0; i < 5; i++) {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = set;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = i == 0 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &bufferInfos[i];
+        }
+        vkUpdateDescriptorSets(m_device, 5, writes, 0, nullptr);
+
+        VkCommandBuffer cmd = pass.GetCommandBuffer();
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullingPipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullingLayout, 0, 1, &set, 0, nullptr);
+        vkCmdDispatch(cmd, (m_uniforms.instanceCount + CULLING_GROUP_SIZE - 1) / CULLING_GROUP_SIZE, 1, 1);
+    }
+
+    void GpuDrivenRenderer::RecordDraws(RenderGraphPassContext& pass, const GpuDrawResources& draws,
+                                        GBufferLayout layout) {
+        m_stats.drawCallsLastFrame = 0;
+        if (m_device == VK_NULL_HANDLE || m_uniforms.instanceCount == 0) {
+            return;
+        }
+
+        if (pass.GetRenderPass() != m_drawRenderPass) {
+            const bool compact = layout == GBufferLayout::Compact;
+            m_drawDesc = {};
+            m_drawDesc.stages = {
+                { VK_SHADER_STAGE_VERTEX_BIT, "deferred_geometry_indirect.vert.spv" },
+                { VK_SHADER_STAGE_FRAGMENT_BIT,
+                  compact ? "deferred_geometry_indirect_compact.frag.spv" : "deferred_geometry_indirect.frag.spv" },
+            };
+            m_drawDesc.vertexBindings = { { 0, sizeof(GpuVertex), VK_VERTEX_INPUT_RATE_VERTEX } };
+            m_drawDesc.vertexAttributes = {
+                { 0, 0, VK_FORMAT_R32G32B32_SFLOAT, static_cast<uint32_t>(offsetof(GpuVertex, position)) },
+                { 1, 0, VK_FORMAT_R32G32B32_SFLOAT, static_cast<uint32_t>(offsetof(GpuVertex, normal)) },
+                { 2, 0, VK_FORMAT_R32G32_SFLOAT, static_cast<uint32_t>(offsetof(GpuVertex, texCoord)) },
+                { 3, 0, VK_FORMAT_R32G32B32_SFLOAT, static_cast<uint32_t>(offsetof(GpuVertex, tangent)) },
+            };
+            m_drawDesc.blendEnable.assign(compact ? 3 : 4, 0);
+            m_drawDesc.layout = m_drawLayout;
+            m_drawDesc.renderPass = pass.GetRenderPass();
+            m_drawDesc.subpass = pass.GetSubpass();
+            m_drawRenderPass = pass.GetRenderPass();
+            m_drawPipelines = {};
+
+            // Build the permutations previous frames and runs drew most, so a material that
+            // shows up later does not stall its first frame on a pipeline compile
+            m_pipelines->PrewarmPermutations(m_drawDesc, GPU_GEOMETRY_PERMUTATIONS);
+        }
+
+        // Pipelines of the permutations drawn this frame
+        bool drawable = false;
+        for (uint32_t p = 0; p < GPU_GEOMETRY_PERMUTATIONS; p++) {
+            if (m_uniforms.permutationCount[p] == 0) {
+                continue;
+            }
+            m_drawDesc.features = p;
+            if (m_drawPipelines[p] == VK_NULL_HANDLE) {
+                m_drawPipelines[p] = m_pipelines->GetGraphicsPipeline(m_drawDesc);
+            }
+            m_pipelines->RecordPermutationUse(m_drawDesc, m_uniforms.permutationCount[p]);
+            drawable = drawable || m_drawPipelines[p] != VK_NULL_HANDLE;
+        }
+        if (!drawable) {
+            return;
+        }
+
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        if (!m_context->GetFrameDescriptorAllocator().Allocate(m_drawSetLayout, set)) {
+            return;
+        }
+        const FrameData& frame = m_frames[m_context->GetCurrentFrameIndex()];
+        const VkDescriptorBufferInfo bufferInfos[2] = {
+            { frame.uniformBuffer, 0, sizeof(GpuSceneUniforms) },
+            { pass.GetBuffer(draws.instances), 0, VK_WHOLE_SIZE },
+        };
+        VkWriteDescriptorSet writes[2]{};
+        for (uint32_t i = 0; i < 2; i++) {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = set;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = i == 0 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &bufferInfos[i];
+        }
+        vkUpdateDescriptorSets(m_device, 2, writes, 0, nullptr);
+
+        const VkBuffer commands = pass.GetBuffer(draws.drawCommands);
+        const VkBuffer countBuffer = m_drawIndirectCount ? pass.GetBuffer(draws.drawCount) : VK_NULL_HANDLE;
+        const uint32_t drawCount = m_uniforms.instanceCount;
+        const auto stride = static_cast<uint32_t>(DRAW_COMMAND_SIZE);
+        const uint32_t maxDrawIndirectCount = m_context->GetDeviceCapabilities().limits.maxDrawIndirectCount;
+        const uint32_t batch = std::max(maxDrawIndirectCount, 1u);
+
+        // The indirect paths are a handful of calls per permutation; only per-instance draws
+        // are worth spreading over recording threads
+        uint32_t bucketCount = 1;
+        for (uint32_t p = 0; p < GPU_GEOMETRY_PERMUTATIONS; p++) {
+            const uint32_t count = m_uniforms.permutationCount[p];
+            if (count == 0 || m_drawPipelines[p] == VK_NULL_HANDLE) {
+                continue;
+            }
+            if (m_drawIndirectCount) {
+                m_stats.drawCallsLastFrame++;
+            } else if (m_multiDrawIndirect) {
+                m_stats.drawCallsLastFrame += (count + batch - 1) / batch;
+            } else {
+                m_stats.drawCallsLastFrame += count;
+            }
+        }
+        if (!m_drawIndirectCount && !m_multiDrawIndirect) {
+            bucketCount = (drawCount + DRAWS_PER_RECORDING_BUCKET - 1) / DRAWS_PER_RECORDING_BUCKET;
+        }
+
+        pass.RecordParallel(bucketCount, [&](uint32_t bucket, VkCommandBuffer cmd) {
+            // Every permutation shares the layout, so the sets stay bound across pipeline switches
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_drawLayout, 0, 1, &set, 0, nullptr);
+            m_context->GetBindlessRegistry()->Bind(cmd, m_drawLayout, 1);
+            const VkDeviceSize vertexOffset = 0;
+            vkCmdBindVertexBuffers(cmd, 0, 1, &m_vertexBuffer.buffer, &vertexOffset);
+            vkCmdBindIndexBuffer(cmd, m_indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+
+            // Slots this bucket records; the indirect paths record everything in one bucket
+            const uint32_t bucketFirst = bucket * DRAWS_PER_RECORDING_BUCKET;
+            const uint32_t bucketLast =
+                bucketCount > 1 ? std::min(bucketFirst + DRAWS_PER_RECORDING_BUCKET, drawCount) : drawCount;
+            for (uint32_t p = 0; p < GPU_GEOMETRY_PERMUTATIONS; p++) {
+                const uint32_t first = std::max(m_uniforms.permutationFirst[p], bucketFirst);
+                const uint32_t last =
+                    std::min(m_uniforms.permutationFirst[p] + m_uniforms.permutationCount[p], bucketLast);
+                if (first >= last || m_drawPipelines[p] == VK_NULL_HANDLE) {
+                    continue;
+                }
+                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_drawPipelines[p]);
+
+                if (m_drawIndirectCount) {
+                    // One call per permutation regardless of how many instances survive culling
+                    const uint32_t maxDraws = std::min(last - first, maxDrawIndirectCount);
+                    vkCmdDrawIndexedIndirectCount(cmd, commands, first * DRAW_COMMAND_SIZE, countBuffer,
+                                                  p * sizeof(uint32_t), maxDraws, stride);
+                } else if (m_multiDrawIndirect) {
+                    // One slot per instance; culled slots have instanceCount = 0
+                    for (uint32_t batchFirst = first; batchFirst < last; batchFirst += batch) {
+                        vkCmdDrawIndexedIndirect(cmd, commands, batchFirst * DRAW_COMMAND_SIZE,
+                                                 std::min(batch, last - batchFirst), stride);
+                    }
+                } else {
+                    for (uint32_t i = first; i < last; i++) {
+                        vkCmdDrawIndexedIndirect(cmd, commands, i * DRAW_COMMAND_SIZE, 1, stride);
+                    }
+                }
+            }
+        });
+    }
+
+    bool GpuDrivenRenderer::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, Buffer& out) {
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = usage;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+        // Pinned: descriptors and bindings reference these buffers every frame
+        return m_context->GetMemoryManager().CreateBuffer(MemoryCategory::Geometry, bufferInfo, allocInfo, out.buffer,
+                                                          out.allocation);
+    }
+
+    void GpuDrivenRenderer::DestroyBuffer(Buffer& buffer) {
+        if (buffer.buffer != VK_NULL_HANDLE) {
+            m_context->GetMemoryManager().DestroyBuffer(buffer.buffer, buffer.allocation);
+        }
+        buffer = {};
+    }
+
+    bool GpuDrivenRenderer::QueueMeshUpload(const PendingMesh& pending) {
+        VulkanUploadRing& uploadRing = m_context->GetUploadRing();
+        MeshState& mesh = m_meshes[pending.index];
+
+        // Parts already accepted keep their ticket; the rest are retried next frame
+        if (!mesh.tickets[0].IsValid()) {
+            mesh.tickets[0] = uploadRing.UploadBuffer(
+                m_vertexBuffer.buffer, static_cast<VkDeviceSize>(mesh.record.vertexOffset) * sizeof(GpuVertex),
+                pending.vertices.data(), pending.vertices.size() * sizeof(GpuVertex),
+                VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+        }
+        if (!mesh.tickets[1].IsValid()) {
+            mesh.tickets[1] = uploadRing.UploadBuffer(
+                m_indexBuffer.buffer, static_cast<VkDeviceSize>(mesh.record.firstIndex) * sizeof(uint32_t),
+                pending.indices.data(), pending.indices.size() * sizeof(uint32_t), VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                VK_ACCESS_INDEX_READ_BIT);
+        }
+        if (!mesh.tickets[2].IsValid()) {
+            mesh.tickets[2] = uploadRing.UploadBuffer(m_meshBuffer.buffer,
+                                                      static_cast<VkDeviceSize>(pending.index) * sizeof(GpuMesh),
+                                                      &mesh.record, sizeof(GpuMesh),
+                                                      VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+        }
+        mesh.queued = mesh.tickets[0].IsValid() && mesh.tickets[1].IsValid() && mesh.tickets[2].IsValid();
+        return mesh.queued;
+    }
+
+    void GpuDrivenRenderer::UpdateResidency() {
+        size_t queued = 0;
+        while (queued < m_pendingMeshes.size() && QueueMeshUpload(m_pendingMeshes[queued])) {
+            queued++;
+        }
+        m_pendingMeshes.erase(m_pendingMeshes.begin(), m_pendingMeshes.begin() + static_cast<std::ptrdiff_t>(queued));
+
+        const VulkanUploadRing& uploadRing = m_context->GetUploadRing();
+        while (m_residentMeshes < m_meshes.size()) {
+            const MeshState& mesh = m_meshes[m_residentMeshes];
+            if (!mesh.queued || !uploadRing.IsComplete(mesh.tickets[0]) || !uploadRing.IsComplete(mesh.tickets[1]) ||
+                !uploadRing.IsComplete(mesh.tickets[2])) {
+                break;
+            }
+            m_residentMeshes++;
+        }
+    }
+
+    void GpuDrivenRenderer::MarkDirty(uint32_t slot) {
+        if (!m_slotDirty[slot]) {
+            m_slotDirty[slot] = 1;
+            m_dirtySlots.push_back(slot);
+        }
+    }
+
+    uint32_t GpuDrivenRenderer::GetMaterialPermutation(uint32_t material) const {
+        BindlessMaterial record;
+        if (!m_context->GetBindlessRegistry()->GetMaterial(material, record)) {
+            return SHADER_FEATURE_NORMAL_MAP | SHADER_FEATURE_METALLIC_ROUGHNESS_MAP;
+        }
+        ShaderFeatures features = 0;
+        if (record.normalTexture != INVALID_BINDLESS_INDEX) {
+            features |= SHADER_FEATURE_NORMAL_MAP;
+        }
+        if (record.metallicRoughnessTexture != INVALID_BINDLESS_INDEX) {
+            features |= SHADER_FEATURE_METALLIC_ROUGHNESS_MAP;
+        }
+        return features;
+    }
+
+    void GpuDrivenRenderer::RefreshPermutations() {
+        // Instances share few materials; look each one up once
+        std::unordered_map<uint32_t, uint32_t> permutations;
+        for (uint32_t id = 0; id < m_idToSlot.size(); id++) {
+            if (m_idToSlot[id] == UINT32_MAX) {
+                continue;
+            }
+            const uint32_t material = m_instances[m_idToSlot[id]].material;
+            auto it = permutations.find(material);
+            if (it == permutations.end()) {
+                it = permutations.emplace(material, GetMaterialPermutation(material)).first;
+            }
+            if (it->second != m_instances[m_idToSlot[id]].permutation) {
+                SetInstanceMaterial(GpuInstanceHandle{ id }, material);
+            }
+        }
+    }
+
+    uint32_t GpuDrivenRenderer::InsertSlot(uint32_t permutation) {
+        // Open a slot at the end and walk it down to the end of the permutation's range: the
+        // first instance of each later range moves to that range's end
+        auto hole = static_cast<uint32_t>(m_instances.size());
+        m_instances.emplace_back();
+        m_slotToId.push_back(UINT32_MAX);
+        for (uint32_t p = GPU_GEOMETRY_PERMUTATIONS - 1; p > permutation; p--) {
+            const uint32_t first = m_permutationEnd[p - 1];
+            if (first != hole) {
+                MoveSlot(first, hole);
+            }
+            hole = first;
+            m_permutationEnd[p]++;
+        }
+        m_permutationEnd[permutation]++;
+        return hole;
+    }
+
+    void GpuDrivenRenderer::EraseSlot(uint32_t slot) {
+        // Fill the slot with the last instance of its range, then carry the hole up through the
+        // later ranges the same way, so at most one instance per permutation moves
+        uint32_t hole = slot;
+        for (uint32_t p = m_instances[slot].permutation; p < GPU_GEOMETRY_PERMUTATIONS; p++) {
+            const uint32_t last = m_permutationEnd[p] - 1;
+            if (last != hole) {
+                MoveSlot(last, hole);
+            }
+            hole = last;
+            m_permutationEnd[p]--;
+        }
+        m_instances.pop_back();
+        m_slotToId.pop_back();
+    }
+
+    void GpuDrivenRenderer::MoveSlot(uint32_t from, uint32_t to) {
+        m_instances[to] = m_instances[from];
+        m_slotToId[to] = m_slotToId[from];
+        m_idToSlot[m_slotToId[to]] = to;
+        MarkDirty(to);
+    }
+
+    uint32_t GpuDrivenRenderer::StageInstances(const FrameData& frame) {
+        m_copyRegions.clear();
+        if (m_dirtySlots.empty()) {
+            return 0;
+        }
+
+        // Lowest slots first, so newly added instances become drawable in order
+        std::sort(m_dirtySlots.begin(), m_dirtySlots.end());
+        const auto instanceCount = static_cast<uint32_t>(m_instances.size());
+        auto* staging = static_cast<GpuInstance*>(frame.stagingMapped);
+
+        uint32_t staged = 0;
+        size_t next = 0;
+        for (; next < m_dirtySlots.size() && staged < m_createInfo.instanceUploadsPerFrame; next++) {
+            const uint32_t slot = m_dirtySlots[next];
+            m_slotDirty[slot] = 0;
+            if (slot >= instanceCount) {
+                continue;  // Removed since it was marked
+            }
+            staging[staged] = m_instances[slot];
+
+            // Coalesce consecutive slots into one copy region
+            const VkDeviceSize srcOffset = static_cast<VkDeviceSize>(staged) * sizeof(GpuInstance);
+            const VkDeviceSize dstOffset = static_cast<VkDeviceSize>(slot) * sizeof(GpuInstance);
+            if (!m_copyRegions.empty() && m_copyRegions.back().srcOffset + m_copyRegions.back().size == srcOffset &&
+                m_copyRegions.back().dstOffset + m_copyRegions.back().size == dstOffset) {
+                m_copyRegions.back().size += sizeof(GpuInstance);
+            } else {
+                m_copyRegions.push_back({ srcOffset, dstOffset, sizeof(GpuInstance) });
+            }
+            staged++;
+        }
+        m_dirtySlots.erase(m_dirtySlots.begin(), m_dirtySlots.begin() + static_cast<std::ptrdiff_t>(next));
+
+        // Slots below the first never-uploaded one hold valid data on the GPU
+        const auto firstMissing = std::lower_bound(m_dirtySlots.begin(), m_dirtySlots.end(), m_uploadedSlots);
+        m_uploadedSlots = firstMissing == m_dirtySlots.end() ? instanceCount : std::min(*firstMissing, instanceCount);
+        return staged;
+    }
+
+} // namespace StellarAlia::Function::Graphics
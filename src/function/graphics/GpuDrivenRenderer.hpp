@@ -0,0 +1,352 @@
+#pragma once
+
+/**
+ * @file GpuDrivenRenderer.hpp
+ * @brief GPU-driven geometry submission: compute culling feeding indirect draws
+ *
+ * Meshes live in one shared vertex and index buffer, and instances (transform, mesh,
+ * material) in a storage buffer. Each frame a compute pass (gpu_culling.comp) frustum
+ * culls every instance and writes a VkDrawIndexedIndirectCommand per visible one, and
+ * the G-buffer pass consumes the stream with a single multi-draw indirect call. The CPU
+ * only uploads instances that changed, so its per-frame cost does not grow with the
+ * number of objects.
+ *
+ * Materials come from the bindless registry, so the context must be created with
+ * bindless enabled. Materials without a normal or metallic/roughness texture are drawn
+ * with a geometry shader permutation that skips it: instances are kept sorted by
+ * permutation, culling keeps each permutation's draws within its own range, and every
+ * range is drawn with its own pipeline.
+ *
+ * Only the Vulkan backend is implemented.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "function/graphics/DeferredRenderer.hpp"
+#include "function/graphics/PipelineManager.hpp"
+#include "function/graphics/RenderGraph.hpp"
+#include "function/graphics/vulkan/VulkanUploadRing.hpp"
+
+namespace StellarAlia::Function::Graphics {
+
+    class VulkanGraphicsContext;
+
+    /**
+     * @brief Geometry shader permutations: each combination of the normal and metallic/roughness maps
+     * A permutation's index is its ShaderFeatures mask.
+     */
+    constexpr uint32_t GPU_GEOMETRY_PERMUTATIONS = 4;
+
+    /**
+     * @brief Vertex layout of the shared vertex buffer (inputs of deferred_geometry*.vert)
+     */
+    struct GpuVertex {
+        float position[3] = {};
+        float normal[3] = {};
+        float texCoord[2] = {};
+        float tangent[3] = {};
+    };
+    static_assert(sizeof(GpuVertex) == 44, "GpuVertex must match the geometry vertex inputs");
+
+    /**
+     * @brief Per-instance record (std430, matches GpuInstance in gpu_scene.glsl)
+     */
+    struct GpuInstance {
+        float model[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                            0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };  // Column-major
+        float normalMatrix[12] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                                   0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };       // Three padded columns
+        uint32_t mesh = 0;
+        uint32_t material = 0;
+        uint32_t permutation = 0;  // Geometry permutation, derived from the material
+        uint32_t _pad = 0;
+    };
+    static_assert(sizeof(GpuInstance) == 128, "GpuInstance must match the std430 shader layout");
+
+    /**
+     * @brief Per-mesh record (std430, matches GpuMesh in gpu_scene.glsl)
+     */
+    struct GpuMesh {
+        float boundsCenter[3] = {};
+        float boundsRadius = 0.0f;
+        uint32_t indexCount = 0;
+        uint32_t firstIndex = 0;
+        int32_t vertexOffset = 0;
+        uint32_t _pad = 0;
+    };
+    static_assert(sizeof(GpuMesh) == 32, "GpuMesh must match the std430 shader layout");
+
+    /**
+     * @brief Scene uniforms shared by culling and drawing (std140, matches gpu_scene.glsl)
+     */
+    struct GpuSceneUniforms {
+        float viewProjection[16] = {};
+        float frustumPlanes[6][4] = {};
+        uint32_t instanceCount = 0;
+        uint32_t residentMeshCount = 0;
+        uint32_t compactDraws = 0;
+        uint32_t _pad = 0;
+        uint32_t permutationFirst[GPU_GEOMETRY_PERMUTATIONS] = {};  // Instance slots of each permutation
+        uint32_t permutationCount[GPU_GEOMETRY_PERMUTATIONS] = {};
+    };
+    static_assert(sizeof(GpuSceneUniforms) == 208, "GpuSceneUniforms must match the std140 shader layout");
+
+    /**
+     * @brief Handle to a mesh in the shared geometry buffers
+     */
+    struct GpuMeshHandle {
+        uint32_t index = UINT32_MAX;
+        bool IsValid() const { return index != UINT32_MAX; }
+    };
+
+    /**
+     * @brief Handle to an instance; stays valid until the instance is removed
+     */
+    struct GpuInstanceHandle {
+        uint32_t id = UINT32_MAX;
+        bool IsValid() const { return id != UINT32_MAX; }
+    };
+
+    /**
+     * @brief Indirect draw streams produced by the culling pass
+     */
+    struct GpuDrawResources {
+        RenderGraphResource instances;
+        RenderGraphResource drawCommands;
+        RenderGraphResource drawCount;  // One per permutation; only consumed when drawIndirectCount is enabled
+    };
+
+    /**
+     * @brief GPU-driven renderer creation parameters
+     */
+    struct GpuDrivenRendererCreateInfo {
+        uint32_t maxInstances = 262144;
+        uint32_t maxMeshes = 4096;
+        uint32_t maxVertices = 1u << 20;          // Shared vertex buffer capacity
+        uint32_t maxIndices = 4u << 20;           // Shared index buffer capacity (32-bit indices)
+        uint32_t instanceUploadsPerFrame = 32768; // Changed instances copied per frame; the rest wait
+    };
+
+    /**
+     * @brief GPU-driven renderer statistics
+     */
+    struct GpuDrivenStats {
+        uint32_t instances = 0;
+        uint32_t meshes = 0;
+        uint32_t residentMeshes = 0;          // Meshes whose uploads completed
+        uint32_t instancesUploadedLastFrame = 0;
+        uint32_t pendingInstanceUploads = 0;
+        uint32_t drawCallsLastFrame = 0;      // Indirect draw calls recorded by the CPU
+    };
+
+    /**
+     * @brief Owns the shared geometry, the instance buffer and the culling pipeline
+     *
+     * Not thread-safe; call from the render thread.
+     */
+    class GpuDrivenRenderer {
+    public:
+        GpuDrivenRenderer() = default;
+        ~GpuDrivenRenderer();
+
+        GpuDrivenRenderer(const GpuDrivenRenderer&) = delete;
+        GpuDrivenRenderer& operator=(const GpuDrivenRenderer&) = delete;
+
+        /**
+         * @brief Create the geometry, instance and mesh buffers and the culling pipeline
+         * @param context Vulkan context created with bindless enabled
+         * @param pipelines Pipeline manager
+         * @param createInfo Creation parameters
+         * @return True on success
+         */
+        bool Initialize(VulkanGraphicsContext& context, PipelineManager& pipelines,
+                        const GpuDrivenRendererCreateInfo& createInfo = {});
+
+        /**
+         * @brief Release resources (the GPU must be idle)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Append a mesh to the shared geometry buffers
+         * The data is uploaded through the upload ring; instances of the mesh are drawn
+         * once the upload has completed.
+         * @param vertices Vertices
+         * @param vertexCount Vertex count
+         * @param indices 32-bit indices relative to the first vertex
+         * @param indexCount Index count
+         * @return Mesh handle, invalid when the buffers are full
+         */
+        GpuMeshHandle AddMesh(const GpuVertex* vertices, uint32_t vertexCount, const uint32_t* indices,
+                              uint32_t indexCount);
+
+        /**
+         * @brief Add an instance
+         * @param mesh Mesh to draw
+         * @param model Column-major object-to-world matrix
+         * @param material Bindless material index
+         * @return Instance handle, invalid when the instance buffer is full
+         */
+        GpuInstanceHandle AddInstance(GpuMeshHandle mesh, const float (&model)[16], uint32_t material);
+
+        /**
+         * @brief Move an instance
+         * @param instance Instance handle
+         * @param model Column-major object-to-world matrix
+         */
+        void SetInstanceTransform(GpuInstanceHandle instance, const float (&model)[16]);
+
+        /**
+         * @brief Change an instance's material
+         * May move the instance to another geometry permutation. Texture changes made later
+         * through VulkanBindlessRegistry::UpdateMaterial are picked up on the next frame.
+         * @param instance Instance handle
+         * @param material Bindless material index
+         */
+        void SetInstanceMaterial(GpuInstanceHandle instance, uint32_t material);
+
+        /**
+         * @brief Remove an instance (the last instance takes its slot)
+         * @param instance Instance handle
+         */
+        void RemoveInstance(GpuInstanceHandle instance);
+
+        /**
+         * @brief Set the camera used for culling and drawing
+         * @param viewProjection Column-major view-projection matrix (Vulkan clip space)
+         */
+        void SetViewProjection(const float (&viewProjection)[16]);
+
+        /**
+         * @brief Declare the instance upload and culling passes
+         * @param graph Graph being built for this frame
+         * @return Draw streams for the geometry pass
+         */
+        GpuDrawResources AddCullingPasses(RenderGraph& graph);
+
+        /**
+         * @brief Declare the geometry pass's reads of the draw streams
+         * @param builder Builder of the geometry pass
+         * @param draws Resources returned by AddCullingPasses
+         */
+        void DeclareDrawReads(RenderGraphBuilder& builder, const GpuDrawResources& draws) const;
+
+        /**
+         * @brief Record the indirect draws into the geometry pass
+         * Records through RenderGraphPassContext::RecordParallel, so the geometry pass may be
+         * declared with SetParallelRecording.
+         * @param pass Geometry pass context
+         * @param draws Resources returned by AddCullingPasses
+         * @param layout G-buffer layout the pass writes
+         */
+        void RecordDraws(RenderGraphPassContext& pass, const GpuDrawResources& draws, GBufferLayout layout);
+
+        /**
+         * @brief Get statistics
+         * @return Counters
+         */
+        const GpuDrivenStats& GetStats() const { return m_stats; }
+
+    private:
+        struct FrameData {
+            VkBuffer uniformBuffer = VK_NULL_HANDLE;
+            VmaAllocation uniformAllocation = VK_NULL_HANDLE;
+            void* uniformsMapped = nullptr;
+            VkBuffer stagingBuffer = VK_NULL_HANDLE;  // Changed instances, copied by the upload pass
+            VmaAllocation stagingAllocation = VK_NULL_HANDLE;
+            void* stagingMapped = nullptr;
+        };
+
+        struct PendingMesh {
+            uint32_t index = 0;
+            std::vector<GpuVertex> vertices;
+            std::vector<uint32_t> indices;
+        };
+
+        struct MeshState {
+            GpuMesh record;
+            UploadTicket tickets[3];  // Vertices, indices, record
+            bool queued = false;      // All three uploads were accepted by the ring
+        };
+
+        struct Buffer {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VmaAllocation allocation = VK_NULL_HANDLE;
+        };
+
+        VulkanGraphicsContext* m_context = nullptr;
+        PipelineManager* m_pipelines = nullptr;
+        VkDevice m_device = VK_NULL_HANDLE;
+        GpuDrivenRendererCreateInfo m_createInfo;
+        bool m_drawIndirectCount = false;
+        bool m_multiDrawIndirect = false;
+
+        Buffer m_vertexBuffer;
+        Buffer m_indexBuffer;
+        Buffer m_meshBuffer;
+        Buffer m_instanceBuffer;
+        std::vector<FrameData> m_frames;
+        uint32_t m_vertexCount = 0;
+        uint32_t m_indexCount = 0;
+
+        std::vector<MeshState> m_meshes;
+        std::vector<PendingMesh> m_pendingMeshes;  // Uploads deferred by the ring's frame budget
+        uint32_t m_residentMeshes = 0;
+
+        // Dense instance array; handles map to slots so removal can swap in the last one
+        std::vector<GpuInstance> m_instances;
+        std::vector<uint32_t> m_slotToId;
+        std::vector<uint32_t> m_idToSlot;
+        std::vector<uint32_t> m_freeIds;
+        std::vector<uint8_t> m_slotDirty;
+        std::vector<uint32_t> m_dirtySlots;
+        std::vector<VkBufferCopy> m_copyRegions;  // Recorded by this frame's upload pass
+        uint32_t m_uploadedSlots = 0;             // Prefix of slots whose data reached the GPU
+
+        GpuSceneUniforms m_uniforms;
+        GpuDrawResources m_draws;  // Filled by pass setup, read by the execute callbacks
+
+        VkDescriptorSetLayout m_cullingSetLayout = VK_NULL_HANDLE;  // Owned by the layout cache
+        VkPipelineLayout m_cullingLayout = VK_NULL_HANDLE;          // Owned by the pipeline manager
+        VkPipeline m_cullingPipeline = VK_NULL_HANDLE;
+        VkDescriptorSetLayout m_drawSetLayout = VK_NULL_HANDLE;
+        VkPipelineLayout m_drawLayout = VK_NULL_HANDLE;
+
+        // Instances sorted by permutation: permutation p owns slots [m_permutationEnd[p - 1], m_permutationEnd[p])
+        std::array<uint32_t, GPU_GEOMETRY_PERMUTATIONS> m_permutationEnd{};
+
+        // Rebuilt only when the graph hands out a different render pass; each permutation's
+        // pipeline is built the first time the permutation is drawn
+        GraphicsPipelineDesc m_drawDesc;
+        VkRenderPass m_drawRenderPass = VK_NULL_HANDLE;
+        std::array<VkPipeline, GPU_GEOMETRY_PERMUTATIONS> m_drawPipelines{};
+        uint32_t m_pipelineGeneration = 0;  // PipelineManager generation the pipelines were fetched at
+        uint64_t m_materialGeneration = 0;  // Bindless material generation the permutations reflect
+
+        GpuDrivenStats m_stats;
+
+        bool CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage, Buffer& out);
+        void DestroyBuffer(Buffer& buffer);
+        bool QueueMeshUpload(const PendingMesh& mesh);
+        void UpdateResidency();
+        void MarkDirty(uint32_t slot);
+        uint32_t GetMaterialPermutation(uint32_t material) const;
+        void RefreshPermutations();
+        uint32_t InsertSlot(uint32_t permutation);
+        void EraseSlot(uint32_t slot);
+        void MoveSlot(uint32_t from, uint32_t to);
+        uint32_t StageInstances(const FrameData& frame);
+        void RecordCulling(RenderGraphPassContext& pass, const GpuDrawResources& draws);
+    };
+
+} // namespace StellarAlia::Function::Graphics
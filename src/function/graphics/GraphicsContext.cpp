@@ -5,6 +5,31 @@
 
 namespace StellarAlia::Function::Graphics {
 
+    bool ParsePresentMode(std::string_view name, PresentMode& outMode) {
+        if (name == "fifo") {
+            outMode = PresentMode::Fifo;
+        } else if (name == "fifo_relaxed") {
+            outMode = PresentMode::FifoRelaxed;
+        } else if (name == "mailbox") {
+            outMode = PresentMode::Mailbox;
+        } else if (name == "immediate") {
+            outMode = PresentMode::Immediate;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    const char* PresentModeToString(PresentMode mode) {
+        switch (mode) {
+            case PresentMode::Fifo:        return "fifo";
+            case PresentMode::FifoRelaxed: return "fifo_relaxed";
+            case PresentMode::Mailbox:     return "mailbox";
+            case PresentMode::Immediate:   return "immediate";
+        }
+        return "unknown";
+    }
+
     std::unique_ptr<GraphicsContext> CreateGraphicsContext(const GraphicsContextCreateInfo& createInfo) {
         switch (createInfo.api) {
             case GraphicsAPI::Vulkan:
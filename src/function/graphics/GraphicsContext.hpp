@@ -12,6 +12,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <string_view>
 
 namespace StellarAlia::Function::Graphics {
 
@@ -27,6 +29,41 @@ namespace StellarAlia::Function::Graphics {
         Metal
     };
 
+    /**
+     * @brief Swapchain presentation modes
+     */
+    enum class PresentMode {
+        Fifo = 0,     // V-synced queue; always supported
+        FifoRelaxed,  // V-synced, but late frames tear instead of waiting a full interval
+        Mailbox,      // V-synced, newest frame replaces queued ones (low latency, no tearing)
+        Immediate     // No v-sync; lowest latency, may tear
+    };
+
+    /**
+     * @brief Presentation and pacing controls, adjustable at runtime
+     */
+    struct PresentPolicy {
+        PresentMode mode = PresentMode::Fifo;
+        uint32_t imageCount = 0;       // Swapchain images; 0 = surface minimum + 1
+        uint32_t maxQueuedFrames = 0;  // Frames the CPU may queue ahead of the GPU; 0 = frames in flight
+        float targetFrameRate = 0.0f;  // CPU-side frame cap in Hz; 0 = uncapped
+    };
+
+    /**
+     * @brief Parse a present mode name (fifo, fifo_relaxed, mailbox, immediate)
+     * @param name Mode name, case-sensitive
+     * @param outMode Receives the parsed mode on success
+     * @return True if the name was recognized
+     */
+    bool ParsePresentMode(std::string_view name, PresentMode& outMode);
+
+    /**
+     * @brief Get the config name of a present mode
+     * @param mode Present mode
+     * @return Name accepted by ParsePresentMode
+     */
+    const char* PresentModeToString(PresentMode mode);
+
     // Forward declaration
     namespace Window {
         class WindowSystem;
@@ -39,6 +76,27 @@ namespace StellarAlia::Function::Graphics {
         GraphicsAPI api = GraphicsAPI::Vulkan;
         bool enableValidation = true;
         std::shared_ptr<WindowSystem> window = nullptr;  // Abstract window system interface
+        bool headless = false;  // Render into offscreen images; no window, surface or swapchain
+        uint32_t width = 1280;  // Offscreen resolution, used when headless without a window
+        uint32_t height = 720;
+        uint32_t framesInFlight = 2;  // Frames the CPU may record ahead of the GPU
+        PresentPolicy presentPolicy;
+        bool allowTimelineSemaphores = true;  // Use timeline semaphores when the device supports them
+        uint64_t uploadRingSize = 64ull * 1024 * 1024;       // Staging ring for asynchronous uploads
+        uint64_t uploadBudgetPerFrame = 16ull * 1024 * 1024; // Upload bytes accepted per frame; 0 = unlimited
+        std::string preferredDevice;  // GPU name substring or device UUID; empty = highest-scoring device
+        bool enableBindless = false;  // Global texture array + material buffer when descriptor indexing is available
+        uint32_t recordingThreads = 1;  // Threads that may record secondary command buffers (one pool each per frame)
+    };
+
+    /**
+     * @brief Per-frame timing statistics reported by a graphics context
+     */
+    struct FrameStats {
+        uint64_t frameNumber = 0;             // Frames submitted since initialization
+        double cpuFrameTimeMs = 0.0;          // Wall time between the last two presents
+        double swapchainRecreateMs = 0.0;     // Part of the last frame spent recreating the swapchain
+        uint32_t swapchainRecreateCount = 0;  // Recreations since initialization
     };
 
     /**
@@ -95,6 +153,12 @@ namespace StellarAlia::Function::Graphics {
          */
         virtual bool IsInitialized() const = 0;
 
+        /**
+         * @brief Check if the context renders offscreen without a presentation surface
+         * @return True if headless, false otherwise
+         */
+        virtual bool IsHeadless() const = 0;
+
         /**
          * @brief Get the swapchain width
          * @return Width in pixels
@@ -114,6 +178,25 @@ namespace StellarAlia::Function::Graphics {
          */
         virtual void Resize(uint32_t width, uint32_t height) = 0;
 
+        /**
+         * @brief Get timing statistics of the most recently presented frame
+         * @return Frame statistics
+         */
+        virtual const FrameStats& GetFrameStats() const = 0;
+
+        /**
+         * @brief Change present mode, swapchain image count, latency limit and frame cap
+         * Swapchain-affecting changes are applied by the next BeginFrame.
+         * @param policy New presentation policy
+         */
+        virtual void SetPresentPolicy(const PresentPolicy& policy) = 0;
+
+        /**
+         * @brief Get the active presentation policy
+         * @return Presentation policy as requested (the device may fall back to FIFO)
+         */
+        virtual const PresentPolicy& GetPresentPolicy() const = 0;
+
     protected:
         GraphicsContext() = default;
         GraphicsContext(const GraphicsContext&) = delete;
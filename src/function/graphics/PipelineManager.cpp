@@ -0,0 +1,842 @@
+#include "function/graphics/PipelineManager.hpp"
+#include "function/graphics/vulkan/VulkanGraphicsContext.hpp"
+#include "core/utils/Hash.hpp"
+#include "core/logs/Log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+namespace StellarAlia::Function::Graphics {
+
+    namespace {
+        constexpr uint32_t CACHE_MAGIC = 0x43504153;  // "SAPC"
+        constexpr uint32_t CACHE_VERSION = 1;
+        constexpr const char* PERMUTATION_USAGE_HEADER = "# StellarAlia shader permutation usage v1";
+
+        /**
+         * @brief Header written in front of the driver's pipeline cache blob
+         *
+         * The driver validates its own blob too, but some drivers crash or silently
+         * recompile on stale data, so we refuse it before it reaches the driver.
+         */
+        struct PipelineCacheFileHeader {
+            uint32_t magic = CACHE_MAGIC;
+            uint32_t version = CACHE_VERSION;
+            uint32_t vendorID = 0;
+            uint32_t deviceID = 0;
+            uint32_t driverVersion = 0;
+            uint32_t reserved = 0;
+            uint8_t pipelineCacheUUID[VK_UUID_SIZE] = {};
+            uint64_t dataSize = 0;
+            uint64_t dataHash = 0;
+        };
+
+        PipelineCacheFileHeader MakeHeader(const DeviceCapabilities& caps) {
+            PipelineCacheFileHeader header;
+            header.vendorID = caps.vendorID;
+            header.deviceID = caps.deviceID;
+            header.driverVersion = caps.driverVersion;
+            std::memcpy(header.pipelineCacheUUID, caps.pipelineCacheUUID, VK_UUID_SIZE);
+            return header;
+        }
+
+        void HashStage(uint64_t& hash, const ShaderStageDesc& stage) {
+            Core::Hash::Combine(hash, stage.stage);
+            Core::Hash::Combine(hash, stage.path);
+            Core::Hash::Combine(hash, stage.entryPoint);
+        }
+
+        // Names the shaders a permutation belongs to; built from paths only, so it is stable across runs
+        uint64_t HashStages(const std::vector<ShaderStageDesc>& stages) {
+            uint64_t hash = Core::Hash::FNV_OFFSET_BASIS;
+            Core::Hash::Combine(hash, stages.size());
+            for (const auto& stage : stages) {
+                HashStage(hash, stage);
+            }
+            return hash;
+        }
+
+        /**
+         * @brief Specialization constants of a permutation: one VkBool32 per feature bit
+         * Shared by every stage of the pipeline; constants a stage does not declare are ignored.
+         */
+        struct FeatureSpecialization {
+            std::array<VkBool32, SHADER_FEATURE_COUNT> values{};
+            std::array<VkSpecializationMapEntry, SHADER_FEATURE_COUNT> entries{};
+            VkSpecializationInfo info{};
+
+            explicit FeatureSpecialization(ShaderFeatures features) {
+                for (uint32_t i = 0; i < SHADER_FEATURE_COUNT; i++) {
+                    values[i] = (features >> i) & 1u ? VK_TRUE : VK_FALSE;
+                    entries[i] = { i, i * static_cast<uint32_t>(sizeof(VkBool32)), sizeof(VkBool32) };
+                }
+                info.mapEntryCount = SHADER_FEATURE_COUNT;
+                info.pMapEntries = entries.data();
+                info.dataSize = sizeof(values);
+                info.pData = values.data();
+            }
+
+            FeatureSpecialization(const FeatureSpecialization&) = delete;
+            FeatureSpecialization& operator=(const FeatureSpecialization&) = delete;
+        };
+
+        uint64_t HashLayout(const std::vector<VkDescriptorSetLayout>& setLayouts,
+                            const std::vector<VkPushConstantRange>& pushConstants) {
+            uint64_t hash = Core::Hash::FNV_OFFSET_BASIS;
+            Core::Hash::Combine(hash, setLayouts.size());
+            for (VkDescriptorSetLayout setLayout : setLayouts) {
+                Core::Hash::Combine(hash, setLayout);
+            }
+            Core::Hash::Combine(hash, pushConstants.size());
+            for (const auto& range : pushConstants) {
+                Core::Hash::Combine(hash, range.stageFlags);
+                Core::Hash::Combine(hash, range.offset);
+                Core::Hash::Combine(hash, range.size);
+            }
+            return hash;
+        }
+
+        bool SameRanges(const std::vector<VkPushConstantRange>& a, const std::vector<VkPushConstantRange>& b) {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < a.size(); i++) {
+                if (a[i].stageFlags != b[i].stageFlags || a[i].offset != b[i].offset || a[i].size != b[i].size) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        double ElapsedMs(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    uint64_t HashPipelineDesc(const GraphicsPipelineDesc& desc) {
+        uint64_t hash = Core::Hash::FNV_OFFSET_BASIS;
+        Core::Hash::Combine(hash, desc.stages.size());
+        for (const auto& stage : desc.stages) {
+            HashStage(hash, stage);
+        }
+        Core::Hash::Combine(hash, desc.vertexBindings.size());
+        for (const auto& binding : desc.vertexBindings) {
+            Core::Hash::Combine(hash, binding.binding);
+            Core::Hash::Combine(hash, binding.stride);
+            Core::Hash::Combine(hash, binding.inputRate);
+        }
+        Core::Hash::Combine(hash, desc.vertexAttributes.size());
+        for (const auto& attribute : desc.vertexAttributes) {
+            Core::Hash::Combine(hash, attribute.location);
+            Core::Hash::Combine(hash, attribute.binding);
+            Core::Hash::Combine(hash, attribute.format);
+            Core::Hash::Combine(hash, attribute.offset);
+        }
+        Core::Hash::Combine(hash, desc.topology);
+        Core::Hash::Combine(hash, desc.polygonMode);
+        Core::Hash::Combine(hash, desc.cullMode);
+        Core::Hash::Combine(hash, desc.frontFace);
+        Core::Hash::Combine(hash, desc.samples);
+        Core::Hash::Combine(hash, desc.depthTest);
+        Core::Hash::Combine(hash, desc.depthWrite);
+        Core::Hash::Combine(hash, desc.depthCompare);
+        Core::Hash::Combine(hash, desc.blendEnable.size());
+        hash = Core::Hash::Fnv1a(desc.blendEnable.data(), desc.blendEnable.size(), hash);
+        Core::Hash::Combine(hash, desc.layout);
+        Core::Hash::Combine(hash, desc.renderPass);
+        Core::Hash::Combine(hash, desc.subpass);
+        Core::Hash::Combine(hash, desc.features);
+        return hash;
+    }
+
+    uint64_t HashPipelineDesc(const ComputePipelineDesc& desc) {
+        uint64_t hash = Core::Hash::FNV_OFFSET_BASIS;
+        HashStage(hash, desc.stage);
+        Core::Hash::Combine(hash, desc.layout);
+        Core::Hash::Combine(hash, desc.features);
+        return hash;
+    }
+
+    PipelineManager::~PipelineManager() {
+        Shutdown();
+    }
+
+    bool PipelineManager::Initialize(VulkanGraphicsContext& context, const PipelineManagerCreateInfo& createInfo) {
+        if (m_device != VK_NULL_HANDLE) {
+            SA_LOG_WARN("PipelineManager already initialized");
+            return false;
+        }
+        if (context.GetDevice() == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("PipelineManager requires an initialized Vulkan context");
+            return false;
+        }
+
+        m_context = &context;
+        m_device = context.GetDevice();
+        m_cachePath = createInfo.cachePath;
+        m_permutationUsagePath = createInfo.permutationUsagePath;
+        m_stats = {};
+
+        ShaderLibraryCreateInfo shaderInfo;
+        shaderInfo.spirvDirectory = createInfo.shaderDirectory;
+        shaderInfo.sourceDirectory = createInfo.shaderSourceDirectory;
+        if (!createInfo.shaderSourceDirectory.empty()) {
+            // Same include path as CompileShaders.cmake
+            shaderInfo.includeDirectories = { createInfo.shaderSourceDirectory / "include" };
+        }
+        shaderInfo.compilerPath = createInfo.shaderCompiler;
+        shaderInfo.hotReload = createInfo.hotReloadShaders;
+        if (!m_shaderLibrary.Initialize(context, shaderInfo)) {
+            m_device = VK_NULL_HANDLE;
+            m_context = nullptr;
+            return false;
+        }
+
+        std::vector<char> initialData = LoadCacheFile();
+
+        VkPipelineCacheCreateInfo cacheInfo{};
+        cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        cacheInfo.initialDataSize = initialData.size();
+        cacheInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+        VkResult result = vkCreatePipelineCache(m_device, &cacheInfo, nullptr, &m_pipelineCache);
+        if (result != VK_SUCCESS && !initialData.empty()) {
+            SA_LOG_WARN("Driver rejected the on-disk pipeline cache (VkResult {}); starting empty",
+                        static_cast<int>(result));
+            cacheInfo.initialDataSize = 0;
+            cacheInfo.pInitialData = nullptr;
+            m_stats.cacheLoaded = false;
+            m_stats.cacheLoadedBytes = 0;
+            result = vkCreatePipelineCache(m_device, &cacheInfo, nullptr, &m_pipelineCache);
+        }
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create pipeline cache (VkResult {})", static_cast<int>(result));
+            m_shaderLibrary.Shutdown();
+            m_device = VK_NULL_HANDLE;
+            m_context = nullptr;
+            return false;
+        }
+
+        if (m_stats.cacheLoaded) {
+            SA_LOG_INFO("Pipeline cache loaded from {} ({} bytes)", m_cachePath.string(), m_stats.cacheLoadedBytes);
+        }
+        LoadPermutationUsage();
+        return true;
+    }
+
+    void PipelineManager::Shutdown() {
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        SaveCache();
+        SavePermutationUsage();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SA_LOG_INFO("Pipelines: {} created ({} prewarmed), {} deduplicated, {:.2f} ms compiling",
+                    m_stats.pipelinesCreated, m_stats.permutationsPrewarmed, m_stats.deduplicatedRequests,
+                    m_stats.compileTimeMs);
+
+        for (auto& [hash, bucket] : m_graphicsPipelines) {
+            for (auto& entry : bucket) {
+                vkDestroyPipeline(m_device, entry.pipeline, nullptr);
+            }
+        }
+        for (auto& [hash, bucket] : m_computePipelines) {
+            for (auto& entry : bucket) {
+                vkDestroyPipeline(m_device, entry.pipeline, nullptr);
+            }
+        }
+        for (auto& [hash, bucket] : m_layouts) {
+            for (auto& entry : bucket) {
+                vkDestroyPipelineLayout(m_device, entry.layout, nullptr);
+            }
+        }
+        m_graphicsPipelines.clear();
+        m_computePipelines.clear();
+        m_layouts.clear();
+        m_permutationUses.clear();
+        m_shaderLibrary.Shutdown();
+
+        if (m_pipelineCache != VK_NULL_HANDLE) {
+            vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+            m_pipelineCache = VK_NULL_HANDLE;
+        }
+
+        m_device = VK_NULL_HANDLE;
+        m_context = nullptr;
+    }
+
+    VkPipeline PipelineManager::GetGraphicsPipeline(const GraphicsPipelineDesc& desc) {
+        const uint64_t hash = HashPipelineDesc(desc);
+        for (;;) {
+            uint32_t generation = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_device == VK_NULL_HANDLE) {
+                    return VK_NULL_HANDLE;
+                }
+                auto it = m_graphicsPipelines.find(hash);
+                if (it != m_graphicsPipelines.end()) {
+                    for (const auto& entry : it->second) {
+                        if (entry.desc == desc) {
+                            m_stats.deduplicatedRequests++;
+                            return entry.pipeline;
+                        }
+                    }
+                }
+                generation = m_generation.load(std::memory_order_relaxed);
+            }
+
+            // Compile outside the lock so worker threads can build different pipelines concurrently
+            VkPipeline pipeline = CreateGraphicsPipeline(desc);
+            if (pipeline == VK_NULL_HANDLE) {
+                return VK_NULL_HANDLE;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_generation.load(std::memory_order_relaxed) != generation) {
+                // A reload replaced shader modules mid-compile; the result may be built from the old ones
+                vkDestroyPipeline(m_device, pipeline, nullptr);
+                continue;
+            }
+            auto& bucket = m_graphicsPipelines[hash];
+            for (const auto& entry : bucket) {
+                if (entry.desc == desc) {
+                    // Another thread won the race; keep its pipeline
+                    vkDestroyPipeline(m_device, pipeline, nullptr);
+                    m_stats.deduplicatedRequests++;
+                    return entry.pipeline;
+                }
+            }
+            bucket.push_back({ desc, pipeline });
+            return pipeline;
+        }
+    }
+
+    VkPipeline PipelineManager::GetComputePipeline(const ComputePipelineDesc& desc) {
+        const uint64_t hash = HashPipelineDesc(desc);
+        for (;;) {
+            uint32_t generation = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_device == VK_NULL_HANDLE) {
+                    return VK_NULL_HANDLE;
+                }
+                auto it = m_computePipelines.find(hash);
+                if (it != m_computePipelines.end()) {
+                    for (const auto& entry : it->second) {
+                        if (entry.desc == desc) {
+                            m_stats.deduplicatedRequests++;
+                            return entry.pipeline;
+                        }
+                    }
+                }
+                generation = m_generation.load(std::memory_order_relaxed);
+            }
+
+            VkPipeline pipeline = CreateComputePipeline(desc);
+            if (pipeline == VK_NULL_HANDLE) {
+                return VK_NULL_HANDLE;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_generation.load(std::memory_order_relaxed) != generation) {
+                // A reload replaced shader modules mid-compile; the result may be built from the old ones
+                vkDestroyPipeline(m_device, pipeline, nullptr);
+                continue;
+            }
+            auto& bucket = m_computePipelines[hash];
+            for (const auto& entry : bucket) {
+                if (entry.desc == desc) {
+                    vkDestroyPipeline(m_device, pipeline, nullptr);
+                    m_stats.deduplicatedRequests++;
+                    return entry.pipeline;
+                }
+            }
+            bucket.push_back({ desc, pipeline });
+            return pipeline;
+        }
+    }
+
+    VkPipelineLayout PipelineManager::GetPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts,
+                                                        const std::vector<VkPushConstantRange>& pushConstants) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_device == VK_NULL_HANDLE) {
+            return VK_NULL_HANDLE;
+        }
+
+        const uint64_t hash = HashLayout(setLayouts, pushConstants);
+        auto& bucket = m_layouts[hash];
+        for (const auto& entry : bucket) {
+            if (entry.setLayouts == setLayouts && SameRanges(entry.pushConstants, pushConstants)) {
+                return entry.layout;
+            }
+        }
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+        layoutInfo.pSetLayouts = setLayouts.data();
+        layoutInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstants.size());
+        layoutInfo.pPushConstantRanges = pushConstants.data();
+
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        VkResult result = vkCreatePipelineLayout(m_device, &layoutInfo, nullptr, &layout);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create pipeline layout (VkResult {})", static_cast<int>(result));
+            return VK_NULL_HANDLE;
+        }
+
+        bucket.push_back({ setLayouts, pushConstants, layout });
+        return layout;
+    }
+
+    bool PipelineManager::SaveCache() {
+        if (m_device == VK_NULL_HANDLE || m_pipelineCache == VK_NULL_HANDLE || m_cachePath.empty()) {
+            return false;
+        }
+
+        size_t dataSize = 0;
+        if (vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) {
+            return false;
+        }
+        std::vector<char> data(dataSize);
+        if (vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, data.data()) != VK_SUCCESS) {
+            SA_LOG_WARN("Failed to read pipeline cache data");
+            return false;
+        }
+        data.resize(dataSize);
+
+        PipelineCacheFileHeader header = MakeHeader(m_context->GetDeviceCapabilities());
+        header.dataSize = dataSize;
+        header.dataHash = Core::Hash::Fnv1a(data.data(), data.size());
+
+        std::error_code ec;
+        if (m_cachePath.has_parent_path()) {
+            std::filesystem::create_directories(m_cachePath.parent_path(), ec);
+        }
+
+        // Write to a temporary file and rename so a crash never leaves a truncated cache
+        std::filesystem::path tempPath = m_cachePath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                SA_LOG_WARN("Cannot write pipeline cache to {}", tempPath.string());
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!file.good()) {
+                SA_LOG_WARN("Failed writing pipeline cache to {}", tempPath.string());
+                file.close();
+                std::filesystem::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempPath, m_cachePath, ec);
+        if (ec) {
+            SA_LOG_WARN("Failed to replace pipeline cache {}: {}", m_cachePath.string(), ec.message());
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        SA_LOG_INFO("Pipeline cache saved to {} ({} bytes)", m_cachePath.string(), dataSize);
+        return true;
+    }
+
+    void PipelineManager::RecordPermutationUse(const GraphicsPipelineDesc& desc, uint64_t uses) {
+        const uint64_t stages = HashStages(desc.stages);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_permutationUses[stages][desc.features] += uses;
+    }
+
+    std::vector<ShaderFeatures> PipelineManager::GetHotPermutations(const GraphicsPipelineDesc& desc,
+                                                                    uint32_t maxPermutations) const {
+        std::vector<std::pair<ShaderFeatures, uint64_t>> ranked;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_permutationUses.find(HashStages(desc.stages));
+            if (it == m_permutationUses.end()) {
+                return {};
+            }
+            ranked.assign(it->second.begin(), it->second.end());
+        }
+
+        std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        std::vector<ShaderFeatures> permutations;
+        for (size_t i = 0; i < ranked.size() && i < maxPermutations; i++) {
+            permutations.push_back(ranked[i].first);
+        }
+        return permutations;
+    }
+
+    uint32_t PipelineManager::PrewarmPermutations(const GraphicsPipelineDesc& desc, uint32_t maxPermutations) {
+        const auto isBuilt = [this](const GraphicsPipelineDesc& permutation) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_graphicsPipelines.find(HashPipelineDesc(permutation));
+            return it != m_graphicsPipelines.end() &&
+                   std::any_of(it->second.begin(), it->second.end(),
+                               [&](const Entry<GraphicsPipelineDesc>& entry) { return entry.desc == permutation; });
+        };
+
+        uint32_t ready = 0;
+        GraphicsPipelineDesc permutation = desc;
+        for (ShaderFeatures features : GetHotPermutations(desc, maxPermutations)) {
+            permutation.features = features;
+            if (isBuilt(permutation)) {
+                ready++;
+            } else if (GetGraphicsPipeline(permutation) != VK_NULL_HANDLE) {
+                ready++;
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stats.permutationsPrewarmed++;
+            }
+        }
+        return ready;
+    }
+
+    bool PipelineManager::ReloadShaders() {
+        const std::vector<std::string> changed = m_shaderLibrary.Reload();
+        if (changed.empty()) {
+            return false;
+        }
+
+        const auto usesChanged = [&changed](const ShaderStageDesc& stage) {
+            return std::find(changed.begin(), changed.end(), stage.path) != changed.end();
+        };
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint32_t dropped = 0;
+        const auto drop = [&](VkPipeline pipeline) {
+            m_context->DeferDestruction([device = m_device, pipeline]() {
+                vkDestroyPipeline(device, pipeline, nullptr);
+            });
+            dropped++;
+        };
+        for (auto& [hash, bucket] : m_graphicsPipelines) {
+            std::erase_if(bucket, [&](const Entry<GraphicsPipelineDesc>& entry) {
+                const bool stale = std::any_of(entry.desc.stages.begin(), entry.desc.stages.end(), usesChanged);
+                if (stale) {
+                    drop(entry.pipeline);
+                }
+                return stale;
+            });
+        }
+        for (auto& [hash, bucket] : m_computePipelines) {
+            std::erase_if(bucket, [&](const Entry<ComputePipelineDesc>& entry) {
+                const bool stale = usesChanged(entry.desc.stage);
+                if (stale) {
+                    drop(entry.pipeline);
+                }
+                return stale;
+            });
+        }
+
+        m_stats.pipelinesReloaded += dropped;
+        m_generation.fetch_add(1, std::memory_order_release);
+        SA_LOG_INFO("{} shaders reloaded; {} pipelines will be rebuilt", changed.size(), dropped);
+        return true;
+    }
+
+    PipelineStats PipelineManager::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    std::vector<char> PipelineManager::LoadCacheFile() {
+        if (m_cachePath.empty()) {
+            return {};
+        }
+
+        std::ifstream file(m_cachePath, std::ios::binary);
+        if (!file.is_open()) {
+            return {};
+        }
+
+        PipelineCacheFileHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            SA_LOG_WARN("Pipeline cache {} is truncated; ignoring it", m_cachePath.string());
+            return {};
+        }
+
+        const PipelineCacheFileHeader expected = MakeHeader(m_context->GetDeviceCapabilities());
+        if (header.magic != expected.magic || header.version != expected.version) {
+            SA_LOG_WARN("Pipeline cache {} has an unknown format; ignoring it", m_cachePath.string());
+            return {};
+        }
+        if (header.vendorID != expected.vendorID || header.deviceID != expected.deviceID ||
+            header.driverVersion != expected.driverVersion ||
+            std::memcmp(header.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+            SA_LOG_INFO("Pipeline cache {} was built for a different device or driver; rebuilding",
+                        m_cachePath.string());
+            return {};
+        }
+
+        // Size the buffer from the header only once the file is known to hold that many bytes
+        std::error_code error;
+        const uintmax_t fileSize = std::filesystem::file_size(m_cachePath, error);
+        if (error || fileSize < sizeof(header) || header.dataSize > fileSize - sizeof(header)) {
+            SA_LOG_WARN("Pipeline cache {} is truncated; ignoring it", m_cachePath.string());
+            return {};
+        }
+
+        std::vector<char> data(static_cast<size_t>(header.dataSize));
+        if (!file.read(data.data(), static_cast<std::streamsize>(data.size())) ||
+            Core::Hash::Fnv1a(data.data(), data.size()) != header.dataHash) {
+            SA_LOG_WARN("Pipeline cache {} is corrupt; ignoring it", m_cachePath.string());
+            return {};
+        }
+
+        m_stats.cacheLoaded = true;
+        m_stats.cacheLoadedBytes = data.size();
+        return data;
+    }
+
+    void PipelineManager::LoadPermutationUsage() {
+        if (m_permutationUsagePath.empty()) {
+            return;
+        }
+        std::ifstream file(m_permutationUsagePath);
+        if (!file.is_open()) {
+            return;
+        }
+
+        std::string header;
+        if (!std::getline(file, header) || header != PERMUTATION_USAGE_HEADER) {
+            SA_LOG_WARN("Permutation usage {} has an unknown format; ignoring it", m_permutationUsagePath.string());
+            return;
+        }
+
+        // Halve the previous runs' counts so permutations that fell out of use age out
+        uint64_t stages = 0;
+        ShaderFeatures features = 0;
+        uint64_t uses = 0;
+        size_t loaded = 0;
+        while (file >> std::hex >> stages >> features >> std::dec >> uses) {
+            if (uses / 2 != 0) {
+                m_permutationUses[stages][features] += uses / 2;
+                loaded++;
+            }
+        }
+        if (loaded != 0) {
+            SA_LOG_INFO("Shader permutation usage loaded from {} ({} permutations)", m_permutationUsagePath.string(),
+                        loaded);
+        }
+    }
+
+    bool PipelineManager::SavePermutationUsage() {
+        if (m_permutationUsagePath.empty()) {
+            return false;
+        }
+
+        std::ostringstream text;
+        text << PERMUTATION_USAGE_HEADER << '\n';
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_permutationUses.empty()) {
+                return false;
+            }
+            for (const auto& [stages, permutations] : m_permutationUses) {
+                for (const auto& [features, uses] : permutations) {
+                    text << std::hex << stages << ' ' << features << ' ' << std::dec << uses << '\n';
+                }
+            }
+        }
+
+        std::error_code ec;
+        if (m_permutationUsagePath.has_parent_path()) {
+            std::filesystem::create_directories(m_permutationUsagePath.parent_path(), ec);
+        }
+
+        // Same temporary-file-and-rename scheme as the pipeline cache
+        std::filesystem::path tempPath = m_permutationUsagePath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::trunc);
+            if (!file.is_open() || !(file << text.str())) {
+                SA_LOG_WARN("Cannot write permutation usage to {}", tempPath.string());
+                file.close();
+                std::filesystem::remove(tempPath, ec);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tempPath, m_permutationUsagePath, ec);
+        if (ec) {
+            SA_LOG_WARN("Failed to replace permutation usage {}: {}", m_permutationUsagePath.string(), ec.message());
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+        return true;
+    }
+
+    VkPipeline PipelineManager::CreateGraphicsPipeline(const GraphicsPipelineDesc& desc) {
+        if (desc.layout == VK_NULL_HANDLE || desc.renderPass == VK_NULL_HANDLE || desc.stages.empty()) {
+            SA_LOG_ERROR("Graphics pipeline description needs stages, a layout and a render pass");
+            return VK_NULL_HANDLE;
+        }
+
+        const FeatureSpecialization specialization(desc.features);
+        std::vector<VkPipelineShaderStageCreateInfo> stages;
+        stages.reserve(desc.stages.size());
+        for (const auto& stage : desc.stages) {
+            VkShaderModule module = m_shaderLibrary.GetModule(stage.path);
+            if (module == VK_NULL_HANDLE) {
+                return VK_NULL_HANDLE;
+            }
+            VkPipelineShaderStageCreateInfo stageInfo{};
+            stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            stageInfo.stage = stage.stage;
+            stageInfo.module = module;
+            stageInfo.pName = stage.entryPoint.c_str();
+            stageInfo.pSpecializationInfo = &specialization.info;
+            stages.push_back(stageInfo);
+        }
+
+        std::vector<VkVertexInputBindingDescription> bindings;
+        bindings.reserve(desc.vertexBindings.size());
+        for (const auto& binding : desc.vertexBindings) {
+            bindings.push_back({ binding.binding, binding.stride, binding.inputRate });
+        }
+        std::vector<VkVertexInputAttributeDescription> attributes;
+        attributes.reserve(desc.vertexAttributes.size());
+        for (const auto& attribute : desc.vertexAttributes) {
+            attributes.push_back({ attribute.location, attribute.binding, attribute.format, attribute.offset });
+        }
+
+        VkPipelineVertexInputStateCreateInfo vertexInput{};
+        vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInput.vertexBindingDescriptionCount = static_cast<uint32_t>(bindings.size());
+        vertexInput.pVertexBindingDescriptions = bindings.data();
+        vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
+        vertexInput.pVertexAttributeDescriptions = attributes.data();
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = desc.topology;
+
+        // Viewport and scissor are dynamic so pipelines survive swapchain resizes
+        VkPipelineViewportStateCreateInfo viewportState{};
+        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount = 1;
+
+        VkPipelineRasterizationStateCreateInfo rasterizer{};
+        rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizer.polygonMode = desc.polygonMode;
+        rasterizer.cullMode = desc.cullMode;
+        rasterizer.frontFace = desc.frontFace;
+        rasterizer.lineWidth = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisample{};
+        multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisample.rasterizationSamples = desc.samples;
+
+        VkPipelineDepthStencilStateCreateInfo depthStencil{};
+        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable = desc.depthTest ? VK_TRUE : VK_FALSE;
+        depthStencil.depthWriteEnable = desc.depthWrite ? VK_TRUE : VK_FALSE;
+        depthStencil.depthCompareOp = desc.depthCompare;
+
+        std::vector<VkPipelineColorBlendAttachmentState> blendAttachments(desc.blendEnable.size());
+        for (size_t i = 0; i < desc.blendEnable.size(); i++) {
+            auto& attachment = blendAttachments[i];
+            attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                        VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+            attachment.blendEnable = desc.blendEnable[i] ? VK_TRUE : VK_FALSE;
+            attachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+            attachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            attachment.colorBlendOp = VK_BLEND_OP_ADD;
+            attachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+            attachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            attachment.alphaBlendOp = VK_BLEND_OP_ADD;
+        }
+
+        VkPipelineColorBlendStateCreateInfo colorBlend{};
+        colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlend.attachmentCount = static_cast<uint32_t>(blendAttachments.size());
+        colorBlend.pAttachments = blendAttachments.data();
+
+        const std::array<VkDynamicState, 2> dynamicStates = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+        VkPipelineDynamicStateCreateInfo dynamicState{};
+        dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+        dynamicState.pDynamicStates = dynamicStates.data();
+
+        VkGraphicsPipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.stageCount = static_cast<uint32_t>(stages.size());
+        pipelineInfo.pStages = stages.data();
+        pipelineInfo.pVertexInputState = &vertexInput;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState = &multisample;
+        pipelineInfo.pDepthStencilState = &depthStencil;
+        pipelineInfo.pColorBlendState = &colorBlend;
+        pipelineInfo.pDynamicState = &dynamicState;
+        pipelineInfo.layout = desc.layout;
+        pipelineInfo.renderPass = desc.renderPass;
+        pipelineInfo.subpass = desc.subpass;
+
+        const auto start = std::chrono::steady_clock::now();
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkResult result = vkCreateGraphicsPipelines(m_device, m_pipelineCache, 1, &pipelineInfo, nullptr, &pipeline);
+        const double elapsedMs = ElapsedMs(start);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create graphics pipeline (VkResult {})", static_cast<int>(result));
+            return VK_NULL_HANDLE;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.pipelinesCreated++;
+        m_stats.compileTimeMs += elapsedMs;
+        return pipeline;
+    }
+
+    VkPipeline PipelineManager::CreateComputePipeline(const ComputePipelineDesc& desc) {
+        if (desc.layout == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("Compute pipeline description needs a layout");
+            return VK_NULL_HANDLE;
+        }
+
+        VkShaderModule module = m_shaderLibrary.GetModule(desc.stage.path);
+        if (module == VK_NULL_HANDLE) {
+            return VK_NULL_HANDLE;
+        }
+
+        const FeatureSpecialization specialization(desc.features);
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = module;
+        pipelineInfo.stage.pName = desc.stage.entryPoint.c_str();
+        pipelineInfo.stage.pSpecializationInfo = &specialization.info;
+        pipelineInfo.layout = desc.layout;
+
+        const auto start = std::chrono::steady_clock::now();
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkResult result = vkCreateComputePipelines(m_device, m_pipelineCache, 1, &pipelineInfo, nullptr, &pipeline);
+        const double elapsedMs = ElapsedMs(start);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create compute pipeline (VkResult {})", static_cast<int>(result));
+            return VK_NULL_HANDLE;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.pipelinesCreated++;
+        m_stats.compileTimeMs += elapsedMs;
+        return pipeline;
+    }
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,326 @@
+#pragma once
+
+/**
+ * @file PipelineManager.hpp
+ * @brief Pipeline creation, deduplication and persistent pipeline cache
+ *
+ * Pipelines are requested through value-type descriptions. Identical descriptions map
+ * to the same VkPipeline, so callers never need to track what was already built. All
+ * pipelines share one VkPipelineCache that is written to disk on shutdown and reloaded
+ * on the next run when the device, driver and cache UUID still match. Shader modules
+ * come from a ShaderLibrary; when hot reload replaces one, every pipeline built from it
+ * is dropped and rebuilt on the next request.
+ *
+ * Shaders carry optional features (normal mapping, tone mapping, ...) as boolean
+ * specialization constants, so one SPIR-V file serves every combination. A description's
+ * ShaderFeatures select its permutation; each permutation is its own pipeline, built the
+ * first time it is requested. Renderers report how much each permutation is used, the
+ * counts are kept across runs, and PrewarmPermutations() builds the most used ones before
+ * anything draws them.
+ *
+ * Only the Vulkan backend is implemented.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "function/graphics/ShaderLibrary.hpp"
+
+namespace StellarAlia::Function::Graphics {
+
+    class VulkanGraphicsContext;
+
+    /**
+     * @brief Shader feature bits; bit i is specialization constant i of shaders/include/shader_features.glsl
+     * Bits a shader does not declare are ignored.
+     */
+    using ShaderFeatures = uint32_t;
+    constexpr ShaderFeatures SHADER_FEATURE_NORMAL_MAP = 1u << 0;
+    constexpr ShaderFeatures SHADER_FEATURE_METALLIC_ROUGHNESS_MAP = 1u << 1;
+    constexpr ShaderFeatures SHADER_FEATURE_TONEMAP = 1u << 2;
+    constexpr ShaderFeatures SHADER_FEATURE_GAMMA_CORRECTION = 1u << 3;
+    constexpr uint32_t SHADER_FEATURE_COUNT = 4;
+    constexpr ShaderFeatures SHADER_FEATURES_ALL = (1u << SHADER_FEATURE_COUNT) - 1;
+
+    /**
+     * @brief One shader stage of a pipeline
+     */
+    struct ShaderStageDesc {
+        VkShaderStageFlagBits stage = VK_SHADER_STAGE_VERTEX_BIT;
+        std::string path;                // SPIR-V file, relative to the shader directory
+        std::string entryPoint = "main";
+
+        bool operator==(const ShaderStageDesc&) const = default;
+    };
+
+    /**
+     * @brief Vertex buffer binding
+     */
+    struct VertexBindingDesc {
+        uint32_t binding = 0;
+        uint32_t stride = 0;
+        VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+        bool operator==(const VertexBindingDesc&) const = default;
+    };
+
+    /**
+     * @brief Vertex attribute
+     */
+    struct VertexAttributeDesc {
+        uint32_t location = 0;
+        uint32_t binding = 0;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        uint32_t offset = 0;
+
+        bool operator==(const VertexAttributeDesc&) const = default;
+    };
+
+    /**
+     * @brief Full description of a graphics pipeline
+     */
+    struct GraphicsPipelineDesc {
+        std::vector<ShaderStageDesc> stages;
+        std::vector<VertexBindingDesc> vertexBindings;
+        std::vector<VertexAttributeDesc> vertexAttributes;
+
+        VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+        VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+        VkFrontFace frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+
+        bool depthTest = true;
+        bool depthWrite = true;
+        VkCompareOp depthCompare = VK_COMPARE_OP_LESS_OR_EQUAL;
+
+        std::vector<uint8_t> blendEnable;  // One entry per color attachment (standard alpha blending)
+
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        uint32_t subpass = 0;
+
+        ShaderFeatures features = SHADER_FEATURES_ALL;  // Permutation, specialized into every stage
+
+        bool operator==(const GraphicsPipelineDesc&) const = default;
+    };
+
+    /**
+     * @brief Full description of a compute pipeline
+     */
+    struct ComputePipelineDesc {
+        ShaderStageDesc stage;  // stage.stage is ignored; always VK_SHADER_STAGE_COMPUTE_BIT
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        ShaderFeatures features = SHADER_FEATURES_ALL;
+
+        bool operator==(const ComputePipelineDesc&) const = default;
+    };
+
+    /**
+     * @brief Pipeline manager creation parameters
+     */
+    struct PipelineManagerCreateInfo {
+        std::filesystem::path shaderDirectory = "shaders";               // Compiled .spv files
+        std::filesystem::path cachePath = "cache/pipeline_cache.bin";    // Empty = no persistent cache
+        std::filesystem::path permutationUsagePath = "cache/shader_permutations.txt";  // Empty = this run only
+        std::filesystem::path shaderSourceDirectory;  // GLSL sources (with include/); empty = key shaders by SPIR-V
+        std::filesystem::path shaderCompiler;         // glslc used to recompile edited shaders; empty = none
+        bool hotReloadShaders = false;                // Reload shaders that change on disk (development builds)
+    };
+
+    /**
+     * @brief Pipeline statistics
+     */
+    struct PipelineStats {
+        uint32_t pipelinesCreated = 0;
+        uint32_t deduplicatedRequests = 0;  // Requests answered by an existing pipeline
+        double compileTimeMs = 0.0;         // Total time spent in vkCreate*Pipelines
+        uint32_t pipelinesReloaded = 0;     // Pipelines dropped because a shader was reloaded
+        uint32_t permutationsPrewarmed = 0; // Pipelines built by PrewarmPermutations()
+        bool cacheLoaded = false;           // A valid on-disk cache was found at startup
+        size_t cacheLoadedBytes = 0;
+    };
+
+    /**
+     * @brief Builds and owns pipelines, pipeline layouts and shader modules
+     *
+     * Thread-safe; pipelines may be requested from worker threads.
+     */
+    class PipelineManager {
+    public:
+        PipelineManager() = default;
+        ~PipelineManager();
+
+        PipelineManager(const PipelineManager&) = delete;
+        PipelineManager& operator=(const PipelineManager&) = delete;
+
+        /**
+         * @brief Create the pipeline cache, seeding it from disk when valid
+         * @param context Initialized Vulkan context
+         * @param createInfo Creation parameters
+         * @return True on success
+         */
+        bool Initialize(VulkanGraphicsContext& context, const PipelineManagerCreateInfo& createInfo);
+
+        /**
+         * @brief Save the cache and destroy every pipeline (the GPU must be idle)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Get or build a graphics pipeline
+         * @param desc Pipeline description
+         * @return Pipeline, or VK_NULL_HANDLE on failure
+         */
+        VkPipeline GetGraphicsPipeline(const GraphicsPipelineDesc& desc);
+
+        /**
+         * @brief Get or build a compute pipeline
+         * @param desc Pipeline description
+         * @return Pipeline, or VK_NULL_HANDLE on failure
+         */
+        VkPipeline GetComputePipeline(const ComputePipelineDesc& desc);
+
+        /**
+         * @brief Get or create a pipeline layout
+         * @param setLayouts Descriptor set layouts, in set order
+         * @param pushConstants Push constant ranges
+         * @return Shared layout, or VK_NULL_HANDLE on failure
+         */
+        VkPipelineLayout GetPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts,
+                                           const std::vector<VkPushConstantRange>& pushConstants = {});
+
+        /**
+         * @brief Write the pipeline cache to disk
+         * @return True if written
+         */
+        bool SaveCache();
+
+        /**
+         * @brief Get pipeline statistics
+         * @return Snapshot of the counters
+         */
+        PipelineStats GetStats() const;
+
+        /**
+         * @brief Get the shared pipeline cache
+         * @return VkPipelineCache
+         */
+        VkPipelineCache GetPipelineCache() const { return m_pipelineCache; }
+
+        /**
+         * @brief Get the shader library that provides the pipelines' modules
+         * @return Shader library
+         */
+        ShaderLibrary& GetShaderLibrary() { return m_shaderLibrary; }
+
+        /**
+         * @brief Apply shader hot reload: drop every pipeline built from a changed shader
+         * Call once per frame from the thread that records frames. Dropped pipelines are
+         * destroyed once no frame in flight uses them.
+         * @return True if any shader changed; GetGeneration() has then changed
+         */
+        bool ReloadShaders();
+
+        /**
+         * @brief Count uses of a graphics pipeline permutation
+         * Uses are tallied per set of shader stages and features, so the count survives
+         * render pass and layout changes and carries over to the next run.
+         * @param desc Description whose features name the permutation
+         * @param uses Amount to add, e.g. the draws recorded with it this frame
+         */
+        void RecordPermutationUse(const GraphicsPipelineDesc& desc, uint64_t uses = 1);
+
+        /**
+         * @brief Get the most used permutations of a pipeline's shader stages
+         * @param desc Description; only its stages are considered
+         * @param maxPermutations Most permutations to return
+         * @return Features of each permutation, most used first
+         */
+        std::vector<ShaderFeatures> GetHotPermutations(const GraphicsPipelineDesc& desc,
+                                                       uint32_t maxPermutations) const;
+
+        /**
+         * @brief Build the most used permutations of a pipeline ahead of their first draw
+         * Call when the pipeline's render pass or layout changes. The permutations then
+         * come out of the pipeline cache up front instead of stalling the frame that first
+         * needs them.
+         * @param desc Description; its features are replaced by each hot permutation's
+         * @param maxPermutations Most permutations to build
+         * @return Number of permutations built or already present
+         */
+        uint32_t PrewarmPermutations(const GraphicsPipelineDesc& desc, uint32_t maxPermutations);
+
+        /**
+         * @brief Get a counter that changes whenever ReloadShaders() drops pipelines
+         * Callers holding VkPipeline handles re-request them when this differs from the
+         * value they saw when they fetched the handles.
+         * @return Generation
+         */
+        uint32_t GetGeneration() const { return m_generation.load(std::memory_order_acquire); }
+
+    private:
+        template <typename Desc>
+        struct Entry {
+            Desc desc;
+            VkPipeline pipeline = VK_NULL_HANDLE;
+        };
+
+        struct LayoutEntry {
+            std::vector<VkDescriptorSetLayout> setLayouts;
+            std::vector<VkPushConstantRange> pushConstants;
+            VkPipelineLayout layout = VK_NULL_HANDLE;
+        };
+
+        VkDevice m_device = VK_NULL_HANDLE;
+        VulkanGraphicsContext* m_context = nullptr;
+        std::filesystem::path m_cachePath;
+        VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+
+        // Keyed by description hash; each bucket holds the colliding descriptions
+        std::unordered_map<uint64_t, std::vector<Entry<GraphicsPipelineDesc>>> m_graphicsPipelines;
+        std::unordered_map<uint64_t, std::vector<Entry<ComputePipelineDesc>>> m_computePipelines;
+        std::unordered_map<uint64_t, std::vector<LayoutEntry>> m_layouts;
+        ShaderLibrary m_shaderLibrary;
+
+        // Permutation uses by shader stage hash, then features; seeded from the previous runs
+        std::filesystem::path m_permutationUsagePath;
+        std::unordered_map<uint64_t, std::unordered_map<ShaderFeatures, uint64_t>> m_permutationUses;
+        std::atomic<uint32_t> m_generation{ 0 };
+
+        PipelineStats m_stats;
+        mutable std::mutex m_mutex;
+
+        std::vector<char> LoadCacheFile();
+        void LoadPermutationUsage();
+        bool SavePermutationUsage();
+        VkPipeline CreateGraphicsPipeline(const GraphicsPipelineDesc& desc);
+        VkPipeline CreateComputePipeline(const ComputePipelineDesc& desc);
+    };
+
+    /**
+     * @brief Hash a graphics pipeline description
+     * @param desc Description
+     * @return Stable 64-bit hash
+     */
+    uint64_t HashPipelineDesc(const GraphicsPipelineDesc& desc);
+
+    /**
+     * @brief Hash a compute pipeline description
+     * @param desc Description
+     * @return Stable 64-bit hash
+     */
+    uint64_t HashPipelineDesc(const ComputePipelineDesc& desc);
+
+} // namespace StellarAlia::Function::Graphics
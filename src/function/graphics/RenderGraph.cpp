@@ -0,0 +1,1519 @@
+#include "function/graphics/RenderGraph.hpp"
+#include "function/graphics/vulkan/VulkanGraphicsContext.hpp"
+#include "core/jobs/JobSystem.hpp"
+#include "core/utils/Hash.hpp"
+#include "core/logs/Log.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace StellarAlia::Function::Graphics {
+
+    namespace {
+        struct AccessInfo {
+            VkPipelineStageFlags stage = 0;
+            VkAccessFlags access = 0;
+            VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+            bool write = false;
+            VkImageUsageFlags imageUsage = 0;
+            VkBufferUsageFlags bufferUsage = 0;
+        };
+
+        constexpr VkAccessFlags WRITE_ACCESS_MASK = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                                    VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+        bool IsDepthFormat(VkFormat format) {
+            switch (format) {
+                case VK_FORMAT_D16_UNORM:
+                case VK_FORMAT_X8_D24_UNORM_PACK32:
+                case VK_FORMAT_D32_SFLOAT:
+                case VK_FORMAT_D16_UNORM_S8_UINT:
+                case VK_FORMAT_D24_UNORM_S8_UINT:
+                case VK_FORMAT_D32_SFLOAT_S8_UINT:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        // format only matters for input attachments, whose layout depends on the aspect
+        AccessInfo GetAccessInfo(RenderGraphAccess access, VkFormat format = VK_FORMAT_UNDEFINED) {
+            constexpr VkPipelineStageFlags depthStages =
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+
+            switch (access) {
+                case RenderGraphAccess::ColorAttachment:
+                    return { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                             VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                             VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, true, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, 0 };
+                case RenderGraphAccess::DepthAttachment:
+                    return { depthStages,
+                             VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                             VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, true,
+                             VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, 0 };
+                case RenderGraphAccess::DepthReadOnly:
+                    return { depthStages, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+                             VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, false,
+                             VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, 0 };
+                case RenderGraphAccess::InputAttachment:
+                    return { VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_INPUT_ATTACHMENT_READ_BIT,
+                             IsDepthFormat(format) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+                                                   : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                             false, VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT, 0 };
+                case RenderGraphAccess::SampledFragment:
+                    return { VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, false, VK_IMAGE_USAGE_SAMPLED_BIT, 0 };
+                case RenderGraphAccess::SampledCompute:
+                    return { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT,
+                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, false, VK_IMAGE_USAGE_SAMPLED_BIT, 0 };
+                case RenderGraphAccess::StorageReadCompute:
+                    return { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL,
+                             false, VK_IMAGE_USAGE_STORAGE_BIT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT };
+                case RenderGraphAccess::StorageWriteCompute:
+                    return { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                             VK_IMAGE_LAYOUT_GENERAL, true, VK_IMAGE_USAGE_STORAGE_BIT,
+                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT };
+                case RenderGraphAccess::StorageReadVertex:
+                    return { VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL,
+                             false, VK_IMAGE_USAGE_STORAGE_BIT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT };
+                case RenderGraphAccess::StorageReadFragment:
+                    return { VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT, VK_IMAGE_LAYOUT_GENERAL,
+                             false, VK_IMAGE_USAGE_STORAGE_BIT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT };
+                case RenderGraphAccess::UniformRead:
+                    return { VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_ACCESS_UNIFORM_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED, false, 0,
+                             VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT };
+                case RenderGraphAccess::VertexBuffer:
+                    return { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+                             VK_IMAGE_LAYOUT_UNDEFINED, false, 0, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT };
+                case RenderGraphAccess::IndexBuffer:
+                    return { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED,
+                             false, 0, VK_BUFFER_USAGE_INDEX_BUFFER_BIT };
+                case RenderGraphAccess::IndirectBuffer:
+                    return { VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+                             VK_IMAGE_LAYOUT_UNDEFINED, false, 0, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT };
+                case RenderGraphAccess::TransferSrc:
+                    return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                             VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, false, VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                             VK_BUFFER_USAGE_TRANSFER_SRC_BIT };
+                case RenderGraphAccess::TransferDst:
+                    return { VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, true, VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+                             VK_BUFFER_USAGE_TRANSFER_DST_BIT };
+            }
+            return {};
+        }
+
+        bool IsAttachment(RenderGraphAccess access) {
+            return access == RenderGraphAccess::ColorAttachment || access == RenderGraphAccess::DepthAttachment ||
+                   access == RenderGraphAccess::DepthReadOnly || access == RenderGraphAccess::InputAttachment;
+        }
+
+        VkImageAspectFlags GetAspectMask(VkFormat format) {
+            switch (format) {
+                case VK_FORMAT_D16_UNORM_S8_UINT:
+                case VK_FORMAT_D24_UNORM_S8_UINT:
+                case VK_FORMAT_D32_SFLOAT_S8_UINT:
+                    return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+                default:
+                    return IsDepthFormat(format) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------------------
+    // RenderGraphBuilder
+    // ------------------------------------------------------------------------------------
+
+    RenderGraphResource RenderGraphBuilder::CreateTexture(std::string_view name, const RenderGraphTextureDesc& desc) {
+        const uint32_t id = m_graph.AddResource(name, true);
+        m_graph.m_resources[id].textureDesc = desc;
+        return { id };
+    }
+
+    RenderGraphResource RenderGraphBuilder::CreateBuffer(std::string_view name, const RenderGraphBufferDesc& desc) {
+        const uint32_t id = m_graph.AddResource(name, false);
+        m_graph.m_resources[id].bufferDesc = desc;
+        return { id };
+    }
+
+    RenderGraphResource RenderGraphBuilder::Read(RenderGraphResource resource, RenderGraphAccess access) {
+        if (GetAccessInfo(access).write) {
+            SA_LOG_WARN("Pass '{}' declares a write access as a read", m_graph.m_passes[m_pass].name);
+        }
+        return Write(resource, access);
+    }
+
+    RenderGraphResource RenderGraphBuilder::Write(RenderGraphResource resource, RenderGraphAccess access) {
+        if (!resource.IsValid() || resource.id >= m_graph.m_resources.size()) {
+            SA_LOG_ERROR("Pass '{}' uses an invalid resource", m_graph.m_passes[m_pass].name);
+            return resource;
+        }
+
+        auto& pass = m_graph.m_passes[m_pass];
+        for (const auto& use : pass.uses) {
+            if (use.resource == resource.id) {
+                SA_LOG_WARN("Pass '{}' uses '{}' more than once; keeping the first access", pass.name,
+                            m_graph.m_resources[resource.id].name);
+                return resource;
+            }
+        }
+        pass.uses.push_back({ resource.id, access });
+        return resource;
+    }
+
+    void RenderGraphBuilder::Clear(RenderGraphResource resource, const VkClearValue& value) {
+        m_graph.m_passes[m_pass].clears.emplace_back(resource.id, value);
+    }
+
+    void RenderGraphBuilder::SetSideEffects() {
+        m_graph.m_passes[m_pass].sideEffects = true;
+    }
+
+    void RenderGraphBuilder::SetParallelRecording() {
+        m_graph.m_passes[m_pass].parallel = true;
+    }
+
+    // ------------------------------------------------------------------------------------
+    // RenderGraphPassContext
+    // ------------------------------------------------------------------------------------
+
+    VkImage RenderGraphPassContext::GetImage(RenderGraphResource resource) const {
+        return m_graph.ResolveImage(resource.id);
+    }
+
+    VkImageView RenderGraphPassContext::GetImageView(RenderGraphResource resource) const {
+        return m_graph.ResolveImageView(resource.id);
+    }
+
+    VkBuffer RenderGraphPassContext::GetBuffer(RenderGraphResource resource) const {
+        return m_graph.ResolveBuffer(resource.id);
+    }
+
+    VkFormat RenderGraphPassContext::GetFormat(RenderGraphResource resource) const {
+        return m_graph.GetTextureFormat(m_graph.m_resources[resource.id]);
+    }
+
+    void RenderGraphPassContext::RecordParallel(uint32_t bucketCount,
+                                                const std::function<void(uint32_t, VkCommandBuffer)>& record) {
+        if (!m_parallel) {
+            for (uint32_t bucket = 0; bucket < bucketCount; bucket++) {
+                record(bucket, m_cmd);
+            }
+            return;
+        }
+
+        VkCommandBufferInheritanceInfo inheritance{};
+        inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance.renderPass = m_renderPass;
+        inheritance.subpass = m_subpass;
+        inheritance.framebuffer = m_framebuffer;
+
+        const VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(m_extent.width),
+                                   static_cast<float>(m_extent.height), 0.0f, 1.0f };
+        const VkRect2D scissor{ { 0, 0 }, m_extent };
+        const bool timed = m_timestampQuery != UINT32_MAX;
+        VulkanGraphicsContext& graphicsContext = *m_graph.m_context;
+        VkQueryPool timestampPool = m_graph.m_timestampPool;
+
+        // Slot b is only written by the job recording bucket b
+        std::vector<VkCommandBuffer> secondaries(bucketCount, VK_NULL_HANDLE);
+        bool beginWritten = false;
+        bool endWritten = false;
+        m_graph.m_jobs->ParallelFor(bucketCount, [&](uint32_t begin, uint32_t end) {
+            const uint32_t thread = Core::Jobs::JobSystem::GetCurrentThreadIndex();
+            for (uint32_t bucket = begin; bucket < end; bucket++) {
+                VkCommandBuffer cmd = graphicsContext.BeginSecondaryCommandBuffer(thread, inheritance);
+                if (cmd == VK_NULL_HANDLE) {
+                    continue;
+                }
+                vkCmdSetViewport(cmd, 0, 1, &viewport);
+                vkCmdSetScissor(cmd, 0, 1, &scissor);
+                if (timed && bucket == 0) {
+                    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestampPool, m_timestampQuery);
+                    beginWritten = true;
+                }
+                record(bucket, cmd);
+                if (timed && bucket == bucketCount - 1) {
+                    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestampPool,
+                                        m_timestampQuery + 1);
+                    endWritten = true;
+                }
+                if (vkEndCommandBuffer(cmd) != VK_SUCCESS) {
+                    SA_LOG_ERROR("Failed to end secondary command buffer for bucket {}", bucket);
+                    continue;
+                }
+                secondaries[bucket] = cmd;
+            }
+        });
+
+        // A query written into a buffer that failed to end is still consumed, so the pass keeps
+        // its slot; its results are simply unavailable for the frame
+        m_timestampsWritten = beginWritten || endWritten;
+        secondaries.erase(std::remove(secondaries.begin(), secondaries.end(), VK_NULL_HANDLE), secondaries.end());
+        if (!secondaries.empty()) {
+            vkCmdExecuteCommands(m_cmd, static_cast<uint32_t>(secondaries.size()), secondaries.data());
+        }
+    }
+
+    // ------------------------------------------------------------------------------------
+    // RenderGraph
+    // ------------------------------------------------------------------------------------
+
+    RenderGraph::~RenderGraph() {
+        Shutdown();
+    }
+
+    bool RenderGraph::Initialize(VulkanGraphicsContext& context) {
+        if (m_device != VK_NULL_HANDLE) {
+            SA_LOG_WARN("RenderGraph already initialized");
+            return false;
+        }
+        if (context.GetDevice() == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("RenderGraph requires an initialized Vulkan context");
+            return false;
+        }
+        m_context = &context;
+        m_device = context.GetDevice();
+        m_framebufferGeneration = context.GetFrameStats().swapchainRecreateCount;
+        m_stats = {};
+        return true;
+    }
+
+    void RenderGraph::Shutdown() {
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        for (auto& [key, framebuffer] : m_framebuffers) {
+            vkDestroyFramebuffer(m_device, framebuffer, nullptr);
+        }
+        m_framebuffers.clear();
+        for (auto& [key, renderPass] : m_renderPasses) {
+            vkDestroyRenderPass(m_device, renderPass, nullptr);
+        }
+        m_renderPasses.clear();
+
+        // Destroy immediately rather than deferred: the caller guarantees the GPU is idle
+        for (const auto& physical : m_physical) {
+            if (physical.view != VK_NULL_HANDLE) {
+                vkDestroyImageView(m_device, physical.view, nullptr);
+            }
+            if (physical.image != VK_NULL_HANDLE) {
+                vkDestroyImage(m_device, physical.image, nullptr);
+            }
+            if (physical.buffer != VK_NULL_HANDLE) {
+                vkDestroyBuffer(m_device, physical.buffer, nullptr);
+            }
+        }
+        for (const auto& block : m_blocks) {
+            m_context->GetMemoryManager().FreeMemory(block.allocation);
+        }
+        m_physical.clear();
+        m_blocks.clear();
+
+        SetTimingEnabled(false);
+
+        m_passes.clear();
+        m_resources.clear();
+        m_compiled.clear();
+        m_structureHash = 0;
+        m_device = VK_NULL_HANDLE;
+        m_context = nullptr;
+        m_jobs = nullptr;
+    }
+
+    bool RenderGraph::SetJobSystem(Core::Jobs::JobSystem* jobs) {
+        m_jobs = nullptr;
+        if (m_device == VK_NULL_HANDLE || jobs == nullptr) {
+            return false;
+        }
+        if (!jobs->IsInitialized()) {
+            SA_LOG_WARN("Render graph job system is not initialized; recording every pass inline");
+            return false;
+        }
+        if (jobs->GetThreadCount() > m_context->GetRecordingThreadCount()) {
+            SA_LOG_WARN("Job system has {} threads but the context only records on {}; recording every pass inline",
+                        jobs->GetThreadCount(), m_context->GetRecordingThreadCount());
+            return false;
+        }
+        m_jobs = jobs;
+        return true;
+    }
+
+    bool RenderGraph::SetTimingEnabled(bool enabled) {
+        if (m_device == VK_NULL_HANDLE) {
+            return false;
+        }
+        if (!enabled) {
+            if (m_timestampPool != VK_NULL_HANDLE) {
+                m_context->WaitIdle();
+                vkDestroyQueryPool(m_device, m_timestampPool, nullptr);
+                m_timestampPool = VK_NULL_HANDLE;
+            }
+            m_timedPasses.clear();
+            m_timings.clear();
+            return false;
+        }
+        if (m_timestampPool != VK_NULL_HANDLE) {
+            return true;
+        }
+
+        const DeviceCapabilities& caps = m_context->GetDeviceCapabilities();
+        const uint32_t family = m_context->GetGraphicsQueueFamily();
+        if (family >= caps.queueFamilies.size() || caps.queueFamilies[family].timestampValidBits == 0) {
+            SA_LOG_WARN("Render graph timing unavailable: the graphics queue has no timestamp support");
+            return false;
+        }
+
+        const uint32_t frames = m_context->GetFramesInFlight();
+        VkQueryPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        poolInfo.queryCount = frames * MAX_TIMED_PASSES * 2;
+        VkResult result = vkCreateQueryPool(m_device, &poolInfo, nullptr, &m_timestampPool);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create timestamp query pool: VkResult = {}", static_cast<int>(result));
+            return false;
+        }
+        m_timestampPeriodNs = caps.limits.timestampPeriod;
+        m_timedPasses.assign(frames, {});
+        return true;
+    }
+
+    void RenderGraph::ReadTimestamps(uint32_t frame) {
+        // The frame's fence has been waited on, so the slot's previous queries are complete
+        const std::vector<std::string>& names = m_timedPasses[frame];
+        if (names.empty()) {
+            return;
+        }
+
+        const auto count = static_cast<uint32_t>(names.size() * 2);
+        m_timestampScratch.resize(count);
+        VkResult result = vkGetQueryPoolResults(m_device, m_timestampPool, frame * MAX_TIMED_PASSES * 2, count,
+                                                count * sizeof(uint64_t), m_timestampScratch.data(),
+                                                sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+        if (result != VK_SUCCESS) {
+            return;
+        }
+
+        m_timings.resize(names.size());
+        for (size_t i = 0; i < names.size(); i++) {
+            const uint64_t ticks = m_timestampScratch[i * 2 + 1] - m_timestampScratch[i * 2];
+            m_timings[i].name = names[i];
+            m_timings[i].gpuMs = static_cast<double>(ticks) * m_timestampPeriodNs / 1e6;
+        }
+    }
+
+    void RenderGraph::Reset() {
+        m_passes.clear();
+        m_resources.clear();
+        m_compiled.clear();
+        m_finalBarriers = {};
+    }
+
+    RenderGraphResource RenderGraph::ImportTexture(std::string_view name, const RenderGraphImportedTexture& texture) {
+        const uint32_t id = AddResource(name, true);
+        Resource& resource = m_resources[id];
+        resource.imported = true;
+        resource.importedTexture = texture;
+        return { id };
+    }
+
+    RenderGraphResource RenderGraph::ImportBuffer(std::string_view name, const RenderGraphImportedBuffer& buffer) {
+        const uint32_t id = AddResource(name, false);
+        Resource& resource = m_resources[id];
+        resource.imported = true;
+        resource.importedBuffer = buffer;
+        return { id };
+    }
+
+    void RenderGraph::AddPass(std::string_view name, const RenderGraphSetup& setup, RenderGraphExecute execute) {
+        const auto index = static_cast<uint32_t>(m_passes.size());
+        Pass& pass = m_passes.emplace_back();
+        pass.name = name;
+        pass.execute = std::move(execute);
+
+        RenderGraphBuilder builder(*this, index);
+        setup(builder);
+    }
+
+    bool RenderGraph::Compile() {
+        if (m_device == VK_NULL_HANDLE) {
+            return false;
+        }
+
+        const VulkanBackbuffer backbuffer = m_context->GetCurrentBackbuffer();
+        m_defaultExtent = backbuffer.extent;
+
+        // A recreated swapchain invalidates every framebuffer that referenced its views
+        const uint32_t generation = m_context->GetFrameStats().swapchainRecreateCount;
+        if (generation != m_framebufferGeneration) {
+            m_framebufferGeneration = generation;
+            std::vector<VkFramebuffer> stale;
+            for (auto& [key, framebuffer] : m_framebuffers) {
+                stale.push_back(framebuffer);
+            }
+            m_framebuffers.clear();
+            VkDevice device = m_device;
+            m_context->DeferDestruction([device, stale = std::move(stale)]() {
+                for (VkFramebuffer framebuffer : stale) {
+                    vkDestroyFramebuffer(device, framebuffer, nullptr);
+                }
+            });
+        }
+
+        CullPasses();
+        m_compiled.clear();
+        for (uint32_t i = 0; i < m_passes.size(); i++) {
+            if (!m_passes[i].culled) {
+                CompiledPass& compiled = m_compiled.emplace_back();
+                compiled.pass = i;
+                compiled.leader = static_cast<uint32_t>(m_compiled.size() - 1);
+            }
+        }
+        if (!MergeSubpasses()) {
+            m_compiled.clear();
+            return false;
+        }
+        ComputeLifetimes();
+
+        // Transients map to physical resources in declaration order, which the hash pins down
+        uint32_t physicalIndex = 0;
+        for (Resource& resource : m_resources) {
+            if (!resource.imported && resource.firstPass != UINT32_MAX) {
+                resource.physical = physicalIndex++;
+            }
+        }
+
+        const uint64_t hash = HashStructure();
+        if (hash != m_structureHash) {
+            DestroyPhysicalResources();
+            if (!BuildPhysicalResources()) {
+                DestroyPhysicalResources();
+                m_structureHash = 0;
+                return false;
+            }
+            m_structureHash = hash;
+            m_stats.rebuilds++;
+            SA_LOG_INFO("Render graph rebuilt: {} passes ({} culled, {} merged), {} transients in {} KiB "
+                        "({} KiB without aliasing, {} KiB lazily allocated)",
+                        m_stats.passCount, m_stats.culledPasses, m_stats.mergedPasses, m_stats.transientResources,
+                        m_stats.transientBytes / 1024, m_stats.unaliasedBytes / 1024, m_stats.lazyBytes / 1024);
+        }
+
+        BuildBarriers();
+        return BuildRenderPasses();
+    }
+
+    void RenderGraph::Execute(VkCommandBuffer cmd) {
+        if (m_device == VK_NULL_HANDLE || cmd == VK_NULL_HANDLE) {
+            return;
+        }
+
+        const uint32_t frame = m_context->GetCurrentFrameIndex();
+        const uint32_t queryBase = frame * MAX_TIMED_PASSES * 2;
+        const bool timed = m_timestampPool != VK_NULL_HANDLE;
+        if (timed) {
+            ReadTimestamps(frame);
+            m_timedPasses[frame].clear();
+            vkCmdResetQueryPool(cmd, m_timestampPool, queryBase, MAX_TIMED_PASSES * 2);
+        }
+
+        // Threads outside the job system run ParallelFor inline and own no secondary command
+        // pool; record parallel passes inline on them instead
+        const bool canRecordParallel = m_jobs != nullptr && m_jobs->IsInitialized() &&
+            Core::Jobs::JobSystem::GetCurrentThreadIndex() != Core::Jobs::INVALID_THREAD_INDEX;
+
+        bool skipGroup = false;
+        VkFramebuffer framebuffer = VK_NULL_HANDLE;
+        for (uint32_t c = 0; c < m_compiled.size(); c++) {
+            const CompiledPass& compiled = m_compiled[c];
+            const CompiledPass& leader = m_compiled[compiled.leader];
+            Pass& pass = m_passes[compiled.pass];
+
+            // A parallel subpass may contain nothing but vkCmdExecuteCommands
+            const bool parallel = pass.parallel && canRecordParallel && leader.renderPass != VK_NULL_HANDLE;
+            const VkSubpassContents contents =
+                parallel ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+
+            RenderGraphPassContext context(*this, cmd);
+            if (compiled.leader == c) {
+                RecordBarriers(cmd, compiled.barriers);
+                skipGroup = false;
+
+                if (leader.renderPass != VK_NULL_HANDLE) {
+                    framebuffer = GetFramebuffer(leader);
+                    skipGroup = framebuffer == VK_NULL_HANDLE;
+                    if (!skipGroup) {
+                        // Pipelines from PipelineManager use dynamic viewport and scissor. Set
+                        // outside the render pass so inline subpasses of the group inherit them;
+                        // secondary buffers set their own.
+                        const VkViewport viewport{ 0.0f, 0.0f, static_cast<float>(leader.extent.width),
+                                                   static_cast<float>(leader.extent.height), 0.0f, 1.0f };
+                        const VkRect2D scissor{ { 0, 0 }, leader.extent };
+                        vkCmdSetViewport(cmd, 0, 1, &viewport);
+                        vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+                        VkRenderPassBeginInfo beginInfo{};
+                        beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+                        beginInfo.renderPass = leader.renderPass;
+                        beginInfo.framebuffer = framebuffer;
+                        beginInfo.renderArea = { { 0, 0 }, leader.extent };
+                        beginInfo.clearValueCount = static_cast<uint32_t>(leader.clearValues.size());
+                        beginInfo.pClearValues = leader.clearValues.data();
+                        vkCmdBeginRenderPass(cmd, &beginInfo, contents);
+                    }
+                }
+            } else if (!skipGroup) {
+                vkCmdNextSubpass(cmd, contents);
+            }
+            if (skipGroup) {
+                continue;
+            }
+
+            context.m_renderPass = leader.renderPass;
+            context.m_framebuffer = framebuffer;
+            context.m_subpass = compiled.subpass;
+            context.m_extent = leader.extent;
+            context.m_parallel = parallel;
+
+            const auto timedIndex = timed ? static_cast<uint32_t>(m_timedPasses[frame].size()) : MAX_TIMED_PASSES;
+            const bool timedPass = timedIndex < MAX_TIMED_PASSES;
+            if (timedPass && parallel) {
+                context.m_timestampQuery = queryBase + timedIndex * 2;
+            } else if (timedPass) {
+                vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_timestampPool,
+                                    queryBase + timedIndex * 2);
+            }
+            if (pass.execute) {
+                pass.execute(context);
+            }
+            if (timedPass && parallel) {
+                if (context.m_timestampsWritten) {
+                    m_timedPasses[frame].push_back(pass.name);
+                }
+            } else if (timedPass) {
+                vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampPool,
+                                    queryBase + timedIndex * 2 + 1);
+                m_timedPasses[frame].push_back(pass.name);
+            }
+            if (leader.renderPass != VK_NULL_HANDLE && compiled.lastInGroup) {
+                vkCmdEndRenderPass(cmd);
+            }
+        }
+
+        RecordBarriers(cmd, m_finalBarriers);
+    }
+
+    uint32_t RenderGraph::AddResource(std::string_view name, bool isImage) {
+        const auto id = static_cast<uint32_t>(m_resources.size());
+        Resource& resource = m_resources.emplace_back();
+        resource.name = name;
+        resource.isImage = isImage;
+        return id;
+    }
+
+    void RenderGraph::CullPasses() {
+        // Passes only depend on earlier passes, so one reverse sweep propagates liveness
+        std::vector<uint8_t> needed(m_passes.size(), 0);
+        for (size_t p = 0; p < m_passes.size(); p++) {
+            const Pass& pass = m_passes[p];
+            needed[p] = pass.sideEffects ? 1 : 0;
+            for (const auto& use : pass.uses) {
+                if (GetAccessInfo(use.access).write && m_resources[use.resource].imported) {
+                    needed[p] = 1;
+                }
+            }
+        }
+
+        for (size_t p = m_passes.size(); p-- > 0;) {
+            if (!needed[p]) {
+                continue;
+            }
+            const Pass& pass = m_passes[p];
+            for (const auto& use : pass.uses) {
+                // A cleared attachment does not depend on what earlier passes wrote
+                const bool cleared = std::any_of(pass.clears.begin(), pass.clears.end(),
+                                                 [&](const auto& clear) { return clear.first == use.resource; });
+                if (cleared) {
+                    continue;
+                }
+                for (size_t q = 0; q < p; q++) {
+                    for (const auto& earlier : m_passes[q].uses) {
+                        if (earlier.resource == use.resource && GetAccessInfo(earlier.access).write) {
+                            needed[q] = 1;
+                        }
+                    }
+                }
+            }
+        }
+
+        m_stats.passCount = static_cast<uint32_t>(m_passes.size());
+        m_stats.culledPasses = 0;
+        for (size_t p = 0; p < m_passes.size(); p++) {
+            m_passes[p].culled = !needed[p];
+            if (m_passes[p].culled) {
+                m_stats.culledPasses++;
+            }
+        }
+    }
+
+    bool RenderGraph::MergeSubpasses() {
+        m_stats.mergedPasses = 0;
+
+        auto findUse = [&](uint32_t compiledIndex, uint32_t resource) -> const ResourceUse* {
+            for (const auto& use : m_passes[m_compiled[compiledIndex].pass].uses) {
+                if (use.resource == resource) {
+                    return &use;
+                }
+            }
+            return nullptr;
+        };
+        auto hasAttachments = [&](uint32_t compiledIndex) {
+            const auto& uses = m_passes[m_compiled[compiledIndex].pass].uses;
+            return std::any_of(uses.begin(), uses.end(), [](const auto& use) { return IsAttachment(use.access); });
+        };
+
+        for (uint32_t c = 1; c < m_compiled.size(); c++) {
+            const Pass& pass = m_passes[m_compiled[c].pass];
+            const bool readsInputs = std::any_of(pass.uses.begin(), pass.uses.end(), [](const auto& use) {
+                return use.access == RenderGraphAccess::InputAttachment;
+            });
+            if (!readsInputs) {
+                continue;
+            }
+
+            // Resources shared with the group must stay attachments throughout (no barrier can
+            // be recorded between subpasses), and every input must come from the group
+            const uint32_t leader = m_compiled[c - 1].leader;
+            const VkExtent2D extent = [&]() {
+                for (const auto& use : m_passes[m_compiled[leader].pass].uses) {
+                    if (IsAttachment(use.access)) {
+                        return GetTextureExtent(m_resources[use.resource]);
+                    }
+                }
+                return VkExtent2D{};
+            }();
+            bool mergeable = hasAttachments(leader);
+            for (const auto& use : pass.uses) {
+                if (!mergeable) {
+                    break;
+                }
+                if (IsAttachment(use.access)) {
+                    const VkExtent2D useExtent = GetTextureExtent(m_resources[use.resource]);
+                    mergeable = useExtent.width == extent.width && useExtent.height == extent.height;
+                }
+                bool sharedWithGroup = false;
+                for (uint32_t member = leader; member < c && mergeable; member++) {
+                    const ResourceUse* earlier = findUse(member, use.resource);
+                    if (earlier) {
+                        sharedWithGroup = true;
+                        mergeable = IsAttachment(earlier->access) && IsAttachment(use.access);
+                    }
+                }
+                if (use.access == RenderGraphAccess::InputAttachment && !sharedWithGroup) {
+                    mergeable = false;
+                }
+            }
+
+            if (!mergeable) {
+                SA_LOG_ERROR("Pass '{}' reads input attachments but cannot become a subpass of '{}'", pass.name,
+                             m_passes[m_compiled[leader].pass].name);
+                return false;
+            }
+            m_compiled[c].leader = leader;
+            m_compiled[c].subpass = m_compiled[c - 1].subpass + 1;
+            m_compiled[c - 1].lastInGroup = false;
+            m_stats.mergedPasses++;
+        }
+        return true;
+    }
+
+    void RenderGraph::ComputeLifetimes() {
+        // Usage comes from surviving passes only: transient attachments must not carry the
+        // sampled bit of a culled reader
+        std::vector<uint32_t> group(m_resources.size(), UINT32_MAX);
+        std::vector<uint8_t> attachmentOnly(m_resources.size(), 1);
+        for (Resource& resource : m_resources) {
+            resource.imageUsage = 0;
+            resource.bufferUsage = 0;
+        }
+
+        for (uint32_t c = 0; c < m_compiled.size(); c++) {
+            for (const auto& use : m_passes[m_compiled[c].pass].uses) {
+                Resource& resource = m_resources[use.resource];
+                const AccessInfo info = GetAccessInfo(use.access);
+                resource.imageUsage |= info.imageUsage;
+                resource.bufferUsage |= info.bufferUsage;
+                resource.firstPass = std::min(resource.firstPass, c);
+                resource.lastPass = std::max(resource.lastPass, c);
+
+                if (group[use.resource] == UINT32_MAX) {
+                    group[use.resource] = m_compiled[c].leader;
+                } else if (group[use.resource] != m_compiled[c].leader) {
+                    attachmentOnly[use.resource] = 0;
+                }
+                if (!IsAttachment(use.access)) {
+                    attachmentOnly[use.resource] = 0;
+                }
+            }
+        }
+
+        // Never loaded from or stored to memory: a candidate for tile memory
+        for (uint32_t id = 0; id < m_resources.size(); id++) {
+            Resource& resource = m_resources[id];
+            resource.transientAttachment = !resource.imported && resource.isImage &&
+                                           resource.firstPass != UINT32_MAX && attachmentOnly[id];
+            if (resource.transientAttachment) {
+                resource.imageUsage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+            }
+        }
+    }
+
+    uint64_t RenderGraph::HashStructure() const {
+        // Only what shapes the physical transients: descriptions, usage and lifetimes
+        uint64_t hash = Core::Hash::FNV_OFFSET_BASIS;
+        for (const Resource& resource : m_resources) {
+            if (resource.imported || resource.firstPass == UINT32_MAX) {
+                continue;
+            }
+            Core::Hash::Combine(hash, resource.isImage);
+            Core::Hash::Combine(hash, resource.firstPass);
+            Core::Hash::Combine(hash, resource.lastPass);
+            if (resource.isImage) {
+                const VkExtent2D extent = GetTextureExtent(resource);
+                Core::Hash::Combine(hash, extent.width);
+                Core::Hash::Combine(hash, extent.height);
+                Core::Hash::Combine(hash, resource.textureDesc.format);
+                Core::Hash::Combine(hash, resource.textureDesc.samples);
+                Core::Hash::Combine(hash, resource.imageUsage);
+            } else {
+                Core::Hash::Combine(hash, resource.bufferDesc.size);
+                Core::Hash::Combine(hash, resource.bufferUsage);
+            }
+        }
+        return hash;
+    }
+
+    bool RenderGraph::BuildPhysicalResources() {
+        struct Candidate {
+            uint32_t resource = 0;
+            VkMemoryRequirements requirements = {};
+            bool lazy = false;
+        };
+        struct BlockPlan {
+            bool isImage = true;
+            bool lazy = false;
+            VkMemoryRequirements requirements = {};
+            std::vector<std::pair<uint32_t, uint32_t>> lifetimes;
+        };
+
+        m_stats.transientResources = 0;
+        m_stats.transientBytes = 0;
+        m_stats.unaliasedBytes = 0;
+        m_stats.lazyBytes = 0;
+
+        const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+        vmaGetMemoryProperties(m_context->GetAllocator(), &memoryProperties);
+        auto supportsLazyMemory = [&](uint32_t memoryTypeBits) {
+            for (uint32_t i = 0; i < memoryProperties->memoryTypeCount; i++) {
+                if ((memoryTypeBits & (1u << i)) &&
+                    (memoryProperties->memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        std::vector<Candidate> candidates;
+        uint32_t lazyCandidates = 0;
+        for (uint32_t id = 0; id < m_resources.size(); id++) {
+            Resource& resource = m_resources[id];
+            if (resource.imported || resource.firstPass == UINT32_MAX) {
+                continue;
+            }
+
+            PhysicalResource physical;
+            Candidate candidate;
+            candidate.resource = id;
+            if (resource.isImage) {
+                const VkExtent2D extent = GetTextureExtent(resource);
+                VkImageCreateInfo imageInfo{};
+                imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+                imageInfo.imageType = VK_IMAGE_TYPE_2D;
+                imageInfo.format = resource.textureDesc.format;
+                imageInfo.extent = { extent.width, extent.height, 1 };
+                imageInfo.mipLevels = 1;
+                imageInfo.arrayLayers = 1;
+                imageInfo.samples = resource.textureDesc.samples;
+                imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+                imageInfo.usage = resource.imageUsage;
+                imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                if (vkCreateImage(m_device, &imageInfo, nullptr, &physical.image) != VK_SUCCESS) {
+                    SA_LOG_ERROR("Failed to create render graph texture '{}'", resource.name);
+                    return false;
+                }
+                vkGetImageMemoryRequirements(m_device, physical.image, &candidate.requirements);
+            } else {
+                VkBufferCreateInfo bufferInfo{};
+                bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                bufferInfo.size = resource.bufferDesc.size;
+                bufferInfo.usage = resource.bufferUsage;
+                bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                if (vkCreateBuffer(m_device, &bufferInfo, nullptr, &physical.buffer) != VK_SUCCESS) {
+                    SA_LOG_ERROR("Failed to create render graph buffer '{}'", resource.name);
+                    return false;
+                }
+                vkGetBufferMemoryRequirements(m_device, physical.buffer, &candidate.requirements);
+            }
+
+            candidate.lazy = resource.transientAttachment && supportsLazyMemory(candidate.requirements.memoryTypeBits);
+            if (candidate.lazy) {
+                lazyCandidates++;
+            } else {
+                m_stats.unaliasedBytes += candidate.requirements.size;
+            }
+            m_physical.push_back(physical);
+            candidates.push_back(candidate);
+        }
+
+        // Greedy first-fit, largest first: a resource joins a block when its lifetime does
+        // not overlap any current member; the block grows to the largest member
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.requirements.size > b.requirements.size;
+        });
+
+        std::vector<BlockPlan> plans;
+        for (const Candidate& candidate : candidates) {
+            Resource& resource = m_resources[candidate.resource];
+            const auto lifetime = std::make_pair(resource.firstPass, resource.lastPass);
+
+            // Lazily allocated memory is never committed, so there is nothing to gain by aliasing it
+            uint32_t chosen = UINT32_MAX;
+            for (uint32_t b = 0; b < plans.size() && chosen == UINT32_MAX && !candidate.lazy; b++) {
+                BlockPlan& plan = plans[b];
+                if (plan.isImage != resource.isImage || plan.lazy ||
+                    (plan.requirements.memoryTypeBits & candidate.requirements.memoryTypeBits) == 0) {
+                    continue;
+                }
+                const bool overlaps = std::any_of(plan.lifetimes.begin(), plan.lifetimes.end(), [&](const auto& other) {
+                    return lifetime.first <= other.second && other.first <= lifetime.second;
+                });
+                if (!overlaps) {
+                    chosen = b;
+                }
+            }
+
+            if (chosen == UINT32_MAX) {
+                chosen = static_cast<uint32_t>(plans.size());
+                BlockPlan& plan = plans.emplace_back();
+                plan.isImage = resource.isImage;
+                plan.lazy = candidate.lazy;
+                plan.requirements = candidate.requirements;
+            } else {
+                BlockPlan& plan = plans[chosen];
+                plan.requirements.size = std::max(plan.requirements.size, candidate.requirements.size);
+                plan.requirements.alignment = std::max(plan.requirements.alignment, candidate.requirements.alignment);
+                plan.requirements.memoryTypeBits &= candidate.requirements.memoryTypeBits;
+            }
+            plans[chosen].lifetimes.push_back(lifetime);
+            m_physical[resource.physical].block = chosen;
+        }
+
+        for (const BlockPlan& plan : plans) {
+            VmaAllocationCreateInfo allocInfo{};
+            allocInfo.requiredFlags = plan.lazy ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT
+                                                : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            MemoryBlock block;
+            if (!m_context->GetMemoryManager().AllocateMemory(MemoryCategory::RenderTarget, plan.requirements,
+                                                              allocInfo, block.allocation)) {
+                return false;
+            }
+            m_blocks.push_back(block);
+            (plan.lazy ? m_stats.lazyBytes : m_stats.transientBytes) += plan.requirements.size;
+        }
+        if (lazyCandidates > 0 && m_stats.lazyBytes == 0) {
+            SA_LOG_WARN("Render graph: {} transient attachments support lazy memory but none was placed there",
+                        lazyCandidates);
+        }
+
+        VmaAllocator allocator = m_context->GetAllocator();
+        for (uint32_t id = 0; id < m_resources.size(); id++) {
+            const Resource& resource = m_resources[id];
+            if (resource.physical == UINT32_MAX) {
+                continue;
+            }
+            PhysicalResource& physical = m_physical[resource.physical];
+            VmaAllocation allocation = m_blocks[physical.block].allocation;
+
+            if (!resource.isImage) {
+                if (vmaBindBufferMemory(allocator, allocation, physical.buffer) != VK_SUCCESS) {
+                    SA_LOG_ERROR("Failed to bind render graph buffer '{}'", resource.name);
+                    return false;
+                }
+                continue;
+            }
+
+            if (vmaBindImageMemory(allocator, allocation, physical.image) != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to bind render graph texture '{}'", resource.name);
+                return false;
+            }
+
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.image = physical.image;
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = resource.textureDesc.format;
+            viewInfo.subresourceRange = { GetAspectMask(resource.textureDesc.format), 0, 1, 0, 1 };
+            // Sampling a depth/stencil image (or reading it as an input attachment) reads depth only
+            if (viewInfo.subresourceRange.aspectMask != VK_IMAGE_ASPECT_COLOR_BIT &&
+                (resource.imageUsage & (VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT))) {
+                viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+            }
+            if (vkCreateImageView(m_device, &viewInfo, nullptr, &physical.view) != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to create view for render graph texture '{}'", resource.name);
+                return false;
+            }
+        }
+
+        m_stats.transientResources = static_cast<uint32_t>(m_physical.size());
+        return true;
+    }
+
+    void RenderGraph::DestroyPhysicalResources() {
+        if (m_physical.empty() && m_blocks.empty()) {
+            return;
+        }
+
+        // Frames still in flight may use the old resources (and framebuffers over their views)
+        std::vector<VkFramebuffer> framebuffers;
+        for (auto& [key, framebuffer] : m_framebuffers) {
+            framebuffers.push_back(framebuffer);
+        }
+        m_framebuffers.clear();
+
+        VkDevice device = m_device;
+        VulkanMemoryManager* memoryManager = &m_context->GetMemoryManager();
+        m_context->DeferDestruction([device, memoryManager, framebuffers = std::move(framebuffers),
+                                     physicals = std::move(m_physical), blocks = std::move(m_blocks)]() {
+            for (VkFramebuffer framebuffer : framebuffers) {
+                vkDestroyFramebuffer(device, framebuffer, nullptr);
+            }
+            for (const auto& physical : physicals) {
+                if (physical.view != VK_NULL_HANDLE) {
+                    vkDestroyImageView(device, physical.view, nullptr);
+                }
+                if (physical.image != VK_NULL_HANDLE) {
+                    vkDestroyImage(device, physical.image, nullptr);
+                }
+                if (physical.buffer != VK_NULL_HANDLE) {
+                    vkDestroyBuffer(device, physical.buffer, nullptr);
+                }
+            }
+            for (const auto& block : blocks) {
+                memoryManager->FreeMemory(block.allocation);
+            }
+        });
+        m_physical.clear();
+        m_blocks.clear();
+    }
+
+    void RenderGraph::BuildBarriers() {
+        struct State {
+            VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+            VkPipelineStageFlags writeStages = 0;   // Stages of the last write (or layout transition)
+            VkAccessFlags writeAccess = 0;          // Writes not yet made available
+            VkPipelineStageFlags readStages = 0;    // Readers since the last write
+            VkPipelineStageFlags syncedStages = 0;  // Stages that already see the last write
+        };
+
+        // Last access of every transient, in execution order
+        std::vector<std::pair<VkPipelineStageFlags, VkAccessFlags>> lastUse(m_resources.size(), { 0, 0 });
+        for (const CompiledPass& compiled : m_compiled) {
+            for (const auto& use : m_passes[compiled.pass].uses) {
+                const AccessInfo info = GetAccessInfo(use.access);
+                lastUse[use.resource] = { info.stage, info.access & WRITE_ACCESS_MASK };
+            }
+        }
+
+        // Aliased transients start where the previous occupant of their memory left off; the
+        // first occupant waits for the last one of the previous frame
+        std::vector<std::vector<uint32_t>> occupants(m_blocks.size());
+        for (uint32_t id = 0; id < m_resources.size(); id++) {
+            const Resource& resource = m_resources[id];
+            if (resource.physical != UINT32_MAX) {
+                occupants[m_physical[resource.physical].block].push_back(id);
+            }
+        }
+
+        std::vector<State> states(m_resources.size());
+        for (auto& members : occupants) {
+            std::sort(members.begin(), members.end(), [&](uint32_t a, uint32_t b) {
+                return m_resources[a].firstPass < m_resources[b].firstPass;
+            });
+            for (size_t i = 0; i < members.size(); i++) {
+                const uint32_t previous = members[(i + members.size() - 1) % members.size()];
+                states[members[i]].writeStages = lastUse[previous].first;
+                states[members[i]].writeAccess = lastUse[previous].second;
+            }
+        }
+        for (uint32_t id = 0; id < m_resources.size(); id++) {
+            const Resource& resource = m_resources[id];
+            if (!resource.imported) {
+                continue;
+            }
+            State& state = states[id];
+            if (resource.isImage) {
+                state.layout = resource.importedTexture.initialLayout;
+                state.writeStages = resource.importedTexture.initialStage;
+                state.writeAccess = resource.importedTexture.initialAccess;
+            } else {
+                state.writeStages = resource.importedBuffer.initialStage;
+                state.writeAccess = resource.importedBuffer.initialAccess;
+            }
+        }
+
+        auto addBarrier = [](BarrierBatch& batch, uint32_t resource, const State& state, VkImageLayout newLayout,
+                             VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+            const VkPipelineStageFlags src = state.writeStages | state.readStages;
+            batch.srcStages |= src != 0 ? src : static_cast<VkPipelineStageFlags>(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+            batch.dstStages |= dstStage;
+            batch.ops.push_back({ resource, state.layout, newLayout, state.writeAccess, dstAccess });
+        };
+
+        for (uint32_t c = 0; c < m_compiled.size(); c++) {
+            const CompiledPass& compiled = m_compiled[c];
+            // Barriers of merged passes are recorded before the group's render pass begins
+            BarrierBatch& batch = m_compiled[compiled.leader].barriers;
+
+            for (const auto& use : m_passes[compiled.pass].uses) {
+                const Resource& resource = m_resources[use.resource];
+                const AccessInfo info = GetAccessInfo(use.access, GetTextureFormat(resource));
+                const bool isImage = resource.isImage;
+                State& state = states[use.resource];
+                const bool layoutChange = isImage && state.layout != info.layout;
+
+                // Within a group, subpass dependencies and the render pass's own layout
+                // transitions take care of attachments shared with earlier subpasses
+                bool inGroup = false;
+                for (uint32_t member = compiled.leader; member < c && !inGroup; member++) {
+                    for (const auto& earlier : m_passes[m_compiled[member].pass].uses) {
+                        inGroup = inGroup || earlier.resource == use.resource;
+                    }
+                }
+                if (inGroup) {
+                    state.layout = info.layout;
+                    if (info.write) {
+                        state.writeStages = info.stage;
+                        state.writeAccess = info.access & WRITE_ACCESS_MASK;
+                        state.readStages = 0;
+                        state.syncedStages = info.stage;
+                    } else {
+                        state.readStages |= info.stage;
+                        state.syncedStages |= info.stage;
+                    }
+                    continue;
+                }
+
+                if (info.write || layoutChange) {
+                    // WAW/WAR hazards and layout transitions
+                    addBarrier(batch, use.resource, state, isImage ? info.layout : VK_IMAGE_LAYOUT_UNDEFINED,
+                               info.stage, info.access);
+                    state.layout = isImage ? info.layout : VK_IMAGE_LAYOUT_UNDEFINED;
+                    state.writeStages = info.stage;
+                    state.writeAccess = info.access & WRITE_ACCESS_MASK;
+                    state.readStages = info.write ? 0 : info.stage;
+                    state.syncedStages = info.stage;
+                } else if ((state.syncedStages & info.stage) != info.stage && state.writeStages != 0) {
+                    // RAW: the last write is not yet visible to this stage
+                    State readState = state;
+                    readState.readStages = 0;
+                    addBarrier(batch, use.resource, readState, state.layout, info.stage, info.access);
+                    state.syncedStages |= info.stage;
+                    state.readStages |= info.stage;
+                } else {
+                    state.readStages |= info.stage;
+                }
+            }
+        }
+
+        // Hand imported textures back in the layout their owner expects
+        m_finalBarriers = {};
+        for (uint32_t id = 0; id < m_resources.size(); id++) {
+            const Resource& resource = m_resources[id];
+            if (!resource.imported || !resource.isImage || resource.firstPass == UINT32_MAX) {
+                continue;
+            }
+            if (states[id].layout != resource.importedTexture.finalLayout) {
+                addBarrier(m_finalBarriers, id, states[id], resource.importedTexture.finalLayout,
+                           VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0);
+            }
+        }
+
+        m_stats.barrierBatches = m_finalBarriers.ops.empty() ? 0 : 1;
+        for (const CompiledPass& compiled : m_compiled) {
+            if (!compiled.barriers.ops.empty()) {
+                m_stats.barrierBatches++;
+            }
+        }
+    }
+
+    bool RenderGraph::BuildRenderPasses() {
+        std::vector<VkAttachmentDescription> descriptions;
+        std::vector<VkSubpassDescription> subpasses;
+        std::vector<VkSubpassDependency> dependencies;
+        std::vector<std::vector<VkAttachmentReference>> colorRefs;
+        std::vector<std::vector<VkAttachmentReference>> inputRefs;
+        std::vector<VkAttachmentReference> depthRefs;
+        std::vector<std::vector<uint32_t>> preserved;
+
+        for (uint32_t c = 0; c < m_compiled.size(); c++) {
+            CompiledPass& leader = m_compiled[c];
+            if (leader.leader != c) {
+                continue;
+            }
+            uint32_t end = c + 1;
+            while (end < m_compiled.size() && m_compiled[end].leader == c) {
+                end++;
+            }
+
+            // Attachments in order of first use across the group's subpasses
+            std::vector<uint32_t>& attachments = leader.attachments;
+            for (uint32_t member = c; member < end; member++) {
+                for (const auto& use : m_passes[m_compiled[member].pass].uses) {
+                    if (IsAttachment(use.access) &&
+                        std::find(attachments.begin(), attachments.end(), use.resource) == attachments.end()) {
+                        attachments.push_back(use.resource);
+                    }
+                }
+            }
+            if (attachments.empty()) {
+                continue;
+            }
+            leader.extent = GetTextureExtent(m_resources[attachments.front()]);
+
+            descriptions.clear();
+            for (uint32_t resourceId : attachments) {
+                const Resource& resource = m_resources[resourceId];
+                const VkFormat format = GetTextureFormat(resource);
+
+                // Contents matter if an earlier surviving pass wrote them (or they were imported
+                // with defined contents), and must be kept if a later pass or the owner reads them
+                bool writtenBefore = resource.imported && resource.isImage &&
+                                     resource.importedTexture.initialLayout != VK_IMAGE_LAYOUT_UNDEFINED;
+                bool usedAfter = resource.imported;
+                RenderGraphAccess firstAccess = RenderGraphAccess::ColorAttachment;
+                RenderGraphAccess lastAccess = RenderGraphAccess::ColorAttachment;
+                bool seenInGroup = false;
+                for (uint32_t other = 0; other < m_compiled.size(); other++) {
+                    for (const auto& otherUse : m_passes[m_compiled[other].pass].uses) {
+                        if (otherUse.resource != resourceId) {
+                            continue;
+                        }
+                        if (other < c && GetAccessInfo(otherUse.access).write) {
+                            writtenBefore = true;
+                        } else if (other >= end) {
+                            usedAfter = true;
+                        } else if (other >= c) {
+                            firstAccess = seenInGroup ? firstAccess : otherUse.access;
+                            lastAccess = otherUse.access;
+                            seenInGroup = true;
+                        }
+                    }
+                }
+
+                // Only the first subpass using an attachment may clear it
+                VkClearValue clearValue{};
+                bool cleared = false;
+                for (uint32_t member = c; member < end && !cleared; member++) {
+                    const Pass& pass = m_passes[m_compiled[member].pass];
+                    const bool usesIt = std::any_of(pass.uses.begin(), pass.uses.end(),
+                                                    [&](const auto& use) { return use.resource == resourceId; });
+                    if (!usesIt) {
+                        continue;
+                    }
+                    for (const auto& [clearResource, value] : pass.clears) {
+                        if (clearResource == resourceId) {
+                            clearValue = value;
+                            cleared = true;
+                        }
+                    }
+                    break;
+                }
+
+                VkAttachmentDescription description{};
+                description.format = format;
+                description.samples = resource.imported ? VK_SAMPLE_COUNT_1_BIT : resource.textureDesc.samples;
+                description.loadOp = cleared        ? VK_ATTACHMENT_LOAD_OP_CLEAR
+                                     : writtenBefore ? VK_ATTACHMENT_LOAD_OP_LOAD
+                                                     : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+                description.storeOp = usedAfter ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                description.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+                description.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                // Barriers outside the render pass transition into the first subpass's layout;
+                // the render pass itself handles changes between subpasses
+                description.initialLayout = GetAccessInfo(firstAccess, format).layout;
+                description.finalLayout = GetAccessInfo(lastAccess, format).layout;
+                descriptions.push_back(description);
+                leader.clearValues.push_back(clearValue);
+            }
+
+            auto attachmentIndex = [&](uint32_t resourceId) {
+                return static_cast<uint32_t>(std::find(attachments.begin(), attachments.end(), resourceId) -
+                                             attachments.begin());
+            };
+
+            const uint32_t subpassCount = end - c;
+            colorRefs.assign(subpassCount, {});
+            inputRefs.assign(subpassCount, {});
+            depthRefs.assign(subpassCount, { VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED });
+            preserved.assign(subpassCount, {});
+            std::vector<uint32_t> firstSubpass(attachments.size(), UINT32_MAX);
+            std::vector<uint32_t> lastSubpass(attachments.size(), 0);
+
+            // Color and input attachments in declaration order (shader locations and
+            // input_attachment_index), depth separately
+            for (uint32_t s = 0; s < subpassCount; s++) {
+                for (const auto& use : m_passes[m_compiled[c + s].pass].uses) {
+                    if (!IsAttachment(use.access)) {
+                        continue;
+                    }
+                    const uint32_t index = attachmentIndex(use.resource);
+                    const VkImageLayout layout =
+                        GetAccessInfo(use.access, GetTextureFormat(m_resources[use.resource])).layout;
+                    firstSubpass[index] = std::min(firstSubpass[index], s);
+                    lastSubpass[index] = std::max(lastSubpass[index], s);
+                    if (use.access == RenderGraphAccess::ColorAttachment) {
+                        colorRefs[s].push_back({ index, layout });
+                    } else if (use.access == RenderGraphAccess::InputAttachment) {
+                        inputRefs[s].push_back({ index, layout });
+                    } else {
+                        depthRefs[s] = { index, layout };
+                    }
+                }
+            }
+
+            // Attachments a subpass skips but a later one uses must be preserved across it
+            for (uint32_t s = 0; s < subpassCount; s++) {
+                for (uint32_t index = 0; index < attachments.size(); index++) {
+                    if (firstSubpass[index] >= s || lastSubpass[index] <= s) {
+                        continue;
+                    }
+                    const bool used = std::any_of(m_passes[m_compiled[c + s].pass].uses.begin(),
+                                                  m_passes[m_compiled[c + s].pass].uses.end(),
+                                                  [&](const auto& use) { return use.resource == attachments[index]; });
+                    if (!used) {
+                        preserved[s].push_back(index);
+                    }
+                }
+            }
+
+            subpasses.assign(subpassCount, {});
+            dependencies.clear();
+            for (uint32_t s = 0; s < subpassCount; s++) {
+                VkSubpassDescription& subpass = subpasses[s];
+                subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+                subpass.inputAttachmentCount = static_cast<uint32_t>(inputRefs[s].size());
+                subpass.pInputAttachments = inputRefs[s].data();
+                subpass.colorAttachmentCount = static_cast<uint32_t>(colorRefs[s].size());
+                subpass.pColorAttachments = colorRefs[s].data();
+                subpass.pDepthStencilAttachment =
+                    depthRefs[s].attachment != VK_ATTACHMENT_UNUSED ? &depthRefs[s] : nullptr;
+                subpass.preserveAttachmentCount = static_cast<uint32_t>(preserved[s].size());
+                subpass.pPreserveAttachments = preserved[s].data();
+
+                if (s > 0) {
+                    // Attachment writes of the previous subpass become visible to this one, per region
+                    VkSubpassDependency dependency{};
+                    dependency.srcSubpass = s - 1;
+                    dependency.dstSubpass = s;
+                    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                              VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                              VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+                    dependency.dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                                              VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                              VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                              VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+                    dependency.srcAccessMask =
+                        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+                    dependency.dstAccessMask = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT |
+                                               VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                                               VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                               VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                               VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+                    dependency.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+                    dependencies.push_back(dependency);
+                }
+            }
+
+            uint64_t key = Core::Hash::FNV_OFFSET_BASIS;
+            Core::Hash::Combine(key, descriptions.size());
+            for (const auto& description : descriptions) {
+                Core::Hash::Combine(key, description.format);
+                Core::Hash::Combine(key, description.samples);
+                Core::Hash::Combine(key, description.loadOp);
+                Core::Hash::Combine(key, description.storeOp);
+                Core::Hash::Combine(key, description.initialLayout);
+                Core::Hash::Combine(key, description.finalLayout);
+            }
+            Core::Hash::Combine(key, subpassCount);
+            for (uint32_t s = 0; s < subpassCount; s++) {
+                for (const auto* refs : { &colorRefs[s], &inputRefs[s] }) {
+                    Core::Hash::Combine(key, refs->size());
+                    for (const auto& ref : *refs) {
+                        Core::Hash::Combine(key, ref);
+                    }
+                }
+                Core::Hash::Combine(key, depthRefs[s]);
+                Core::Hash::Combine(key, preserved[s].size());
+            }
+
+            auto it = m_renderPasses.find(key);
+            if (it != m_renderPasses.end()) {
+                leader.renderPass = it->second;
+                continue;
+            }
+
+            VkRenderPassCreateInfo renderPassInfo{};
+            renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+            renderPassInfo.attachmentCount = static_cast<uint32_t>(descriptions.size());
+            renderPassInfo.pAttachments = descriptions.data();
+            renderPassInfo.subpassCount = subpassCount;
+            renderPassInfo.pSubpasses = subpasses.data();
+            renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+            renderPassInfo.pDependencies = dependencies.data();
+
+            VkRenderPass renderPass = VK_NULL_HANDLE;
+            VkResult result = vkCreateRenderPass(m_device, &renderPassInfo, nullptr, &renderPass);
+            if (result != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to create render pass for '{}' (VkResult {})", m_passes[leader.pass].name,
+                             static_cast<int>(result));
+                return false;
+            }
+            m_renderPasses.emplace(key, renderPass);
+            leader.renderPass = renderPass;
+        }
+        return true;
+    }
+
+    VkFramebuffer RenderGraph::GetFramebuffer(const CompiledPass& pass) {
+        uint64_t key = Core::Hash::FNV_OFFSET_BASIS;
+        Core::Hash::Combine(key, pass.renderPass);
+        Core::Hash::Combine(key, pass.extent.width);
+        Core::Hash::Combine(key, pass.extent.height);
+
+        // Fixed-size scratch: graphics passes never exceed the device's attachment limit
+        constexpr size_t MAX_ATTACHMENTS = 16;
+        VkImageView views[MAX_ATTACHMENTS];
+        const size_t count = std::min(pass.attachments.size(), MAX_ATTACHMENTS);
+        for (size_t i = 0; i < count; i++) {
+            views[i] = ResolveImageView(pass.attachments[i]);
+            Core::Hash::Combine(key, views[i]);
+        }
+
+        auto it = m_framebuffers.find(key);
+        if (it != m_framebuffers.end()) {
+            return it->second;
+        }
+
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = pass.renderPass;
+        framebufferInfo.attachmentCount = static_cast<uint32_t>(count);
+        framebufferInfo.pAttachments = views;
+        framebufferInfo.width = pass.extent.width;
+        framebufferInfo.height = pass.extent.height;
+        framebufferInfo.layers = 1;
+
+        VkFramebuffer framebuffer = VK_NULL_HANDLE;
+        VkResult result = vkCreateFramebuffer(m_device, &framebufferInfo, nullptr, &framebuffer);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create framebuffer for '{}' (VkResult {})", m_passes[pass.pass].name,
+                         static_cast<int>(result));
+            return VK_NULL_HANDLE;
+        }
+        m_framebuffers.emplace(key, framebuffer);
+        return framebuffer;
+    }
+
+    void RenderGraph::RecordBarriers(VkCommandBuffer cmd, const BarrierBatch& batch) {
+        if (batch.ops.empty()) {
+            return;
+        }
+
+        m_imageBarriers.clear();
+        m_bufferBarriers.clear();
+        for (const BarrierOp& op : batch.ops) {
+            const Resource& resource = m_resources[op.resource];
+            if (resource.isImage) {
+                VkImageMemoryBarrier barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.srcAccessMask = op.srcAccess;
+                barrier.dstAccessMask = op.dstAccess;
+                barrier.oldLayout = op.oldLayout;
+                barrier.newLayout = op.newLayout;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.image = ResolveImage(op.resource);
+                barrier.subresourceRange = { GetAspectMask(GetTextureFormat(resource)), 0, 1, 0, 1 };
+                m_imageBarriers.push_back(barrier);
+            } else {
+                VkBufferMemoryBarrier barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                barrier.srcAccessMask = op.srcAccess;
+                barrier.dstAccessMask = op.dstAccess;
+                barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                barrier.buffer = ResolveBuffer(op.resource);
+                barrier.offset = 0;
+                barrier.size = VK_WHOLE_SIZE;
+                m_bufferBarriers.push_back(barrier);
+            }
+        }
+
+        vkCmdPipelineBarrier(cmd, batch.srcStages, batch.dstStages, 0, 0, nullptr,
+                             static_cast<uint32_t>(m_bufferBarriers.size()), m_bufferBarriers.data(),
+                             static_cast<uint32_t>(m_imageBarriers.size()), m_imageBarriers.data());
+    }
+
+    VkImage RenderGraph::ResolveImage(uint32_t resource) const {
+        const Resource& r = m_resources[resource];
+        if (r.imported) {
+            return r.importedTexture.image;
+        }
+        return r.physical != UINT32_MAX ? m_physical[r.physical].image : VK_NULL_HANDLE;
+    }
+
+    VkImageView RenderGraph::ResolveImageView(uint32_t resource) const {
+        const Resource& r = m_resources[resource];
+        if (r.imported) {
+            return r.importedTexture.view;
+        }
+        return r.physical != UINT32_MAX ? m_physical[r.physical].view : VK_NULL_HANDLE;
+    }
+
+    VkBuffer RenderGraph::ResolveBuffer(uint32_t resource) const {
+        const Resource& r = m_resources[resource];
+        if (r.imported) {
+            return r.importedBuffer.buffer;
+        }
+        return r.physical != UINT32_MAX ? m_physical[r.physical].buffer : VK_NULL_HANDLE;
+    }
+
+    VkExtent2D RenderGraph::GetTextureExtent(const Resource& resource) const {
+        if (resource.imported) {
+            return resource.importedTexture.extent;
+        }
+        return { resource.textureDesc.width != 0 ? resource.textureDesc.width : m_defaultExtent.width,
+                 resource.textureDesc.height != 0 ? resource.textureDesc.height : m_defaultExtent.height };
+    }
+
+    VkFormat RenderGraph::GetTextureFormat(const Resource& resource) const {
+        return resource.imported ? resource.importedTexture.format : resource.textureDesc.format;
+    }
+
+} // namespace StellarAlia::Function::Graphics
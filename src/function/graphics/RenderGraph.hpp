@@ -0,0 +1,505 @@
+#pragma once
+
+/**
+ * @file RenderGraph.hpp
+ * @brief Frame graph: declarative passes, automatic barriers and transient aliasing
+ *
+ * Each frame the renderer declares its passes and the resources they read and write.
+ * Compile() culls passes whose results are never consumed, derives one batched barrier
+ * per pass from the declared accesses, and places transient resources whose lifetimes
+ * do not overlap in the same memory. Physical resources, render passes and framebuffers
+ * are cached and only rebuilt when the graph's structure changes.
+ *
+ * A pass that reads input attachments becomes a subpass of the preceding pass's render
+ * pass. Transients that never leave one render pass are created as transient attachments
+ * and, where the device offers it, backed by lazily allocated memory, so on tile-based
+ * GPUs they can live entirely in tile memory.
+ *
+ * Only the Vulkan backend is implemented.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace StellarAlia::Core::Jobs { class JobSystem; }
+
+namespace StellarAlia::Function::Graphics {
+
+    class VulkanGraphicsContext;
+    class RenderGraph;
+
+    /**
+     * @brief GPU time of one pass, from timestamp queries
+     */
+    struct RenderGraphPassTiming {
+        std::string name;
+        double gpuMs = 0.0;
+    };
+
+    /**
+     * @brief Handle to a graph resource, valid for the frame it was declared in
+     */
+    struct RenderGraphResource {
+        uint32_t id = UINT32_MAX;
+        bool IsValid() const { return id != UINT32_MAX; }
+    };
+
+    /**
+     * @brief How a pass uses a resource
+     */
+    enum class RenderGraphAccess : uint32_t {
+        ColorAttachment,      // Write
+        DepthAttachment,      // Write (depth test and write)
+        DepthReadOnly,        // Read (depth test only)
+        InputAttachment,      // Read (subpass input; merges the pass into the writer's render pass)
+        SampledFragment,      // Read
+        SampledCompute,       // Read
+        StorageReadCompute,   // Read
+        StorageWriteCompute,  // Write
+        StorageReadVertex,    // Read
+        StorageReadFragment,  // Read
+        UniformRead,          // Read (vertex, fragment and compute)
+        VertexBuffer,         // Read
+        IndexBuffer,          // Read
+        IndirectBuffer,       // Read
+        TransferSrc,          // Read
+        TransferDst,          // Write
+    };
+
+    /**
+     * @brief Transient texture description
+     */
+    struct RenderGraphTextureDesc {
+        uint32_t width = 0;   // 0 = backbuffer width
+        uint32_t height = 0;  // 0 = backbuffer height
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+    };
+
+    /**
+     * @brief Transient buffer description
+     */
+    struct RenderGraphBufferDesc {
+        VkDeviceSize size = 0;
+    };
+
+    /**
+     * @brief Externally owned texture used by the graph (e.g. the backbuffer)
+     */
+    struct RenderGraphImportedTexture {
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkExtent2D extent = {};
+        VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;  // UNDEFINED discards the contents
+        VkPipelineStageFlags initialStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        VkAccessFlags initialAccess = 0;
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;  // Left in this layout
+    };
+
+    /**
+     * @brief Externally owned buffer used by the graph
+     */
+    struct RenderGraphImportedBuffer {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        VkPipelineStageFlags initialStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        VkAccessFlags initialAccess = 0;
+    };
+
+    /**
+     * @brief Graph statistics for the last compiled frame
+     */
+    struct RenderGraphStats {
+        uint32_t passCount = 0;
+        uint32_t culledPasses = 0;
+        uint32_t mergedPasses = 0;        // Passes recorded as subpasses of an earlier pass
+        uint32_t barrierBatches = 0;      // vkCmdPipelineBarrier calls per frame
+        uint32_t transientResources = 0;
+        VkDeviceSize transientBytes = 0;  // Memory actually allocated for transients
+        VkDeviceSize unaliasedBytes = 0;  // Memory the transients would need without aliasing
+        VkDeviceSize lazyBytes = 0;       // Lazily allocated attachments (may never be committed)
+        uint32_t rebuilds = 0;            // Structural changes since initialization
+    };
+
+    /**
+     * @brief Declares a pass's resources during AddPass setup
+     */
+    class RenderGraphBuilder {
+    public:
+        /**
+         * @brief Create a transient texture owned by the graph
+         * @param name Debug name
+         * @param desc Texture description
+         * @return Resource handle
+         */
+        RenderGraphResource CreateTexture(std::string_view name, const RenderGraphTextureDesc& desc);
+
+        /**
+         * @brief Create a transient buffer owned by the graph
+         * @param name Debug name
+         * @param desc Buffer description
+         * @return Resource handle
+         */
+        RenderGraphResource CreateBuffer(std::string_view name, const RenderGraphBufferDesc& desc);
+
+        /**
+         * @brief Declare a read
+         * @param resource Resource
+         * @param access Read access
+         * @return The same resource, for chaining
+         */
+        RenderGraphResource Read(RenderGraphResource resource, RenderGraphAccess access);
+
+        /**
+         * @brief Declare a write
+         * @param resource Resource
+         * @param access Write access
+         * @return The same resource, for chaining
+         */
+        RenderGraphResource Write(RenderGraphResource resource, RenderGraphAccess access);
+
+        /**
+         * @brief Clear an attachment written by this pass when the render pass begins
+         * @param resource Color or depth attachment written by this pass
+         * @param value Clear value
+         */
+        void Clear(RenderGraphResource resource, const VkClearValue& value);
+
+        /**
+         * @brief Keep the pass even if nothing reads its outputs
+         */
+        void SetSideEffects();
+
+        /**
+         * @brief Record the pass into secondary command buffers on the graph's job system
+         * The execute callback must record through RenderGraphPassContext::RecordParallel.
+         * Without a job system the pass is recorded inline as usual.
+         */
+        void SetParallelRecording();
+
+    private:
+        friend class RenderGraph;
+        RenderGraphBuilder(RenderGraph& graph, uint32_t pass) : m_graph(graph), m_pass(pass) {}
+
+        RenderGraph& m_graph;
+        uint32_t m_pass;
+    };
+
+    /**
+     * @brief Handed to a pass's execute callback
+     */
+    class RenderGraphPassContext {
+    public:
+        VkCommandBuffer GetCommandBuffer() const { return m_cmd; }
+
+        /**
+         * @brief Get the render pass the callback records into (graphics passes only)
+         * @return Render pass, compatible across frames while the graph is unchanged
+         */
+        VkRenderPass GetRenderPass() const { return m_renderPass; }
+
+        /**
+         * @brief Get the subpass index within GetRenderPass()
+         * @return Subpass index, non-zero for passes merged into an earlier pass
+         */
+        uint32_t GetSubpass() const { return m_subpass; }
+
+        /**
+         * @brief Get the attachment extent of the pass
+         * @return Extent
+         */
+        VkExtent2D GetExtent() const { return m_extent; }
+
+        VkImage GetImage(RenderGraphResource resource) const;
+        VkImageView GetImageView(RenderGraphResource resource) const;
+        VkBuffer GetBuffer(RenderGraphResource resource) const;
+
+        /**
+         * @brief Get the format of a texture
+         * @param resource Texture used by the pass
+         * @return Format
+         */
+        VkFormat GetFormat(RenderGraphResource resource) const;
+
+        /**
+         * @brief Check whether RecordParallel records on worker threads
+         * @return True for passes declared with SetParallelRecording while a job system is set
+         */
+        bool IsParallel() const { return m_parallel; }
+
+        /**
+         * @brief Record the pass as bucketCount independent command streams
+         *
+         * In a parallel pass every bucket is recorded by a job into its own secondary command
+         * buffer, which starts with only the viewport and scissor set: the callback binds all
+         * other state itself. The buffers are executed in bucket order, so the result does not
+         * depend on which thread recorded what. Otherwise the buckets are recorded in order into
+         * GetCommandBuffer(). Call at most once per pass, and never use GetCommandBuffer() in a
+         * parallel pass.
+         * @param bucketCount Number of buckets
+         * @param record Called with (bucket, cmd); must be safe to call concurrently
+         */
+        void RecordParallel(uint32_t bucketCount, const std::function<void(uint32_t, VkCommandBuffer)>& record);
+
+    private:
+        friend class RenderGraph;
+        RenderGraphPassContext(const RenderGraph& graph, VkCommandBuffer cmd) : m_graph(graph), m_cmd(cmd) {}
+
+        const RenderGraph& m_graph;
+        VkCommandBuffer m_cmd;
+        VkRenderPass m_renderPass = VK_NULL_HANDLE;
+        VkFramebuffer m_framebuffer = VK_NULL_HANDLE;
+        uint32_t m_subpass = 0;
+        VkExtent2D m_extent = {};
+        bool m_parallel = false;
+        uint32_t m_timestampQuery = UINT32_MAX;  // First of the pass's two queries, written by RecordParallel
+        bool m_timestampsWritten = false;
+    };
+
+    using RenderGraphSetup = std::function<void(RenderGraphBuilder&)>;
+    using RenderGraphExecute = std::function<void(RenderGraphPassContext&)>;
+
+    /**
+     * @brief Frame graph
+     *
+     * Per frame: Reset(), import external resources, AddPass() for each pass, Compile(),
+     * then Execute() into the frame's command buffer. Passes run in declaration order;
+     * a pass must be declared after the passes whose outputs it reads. A pass reading
+     * input attachments must directly follow the pass that writes them, with the same
+     * extent.
+     */
+    class RenderGraph {
+    public:
+        RenderGraph() = default;
+        ~RenderGraph();
+
+        RenderGraph(const RenderGraph&) = delete;
+        RenderGraph& operator=(const RenderGraph&) = delete;
+
+        /**
+         * @brief Bind the graph to a context
+         * @param context Initialized Vulkan context
+         * @return True on success
+         */
+        bool Initialize(VulkanGraphicsContext& context);
+
+        /**
+         * @brief Release every cached resource (the GPU must be idle)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Start declaring a new frame
+         */
+        void Reset();
+
+        /**
+         * @brief Use an external texture in this frame
+         * @param name Debug name
+         * @param texture Image, view and the states it enters and leaves the graph in
+         * @return Resource handle
+         */
+        RenderGraphResource ImportTexture(std::string_view name, const RenderGraphImportedTexture& texture);
+
+        /**
+         * @brief Use an external buffer in this frame
+         * @param name Debug name
+         * @param buffer Buffer and the state it enters the graph in
+         * @return Resource handle
+         */
+        RenderGraphResource ImportBuffer(std::string_view name, const RenderGraphImportedBuffer& buffer);
+
+        /**
+         * @brief Declare a pass
+         * @param name Debug name
+         * @param setup Declares resources; runs immediately
+         * @param execute Records commands; runs during Execute() unless the pass is culled
+         */
+        void AddPass(std::string_view name, const RenderGraphSetup& setup, RenderGraphExecute execute);
+
+        /**
+         * @brief Cull, order barriers and (re)build physical resources if the structure changed
+         * @return True if the graph can be executed
+         */
+        bool Compile();
+
+        /**
+         * @brief Record every surviving pass
+         * @param cmd Frame command buffer
+         */
+        void Execute(VkCommandBuffer cmd);
+
+        /**
+         * @brief Get statistics of the last compiled frame
+         * @return Stats
+         */
+        const RenderGraphStats& GetStats() const { return m_stats; }
+
+        /**
+         * @brief Write GPU timestamps around every pass
+         * Results lag by GetFramesInFlight() frames; timing is unavailable (and this
+         * returns false) on queues without timestamp support.
+         * @param enabled Enable or disable
+         * @return True if timing is active
+         */
+        bool SetTimingEnabled(bool enabled);
+
+        /**
+         * @brief Record passes declared with SetParallelRecording on a job system
+         * The context must have been created with at least jobs->GetThreadCount() recording
+         * threads, and Execute() must then be called from one of the job system's threads.
+         * @param jobs Initialized job system, or nullptr to record every pass inline
+         * @return True if parallel recording is active
+         */
+        bool SetJobSystem(Core::Jobs::JobSystem* jobs);
+
+        /**
+         * @brief Get per-pass GPU times of the most recent frame whose results are available
+         * @return Timings in execution order
+         */
+        const std::vector<RenderGraphPassTiming>& GetPassTimings() const { return m_timings; }
+
+    private:
+        friend class RenderGraphBuilder;
+        friend class RenderGraphPassContext;
+
+        struct ResourceUse {
+            uint32_t resource = 0;
+            RenderGraphAccess access = RenderGraphAccess::SampledFragment;
+        };
+
+        struct Pass {
+            std::string name;
+            std::vector<ResourceUse> uses;
+            std::vector<std::pair<uint32_t, VkClearValue>> clears;
+            RenderGraphExecute execute;
+            bool sideEffects = false;
+            bool parallel = false;
+            bool culled = false;
+        };
+
+        struct Resource {
+            std::string name;
+            bool isImage = true;
+            bool imported = false;
+            RenderGraphTextureDesc textureDesc;
+            RenderGraphBufferDesc bufferDesc;
+            RenderGraphImportedTexture importedTexture;
+            RenderGraphImportedBuffer importedBuffer;
+            VkImageUsageFlags imageUsage = 0;
+            VkBufferUsageFlags bufferUsage = 0;
+            uint32_t firstPass = UINT32_MAX;  // Execution-order lifetime, culled passes excluded
+            uint32_t lastPass = 0;
+            uint32_t physical = UINT32_MAX;   // Index into m_physical for transients
+            bool transientAttachment = false; // Only used as an attachment inside one render pass
+        };
+
+        // A transient resource and the memory block it lives in; survives across frames
+        struct PhysicalResource {
+            VkImage image = VK_NULL_HANDLE;
+            VkImageView view = VK_NULL_HANDLE;
+            VkBuffer buffer = VK_NULL_HANDLE;
+            uint32_t block = 0;
+        };
+
+        struct MemoryBlock {
+            VmaAllocation allocation = VK_NULL_HANDLE;
+        };
+
+        // Barrier recorded before a pass (resource handles are resolved at execute time)
+        struct BarrierOp {
+            uint32_t resource = 0;
+            VkImageLayout oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            VkImageLayout newLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            VkAccessFlags srcAccess = 0;
+            VkAccessFlags dstAccess = 0;
+        };
+
+        struct BarrierBatch {
+            VkPipelineStageFlags srcStages = 0;
+            VkPipelineStageFlags dstStages = 0;
+            std::vector<BarrierOp> ops;
+        };
+
+        // Render pass state lives on the first pass of a merged group; barriers of the
+        // whole group are recorded before its render pass begins
+        struct CompiledPass {
+            uint32_t pass = 0;
+            uint32_t leader = 0;   // Index into m_compiled of the group's first pass
+            uint32_t subpass = 0;
+            bool lastInGroup = true;
+            BarrierBatch barriers;
+            VkRenderPass renderPass = VK_NULL_HANDLE;
+            std::vector<uint32_t> attachments;  // Resource ids in attachment order
+            std::vector<VkClearValue> clearValues;
+            VkExtent2D extent = {};
+        };
+
+        VulkanGraphicsContext* m_context = nullptr;
+        VkDevice m_device = VK_NULL_HANDLE;
+        Core::Jobs::JobSystem* m_jobs = nullptr;
+
+        // Declared this frame
+        std::vector<Pass> m_passes;
+        std::vector<Resource> m_resources;
+
+        // Compiled this frame
+        std::vector<CompiledPass> m_compiled;
+        BarrierBatch m_finalBarriers;
+        VkExtent2D m_defaultExtent = {};
+
+        // Cached across frames
+        uint64_t m_structureHash = 0;
+        std::vector<PhysicalResource> m_physical;
+        std::vector<MemoryBlock> m_blocks;
+        std::unordered_map<uint64_t, VkRenderPass> m_renderPasses;
+        std::unordered_map<uint64_t, VkFramebuffer> m_framebuffers;
+        uint32_t m_framebufferGeneration = 0;
+
+        // Scratch reused by Execute
+        std::vector<VkImageMemoryBarrier> m_imageBarriers;
+        std::vector<VkBufferMemoryBarrier> m_bufferBarriers;
+
+        // Timestamps: two queries per pass, one range per frame in flight
+        static constexpr uint32_t MAX_TIMED_PASSES = 64;
+        VkQueryPool m_timestampPool = VK_NULL_HANDLE;
+        double m_timestampPeriodNs = 0.0;
+        std::vector<std::vector<std::string>> m_timedPasses;  // Per frame slot, names of the recorded passes
+        std::vector<uint64_t> m_timestampScratch;
+        std::vector<RenderGraphPassTiming> m_timings;
+
+        RenderGraphStats m_stats;
+
+        uint32_t AddResource(std::string_view name, bool isImage);
+        uint64_t HashStructure() const;
+        void CullPasses();
+        bool MergeSubpasses();
+        void ComputeLifetimes();
+        bool BuildPhysicalResources();
+        void DestroyPhysicalResources();
+        void BuildBarriers();
+        bool BuildRenderPasses();
+        VkFramebuffer GetFramebuffer(const CompiledPass& pass);
+        void RecordBarriers(VkCommandBuffer cmd, const BarrierBatch& batch);
+        void ReadTimestamps(uint32_t frame);
+        VkImage ResolveImage(uint32_t resource) const;
+        VkImageView ResolveImageView(uint32_t resource) const;
+        VkBuffer ResolveBuffer(uint32_t resource) const;
+        VkExtent2D GetTextureExtent(const Resource& resource) const;
+        VkFormat GetTextureFormat(const Resource& resource) const;
+    };
+
+} // namespace StellarAlia::Function::Graphics
@@ -1,6 +1,11 @@
 #include "function/graphics/RenderSystem.hpp"
 #include "function/graphics/GraphicsContext.hpp"
+#include "function/graphics/GpuDrivenRenderer.hpp"
+#include "function/graphics/PipelineManager.hpp"
+#include "function/graphics/RenderGraph.hpp"
 #include "function/graphics/WindowSystem.hpp"
+#include "function/graphics/vulkan/VulkanGraphicsContext.hpp"
+#include "core/jobs/JobSystem.hpp"
 
 namespace StellarAlia::Function::Graphics {
 
@@ -15,19 +20,31 @@ namespace StellarAlia::Function::Graphics {
             return false; // Already initialized
         }
 
-        if (!createInfo.window) {
+        if (!createInfo.window && !createInfo.headless) {
             return false; // Window must be provided and already initialized
         }
 
         // Get window dimensions (window is already initialized)
-        uint32_t width = createInfo.window->GetWidth();
-        uint32_t height = createInfo.window->GetHeight();
+        uint32_t width = createInfo.window ? createInfo.window->GetWidth() : createInfo.width;
+        uint32_t height = createInfo.window ? createInfo.window->GetHeight() : createInfo.height;
 
         // Create graphics context
         GraphicsContextCreateInfo contextInfo;
         contextInfo.api = createInfo.api;
         contextInfo.enableValidation = createInfo.enableValidation;
         contextInfo.window = createInfo.window; // Pass raw pointer to GraphicsContext
+        contextInfo.headless = createInfo.headless;
+        contextInfo.width = width;
+        contextInfo.height = height;
+        contextInfo.framesInFlight = createInfo.framesInFlight;
+        contextInfo.presentPolicy = createInfo.presentPolicy;
+        contextInfo.uploadRingSize = createInfo.uploadRingSize;
+        contextInfo.uploadBudgetPerFrame = createInfo.uploadBudgetPerFrame;
+        contextInfo.preferredDevice = createInfo.preferredDevice;
+        contextInfo.enableBindless = createInfo.enableBindless || createInfo.gpuDriven;
+        if (createInfo.jobSystem && createInfo.jobSystem->IsInitialized()) {
+            contextInfo.recordingThreads = createInfo.jobSystem->GetThreadCount();
+        }
 
         m_graphicsContext = CreateGraphicsContext(contextInfo);
         if (!m_graphicsContext) {
@@ -39,12 +56,65 @@ namespace StellarAlia::Function::Graphics {
             return false;
         }
 
+        if (createInfo.api == GraphicsAPI::Vulkan) {
+            PipelineManagerCreateInfo pipelineInfo;
+            pipelineInfo.shaderDirectory = createInfo.shaderDirectory;
+            pipelineInfo.cachePath = createInfo.pipelineCachePath;
+#if defined(SA_SHADER_SOURCE_DIR)
+            // Development build: CMake points us at the GLSL sources and the compiler it used
+            pipelineInfo.shaderSourceDirectory = SA_SHADER_SOURCE_DIR;
+            pipelineInfo.shaderCompiler = SA_SHADER_COMPILER;
+            pipelineInfo.hotReloadShaders = createInfo.hotReloadShaders;
+#endif
+
+            DeferredRendererCreateInfo deferredInfo;
+            deferredInfo.layout = createInfo.gbufferLayout;
+            deferredInfo.subpassLighting = createInfo.subpassLighting;
+            deferredInfo.maxLights = createInfo.maxLights;
+
+            auto& vulkanContext = static_cast<VulkanGraphicsContext&>(*m_graphicsContext);
+            m_pipelineManager = std::make_unique<PipelineManager>();
+            m_renderGraph = std::make_unique<RenderGraph>();
+            m_deferredRenderer = std::make_unique<DeferredRenderer>();
+            if (!m_pipelineManager->Initialize(vulkanContext, pipelineInfo) ||
+                !m_renderGraph->Initialize(vulkanContext) ||
+                !m_deferredRenderer->Initialize(vulkanContext, *m_pipelineManager, deferredInfo)) {
+                m_deferredRenderer.reset();
+                m_renderGraph.reset();
+                m_pipelineManager.reset();
+                m_graphicsContext->Shutdown();
+                m_graphicsContext.reset();
+                return false;
+            }
+
+            if (createInfo.gpuDriven) {
+                GpuDrivenRendererCreateInfo gpuDrivenInfo;
+                gpuDrivenInfo.maxInstances = createInfo.maxInstances;
+
+                m_gpuDrivenRenderer = std::make_unique<GpuDrivenRenderer>();
+                if (!m_gpuDrivenRenderer->Initialize(vulkanContext, *m_pipelineManager, gpuDrivenInfo)) {
+                    m_gpuDrivenRenderer.reset();
+                    m_deferredRenderer->Shutdown();
+                    m_deferredRenderer.reset();
+                    m_renderGraph->Shutdown();
+                    m_renderGraph.reset();
+                    m_pipelineManager->Shutdown();
+                    m_pipelineManager.reset();
+                    m_graphicsContext->Shutdown();
+                    m_graphicsContext.reset();
+                    return false;
+                }
+                m_deferredRenderer->SetGpuDrivenRenderer(m_gpuDrivenRenderer.get());
+            }
+
+            m_renderGraph->SetJobSystem(createInfo.jobSystem);
+        }
+
         m_api = createInfo.api;
         m_initialized = true;
 
-        // TODO: Initialize ResourceManager and PipelineManager when implemented
+        // TODO: Initialize ResourceManager when implemented
         // m_resourceManager = CreateResourceManager(...);
-        // m_pipelineManager = CreatePipelineManager(...);
 
         return true;
     }
@@ -54,7 +124,22 @@ namespace StellarAlia::Function::Graphics {
             return;
         }
 
-        // TODO: Cleanup ResourceManager and PipelineManager when implemented
+        // TODO: Cleanup ResourceManager when implemented
+
+        // Pipelines must go before the device; shutting down also saves the pipeline cache
+        if (m_pipelineManager) {
+            m_graphicsContext->WaitIdle();
+            if (m_gpuDrivenRenderer) {
+                m_gpuDrivenRenderer->Shutdown();
+                m_gpuDrivenRenderer.reset();
+            }
+            m_deferredRenderer->Shutdown();
+            m_deferredRenderer.reset();
+            m_renderGraph->Shutdown();
+            m_renderGraph.reset();
+            m_pipelineManager->Shutdown();
+            m_pipelineManager.reset();
+        }
 
         if (m_graphicsContext) {
             m_graphicsContext->Shutdown();
@@ -64,7 +149,6 @@ namespace StellarAlia::Function::Graphics {
         m_camera = nullptr;
         m_scene = nullptr;
         m_resourceManager = nullptr;
-        m_pipelineManager = nullptr;
         m_initialized = false;
         m_api = GraphicsAPI::None;
     }
@@ -81,8 +165,34 @@ namespace StellarAlia::Function::Graphics {
             return;
         }
 
-        // TODO: Implement rendering logic using camera, scene, resources, and pipelines
-        // This will be implemented when Camera, Scene, ResourceManager, and PipelineManager are created
+        if (!m_renderGraph) {
+            return;
+        }
+        auto& vulkanContext = static_cast<VulkanGraphicsContext&>(*m_graphicsContext);
+        if (!vulkanContext.IsFrameActive()) {
+            return; // BeginFrame skipped the frame (minimized or swapchain out of date)
+        }
+
+        const VulkanBackbuffer backbuffer = vulkanContext.GetCurrentBackbuffer();
+        RenderGraphImportedTexture target;
+        target.image = backbuffer.image;
+        target.view = backbuffer.view;
+        target.format = backbuffer.format;
+        target.extent = backbuffer.extent;
+        target.initialStage = backbuffer.readyStage;
+        target.initialAccess = backbuffer.readyAccess;
+        target.finalLayout = backbuffer.finalLayout;
+
+        if (m_pipelineManager) {
+            m_pipelineManager->ReloadShaders();
+        }
+
+        m_renderGraph->Reset();
+        const RenderGraphResource output = m_renderGraph->ImportTexture("Backbuffer", target);
+        m_deferredRenderer->AddPasses(*m_renderGraph, output);
+        if (m_renderGraph->Compile()) {
+            m_renderGraph->Execute(vulkanContext.GetCurrentCommandBuffer());
+        }
     }
 
     void RenderSystem::EndFrame() {
@@ -138,7 +248,19 @@ namespace StellarAlia::Function::Graphics {
     }
 
     PipelineManager* RenderSystem::GetPipelineManager() const {
-        return m_pipelineManager;
+        return m_pipelineManager.get();
+    }
+
+    RenderGraph* RenderSystem::GetRenderGraph() const {
+        return m_renderGraph.get();
+    }
+
+    DeferredRenderer* RenderSystem::GetDeferredRenderer() const {
+        return m_deferredRenderer.get();
+    }
+
+    GpuDrivenRenderer* RenderSystem::GetGpuDrivenRenderer() const {
+        return m_gpuDrivenRenderer.get();
     }
 
     GraphicsAPI RenderSystem::GetAPI() const {
@@ -11,7 +11,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include "function/graphics/GraphicsContext.hpp"
+#include "function/graphics/DeferredRenderer.hpp"
+
+namespace StellarAlia::Core::Jobs { class JobSystem; }
 
 namespace StellarAlia::Function::Graphics
 {
@@ -26,11 +30,14 @@ namespace StellarAlia::Function::Graphics
     class Scene;
     class ResourceManager;
     class PipelineManager;
+    class RenderGraph;
+    class GpuDrivenRenderer;
 
     /**
      * @brief Render system creation parameters
      * 
      * Window is assumed to be already initialized before RenderSystem initialization.
+     * In headless mode no window is required and width/height set the offscreen resolution.
      */
     struct RenderSystemCreateInfo
     {
@@ -38,6 +45,24 @@ namespace StellarAlia::Function::Graphics
         std::shared_ptr<WindowSystem> window = nullptr;
         const char* applicationName = "StellarAlia Application";
         bool enableValidation = true;
+        bool headless = false;
+        uint32_t width = 1280;
+        uint32_t height = 720;
+        uint32_t framesInFlight = 2;
+        PresentPolicy presentPolicy;
+        uint64_t uploadRingSize = 64ull * 1024 * 1024;
+        uint64_t uploadBudgetPerFrame = 16ull * 1024 * 1024;
+        std::string preferredDevice;  // GPU name substring or UUID; empty = auto
+        bool enableBindless = false;  // Opt-in descriptor-indexing material path
+        std::string shaderDirectory = "shaders";                   // Compiled SPIR-V
+        std::string pipelineCachePath = "cache/pipeline_cache.bin"; // Empty = no persistent cache
+        bool hotReloadShaders = true;  // Development builds only: recompile and reload shaders edited on disk
+        bool subpassLighting = false;  // Tile-friendly deferred path: G-buffer read as subpass inputs
+        GBufferLayout gbufferLayout = GBufferLayout::Standard;
+        uint32_t maxLights = 4096;     // Point lights the clustered lighting pass accepts per frame
+        bool gpuDriven = false;        // Compute-culled indirect geometry; implies enableBindless
+        uint32_t maxInstances = 262144;
+        Core::Jobs::JobSystem* jobSystem = nullptr;  // Initialized job system for parallel command recording; nullptr = inline
     };
 
     /**
@@ -85,7 +110,8 @@ namespace StellarAlia::Function::Graphics
 
         /**
          * @brief Render the current frame
-         * Uses the camera, scene, resources, and pipelines to render.
+         * Builds this frame's render graph (G-buffer and lighting passes into the
+         * backbuffer), compiles it and records it into the frame command buffer.
          */
         void Render();
 
@@ -159,6 +185,24 @@ namespace StellarAlia::Function::Graphics
          */
         PipelineManager* GetPipelineManager() const;
 
+        /**
+         * @brief Get the render graph
+         * @return Pointer to the render graph, or nullptr if not initialized
+         */
+        RenderGraph* GetRenderGraph() const;
+
+        /**
+         * @brief Get the deferred renderer
+         * @return Pointer to the deferred renderer, or nullptr if not initialized
+         */
+        DeferredRenderer* GetDeferredRenderer() const;
+
+        /**
+         * @brief Get the GPU-driven renderer
+         * @return Pointer to the GPU-driven renderer, or nullptr unless created with gpuDriven
+         */
+        GpuDrivenRenderer* GetGpuDrivenRenderer() const;
+
         /**
          * @brief Get the graphics API type
          * @return The graphics API being used
@@ -189,7 +233,10 @@ namespace StellarAlia::Function::Graphics
         Camera* m_camera = nullptr;
         Scene* m_scene = nullptr;
         ResourceManager* m_resourceManager = nullptr;
-        PipelineManager* m_pipelineManager = nullptr;
+        std::unique_ptr<PipelineManager> m_pipelineManager;
+        std::unique_ptr<RenderGraph> m_renderGraph;
+        std::unique_ptr<DeferredRenderer> m_deferredRenderer;
+        std::unique_ptr<GpuDrivenRenderer> m_gpuDrivenRenderer;
 
         bool m_initialized = false;
         GraphicsAPI m_api = GraphicsAPI::None;
@@ -0,0 +1,305 @@
+#include "function/graphics/Scene.hpp"
+#include "core/jobs/JobSystem.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__AVX__)
+#define SA_SCENE_CULL_AVX 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SA_SCENE_CULL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace StellarAlia::Function::Graphics {
+
+    namespace {
+        // Fewer blocks than this per slice cost more to hand out than to cull
+        constexpr uint32_t MIN_BLOCKS_PER_SLICE = 256;
+
+        // More slices than threads, so threads that finish early can steal the remainder
+        constexpr uint32_t SLICES_PER_THREAD = 4;
+
+        // Box is outside a plane when its center is further behind the plane than the
+        // box's projected radius: dot(n, c) + d + dot(|n|, e) < 0
+#if defined(SA_SCENE_CULL_AVX)
+        struct PlaneLanes {
+            __m256 nx, ny, nz, d, ax, ay, az;
+        };
+
+        void BroadcastPlanes(const Frustum& frustum, PlaneLanes (&lanes)[6]) {
+            for (int p = 0; p < 6; p++) {
+                const float* plane = frustum.planes[p];
+                lanes[p] = { _mm256_set1_ps(plane[0]), _mm256_set1_ps(plane[1]), _mm256_set1_ps(plane[2]),
+                             _mm256_set1_ps(plane[3]), _mm256_set1_ps(std::abs(plane[0])),
+                             _mm256_set1_ps(std::abs(plane[1])), _mm256_set1_ps(std::abs(plane[2])) };
+            }
+        }
+
+        uint32_t TestBlock(const PlaneLanes (&lanes)[6], const float* cx, const float* cy, const float* cz,
+                           const float* ex, const float* ey, const float* ez) {
+            const __m256 centerX = _mm256_loadu_ps(cx);
+            const __m256 centerY = _mm256_loadu_ps(cy);
+            const __m256 centerZ = _mm256_loadu_ps(cz);
+            const __m256 extentX = _mm256_loadu_ps(ex);
+            const __m256 extentY = _mm256_loadu_ps(ey);
+            const __m256 extentZ = _mm256_loadu_ps(ez);
+            const __m256 zero = _mm256_setzero_ps();
+
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (const PlaneLanes& plane : lanes) {
+                __m256 distance = _mm256_add_ps(_mm256_mul_ps(plane.nx, centerX), plane.d);
+                distance = _mm256_add_ps(distance, _mm256_mul_ps(plane.ny, centerY));
+                distance = _mm256_add_ps(distance, _mm256_mul_ps(plane.nz, centerZ));
+                __m256 radius = _mm256_mul_ps(plane.ax, extentX);
+                radius = _mm256_add_ps(radius, _mm256_mul_ps(plane.ay, extentY));
+                radius = _mm256_add_ps(radius, _mm256_mul_ps(plane.az, extentZ));
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+            }
+            return static_cast<uint32_t>(_mm256_movemask_ps(inside));
+        }
+#elif defined(SA_SCENE_CULL_SSE2)
+        struct PlaneLanes {
+            __m128 nx, ny, nz, d, ax, ay, az;
+        };
+
+        void BroadcastPlanes(const Frustum& frustum, PlaneLanes (&lanes)[6]) {
+            for (int p = 0; p < 6; p++) {
+                const float* plane = frustum.planes[p];
+                lanes[p] = { _mm_set1_ps(plane[0]), _mm_set1_ps(plane[1]), _mm_set1_ps(plane[2]),
+                             _mm_set1_ps(plane[3]), _mm_set1_ps(std::abs(plane[0])), _mm_set1_ps(std::abs(plane[1])),
+                             _mm_set1_ps(std::abs(plane[2])) };
+            }
+        }
+
+        uint32_t TestQuad(const PlaneLanes (&lanes)[6], const float* cx, const float* cy, const float* cz,
+                          const float* ex, const float* ey, const float* ez) {
+            const __m128 centerX = _mm_loadu_ps(cx);
+            const __m128 centerY = _mm_loadu_ps(cy);
+            const __m128 centerZ = _mm_loadu_ps(cz);
+            const __m128 extentX = _mm_loadu_ps(ex);
+            const __m128 extentY = _mm_loadu_ps(ey);
+            const __m128 extentZ = _mm_loadu_ps(ez);
+            const __m128 zero = _mm_setzero_ps();
+
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (const PlaneLanes& plane : lanes) {
+                __m128 distance = _mm_add_ps(_mm_mul_ps(plane.nx, centerX), plane.d);
+                distance = _mm_add_ps(distance, _mm_mul_ps(plane.ny, centerY));
+                distance = _mm_add_ps(distance, _mm_mul_ps(plane.nz, centerZ));
+                __m128 radius = _mm_mul_ps(plane.ax, extentX);
+                radius = _mm_add_ps(radius, _mm_mul_ps(plane.ay, extentY));
+                radius = _mm_add_ps(radius, _mm_mul_ps(plane.az, extentZ));
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+            }
+            return static_cast<uint32_t>(_mm_movemask_ps(inside));
+        }
+
+        uint32_t TestBlock(const PlaneLanes (&lanes)[6], const float* cx, const float* cy, const float* cz,
+                           const float* ex, const float* ey, const float* ez) {
+            return TestQuad(lanes, cx, cy, cz, ex, ey, ez) |
+                   (TestQuad(lanes, cx + 4, cy + 4, cz + 4, ex + 4, ey + 4, ez + 4) << 4);
+        }
+#else
+        struct PlaneLanes {
+            float nx, ny, nz, d, ax, ay, az;
+        };
+
+        void BroadcastPlanes(const Frustum& frustum, PlaneLanes (&lanes)[6]) {
+            for (int p = 0; p < 6; p++) {
+                const float* plane = frustum.planes[p];
+                lanes[p] = { plane[0], plane[1], plane[2], plane[3],
+                             std::abs(plane[0]), std::abs(plane[1]), std::abs(plane[2]) };
+            }
+        }
+
+        uint32_t TestBlock(const PlaneLanes (&lanes)[6], const float* cx, const float* cy, const float* cz,
+                           const float* ex, const float* ey, const float* ez) {
+            uint32_t mask = 0;
+            for (uint32_t i = 0; i < Scene::CULL_BLOCK_SIZE; i++) {
+                bool inside = true;
+                for (const PlaneLanes& plane : lanes) {
+                    const float distance = plane.nx * cx[i] + plane.ny * cy[i] + plane.nz * cz[i] + plane.d;
+                    const float radius = plane.ax * ex[i] + plane.ay * ey[i] + plane.az * ez[i];
+                    inside = inside && distance + radius >= 0.0f;
+                }
+                mask |= static_cast<uint32_t>(inside) << i;
+            }
+            return mask;
+        }
+#endif
+    }
+
+    Frustum Frustum::FromViewProjection(const float (&viewProjection)[16]) {
+        // Gribb-Hartmann extraction for Vulkan clip space (0 <= z <= w)
+        const auto row = [&viewProjection](int r, int c) { return viewProjection[c * 4 + r]; };
+        Frustum frustum;
+        for (int c = 0; c < 4; c++) {
+            frustum.planes[0][c] = row(3, c) + row(0, c);  // Left
+            frustum.planes[1][c] = row(3, c) - row(0, c);  // Right
+            frustum.planes[2][c] = row(3, c) + row(1, c);  // Top (Vulkan y points down)
+            frustum.planes[3][c] = row(3, c) - row(1, c);  // Bottom
+            frustum.planes[4][c] = row(2, c);              // Near
+            frustum.planes[5][c] = row(3, c) - row(2, c);  // Far
+        }
+        for (auto& plane : frustum.planes) {
+            const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+            if (length > 0.0f) {
+                for (float& value : plane) {
+                    value /= length;
+                }
+            }
+        }
+        return frustum;
+    }
+
+    SceneObjectHandle Scene::AddObject(const SceneBounds& bounds, uint32_t userData) {
+        uint32_t id;
+        if (!m_freeIds.empty()) {
+            id = m_freeIds.back();
+            m_freeIds.pop_back();
+        } else {
+            id = static_cast<uint32_t>(m_idToIndex.size());
+            m_idToIndex.push_back(UINT32_MAX);
+        }
+
+        const uint32_t index = GetObjectCount();
+        m_userData.push_back(userData);
+        m_indexToId.push_back(id);
+        m_idToIndex[id] = index;
+        ResizeBounds(index + 1);
+        WriteBounds(index, bounds);
+        return { id };
+    }
+
+    void Scene::RemoveObject(SceneObjectHandle object) {
+        const uint32_t index = GetIndex(object);
+        if (index == UINT32_MAX) {
+            return;
+        }
+
+        const uint32_t last = GetObjectCount() - 1;
+        if (index != last) {
+            m_centerX[index] = m_centerX[last];
+            m_centerY[index] = m_centerY[last];
+            m_centerZ[index] = m_centerZ[last];
+            m_extentX[index] = m_extentX[last];
+            m_extentY[index] = m_extentY[last];
+            m_extentZ[index] = m_extentZ[last];
+            m_userData[index] = m_userData[last];
+            m_indexToId[index] = m_indexToId[last];
+            m_idToIndex[m_indexToId[index]] = index;
+        }
+        m_userData.pop_back();
+        m_indexToId.pop_back();
+        m_idToIndex[object.id] = UINT32_MAX;
+        m_freeIds.push_back(object.id);
+        ResizeBounds(last);
+    }
+
+    void Scene::SetBounds(SceneObjectHandle object, const SceneBounds& bounds) {
+        const uint32_t index = GetIndex(object);
+        if (index != UINT32_MAX) {
+            WriteBounds(index, bounds);
+        }
+    }
+
+    void Scene::Clear() {
+        m_centerX.clear();
+        m_centerY.clear();
+        m_centerZ.clear();
+        m_extentX.clear();
+        m_extentY.clear();
+        m_extentZ.clear();
+        m_userData.clear();
+        m_indexToId.clear();
+        m_idToIndex.clear();
+        m_freeIds.clear();
+    }
+
+    uint32_t Scene::GetIndex(SceneObjectHandle object) const {
+        if (!object.IsValid() || object.id >= m_idToIndex.size()) {
+            return UINT32_MAX;
+        }
+        return m_idToIndex[object.id];
+    }
+
+    uint32_t Scene::CullRange(const Frustum& frustum, uint32_t firstBlock, uint32_t blockCount,
+                              uint32_t* outIndices) const {
+        const uint32_t objectCount = GetObjectCount();
+        const uint32_t endBlock = std::min(firstBlock + blockCount, GetCullBlockCount());
+
+        PlaneLanes lanes[6];
+        BroadcastPlanes(frustum, lanes);
+
+        uint32_t written = 0;
+        for (uint32_t block = firstBlock; block < endBlock; block++) {
+            const uint32_t base = block * CULL_BLOCK_SIZE;
+            uint32_t mask = TestBlock(lanes, &m_centerX[base], &m_centerY[base], &m_centerZ[base], &m_extentX[base],
+                                      &m_extentY[base], &m_extentZ[base]);
+            if (objectCount - base < CULL_BLOCK_SIZE) {
+                mask &= (1u << (objectCount - base)) - 1u;  // Padding lanes
+            }
+
+            // Emit the visible lanes in ascending order
+            while (mask != 0) {
+                outIndices[written++] = base + static_cast<uint32_t>(std::countr_zero(mask));
+                mask &= mask - 1u;
+            }
+        }
+        return written;
+    }
+
+    void Scene::Cull(const Frustum& frustum, std::vector<uint32_t>& visible, Core::Jobs::JobSystem* jobs) const {
+        const uint32_t blockCount = GetCullBlockCount();
+        visible.resize(static_cast<size_t>(blockCount) * CULL_BLOCK_SIZE);
+
+        const uint32_t maxSlices = jobs && jobs->IsInitialized() ? jobs->GetThreadCount() * SLICES_PER_THREAD : 1;
+        uint32_t sliceCount = std::clamp(blockCount / MIN_BLOCKS_PER_SLICE, 1u, maxSlices);
+        if (sliceCount == 1) {
+            visible.resize(CullRange(frustum, 0, blockCount, visible.data()));
+            return;
+        }
+
+        // Each slice writes into its own part of the list, then the parts are packed in order
+        const uint32_t blocksPerSlice = (blockCount + sliceCount - 1) / sliceCount;
+        sliceCount = (blockCount + blocksPerSlice - 1) / blocksPerSlice;
+        std::vector<uint32_t> counts(sliceCount, 0);
+        jobs->ParallelFor(sliceCount, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t slice = begin; slice < end; slice++) {
+                const uint32_t first = slice * blocksPerSlice;
+                counts[slice] = CullRange(frustum, first, blocksPerSlice, visible.data() + first * CULL_BLOCK_SIZE);
+            }
+        });
+
+        size_t written = counts[0];
+        for (uint32_t slice = 1; slice < sliceCount; slice++) {
+            const auto* part = visible.data() + static_cast<size_t>(slice) * blocksPerSlice * CULL_BLOCK_SIZE;
+            std::copy(part, part + counts[slice], visible.data() + written);
+            written += counts[slice];
+        }
+        visible.resize(written);
+    }
+
+    void Scene::WriteBounds(uint32_t index, const SceneBounds& bounds) {
+        m_centerX[index] = bounds.center[0];
+        m_centerY[index] = bounds.center[1];
+        m_centerZ[index] = bounds.center[2];
+        m_extentX[index] = bounds.extent[0];
+        m_extentY[index] = bounds.extent[1];
+        m_extentZ[index] = bounds.extent[2];
+    }
+
+    void Scene::ResizeBounds(uint32_t count) {
+        const size_t padded = static_cast<size_t>((count + CULL_BLOCK_SIZE - 1) / CULL_BLOCK_SIZE) * CULL_BLOCK_SIZE;
+        if (padded == m_centerX.size()) {
+            return;
+        }
+        for (std::vector<float>* component : { &m_centerX, &m_centerY, &m_centerZ, &m_extentX, &m_extentY, &m_extentZ }) {
+            component->resize(padded, 0.0f);
+        }
+    }
+
+} // namespace StellarAlia::Function::Graphics
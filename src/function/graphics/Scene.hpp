@@ -0,0 +1,169 @@
+#pragma once
+
+/**
+ * @file Scene.hpp
+ * @brief Renderable objects and CPU frustum culling
+ *
+ * Object bounds are axis-aligned boxes stored as structure-of-arrays (one float array
+ * per center and extent component), so culling streams six arrays linearly and tests
+ * 8 boxes per iteration with AVX, 4 with SSE2, or one at a time elsewhere. The result
+ * is a compact list of visible object indices.
+ *
+ * Culling only reads the scene, so several views, or disjoint ranges of one view, can
+ * be culled concurrently from different threads.
+ */
+
+#include <cstdint>
+#include <vector>
+
+namespace StellarAlia::Core::Jobs {
+    class JobSystem;
+}
+
+namespace StellarAlia::Function::Graphics {
+
+    /**
+     * @brief Axis-aligned bounding box in world space
+     */
+    struct SceneBounds {
+        float center[3] = {};
+        float extent[3] = {};  // Half size along each axis
+    };
+
+    /**
+     * @brief Six clip planes (ax + by + cz + d >= 0 inside)
+     */
+    struct Frustum {
+        float planes[6][4] = {};  // Left, right, top, bottom, near, far
+
+        /**
+         * @brief Extract normalized planes from a view-projection matrix
+         * @param viewProjection Column-major view-projection matrix (Vulkan clip space, 0 <= z <= w)
+         * @return Frustum
+         */
+        static Frustum FromViewProjection(const float (&viewProjection)[16]);
+    };
+
+    /**
+     * @brief Handle to a scene object; stays valid until the object is removed
+     */
+    struct SceneObjectHandle {
+        uint32_t id = UINT32_MAX;
+        bool IsValid() const { return id != UINT32_MAX; }
+    };
+
+    /**
+     * @brief Flat list of renderable objects with their bounds
+     *
+     * Objects are densely packed: removing one moves the last object into its index, so
+     * indices returned by culling are only valid until the next removal. Handles stay
+     * stable. Not thread-safe for modification.
+     */
+    class Scene {
+    public:
+        /**
+         * @brief Objects per culling block; ranges passed to CullRange are block-aligned
+         */
+        static constexpr uint32_t CULL_BLOCK_SIZE = 8;
+
+        /**
+         * @brief Add an object
+         * @param bounds World-space bounds
+         * @param userData Caller-defined payload, e.g. a GPU instance id
+         * @return Object handle
+         */
+        SceneObjectHandle AddObject(const SceneBounds& bounds, uint32_t userData = 0);
+
+        /**
+         * @brief Remove an object (the last object takes its index)
+         * @param object Object handle
+         */
+        void RemoveObject(SceneObjectHandle object);
+
+        /**
+         * @brief Move or resize an object
+         * @param object Object handle
+         * @param bounds World-space bounds
+         */
+        void SetBounds(SceneObjectHandle object, const SceneBounds& bounds);
+
+        /**
+         * @brief Remove every object
+         */
+        void Clear();
+
+        /**
+         * @brief Get the number of objects
+         * @return Object count
+         */
+        uint32_t GetObjectCount() const { return static_cast<uint32_t>(m_userData.size()); }
+
+        /**
+         * @brief Get the dense index of an object
+         * @param object Object handle
+         * @return Index, or UINT32_MAX if the handle is stale
+         */
+        uint32_t GetIndex(SceneObjectHandle object) const;
+
+        /**
+         * @brief Get the handle of the object at an index
+         * @param index Dense index, e.g. from a visible list
+         * @return Object handle
+         */
+        SceneObjectHandle GetHandle(uint32_t index) const { return { m_indexToId[index] }; }
+
+        /**
+         * @brief Get the payload of the object at an index
+         * @param index Dense index, e.g. from a visible list
+         * @return Payload given to AddObject
+         */
+        uint32_t GetUserData(uint32_t index) const { return m_userData[index]; }
+
+        /**
+         * @brief Get the number of culling blocks
+         * @return Blocks of CULL_BLOCK_SIZE objects (the last may be partial)
+         */
+        uint32_t GetCullBlockCount() const { return (GetObjectCount() + CULL_BLOCK_SIZE - 1) / CULL_BLOCK_SIZE; }
+
+        /**
+         * @brief Cull a range of blocks; safe to call concurrently on the same scene
+         * @param frustum View frustum
+         * @param firstBlock First block to test
+         * @param blockCount Number of blocks to test
+         * @param outIndices Receives the visible indices, in ascending order; needs room for
+         *                   blockCount * CULL_BLOCK_SIZE entries
+         * @return Number of visible objects written
+         */
+        uint32_t CullRange(const Frustum& frustum, uint32_t firstBlock, uint32_t blockCount,
+                           uint32_t* outIndices) const;
+
+        /**
+         * @brief Cull the whole scene
+         * With a job system the blocks are split into contiguous slices culled as jobs and
+         * concatenated, so the list is in the same order either way.
+         * @param frustum View frustum
+         * @param visible Receives the visible indices, in ascending order
+         * @param jobs Job system to spread the work over, or nullptr to cull on the calling thread
+         */
+        void Cull(const Frustum& frustum, std::vector<uint32_t>& visible, Core::Jobs::JobSystem* jobs = nullptr) const;
+
+    private:
+        // One array per component, padded to a whole number of blocks so SIMD loads
+        // of the last block stay in bounds
+        std::vector<float> m_centerX;
+        std::vector<float> m_centerY;
+        std::vector<float> m_centerZ;
+        std::vector<float> m_extentX;
+        std::vector<float> m_extentY;
+        std::vector<float> m_extentZ;
+
+        std::vector<uint32_t> m_userData;
+        std::vector<uint32_t> m_indexToId;
+        std::vector<uint32_t> m_idToIndex;
+        std::vector<uint32_t> m_freeIds;
+
+        void WriteBounds(uint32_t index, const SceneBounds& bounds);
+        void ResizeBounds(uint32_t count);
+    };
+
+} // namespace StellarAlia::Function::Graphics
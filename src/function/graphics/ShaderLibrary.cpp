@@ -0,0 +1,375 @@
+#include "function/graphics/ShaderLibrary.hpp"
+#include "function/graphics/vulkan/VulkanGraphicsContext.hpp"
+#include "core/utils/Hash.hpp"
+#include "core/logs/Log.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <unordered_set>
+
+namespace StellarAlia::Function::Graphics {
+
+    namespace {
+        // How often Reload() looks at the files; stat-ing every shader each frame is wasted work
+        constexpr auto HOT_RELOAD_POLL_INTERVAL = std::chrono::milliseconds(250);
+
+        double ElapsedMs(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        std::filesystem::file_time_type GetWriteTime(const std::filesystem::path& path) {
+            std::error_code ec;
+            const auto time = std::filesystem::last_write_time(path, ec);
+            return ec ? std::filesystem::file_time_type::min() : time;
+        }
+
+        bool ReadText(const std::filesystem::path& path, std::string& text) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) {
+                return false;
+            }
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            text = std::move(contents).str();
+            return true;
+        }
+
+        // Name inside #include "name" or #include <name>; empty if the line is not an include
+        std::string_view ParseInclude(std::string_view line) {
+            const auto skipSpaces = [&line]() {
+                while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) {
+                    line.remove_prefix(1);
+                }
+            };
+            skipSpaces();
+            if (line.empty() || line.front() != '#') {
+                return {};
+            }
+            line.remove_prefix(1);
+            skipSpaces();
+            constexpr std::string_view directive = "include";
+            if (line.substr(0, directive.size()) != directive) {
+                return {};
+            }
+            line.remove_prefix(directive.size());
+            skipSpaces();
+            if (line.empty() || (line.front() != '"' && line.front() != '<')) {
+                return {};
+            }
+            const char close = line.front() == '"' ? '"' : '>';
+            line.remove_prefix(1);
+            const size_t end = line.find(close);
+            return end == std::string_view::npos ? std::string_view{} : line.substr(0, end);
+        }
+
+        // "lighting.frag.spv" -> "lighting.frag"; empty for files that are not .spv
+        std::filesystem::path GetSourceName(const std::string& path) {
+            std::filesystem::path name = path;
+            if (name.extension() != ".spv") {
+                return {};
+            }
+            return name.replace_extension();
+        }
+    }
+
+    ShaderLibrary::~ShaderLibrary() {
+        Shutdown();
+    }
+
+    bool ShaderLibrary::Initialize(VulkanGraphicsContext& context, const ShaderLibraryCreateInfo& createInfo) {
+        if (m_device != VK_NULL_HANDLE) {
+            SA_LOG_WARN("ShaderLibrary already initialized");
+            return false;
+        }
+        if (context.GetDevice() == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("ShaderLibrary requires an initialized Vulkan context");
+            return false;
+        }
+
+        m_context = &context;
+        m_device = context.GetDevice();
+        m_spirvDirectory = createInfo.spirvDirectory;
+        m_sourceDirectory = createInfo.sourceDirectory;
+        m_includeDirectories = createInfo.includeDirectories;
+        m_compilerPath = createInfo.compilerPath;
+        m_hotReload = createInfo.hotReload;
+        m_lastPoll = std::chrono::steady_clock::now();
+        m_stats = {};
+
+        if (m_hotReload) {
+            SA_LOG_INFO("Shader hot reload enabled ({})", m_compilerPath.empty()
+                                                              ? "reloading rebuilt SPIR-V"
+                                                              : "recompiling from " + m_sourceDirectory.string());
+        }
+        return true;
+    }
+
+    void ShaderLibrary::Shutdown() {
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SA_LOG_INFO("Shaders: {} loaded into {} modules ({} shared), {} reloaded, {:.2f} ms loading",
+                    m_shaders.size(), m_modules.size(), m_stats.sharedModules, m_stats.reloads, m_stats.loadTimeMs);
+
+        // Destroy immediately rather than deferred: the caller guarantees the GPU is idle
+        for (auto& [key, module] : m_modules) {
+            vkDestroyShaderModule(m_device, module.module, nullptr);
+        }
+        m_modules.clear();
+        m_shaders.clear();
+
+        m_device = VK_NULL_HANDLE;
+        m_context = nullptr;
+    }
+
+    VkShaderModule ShaderLibrary::GetModule(const std::string& path) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_device == VK_NULL_HANDLE) {
+            return VK_NULL_HANDLE;
+        }
+        auto it = m_shaders.find(path);
+        if (it != m_shaders.end()) {
+            return m_modules.at(it->second.key).module;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        Shader shader;
+        std::vector<uint32_t> code;
+        if (!LoadShader(path, shader, code)) {
+            return VK_NULL_HANDLE;
+        }
+        VkShaderModule module = AcquireModule(shader.key, code, path);
+        if (module == VK_NULL_HANDLE) {
+            return VK_NULL_HANDLE;
+        }
+        m_shaders.emplace(path, std::move(shader));
+        m_stats.loadTimeMs += ElapsedMs(start);
+        return module;
+    }
+
+    std::vector<std::string> ShaderLibrary::Reload() {
+        std::vector<std::string> changed;
+        if (!m_hotReload) {
+            return changed;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto now = std::chrono::steady_clock::now();
+        if (m_device == VK_NULL_HANDLE || now - m_lastPoll < HOT_RELOAD_POLL_INTERVAL) {
+            return changed;
+        }
+        m_lastPoll = now;
+
+        const auto refreshStamps = [](std::vector<FileStamp>& files) {
+            for (FileStamp& file : files) {
+                file.writeTime = GetWriteTime(file.path);
+            }
+        };
+
+        for (auto& [path, shader] : m_shaders) {
+            bool filesChanged = false;
+            for (const FileStamp& file : shader.files) {
+                filesChanged = filesChanged || GetWriteTime(file.path) != file.writeTime;
+            }
+            if (!filesChanged) {
+                continue;
+            }
+
+            // files[0] is the .spv. If only the sources moved, either rebuild it here or wait
+            // for the build to, rather than reloading the old binary under a new key.
+            const std::filesystem::path spirvPath = m_spirvDirectory / path;
+            if (GetWriteTime(spirvPath) == shader.files.front().writeTime) {
+                const std::filesystem::path source = m_sourceDirectory / GetSourceName(path);
+                std::vector<FileStamp> sourceFiles;
+                const bool stale = shader.sourceHash != 0 && HashSource(source, sourceFiles) != shader.sourceHash;
+                if (!stale || m_compilerPath.empty()) {
+                    refreshStamps(shader.files);
+                    continue;
+                }
+                if (!Compile(source, spirvPath)) {
+                    m_stats.reloadFailures++;
+                    refreshStamps(shader.files);
+                    continue;
+                }
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            Shader updated;
+            std::vector<uint32_t> code;
+            if (!LoadShader(path, updated, code)) {
+                m_stats.reloadFailures++;
+                refreshStamps(shader.files);
+                continue;
+            }
+            if (updated.key == shader.key) {
+                shader = std::move(updated);  // Touched but identical
+                continue;
+            }
+            if (AcquireModule(updated.key, code, path) == VK_NULL_HANDLE) {
+                m_stats.reloadFailures++;
+                refreshStamps(shader.files);
+                continue;
+            }
+            ReleaseModule(shader.key);
+            shader = std::move(updated);
+            m_stats.reloads++;
+            m_stats.loadTimeMs += ElapsedMs(start);
+            changed.push_back(path);
+            SA_LOG_INFO("Reloaded shader {}", path);
+        }
+        return changed;
+    }
+
+    ShaderLibraryStats ShaderLibrary::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    bool ShaderLibrary::LoadShader(const std::string& path, Shader& shader, std::vector<uint32_t>& code) {
+        const std::filesystem::path fullPath = m_spirvDirectory / path;
+        std::ifstream file(fullPath, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            SA_LOG_ERROR("Failed to open shader {}", fullPath.string());
+            return false;
+        }
+
+        const std::streamsize size = file.tellg();
+        if (size <= 0 || size % 4 != 0) {
+            SA_LOG_ERROR("Shader {} is not valid SPIR-V ({} bytes)", fullPath.string(), static_cast<int64_t>(size));
+            return false;
+        }
+        code.resize(static_cast<size_t>(size) / 4);
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(code.data()), size)) {
+            SA_LOG_ERROR("Failed to read shader {}", fullPath.string());
+            return false;
+        }
+
+        shader.files.clear();
+        shader.files.push_back({ fullPath, GetWriteTime(fullPath) });
+        shader.sourceHash = 0;
+        if (!m_sourceDirectory.empty() && !GetSourceName(path).empty()) {
+            shader.sourceHash = HashSource(m_sourceDirectory / GetSourceName(path), shader.files);
+        }
+
+        // The SPIR-V is part of the key too, so a .spv that is stale relative to its source
+        // never shares a module with an up-to-date one
+        const uint64_t seed = shader.sourceHash != 0 ? shader.sourceHash : Core::Hash::FNV_OFFSET_BASIS;
+        shader.key = Core::Hash::Fnv1a(code.data(), code.size() * sizeof(uint32_t), seed);
+        return true;
+    }
+
+    uint64_t ShaderLibrary::HashSource(const std::filesystem::path& source, std::vector<FileStamp>& files) const {
+        uint64_t hash = Core::Hash::FNV_OFFSET_BASIS;
+        std::unordered_set<std::string> visited;
+
+        // Depth-first in include order; each file is hashed once, like an include guard would
+        const auto hashFile = [&](const auto& self, const std::filesystem::path& path) -> bool {
+            const std::filesystem::path normal = path.lexically_normal();
+            if (!visited.insert(normal.generic_string()).second) {
+                return true;
+            }
+            std::string text;
+            if (!ReadText(normal, text)) {
+                return false;
+            }
+            files.push_back({ normal, GetWriteTime(normal) });
+            Core::Hash::Combine(hash, text);
+
+            std::string_view remaining = text;
+            while (!remaining.empty()) {
+                const size_t end = remaining.find('\n');
+                const std::string_view line = remaining.substr(0, end);
+                remaining = end == std::string_view::npos ? std::string_view{} : remaining.substr(end + 1);
+
+                const std::string_view name = ParseInclude(line);
+                if (name.empty()) {
+                    continue;
+                }
+                bool found = false;
+                std::error_code ec;
+                const std::filesystem::path local = normal.parent_path() / name;
+                if (std::filesystem::exists(local, ec)) {
+                    found = self(self, local);
+                }
+                for (size_t i = 0; !found && i < m_includeDirectories.size(); i++) {
+                    const std::filesystem::path candidate = m_includeDirectories[i] / name;
+                    if (std::filesystem::exists(candidate, ec)) {
+                        found = self(self, candidate);
+                    }
+                }
+                if (!found) {
+                    SA_LOG_WARN("Shader source {} includes {}, which was not found", normal.string(), name);
+                    Core::Hash::Combine(hash, name);
+                }
+            }
+            return true;
+        };
+
+        return hashFile(hashFile, source) ? hash : 0;
+    }
+
+    bool ShaderLibrary::Compile(const std::filesystem::path& source, const std::filesystem::path& output) const {
+        // glslc infers the stage from the source extension, as in CompileShaders.cmake
+        std::string command = "\"" + m_compilerPath.string() + "\"";
+        for (const auto& include : m_includeDirectories) {
+            command += " -I\"" + include.string() + "\"";
+        }
+        command += " \"" + source.string() + "\" -o \"" + output.string() + "\"";
+#if defined(_WIN32)
+        // cmd.exe strips the outermost pair of quotes
+        command = "\"" + command + "\"";
+#endif
+
+        SA_LOG_INFO("Recompiling shader {}", source.string());
+        const int status = std::system(command.c_str());
+        if (status != 0) {
+            SA_LOG_ERROR("Failed to compile shader {} (status {}); keeping the previous version", source.string(),
+                         status);
+            return false;
+        }
+        return true;
+    }
+
+    VkShaderModule ShaderLibrary::AcquireModule(uint64_t key, const std::vector<uint32_t>& code,
+                                                const std::string& path) {
+        auto it = m_modules.find(key);
+        if (it != m_modules.end()) {
+            it->second.shaders++;
+            m_stats.sharedModules++;
+            return it->second.module;
+        }
+
+        VkShaderModuleCreateInfo moduleInfo{};
+        moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleInfo.codeSize = code.size() * sizeof(uint32_t);
+        moduleInfo.pCode = code.data();
+
+        VkShaderModule module = VK_NULL_HANDLE;
+        VkResult result = vkCreateShaderModule(m_device, &moduleInfo, nullptr, &module);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create shader module for {} (VkResult {})", path, static_cast<int>(result));
+            return VK_NULL_HANDLE;
+        }
+        m_modules.emplace(key, Module{ module, 1 });
+        m_stats.modulesCreated++;
+        return module;
+    }
+
+    void ShaderLibrary::ReleaseModule(uint64_t key) {
+        auto it = m_modules.find(key);
+        if (it == m_modules.end() || --it->second.shaders > 0) {
+            return;
+        }
+        // Another thread may be creating a pipeline from it right now
+        m_context->DeferDestruction([device = m_device, module = it->second.module]() {
+            vkDestroyShaderModule(device, module, nullptr);
+        });
+        m_modules.erase(it);
+    }
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,149 @@
+#pragma once
+
+/**
+ * @file ShaderLibrary.hpp
+ * @brief SPIR-V loading, content-keyed shader module cache and shader hot reload
+ *
+ * Shaders are requested by the path of their compiled .spv file. When the GLSL sources
+ * are available (development builds), a module's key hashes the source together with
+ * every file it includes, so editing a shared include changes the key of each shader
+ * that uses it. Shaders whose key matches an existing module share that VkShaderModule.
+ *
+ * With hot reload enabled, Reload() checks the files each shader was built from. Shaders
+ * whose sources changed are recompiled with the configured compiler (or, without one,
+ * picked up once the build has rewritten their .spv), and their modules are replaced.
+ *
+ * Only the Vulkan backend is implemented.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace StellarAlia::Function::Graphics {
+
+    class VulkanGraphicsContext;
+
+    /**
+     * @brief Shader library creation parameters
+     */
+    struct ShaderLibraryCreateInfo {
+        std::filesystem::path spirvDirectory = "shaders";  // Compiled .spv files
+        std::filesystem::path sourceDirectory;             // GLSL sources; empty = key modules by SPIR-V only
+        std::vector<std::filesystem::path> includeDirectories;  // Searched after the including file's directory
+        std::filesystem::path compilerPath;                // glslc for recompiling on reload; empty = reload .spv only
+        bool hotReload = false;
+    };
+
+    /**
+     * @brief Shader library statistics
+     */
+    struct ShaderLibraryStats {
+        uint32_t modulesCreated = 0;
+        uint32_t sharedModules = 0;  // Shader loads answered by another shader's module
+        uint32_t reloads = 0;        // Shaders replaced by hot reload
+        uint32_t reloadFailures = 0; // Changed shaders that kept their old module
+        double loadTimeMs = 0.0;     // Reading, hashing and creating modules
+    };
+
+    /**
+     * @brief Owns every shader module created through it
+     *
+     * Thread-safe. Modules live until their last shader is reloaded or Shutdown().
+     */
+    class ShaderLibrary {
+    public:
+        ShaderLibrary() = default;
+        ~ShaderLibrary();
+
+        ShaderLibrary(const ShaderLibrary&) = delete;
+        ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+        /**
+         * @brief Bind the library to a context
+         * @param context Initialized Vulkan context
+         * @param createInfo Creation parameters
+         * @return True on success
+         */
+        bool Initialize(VulkanGraphicsContext& context, const ShaderLibraryCreateInfo& createInfo);
+
+        /**
+         * @brief Destroy every module (the GPU must be idle)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Get or load the module of a shader
+         * @param path SPIR-V file, relative to the SPIR-V directory (e.g. "pbr.frag.spv")
+         * @return Module, or VK_NULL_HANDLE on failure
+         */
+        VkShaderModule GetModule(const std::string& path);
+
+        /**
+         * @brief Replace the modules of shaders whose files changed on disk
+         * Does nothing unless hot reload is enabled, and checks the files at most every
+         * few hundred milliseconds, so it may be called every frame. Replaced modules are
+         * destroyed once no frame in flight can use them.
+         * @return Paths of the shaders whose module changed
+         */
+        std::vector<std::string> Reload();
+
+        bool IsHotReloadEnabled() const { return m_hotReload; }
+
+        /**
+         * @brief Get statistics
+         * @return Snapshot of the counters
+         */
+        ShaderLibraryStats GetStats() const;
+
+    private:
+        struct FileStamp {
+            std::filesystem::path path;
+            std::filesystem::file_time_type writeTime;
+        };
+
+        // A loaded shader: the module it uses and the files it was built from
+        struct Shader {
+            uint64_t key = 0;
+            uint64_t sourceHash = 0;          // Source and includes; 0 without sources
+            std::vector<FileStamp> files;     // The .spv first, then the source and its includes
+        };
+
+        struct Module {
+            VkShaderModule module = VK_NULL_HANDLE;
+            uint32_t shaders = 0;  // Shaders using the module
+        };
+
+        VulkanGraphicsContext* m_context = nullptr;
+        VkDevice m_device = VK_NULL_HANDLE;
+        std::filesystem::path m_spirvDirectory;
+        std::filesystem::path m_sourceDirectory;
+        std::vector<std::filesystem::path> m_includeDirectories;
+        std::filesystem::path m_compilerPath;
+        bool m_hotReload = false;
+        std::chrono::steady_clock::time_point m_lastPoll;
+
+        std::unordered_map<std::string, Shader> m_shaders;
+        std::unordered_map<uint64_t, Module> m_modules;
+
+        ShaderLibraryStats m_stats;
+        mutable std::mutex m_mutex;
+
+        bool LoadShader(const std::string& path, Shader& shader, std::vector<uint32_t>& code);
+        uint64_t HashSource(const std::filesystem::path& source, std::vector<FileStamp>& files) const;
+        bool Compile(const std::filesystem::path& source, const std::filesystem::path& output) const;
+        VkShaderModule AcquireModule(uint64_t key, const std::vector<uint32_t>& code, const std::string& path);
+        void ReleaseModule(uint64_t key);
+    };
+
+} // namespace StellarAlia::Function::Graphics
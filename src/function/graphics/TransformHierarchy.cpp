@@ -0,0 +1,238 @@
+#include "function/graphics/TransformHierarchy.hpp"
+#include "core/jobs/JobSystem.hpp"
+#include "core/math/Math.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace StellarAlia::Function::Graphics {
+
+    namespace {
+        // Fewer nodes than this per job cost more to schedule than to update
+        constexpr uint32_t MIN_NODES_PER_BATCH = 1024;
+
+        // Per-thread results, padded so threads do not share cache lines
+        struct alignas(64) UpdateCounters {
+            uint32_t minNode = UINT32_MAX;
+            uint32_t maxNode = 0;
+            uint32_t updated = 0;
+        };
+    }
+
+    TransformNodeHandle TransformHierarchy::CreateNode(const LocalTransform& local, TransformNodeHandle parent) {
+        uint32_t id;
+        if (!m_freeIds.empty()) {
+            id = m_freeIds.back();
+            m_freeIds.pop_back();
+        } else {
+            id = static_cast<uint32_t>(m_local.size());
+            m_local.emplace_back();
+            m_parent.push_back(NO_PARENT);
+            m_alive.push_back(0);
+            m_localDirty.push_back(0);
+            m_gpuTransforms.emplace_back();
+        }
+
+        m_local[id] = local;
+        m_parent[id] = IsAlive(parent) ? parent.id : NO_PARENT;
+        m_alive[id] = 1;
+        m_localDirty[id] = 1;
+        m_anyDirty = true;
+        m_structureDirty = true;
+        m_stats.nodes++;
+        return { id };
+    }
+
+    void TransformHierarchy::DestroyNode(TransformNodeHandle node) {
+        if (!IsAlive(node)) {
+            return;
+        }
+
+        // Structural changes already cost a full pass, so finding the children by scan is fine
+        for (uint32_t child = 0; child < m_parent.size(); child++) {
+            if (m_alive[child] && m_parent[child] == node.id) {
+                m_parent[child] = m_parent[node.id];
+                m_localDirty[child] = 1;
+            }
+        }
+        m_alive[node.id] = 0;
+        m_localDirty[node.id] = 0;
+        m_parent[node.id] = NO_PARENT;
+        m_freeIds.push_back(node.id);
+        m_anyDirty = true;
+        m_structureDirty = true;
+        m_stats.nodes--;
+    }
+
+    bool TransformHierarchy::SetParent(TransformNodeHandle node, TransformNodeHandle parent) {
+        if (!IsAlive(node)) {
+            return false;
+        }
+
+        const uint32_t newParent = IsAlive(parent) ? parent.id : NO_PARENT;
+        for (uint32_t ancestor = newParent; ancestor != NO_PARENT; ancestor = m_parent[ancestor]) {
+            if (ancestor == node.id) {
+                return false;
+            }
+        }
+        if (m_parent[node.id] != newParent) {
+            m_parent[node.id] = newParent;
+            m_localDirty[node.id] = 1;
+            m_anyDirty = true;
+            m_structureDirty = true;
+        }
+        return true;
+    }
+
+    void TransformHierarchy::SetLocal(TransformNodeHandle node, const LocalTransform& local) {
+        if (!IsAlive(node)) {
+            return;
+        }
+        m_local[node.id] = local;
+        m_localDirty[node.id] = 1;
+        m_anyDirty = true;
+    }
+
+    void TransformHierarchy::Update(Core::Jobs::JobSystem* jobs) {
+        m_dirtyRange = {};
+        m_stats.nodesUpdatedLastFrame = 0;
+        if (!m_anyDirty) {
+            return;
+        }
+        if (m_structureDirty) {
+            RebuildOrder();
+        }
+
+        // Threads outside the job system run ParallelFor inline and have no counter slot
+        if (jobs && (!jobs->IsInitialized() ||
+                     Core::Jobs::JobSystem::GetCurrentThreadIndex() == Core::Jobs::INVALID_THREAD_INDEX)) {
+            jobs = nullptr;
+        }
+        std::vector<UpdateCounters> counters(jobs ? jobs->GetThreadCount() : 1);
+
+        // A level's ParallelFor returns once the whole level is done, before its children start
+        for (size_t level = 0; level + 1 < m_levelOffsets.size(); level++) {
+            const uint32_t begin = m_levelOffsets[level];
+            const uint32_t size = m_levelOffsets[level + 1] - begin;
+            if (!jobs || size < 2 * MIN_NODES_PER_BATCH) {
+                UpdateCounters& local = counters[0];
+                UpdateRange(begin, begin + size, local.minNode, local.maxNode, local.updated);
+                continue;
+            }
+            jobs->ParallelFor(size, [&](uint32_t first, uint32_t last) {
+                UpdateCounters& local = counters[Core::Jobs::JobSystem::GetCurrentThreadIndex()];
+                UpdateRange(begin + first, begin + last, local.minNode, local.maxNode, local.updated);
+            }, MIN_NODES_PER_BATCH);
+        }
+
+        uint32_t minNode = UINT32_MAX;
+        uint32_t maxNode = 0;
+        for (const UpdateCounters& local : counters) {
+            minNode = std::min(minNode, local.minNode);
+            maxNode = std::max(maxNode, local.maxNode);
+            m_stats.nodesUpdatedLastFrame += local.updated;
+        }
+        if (minNode != UINT32_MAX) {
+            m_dirtyRange = { minNode, maxNode - minNode + 1 };
+        }
+        m_anyDirty = false;
+    }
+
+    bool TransformHierarchy::IsAlive(TransformNodeHandle node) const {
+        return node.IsValid() && node.id < m_alive.size() && m_alive[node.id];
+    }
+
+    void TransformHierarchy::RebuildOrder() {
+        const auto nodeCount = static_cast<uint32_t>(m_parent.size());
+
+        // Depth of every live node, walking up until a known depth is found
+        constexpr uint32_t UNKNOWN = UINT32_MAX;
+        std::vector<uint32_t> depth(nodeCount, UNKNOWN);
+        std::vector<uint32_t> path;
+        uint32_t maxDepth = 0;
+        for (uint32_t node = 0; node < nodeCount; node++) {
+            if (!m_alive[node] || depth[node] != UNKNOWN) {
+                continue;
+            }
+            path.clear();
+            uint32_t current = node;
+            while (current != NO_PARENT && depth[current] == UNKNOWN) {
+                path.push_back(current);
+                current = m_parent[current];
+            }
+            uint32_t d = current == NO_PARENT ? 0 : depth[current] + 1;
+            for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                depth[*it] = d++;
+            }
+            maxDepth = std::max(maxDepth, d - 1);
+        }
+
+        // Counting sort by depth
+        m_levelOffsets.assign(static_cast<size_t>(maxDepth) + 2, 0);
+        for (uint32_t node = 0; node < nodeCount; node++) {
+            if (m_alive[node]) {
+                m_levelOffsets[depth[node] + 1]++;
+            }
+        }
+        for (size_t level = 1; level < m_levelOffsets.size(); level++) {
+            m_levelOffsets[level] += m_levelOffsets[level - 1];
+        }
+        if (m_levelOffsets.back() == 0) {
+            m_levelOffsets.clear();
+        }
+
+        std::vector<uint32_t> sortedPosition(nodeCount, NO_PARENT);
+        std::vector<uint32_t> cursor(m_levelOffsets.begin(), m_levelOffsets.end());
+        m_sortedNode.resize(m_stats.nodes);
+        for (uint32_t node = 0; node < nodeCount; node++) {
+            if (m_alive[node]) {
+                const uint32_t position = cursor[depth[node]]++;
+                m_sortedNode[position] = node;
+                sortedPosition[node] = position;
+            }
+        }
+
+        m_sortedParent.resize(m_sortedNode.size());
+        for (size_t i = 0; i < m_sortedNode.size(); i++) {
+            const uint32_t parent = m_parent[m_sortedNode[i]];
+            m_sortedParent[i] = parent == NO_PARENT ? NO_PARENT : sortedPosition[parent];
+        }
+        m_worldDirty.assign(m_sortedNode.size(), 0);
+
+        m_stats.levels = m_levelOffsets.empty() ? 0 : static_cast<uint32_t>(m_levelOffsets.size() - 1);
+        m_stats.rebuilds++;
+        m_structureDirty = false;
+    }
+
+    void TransformHierarchy::UpdateRange(uint32_t begin, uint32_t end, uint32_t& minNode, uint32_t& maxNode,
+                                         uint32_t& updated) {
+        for (uint32_t i = begin; i < end; i++) {
+            const uint32_t node = m_sortedNode[i];
+            const uint32_t parent = m_sortedParent[i];
+            const bool dirty = m_localDirty[node] || (parent != NO_PARENT && m_worldDirty[parent]);
+            m_worldDirty[i] = dirty;
+            if (!dirty) {
+                continue;
+            }
+
+            const LocalTransform& local = m_local[node];
+            Core::Math::Mat4 model = Core::Math::Mat4::FromTRS(Core::Math::Vec4::Load3(local.translation),
+                                                               Core::Math::Quat::Load(local.rotation),
+                                                               Core::Math::Vec4::Load3(local.scale));
+            if (parent != NO_PARENT) {
+                model = Core::Math::Mat4::Load(m_gpuTransforms[m_sortedNode[parent]].model) * model;
+            }
+
+            GpuTransform& world = m_gpuTransforms[node];
+            model.Store(world.model);
+            const Core::Math::Mat4 normalMatrix = Core::Math::NormalMatrix(model);
+            std::memcpy(world.normalMatrix, normalMatrix.Data(), sizeof(world.normalMatrix));
+            m_localDirty[node] = 0;
+
+            minNode = std::min(minNode, node);
+            maxNode = std::max(maxNode, node);
+            updated++;
+        }
+    }
+
+} // namespace StellarAlia::Function::Graphics
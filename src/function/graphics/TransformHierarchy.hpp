@@ -0,0 +1,182 @@
+#pragma once
+
+/**
+ * @file TransformHierarchy.hpp
+ * @brief Parent/child transforms resolved into world and normal matrices
+ *
+ * Nodes hold a local translation/rotation/scale and an optional parent. Update()
+ * walks the hierarchy in depth order (every parent before its children) over flat
+ * arrays rebuilt only when the structure changes, and recomputes a node only if its
+ * local transform or an ancestor's changed, so static subtrees cost one flag test per
+ * node. With a job system each depth level is a ParallelFor, which returns only when
+ * the level is done, so children always see their parents' results.
+ *
+ * Results are written to an array of GpuTransform records indexed by node handle, laid
+ * out for std430 storage buffers (mat4 model, vec4 normalMatrix[3]), together with the
+ * range of records that changed, so only that range has to be uploaded.
+ */
+
+#include <cstdint>
+#include <vector>
+
+namespace StellarAlia::Core::Jobs {
+    class JobSystem;
+}
+
+namespace StellarAlia::Function::Graphics {
+
+    /**
+     * @brief Local transform relative to the parent
+     */
+    struct LocalTransform {
+        float translation[3] = {};
+        float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };  // Unit quaternion (x, y, z, w)
+        float scale[3] = { 1.0f, 1.0f, 1.0f };
+    };
+
+    /**
+     * @brief World transform of a node (std430: mat4 model, vec4 normalMatrix[3])
+     */
+    struct GpuTransform {
+        float model[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+                            0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };  // Column-major
+        float normalMatrix[12] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                                   0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };       // Three padded columns
+    };
+    static_assert(sizeof(GpuTransform) == 112, "GpuTransform must match the std430 shader layout");
+
+    /**
+     * @brief Handle to a transform node; also its index in the GpuTransform array
+     */
+    struct TransformNodeHandle {
+        uint32_t id = UINT32_MAX;
+        bool IsValid() const { return id != UINT32_MAX; }
+    };
+
+    /**
+     * @brief Records written by the last Update(), as [first, first + count)
+     */
+    struct TransformDirtyRange {
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    /**
+     * @brief Transform hierarchy statistics
+     */
+    struct TransformHierarchyStats {
+        uint32_t nodes = 0;
+        uint32_t levels = 0;
+        uint32_t nodesUpdatedLastFrame = 0;
+        uint32_t rebuilds = 0;  // Depth-order rebuilds caused by structural changes
+    };
+
+    /**
+     * @brief Flat, depth-ordered transform hierarchy
+     *
+     * Not thread-safe; Update() does its own threading.
+     */
+    class TransformHierarchy {
+    public:
+        /**
+         * @brief Create a node
+         * @param local Local transform
+         * @param parent Parent node, or an invalid handle for a root
+         * @return Node handle
+         */
+        TransformNodeHandle CreateNode(const LocalTransform& local = {}, TransformNodeHandle parent = {});
+
+        /**
+         * @brief Destroy a node; its children are attached to its parent
+         * @param node Node handle
+         */
+        void DestroyNode(TransformNodeHandle node);
+
+        /**
+         * @brief Change a node's parent
+         * @param node Node handle
+         * @param parent New parent, or an invalid handle to make the node a root
+         * @return False if the parent is a descendant of the node (the hierarchy is unchanged)
+         */
+        bool SetParent(TransformNodeHandle node, TransformNodeHandle parent);
+
+        /**
+         * @brief Set a node's local transform
+         * @param node Node handle
+         * @param local Local transform
+         */
+        void SetLocal(TransformNodeHandle node, const LocalTransform& local);
+
+        /**
+         * @brief Get a node's local transform
+         * @param node Node handle
+         * @return Local transform
+         */
+        const LocalTransform& GetLocal(TransformNodeHandle node) const { return m_local[node.id]; }
+
+        /**
+         * @brief Get a node's world transform as of the last Update()
+         * @param node Node handle
+         * @return World and normal matrices
+         */
+        const GpuTransform& GetWorld(TransformNodeHandle node) const { return m_gpuTransforms[node.id]; }
+
+        /**
+         * @brief Recompute the world transforms of changed nodes and their descendants
+         * @param jobs Job system to spread each depth level over, or nullptr to update on the calling thread
+         */
+        void Update(Core::Jobs::JobSystem* jobs = nullptr);
+
+        /**
+         * @brief Get the world transforms, indexed by node handle
+         * Records of destroyed nodes are left in place.
+         * @return GetGpuTransformCount() records
+         */
+        const GpuTransform* GetGpuTransforms() const { return m_gpuTransforms.data(); }
+
+        /**
+         * @brief Get the number of records in the GpuTransform array
+         * @return Record count (the highest node handle plus one)
+         */
+        uint32_t GetGpuTransformCount() const { return static_cast<uint32_t>(m_gpuTransforms.size()); }
+
+        /**
+         * @brief Get the records written by the last Update()
+         * @return Range to upload; empty if nothing changed
+         */
+        TransformDirtyRange GetDirtyRange() const { return m_dirtyRange; }
+
+        /**
+         * @brief Get statistics
+         * @return Counters
+         */
+        const TransformHierarchyStats& GetStats() const { return m_stats; }
+
+    private:
+        static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+        // Per node, indexed by handle
+        std::vector<LocalTransform> m_local;
+        std::vector<uint32_t> m_parent;
+        std::vector<uint8_t> m_alive;
+        std::vector<uint8_t> m_localDirty;
+        std::vector<GpuTransform> m_gpuTransforms;
+        std::vector<uint32_t> m_freeIds;
+        bool m_anyDirty = false;
+
+        // Depth order, rebuilt after structural changes
+        std::vector<uint32_t> m_sortedNode;    // Handle of each sorted entry
+        std::vector<uint32_t> m_sortedParent;  // Sorted position of the parent, or NO_PARENT
+        std::vector<uint32_t> m_levelOffsets;  // Start of each depth level, plus the end
+        std::vector<uint8_t> m_worldDirty;     // Per sorted entry, during Update()
+        bool m_structureDirty = false;
+
+        TransformDirtyRange m_dirtyRange;
+        TransformHierarchyStats m_stats;
+
+        bool IsAlive(TransformNodeHandle node) const;
+        void RebuildOrder();
+        void UpdateRange(uint32_t begin, uint32_t end, uint32_t& minNode, uint32_t& maxNode, uint32_t& updated);
+    };
+
+} // namespace StellarAlia::Function::Graphics
@@ -14,9 +14,11 @@
 
 // Define VMA_IMPLEMENTATION in exactly one source file to include the implementation
 #define VMA_IMPLEMENTATION
-// Disable newer Vulkan features that require extensions not available in pre-built loader
-#define VMA_VULKAN_VERSION 1000000  // Vulkan 1.0 - limits VMA to Vulkan 1.0 features
-#define VMA_KHR_MAINTENANCE4 0       // Disable VK_KHR_maintenance4 extension features
+// Compile in Vulkan 1.1/1.2 code paths. Which ones run is decided at runtime from
+// VmaAllocatorCreateInfo::vulkanApiVersion, so 1.0-only loaders/devices still work;
+// the 1.1+ entry points are fetched through vkGetDeviceProcAddr only when used.
+#define VMA_VULKAN_VERSION 1002000  // Vulkan 1.2
+#define VMA_KHR_MAINTENANCE4 0       // Disable VK_KHR_maintenance4 extension features (Vulkan 1.3)
 
 #include <vma/vk_mem_alloc.h>
 
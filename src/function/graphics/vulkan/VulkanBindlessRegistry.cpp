@@ -0,0 +1,304 @@
+#include "function/graphics/vulkan/VulkanBindlessRegistry.hpp"
+#include "function/graphics/vulkan/VulkanGraphicsContext.hpp"
+#include "core/logs/Log.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace StellarAlia::Function::Graphics {
+
+    namespace {
+        constexpr uint32_t TEXTURE_BINDING = 0;
+        constexpr uint32_t MATERIAL_BINDING = 1;
+    }
+
+    VulkanBindlessRegistry::~VulkanBindlessRegistry() {
+        Shutdown();
+    }
+
+    bool VulkanBindlessRegistry::Initialize(VulkanGraphicsContext& context, const BindlessRegistryCreateInfo& createInfo) {
+        if (m_device != VK_NULL_HANDLE) {
+            SA_LOG_WARN("VulkanBindlessRegistry already initialized");
+            return false;
+        }
+
+        const DeviceCapabilities& caps = context.GetDeviceCapabilities();
+        if (!caps.descriptorIndexing) {
+            SA_LOG_ERROR("Bindless registry requires descriptor indexing");
+            return false;
+        }
+
+        m_context = &context;
+        m_device = context.GetDevice();
+        m_maxTextures = std::min(createInfo.maxTextures, caps.maxBindlessSampledImages);
+        m_maxMaterials = createInfo.maxMaterials;
+        if (m_maxTextures == 0 || m_maxMaterials == 0) {
+            SA_LOG_ERROR("Bindless registry needs at least one texture and material slot");
+            m_device = VK_NULL_HANDLE;
+            m_context = nullptr;
+            return false;
+        }
+
+        // Textures may be written while the set is bound by in-flight frames, as long as
+        // those frames never sample the written slot (guaranteed by deferred slot reuse)
+        const std::array<VkDescriptorSetLayoutBinding, 2> bindings = {{
+            { TEXTURE_BINDING, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_maxTextures,
+              VK_SHADER_STAGE_FRAGMENT_BIT, nullptr },
+            { MATERIAL_BINDING, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr },
+        }};
+        const std::array<VkDescriptorBindingFlags, 2> bindingFlags = {
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+                VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT,
+            0,
+        };
+        m_setLayout = context.GetDescriptorLayoutCache().GetLayout(
+            bindings, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT, bindingFlags);
+        if (m_setLayout == VK_NULL_HANDLE) {
+            Shutdown();
+            return false;
+        }
+
+        const std::array<VkDescriptorPoolSize, 2> poolSizes = {{
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, m_maxTextures },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 },
+        }};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        VkResult result = vkCreateDescriptorPool(m_device, &poolInfo, nullptr, &m_pool);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create bindless descriptor pool (VkResult {})", static_cast<int>(result));
+            Shutdown();
+            return false;
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = m_pool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &m_setLayout;
+        result = vkAllocateDescriptorSets(m_device, &allocInfo, &m_set);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to allocate bindless descriptor set (VkResult {})", static_cast<int>(result));
+            Shutdown();
+            return false;
+        }
+
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = static_cast<VkDeviceSize>(m_maxMaterials) * sizeof(BindlessMaterial);
+        bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo bufferAllocInfo{};
+        bufferAllocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+        // Pinned: the descriptor below references the buffer for the registry's lifetime
+        if (!context.GetMemoryManager().CreateBuffer(MemoryCategory::Geometry, bufferInfo, bufferAllocInfo,
+                                                     m_materialBuffer, m_materialAllocation)) {
+            SA_LOG_ERROR("Failed to create bindless material buffer");
+            Shutdown();
+            return false;
+        }
+
+        VkDescriptorBufferInfo materialInfo{ m_materialBuffer, 0, VK_WHOLE_SIZE };
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = m_set;
+        write.dstBinding = MATERIAL_BINDING;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = &materialInfo;
+        vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+
+        m_materials.assign(m_maxMaterials, BindlessMaterial{});
+        m_materialDirty.assign(m_maxMaterials, 0);
+        m_dirtyMaterials.reserve(256);
+
+        SA_LOG_INFO("Bindless registry: {} texture slots, {} material slots", m_maxTextures, m_maxMaterials);
+        return true;
+    }
+
+    void VulkanBindlessRegistry::Shutdown() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        if (m_materialBuffer != VK_NULL_HANDLE) {
+            m_context->GetMemoryManager().DestroyBuffer(m_materialBuffer, m_materialAllocation);
+            m_materialBuffer = VK_NULL_HANDLE;
+            m_materialAllocation = VK_NULL_HANDLE;
+        }
+        // Destroying the pool frees the set; the layout belongs to the layout cache
+        if (m_pool != VK_NULL_HANDLE) {
+            vkDestroyDescriptorPool(m_device, m_pool, nullptr);
+            m_pool = VK_NULL_HANDLE;
+        }
+        m_set = VK_NULL_HANDLE;
+        m_setLayout = VK_NULL_HANDLE;
+
+        m_nextTexture = 0;
+        m_nextMaterial = 0;
+        m_freeTextures.clear();
+        m_freeMaterials.clear();
+        m_materials.clear();
+        m_materialDirty.clear();
+        m_dirtyMaterials.clear();
+
+        m_device = VK_NULL_HANDLE;
+        m_context = nullptr;
+    }
+
+    uint32_t VulkanBindlessRegistry::RegisterTexture(VkImageView view, VkSampler sampler) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_set == VK_NULL_HANDLE) {
+            return INVALID_BINDLESS_INDEX;
+        }
+
+        uint32_t index = INVALID_BINDLESS_INDEX;
+        if (!m_freeTextures.empty()) {
+            index = m_freeTextures.back();
+            m_freeTextures.pop_back();
+        } else if (m_nextTexture < m_maxTextures) {
+            index = m_nextTexture++;
+        } else {
+            SA_LOG_WARN("Bindless texture array is full ({} slots)", m_maxTextures);
+            return INVALID_BINDLESS_INDEX;
+        }
+
+        VkDescriptorImageInfo imageInfo{ sampler, view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = m_set;
+        write.dstBinding = TEXTURE_BINDING;
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &imageInfo;
+        vkUpdateDescriptorSets(m_device, 1, &write, 0, nullptr);
+        return index;
+    }
+
+    void VulkanBindlessRegistry::ReleaseTexture(uint32_t index) {
+        if (index == INVALID_BINDLESS_INDEX || m_context == nullptr) {
+            return;
+        }
+        // The stale descriptor stays in place; partially bound slots need no clearing
+        m_context->DeferDestruction([this, index]() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_freeTextures.push_back(index);
+        });
+    }
+
+    uint32_t VulkanBindlessRegistry::RegisterMaterial(const BindlessMaterial& material) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_set == VK_NULL_HANDLE) {
+            return INVALID_BINDLESS_INDEX;
+        }
+
+        uint32_t index = INVALID_BINDLESS_INDEX;
+        if (!m_freeMaterials.empty()) {
+            index = m_freeMaterials.back();
+            m_freeMaterials.pop_back();
+        } else if (m_nextMaterial < m_maxMaterials) {
+            index = m_nextMaterial++;
+        } else {
+            SA_LOG_WARN("Bindless material buffer is full ({} slots)", m_maxMaterials);
+            return INVALID_BINDLESS_INDEX;
+        }
+
+        m_materials[index] = material;
+        MarkMaterialDirty(index);
+        return index;
+    }
+
+    void VulkanBindlessRegistry::UpdateMaterial(uint32_t index, const BindlessMaterial& material) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (index >= m_nextMaterial) {
+            return;
+        }
+        m_materials[index] = material;
+        MarkMaterialDirty(index);
+        m_materialGeneration++;
+    }
+
+    bool VulkanBindlessRegistry::GetMaterial(uint32_t index, BindlessMaterial& material) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (index >= m_nextMaterial) {
+            return false;
+        }
+        material = m_materials[index];
+        return true;
+    }
+
+    uint64_t VulkanBindlessRegistry::GetMaterialGeneration() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_materialGeneration;
+    }
+
+    void VulkanBindlessRegistry::ReleaseMaterial(uint32_t index) {
+        if (index == INVALID_BINDLESS_INDEX || m_context == nullptr) {
+            return;
+        }
+        m_context->DeferDestruction([this, index]() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_freeMaterials.push_back(index);
+        });
+    }
+
+    void VulkanBindlessRegistry::FlushMaterials() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_dirtyMaterials.empty()) {
+            return;
+        }
+
+        // Coalesce consecutive indices so a batch of new materials is a single copy
+        std::sort(m_dirtyMaterials.begin(), m_dirtyMaterials.end());
+        VulkanUploadRing& uploadRing = m_context->GetUploadRing();
+
+        size_t kept = 0;
+        size_t runStart = 0;
+        while (runStart < m_dirtyMaterials.size()) {
+            size_t runEnd = runStart + 1;
+            while (runEnd < m_dirtyMaterials.size() && m_dirtyMaterials[runEnd] == m_dirtyMaterials[runEnd - 1] + 1) {
+                runEnd++;
+            }
+
+            const uint32_t first = m_dirtyMaterials[runStart];
+            const auto count = static_cast<uint32_t>(runEnd - runStart);
+            UploadTicket ticket = uploadRing.UploadBuffer(
+                m_materialBuffer, static_cast<VkDeviceSize>(first) * sizeof(BindlessMaterial), &m_materials[first],
+                static_cast<VkDeviceSize>(count) * sizeof(BindlessMaterial), VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                VK_ACCESS_SHADER_READ_BIT);
+
+            if (ticket.IsValid()) {
+                for (size_t i = runStart; i < runEnd; i++) {
+                    m_materialDirty[m_dirtyMaterials[i]] = 0;
+                }
+            } else {
+                // Over the frame budget: keep the run for next frame
+                for (size_t i = runStart; i < runEnd; i++) {
+                    m_dirtyMaterials[kept++] = m_dirtyMaterials[i];
+                }
+            }
+            runStart = runEnd;
+        }
+        m_dirtyMaterials.resize(kept);
+    }
+
+    void VulkanBindlessRegistry::Bind(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t setIndex) const {
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, setIndex, 1, &m_set, 0, nullptr);
+    }
+
+    void VulkanBindlessRegistry::MarkMaterialDirty(uint32_t index) {
+        if (!m_materialDirty[index]) {
+            m_materialDirty[index] = 1;
+            m_dirtyMaterials.push_back(index);
+        }
+    }
+
+} // namespace StellarAlia::Function::Graphics
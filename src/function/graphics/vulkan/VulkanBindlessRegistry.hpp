@@ -0,0 +1,198 @@
+#pragma once
+
+/**
+ * @file VulkanBindlessRegistry.hpp
+ * @brief Global texture array and material buffer for bindless drawing
+ *
+ * Requires descriptor indexing (Vulkan 1.2). All textures live in one update-after-bind
+ * array and all material parameters in one storage buffer, so the geometry pass binds
+ * a single set per frame and selects the material with a per-draw index. Renderers
+ * without descriptor indexing keep using per-material descriptor sets.
+ *
+ * Matches set 1 of shaders/deferred_geometry_bindless.frag.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace StellarAlia::Function::Graphics {
+
+    class VulkanGraphicsContext;
+
+    constexpr uint32_t INVALID_BINDLESS_INDEX = UINT32_MAX;
+
+    /**
+     * @brief Material parameters as laid out in the bindless material buffer (std430)
+     */
+    struct BindlessMaterial {
+        float baseColorFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        float metallicFactor = 1.0f;
+        float roughnessFactor = 1.0f;
+        float normalScale = 1.0f;
+        float aoStrength = 1.0f;
+        uint32_t albedoTexture = 0;             // Indices returned by RegisterTexture
+        uint32_t normalTexture = 0;             // INVALID_BINDLESS_INDEX = none (vertex normal only)
+        uint32_t metallicRoughnessTexture = 0;  // INVALID_BINDLESS_INDEX = none (factors only)
+        uint32_t aoTexture = 0;
+    };
+    static_assert(sizeof(BindlessMaterial) == 48, "BindlessMaterial must match the shader's std430 layout");
+
+    /**
+     * @brief Bindless registry creation parameters
+     */
+    struct BindlessRegistryCreateInfo {
+        uint32_t maxTextures = 16384;   // Clamped to the device's update-after-bind limit
+        uint32_t maxMaterials = 16384;
+    };
+
+    /**
+     * @brief Owns the bindless set: texture slots and material records
+     *
+     * Registration and updates are thread-safe; releases go through the context's deferred
+     * destruction and belong on the render thread. Released slots are recycled only after
+     * every frame that could reference them has completed. Material writes go through the
+     * upload ring and are visible to draws a few frames after the call.
+     */
+    class VulkanBindlessRegistry {
+    public:
+        VulkanBindlessRegistry() = default;
+        ~VulkanBindlessRegistry();
+
+        VulkanBindlessRegistry(const VulkanBindlessRegistry&) = delete;
+        VulkanBindlessRegistry& operator=(const VulkanBindlessRegistry&) = delete;
+
+        /**
+         * @brief Create the set layout, set and material buffer
+         * @param context Vulkan context created with descriptor indexing enabled
+         * @param createInfo Creation parameters
+         * @return True on success
+         */
+        bool Initialize(VulkanGraphicsContext& context, const BindlessRegistryCreateInfo& createInfo);
+
+        /**
+         * @brief Release all resources (the GPU must be idle)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the registry has been created
+         * @return True if valid
+         */
+        bool IsValid() const { return m_set != VK_NULL_HANDLE; }
+
+        /**
+         * @brief Add a texture to the global array
+         * @param view Image view in SHADER_READ_ONLY_OPTIMAL layout
+         * @param sampler Sampler
+         * @return Array index, or INVALID_BINDLESS_INDEX when full
+         */
+        uint32_t RegisterTexture(VkImageView view, VkSampler sampler);
+
+        /**
+         * @brief Free a texture slot once in-flight frames are done with it
+         * @param index Index returned by RegisterTexture
+         */
+        void ReleaseTexture(uint32_t index);
+
+        /**
+         * @brief Add a material record
+         * @param material Material parameters
+         * @return Material index, or INVALID_BINDLESS_INDEX when full
+         */
+        uint32_t RegisterMaterial(const BindlessMaterial& material);
+
+        /**
+         * @brief Overwrite a material record
+         * @param index Index returned by RegisterMaterial
+         * @param material New parameters
+         */
+        void UpdateMaterial(uint32_t index, const BindlessMaterial& material);
+
+        /**
+         * @brief Read back a material record
+         * @param index Index returned by RegisterMaterial
+         * @param material Receives the parameters last written on the CPU
+         * @return False for an index that was never registered
+         */
+        bool GetMaterial(uint32_t index, BindlessMaterial& material) const;
+
+        /**
+         * @brief Get a counter that changes whenever UpdateMaterial() overwrites a record
+         * Lets users that derive state from material records (e.g. shader permutations)
+         * notice edits without re-reading every material each frame.
+         * @return Generation
+         */
+        uint64_t GetMaterialGeneration() const;
+
+        /**
+         * @brief Free a material slot once in-flight frames are done with it
+         * @param index Index returned by RegisterMaterial
+         */
+        void ReleaseMaterial(uint32_t index);
+
+        /**
+         * @brief Queue pending material writes on the upload ring
+         * Called by the context once per frame; writes rejected by the upload budget are
+         * retried next frame.
+         */
+        void FlushMaterials();
+
+        /**
+         * @brief Bind the bindless set
+         * @param cmd Command buffer
+         * @param layout Pipeline layout that uses GetSetLayout() at setIndex
+         * @param setIndex Set number (1 in the geometry shaders)
+         */
+        void Bind(VkCommandBuffer cmd, VkPipelineLayout layout, uint32_t setIndex = 1) const;
+
+        /**
+         * @brief Get the bindless set layout
+         * @return Layout owned by the context's layout cache
+         */
+        VkDescriptorSetLayout GetSetLayout() const { return m_setLayout; }
+
+        /**
+         * @brief Get the texture array capacity
+         * @return Number of texture slots
+         */
+        uint32_t GetMaxTextures() const { return m_maxTextures; }
+
+    private:
+        VulkanGraphicsContext* m_context = nullptr;
+        VkDevice m_device = VK_NULL_HANDLE;
+
+        VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+        VkDescriptorPool m_pool = VK_NULL_HANDLE;
+        VkDescriptorSet m_set = VK_NULL_HANDLE;
+
+        VkBuffer m_materialBuffer = VK_NULL_HANDLE;
+        VmaAllocation m_materialAllocation = VK_NULL_HANDLE;
+
+        uint32_t m_maxTextures = 0;
+        uint32_t m_maxMaterials = 0;
+        uint32_t m_nextTexture = 0;
+        uint32_t m_nextMaterial = 0;
+        std::vector<uint32_t> m_freeTextures;
+        std::vector<uint32_t> m_freeMaterials;
+
+        // CPU copy of every material; dirty indices are uploaded by FlushMaterials
+        std::vector<BindlessMaterial> m_materials;
+        std::vector<uint8_t> m_materialDirty;
+        std::vector<uint32_t> m_dirtyMaterials;
+        uint64_t m_materialGeneration = 0;  // Bumped by UpdateMaterial
+
+        void MarkMaterialDirty(uint32_t index);
+
+        mutable std::mutex m_mutex;
+    };
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,175 @@
+#include "function/graphics/vulkan/VulkanDescriptorAllocator.hpp"
+#include "core/logs/Log.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace StellarAlia::Function::Graphics {
+
+    namespace {
+        // Sized for the deferred shaders: four material samplers and one uniform block per set
+        const std::vector<DescriptorPoolRatio> DEFAULT_RATIOS = {
+            { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f },
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f },
+            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 0.5f },
+            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1.0f },
+            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 0.5f },
+            { VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 0.5f },
+        };
+    }
+
+    VulkanDescriptorAllocator::~VulkanDescriptorAllocator() {
+        Shutdown();
+    }
+
+    bool VulkanDescriptorAllocator::Initialize(const DescriptorAllocatorCreateInfo& createInfo) {
+        if (m_device != VK_NULL_HANDLE) {
+            SA_LOG_WARN("VulkanDescriptorAllocator already initialized");
+            return false;
+        }
+        if (createInfo.device == VK_NULL_HANDLE || createInfo.initialSetsPerPool == 0) {
+            SA_LOG_ERROR("Invalid descriptor allocator create info");
+            return false;
+        }
+
+        m_device = createInfo.device;
+        m_poolFlags = createInfo.poolFlags;
+        m_ratios = createInfo.ratios.empty() ? DEFAULT_RATIOS : createInfo.ratios;
+        m_setsPerPool = createInfo.initialSetsPerPool;
+        m_maxSetsPerPool = std::max(createInfo.maxSetsPerPool, createInfo.initialSetsPerPool);
+        m_setsAllocated = 0;
+        m_poolsCreated = 0;
+        return true;
+    }
+
+    void VulkanDescriptorAllocator::Shutdown() {
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        if (m_currentPool != VK_NULL_HANDLE) {
+            vkDestroyDescriptorPool(m_device, m_currentPool, nullptr);
+            m_currentPool = VK_NULL_HANDLE;
+        }
+        for (VkDescriptorPool pool : m_fullPools) {
+            vkDestroyDescriptorPool(m_device, pool, nullptr);
+        }
+        for (VkDescriptorPool pool : m_freePools) {
+            vkDestroyDescriptorPool(m_device, pool, nullptr);
+        }
+        m_fullPools.clear();
+        m_freePools.clear();
+        m_device = VK_NULL_HANDLE;
+    }
+
+    bool VulkanDescriptorAllocator::Allocate(VkDescriptorSetLayout layout, VkDescriptorSet& outSet, const void* pNext) {
+        outSet = VK_NULL_HANDLE;
+        if (m_device == VK_NULL_HANDLE) {
+            return false;
+        }
+
+        if (m_currentPool == VK_NULL_HANDLE) {
+            m_currentPool = AcquirePool();
+            if (m_currentPool == VK_NULL_HANDLE) {
+                return false;
+            }
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.pNext = pNext;
+        allocInfo.descriptorPool = m_currentPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
+
+        VkResult result = vkAllocateDescriptorSets(m_device, &allocInfo, &outSet);
+        if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+            // Current pool is exhausted: park it and retry once in a fresh one
+            m_fullPools.push_back(m_currentPool);
+            m_currentPool = AcquirePool();
+            if (m_currentPool == VK_NULL_HANDLE) {
+                return false;
+            }
+            allocInfo.descriptorPool = m_currentPool;
+            result = vkAllocateDescriptorSets(m_device, &allocInfo, &outSet);
+        }
+
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to allocate descriptor set (VkResult {})", static_cast<int>(result));
+            outSet = VK_NULL_HANDLE;
+            return false;
+        }
+
+        m_setsAllocated++;
+        return true;
+    }
+
+    void VulkanDescriptorAllocator::Reset() {
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        if (m_currentPool != VK_NULL_HANDLE) {
+            vkResetDescriptorPool(m_device, m_currentPool, 0);
+            m_freePools.push_back(m_currentPool);
+            m_currentPool = VK_NULL_HANDLE;
+        }
+        for (VkDescriptorPool pool : m_fullPools) {
+            vkResetDescriptorPool(m_device, pool, 0);
+            m_freePools.push_back(pool);
+        }
+        m_fullPools.clear();
+        m_setsAllocated = 0;
+    }
+
+    DescriptorAllocatorStats VulkanDescriptorAllocator::GetStats() const {
+        DescriptorAllocatorStats stats;
+        stats.poolCount = static_cast<uint32_t>(m_fullPools.size() + m_freePools.size()) +
+                          (m_currentPool != VK_NULL_HANDLE ? 1u : 0u);
+        stats.setsAllocated = m_setsAllocated;
+        stats.poolsCreated = m_poolsCreated;
+        return stats;
+    }
+
+    VkDescriptorPool VulkanDescriptorAllocator::AcquirePool() {
+        if (!m_freePools.empty()) {
+            VkDescriptorPool pool = m_freePools.back();
+            m_freePools.pop_back();
+            return pool;
+        }
+
+        // Fixed-size scratch: pool creation is the only slow path and should not allocate either
+        constexpr size_t MAX_RATIOS = 16;
+        VkDescriptorPoolSize sizes[MAX_RATIOS];
+        uint32_t sizeCount = 0;
+        for (const auto& ratio : m_ratios) {
+            if (sizeCount == MAX_RATIOS) {
+                break;
+            }
+            const auto count = static_cast<uint32_t>(std::ceil(ratio.perSet * static_cast<float>(m_setsPerPool)));
+            if (count > 0) {
+                sizes[sizeCount++] = { ratio.type, count };
+            }
+        }
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = m_poolFlags;
+        poolInfo.maxSets = m_setsPerPool;
+        poolInfo.poolSizeCount = sizeCount;
+        poolInfo.pPoolSizes = sizes;
+
+        VkDescriptorPool pool = VK_NULL_HANDLE;
+        VkResult result = vkCreateDescriptorPool(m_device, &poolInfo, nullptr, &pool);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create descriptor pool (VkResult {})", static_cast<int>(result));
+            return VK_NULL_HANDLE;
+        }
+
+        m_poolsCreated++;
+        // Grow geometrically so long-running workloads settle on a few large pools
+        m_setsPerPool = std::min(m_maxSetsPerPool, m_setsPerPool + std::max(1u, m_setsPerPool / 2));
+        return pool;
+    }
+
+} // namespace StellarAlia::Function::Graphics
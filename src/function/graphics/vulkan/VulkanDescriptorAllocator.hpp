@@ -0,0 +1,117 @@
+#pragma once
+
+/**
+ * @file VulkanDescriptorAllocator.hpp
+ * @brief Growable descriptor set allocator backed by a chain of pools
+ *
+ * Sets are carved from the current pool; when it runs dry the allocator moves on to a
+ * recycled pool or creates a larger one. Pools are never freed individually: Reset()
+ * recycles the whole chain in one call, which makes the allocator a good fit for
+ * per-frame transient sets.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace StellarAlia::Function::Graphics {
+
+    /**
+     * @brief Descriptors of one type reserved per set in each pool
+     */
+    struct DescriptorPoolRatio {
+        VkDescriptorType type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        float perSet = 1.0f;
+    };
+
+    /**
+     * @brief Descriptor allocator creation parameters
+     */
+    struct DescriptorAllocatorCreateInfo {
+        VkDevice device = VK_NULL_HANDLE;
+        uint32_t initialSetsPerPool = 64;
+        uint32_t maxSetsPerPool = 4096;  // Pools grow by 1.5x up to this size
+        VkDescriptorPoolCreateFlags poolFlags = 0;
+        // Empty = defaults sized for the deferred shaders (samplers plus a uniform block per set)
+        std::vector<DescriptorPoolRatio> ratios;
+    };
+
+    /**
+     * @brief Descriptor allocator statistics
+     */
+    struct DescriptorAllocatorStats {
+        uint32_t poolCount = 0;
+        uint32_t setsAllocated = 0;  // Since the last Reset
+        uint32_t poolsCreated = 0;
+    };
+
+    /**
+     * @brief Chain of descriptor pools with bulk reset
+     *
+     * Not thread-safe; give each recording thread (or frame) its own allocator.
+     * Allocate() performs no heap allocation unless it has to open a new pool.
+     */
+    class VulkanDescriptorAllocator {
+    public:
+        VulkanDescriptorAllocator() = default;
+        ~VulkanDescriptorAllocator();
+
+        VulkanDescriptorAllocator(const VulkanDescriptorAllocator&) = delete;
+        VulkanDescriptorAllocator& operator=(const VulkanDescriptorAllocator&) = delete;
+
+        /**
+         * @brief Prepare the allocator (the first pool is created lazily)
+         * @param createInfo Creation parameters
+         * @return True on success
+         */
+        bool Initialize(const DescriptorAllocatorCreateInfo& createInfo);
+
+        /**
+         * @brief Destroy every pool (sets from this allocator become invalid)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Allocate one descriptor set
+         * @param layout Set layout
+         * @param outSet Allocated set
+         * @param pNext Optional allocate-info chain (e.g. variable descriptor counts)
+         * @return True on success
+         */
+        bool Allocate(VkDescriptorSetLayout layout, VkDescriptorSet& outSet, const void* pNext = nullptr);
+
+        /**
+         * @brief Return every set to the pools
+         * Only call once the GPU has finished with all sets from this allocator.
+         */
+        void Reset();
+
+        /**
+         * @brief Get allocator statistics
+         * @return Snapshot of the counters
+         */
+        DescriptorAllocatorStats GetStats() const;
+
+    private:
+        VkDevice m_device = VK_NULL_HANDLE;
+        VkDescriptorPoolCreateFlags m_poolFlags = 0;
+        std::vector<DescriptorPoolRatio> m_ratios;
+        uint32_t m_setsPerPool = 0;
+        uint32_t m_maxSetsPerPool = 0;
+
+        VkDescriptorPool m_currentPool = VK_NULL_HANDLE;
+        std::vector<VkDescriptorPool> m_fullPools;   // Exhausted since the last Reset
+        std::vector<VkDescriptorPool> m_freePools;   // Reset and ready for reuse
+
+        uint32_t m_setsAllocated = 0;
+        uint32_t m_poolsCreated = 0;
+
+        VkDescriptorPool AcquirePool();
+    };
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,131 @@
+#include "function/graphics/vulkan/VulkanDescriptorLayoutCache.hpp"
+#include "core/utils/Hash.hpp"
+#include "core/logs/Log.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace StellarAlia::Function::Graphics {
+
+    VulkanDescriptorLayoutCache::~VulkanDescriptorLayoutCache() {
+        Shutdown();
+    }
+
+    bool VulkanDescriptorLayoutCache::Initialize(VkDevice device) {
+        if (m_device != VK_NULL_HANDLE) {
+            SA_LOG_WARN("VulkanDescriptorLayoutCache already initialized");
+            return false;
+        }
+        if (device == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("Descriptor layout cache requires a device");
+            return false;
+        }
+        m_device = device;
+        return true;
+    }
+
+    void VulkanDescriptorLayoutCache::Shutdown() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+        for (auto& [hash, bucket] : m_layouts) {
+            for (auto& entry : bucket) {
+                vkDestroyDescriptorSetLayout(m_device, entry.layout, nullptr);
+            }
+        }
+        m_layouts.clear();
+        m_layoutCount = 0;
+        m_device = VK_NULL_HANDLE;
+    }
+
+    VkDescriptorSetLayout VulkanDescriptorLayoutCache::GetLayout(std::span<const VkDescriptorSetLayoutBinding> bindings,
+                                                                 VkDescriptorSetLayoutCreateFlags flags,
+                                                                 std::span<const VkDescriptorBindingFlags> bindingFlags) {
+        if (!bindingFlags.empty() && bindingFlags.size() != bindings.size()) {
+            SA_LOG_ERROR("Descriptor binding flags must match the binding count");
+            return VK_NULL_HANDLE;
+        }
+
+        // Build the canonical key: bindings sorted by index so declaration order does not matter
+        std::vector<size_t> order(bindings.size());
+        std::iota(order.begin(), order.end(), size_t{ 0 });
+        std::sort(order.begin(), order.end(),
+                  [&](size_t a, size_t b) { return bindings[a].binding < bindings[b].binding; });
+
+        LayoutKey key;
+        key.flags = flags;
+        key.bindings.reserve(bindings.size());
+        for (size_t i : order) {
+            const auto& binding = bindings[i];
+            BindingKey bindingKey;
+            bindingKey.binding = binding.binding;
+            bindingKey.type = binding.descriptorType;
+            bindingKey.count = binding.descriptorCount;
+            bindingKey.stages = binding.stageFlags;
+            bindingKey.flags = bindingFlags.empty() ? 0 : bindingFlags[i];
+            if (binding.pImmutableSamplers != nullptr) {
+                bindingKey.hasImmutableSamplers = true;
+                bindingKey.firstSampler = static_cast<uint32_t>(key.immutableSamplers.size());
+                key.immutableSamplers.insert(key.immutableSamplers.end(), binding.pImmutableSamplers,
+                                             binding.pImmutableSamplers + binding.descriptorCount);
+            }
+            key.bindings.push_back(bindingKey);
+        }
+
+        uint64_t hash = Core::Hash::FNV_OFFSET_BASIS;
+        Core::Hash::Combine(hash, key.flags);
+        Core::Hash::Combine(hash, key.bindings.size());
+        for (const auto& binding : key.bindings) {
+            Core::Hash::Combine(hash, binding.binding);
+            Core::Hash::Combine(hash, binding.type);
+            Core::Hash::Combine(hash, binding.count);
+            Core::Hash::Combine(hash, binding.stages);
+            Core::Hash::Combine(hash, binding.flags);
+        }
+        for (VkSampler sampler : key.immutableSamplers) {
+            Core::Hash::Combine(hash, sampler);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_device == VK_NULL_HANDLE) {
+            return VK_NULL_HANDLE;
+        }
+
+        auto& bucket = m_layouts[hash];
+        for (const auto& entry : bucket) {
+            if (entry.key == key) {
+                return entry.layout;
+            }
+        }
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo{};
+        flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        flagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+        flagsInfo.pBindingFlags = bindingFlags.data();
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext = bindingFlags.empty() ? nullptr : &flagsInfo;
+        layoutInfo.flags = flags;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+        VkResult result = vkCreateDescriptorSetLayout(m_device, &layoutInfo, nullptr, &layout);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create descriptor set layout (VkResult {})", static_cast<int>(result));
+            return VK_NULL_HANDLE;
+        }
+
+        bucket.push_back({ std::move(key), layout });
+        m_layoutCount++;
+        return layout;
+    }
+
+    size_t VulkanDescriptorLayoutCache::GetLayoutCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_layoutCount;
+    }
+
+} // namespace StellarAlia::Function::Graphics
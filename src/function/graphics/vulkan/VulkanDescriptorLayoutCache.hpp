@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * @file VulkanDescriptorLayoutCache.hpp
+ * @brief Deduplicating cache of descriptor set layouts
+ *
+ * Layouts are keyed by a hash of their (binding-sorted) bindings, so shaders that
+ * declare the same set in a different order still share one VkDescriptorSetLayout.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace StellarAlia::Function::Graphics {
+
+    /**
+     * @brief Owns every descriptor set layout created through it
+     *
+     * Thread-safe. Layouts live until Shutdown().
+     */
+    class VulkanDescriptorLayoutCache {
+    public:
+        VulkanDescriptorLayoutCache() = default;
+        ~VulkanDescriptorLayoutCache();
+
+        VulkanDescriptorLayoutCache(const VulkanDescriptorLayoutCache&) = delete;
+        VulkanDescriptorLayoutCache& operator=(const VulkanDescriptorLayoutCache&) = delete;
+
+        /**
+         * @brief Bind the cache to a device
+         * @param device Logical device
+         * @return True on success
+         */
+        bool Initialize(VkDevice device);
+
+        /**
+         * @brief Destroy every cached layout
+         */
+        void Shutdown();
+
+        /**
+         * @brief Get or create a layout
+         * @param bindings Layout bindings, in any order
+         * @param flags Layout create flags
+         * @param bindingFlags Optional per-binding flags, parallel to bindings
+         * @return Shared layout, or VK_NULL_HANDLE on failure
+         */
+        VkDescriptorSetLayout GetLayout(std::span<const VkDescriptorSetLayoutBinding> bindings,
+                                        VkDescriptorSetLayoutCreateFlags flags = 0,
+                                        std::span<const VkDescriptorBindingFlags> bindingFlags = {});
+
+        /**
+         * @brief Get the number of distinct layouts created
+         * @return Layout count
+         */
+        size_t GetLayoutCount() const;
+
+    private:
+        struct BindingKey {
+            uint32_t binding = 0;
+            VkDescriptorType type = VK_DESCRIPTOR_TYPE_SAMPLER;
+            uint32_t count = 0;
+            VkShaderStageFlags stages = 0;
+            VkDescriptorBindingFlags flags = 0;
+            uint32_t firstSampler = 0;  // Offset into LayoutKey::immutableSamplers
+            bool hasImmutableSamplers = false;
+
+            bool operator==(const BindingKey&) const = default;
+        };
+
+        struct LayoutKey {
+            VkDescriptorSetLayoutCreateFlags flags = 0;
+            std::vector<BindingKey> bindings;
+            std::vector<VkSampler> immutableSamplers;
+
+            bool operator==(const LayoutKey&) const = default;
+        };
+
+        struct Entry {
+            LayoutKey key;
+            VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+        };
+
+        VkDevice m_device = VK_NULL_HANDLE;
+        std::unordered_map<uint64_t, std::vector<Entry>> m_layouts;
+        size_t m_layoutCount = 0;
+        mutable std::mutex m_mutex;
+    };
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,181 @@
+#include "function/graphics/vulkan/VulkanDeviceCapabilities.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace StellarAlia::Function::Graphics {
+
+    bool DeviceCapabilities::HasExtension(std::string_view name) const {
+        return std::find(extensions.begin(), extensions.end(), name) != extensions.end();
+    }
+
+    std::string DeviceCapabilities::GetDeviceUUIDString() const {
+        if (!hasDeviceUUID) {
+            return {};
+        }
+
+        static const char HEX[] = "0123456789abcdef";
+        std::string result;
+        result.reserve(VK_UUID_SIZE * 2);
+        for (uint8_t byte : deviceUUID) {
+            result.push_back(HEX[byte >> 4]);
+            result.push_back(HEX[byte & 0xF]);
+        }
+        return result;
+    }
+
+    void QueryDeviceCapabilities(VkPhysicalDevice device, uint32_t instanceApiVersion, DeviceCapabilities& outCaps) {
+        outCaps = {};
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(device, &properties);
+        outCaps.deviceName = properties.deviceName;
+        outCaps.deviceType = properties.deviceType;
+        outCaps.vendorID = properties.vendorID;
+        outCaps.deviceID = properties.deviceID;
+        outCaps.driverVersion = properties.driverVersion;
+        outCaps.apiVersion = std::min(instanceApiVersion,
+                                      VK_MAKE_API_VERSION(0, VK_API_VERSION_MAJOR(properties.apiVersion),
+                                                          VK_API_VERSION_MINOR(properties.apiVersion), 0));
+        std::copy(std::begin(properties.pipelineCacheUUID), std::end(properties.pipelineCacheUUID),
+                  outCaps.pipelineCacheUUID);
+        outCaps.limits = properties.limits;
+
+        vkGetPhysicalDeviceFeatures(device, &outCaps.features);
+
+        vkGetPhysicalDeviceMemoryProperties(device, &outCaps.memoryProperties);
+        for (uint32_t i = 0; i < outCaps.memoryProperties.memoryHeapCount; i++) {
+            const VkMemoryHeap& heap = outCaps.memoryProperties.memoryHeaps[i];
+            if (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+                outCaps.deviceLocalHeapSize = std::max(outCaps.deviceLocalHeapSize, heap.size);
+            }
+        }
+        for (uint32_t i = 0; i < outCaps.memoryProperties.memoryTypeCount; i++) {
+            if (outCaps.memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) {
+                outCaps.lazilyAllocatedMemory = true;
+            }
+        }
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
+        outCaps.queueFamilies.resize(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, outCaps.queueFamilies.data());
+
+        uint32_t extensionCount = 0;
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+        std::vector<VkExtensionProperties> extensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, extensions.data());
+        outCaps.extensions.reserve(extensionCount);
+        for (const auto& extension : extensions) {
+            outCaps.extensions.emplace_back(extension.extensionName);
+        }
+        outCaps.memoryBudget = outCaps.HasExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+        // Vulkan 1.1: device UUID for stable selection across driver updates
+        if (outCaps.apiVersion >= VK_API_VERSION_1_1) {
+            VkPhysicalDeviceIDProperties idProperties{};
+            idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+            VkPhysicalDeviceProperties2 properties2{};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties2.pNext = &idProperties;
+            vkGetPhysicalDeviceProperties2(device, &properties2);
+            std::copy(std::begin(idProperties.deviceUUID), std::end(idProperties.deviceUUID), outCaps.deviceUUID);
+            outCaps.hasDeviceUUID = true;
+        }
+
+        // Vulkan 1.2: optional features used by the renderer
+        if (outCaps.apiVersion >= VK_API_VERSION_1_2) {
+            VkPhysicalDeviceVulkan12Features features12{};
+            features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+            VkPhysicalDeviceFeatures2 features2{};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &features12;
+            vkGetPhysicalDeviceFeatures2(device, &features2);
+
+            outCaps.timelineSemaphore = features12.timelineSemaphore == VK_TRUE;
+            outCaps.drawIndirectCount = features12.drawIndirectCount == VK_TRUE;
+            outCaps.descriptorIndexing = features12.runtimeDescriptorArray == VK_TRUE &&
+                                         features12.descriptorBindingPartiallyBound == VK_TRUE &&
+                                         features12.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE &&
+                                         features12.descriptorBindingUpdateUnusedWhilePending == VK_TRUE &&
+                                         features12.shaderSampledImageArrayNonUniformIndexing == VK_TRUE;
+
+            if (outCaps.descriptorIndexing) {
+                VkPhysicalDeviceVulkan12Properties properties12{};
+                properties12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+                VkPhysicalDeviceProperties2 properties2{};
+                properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                properties2.pNext = &properties12;
+                vkGetPhysicalDeviceProperties2(device, &properties2);
+                // Combined image samplers count against both the sampler and sampled-image limits
+                outCaps.maxBindlessSampledImages = std::min({
+                    properties12.maxDescriptorSetUpdateAfterBindSampledImages,
+                    properties12.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                    properties12.maxDescriptorSetUpdateAfterBindSamplers,
+                    properties12.maxPerStageDescriptorUpdateAfterBindSamplers });
+            }
+        }
+    }
+
+    uint64_t ScoreDevice(const DeviceCapabilities& caps) {
+        uint64_t score = 0;
+
+        switch (caps.deviceType) {
+            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   score += 1'000'000; break;
+            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: score += 100'000; break;
+            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    score += 50'000; break;
+            case VK_PHYSICAL_DEVICE_TYPE_OTHER:          score += 10'000; break;
+            case VK_PHYSICAL_DEVICE_TYPE_CPU:            // Software rasterizers are a last resort
+            default:                                     break;
+        }
+
+        // Everything below sums to at most ~8k, under the smallest gap between device types, so a
+        // CPU device reporting a large host heap never outranks a GPU. One point per MiB of
+        // device-local memory, up to 4 GiB
+        score += std::min<uint64_t>(caps.deviceLocalHeapSize / (1024 * 1024), 4096);
+
+        score += std::min<uint64_t>(caps.limits.maxImageDimension2D / 16, 2048);
+        score += std::min<uint64_t>(caps.limits.maxBoundDescriptorSets, 32) * 10;
+
+        if (caps.timelineSemaphore)          score += 500;
+        if (caps.descriptorIndexing)         score += 500;
+        if (caps.drawIndirectCount)          score += 250;
+        if (caps.features.multiDrawIndirect) score += 250;
+        if (caps.features.samplerAnisotropy) score += 100;
+
+        return score;
+    }
+
+    bool MatchesDeviceSelector(const DeviceCapabilities& caps, std::string_view selector) {
+        if (selector.empty()) {
+            return false;
+        }
+
+        // UUID match: compare hex digits only, ignoring dashes and case
+        std::string hex;
+        bool allHex = true;
+        for (char c : selector) {
+            if (c == '-') {
+                continue;
+            }
+            if (!std::isxdigit(static_cast<unsigned char>(c))) {
+                allHex = false;
+                break;
+            }
+            hex.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+        }
+        if (allHex && hex.size() == VK_UUID_SIZE * 2) {
+            return caps.hasDeviceUUID && hex == caps.GetDeviceUUIDString();
+        }
+
+        // Name match: case-insensitive substring
+        auto lower = [](std::string_view text) {
+            std::string result(text);
+            std::transform(result.begin(), result.end(), result.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return result;
+        };
+        return lower(caps.deviceName).find(lower(selector)) != std::string::npos;
+    }
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file VulkanDeviceCapabilities.hpp
+ * @brief Physical device capability snapshot and device scoring
+ *
+ * Capabilities are queried once per physical device at initialization. Later
+ * subsystems read limits and optional features from the cached struct instead of
+ * calling vkGetPhysicalDevice* again.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace StellarAlia::Function::Graphics {
+
+    /**
+     * @brief Cached properties, limits and optional features of a physical device
+     */
+    struct DeviceCapabilities {
+        // Identity
+        std::string deviceName;
+        VkPhysicalDeviceType deviceType = VK_PHYSICAL_DEVICE_TYPE_OTHER;
+        uint32_t vendorID = 0;
+        uint32_t deviceID = 0;
+        uint32_t driverVersion = 0;
+        uint32_t apiVersion = VK_API_VERSION_1_0;  // Usable version (min of instance and device)
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE] = {};
+        uint8_t deviceUUID[VK_UUID_SIZE] = {};
+        bool hasDeviceUUID = false;                // Requires Vulkan 1.1
+
+        // Core properties
+        VkPhysicalDeviceLimits limits = {};
+        VkPhysicalDeviceFeatures features = {};
+        VkPhysicalDeviceMemoryProperties memoryProperties = {};
+        VkDeviceSize deviceLocalHeapSize = 0;      // Largest DEVICE_LOCAL heap in bytes
+        std::vector<VkQueueFamilyProperties> queueFamilies;
+        std::vector<std::string> extensions;
+
+        // Optional features (Vulkan 1.2 / extensions)
+        bool timelineSemaphore = false;
+        bool drawIndirectCount = false;
+        bool descriptorIndexing = false;           // Runtime arrays, partially bound, update-after-bind sampled images
+        uint32_t maxBindlessSampledImages = 0;     // Update-after-bind combined image samplers per set and stage
+        bool memoryBudget = false;                 // VK_EXT_memory_budget
+        bool lazilyAllocatedMemory = false;        // A LAZILY_ALLOCATED memory type exists
+
+        /**
+         * @brief Check whether a device extension is supported
+         * @param name Extension name
+         * @return True if listed by vkEnumerateDeviceExtensionProperties
+         */
+        bool HasExtension(std::string_view name) const;
+
+        /**
+         * @brief Format the device UUID as 32 lowercase hex digits
+         * @return UUID string, or empty if the device has no UUID
+         */
+        std::string GetDeviceUUIDString() const;
+    };
+
+    /**
+     * @brief Query and cache the capabilities of a physical device
+     * @param device Physical device
+     * @param instanceApiVersion API version the instance was created with
+     * @param outCaps Receives the capabilities
+     */
+    void QueryDeviceCapabilities(VkPhysicalDevice device, uint32_t instanceApiVersion, DeviceCapabilities& outCaps);
+
+    /**
+     * @brief Rank a device for rendering
+     * Device type dominates (discrete > integrated > virtual > other > CPU), then
+     * device-local memory, limits and optional features break ties.
+     * @param caps Device capabilities
+     * @return Higher is better
+     */
+    uint64_t ScoreDevice(const DeviceCapabilities& caps);
+
+    /**
+     * @brief Check a device against a user selector
+     * @param caps Device capabilities
+     * @param selector Device UUID (hex, dashes optional) or a case-insensitive name substring
+     * @return True if the device matches
+     */
+    bool MatchesDeviceSelector(const DeviceCapabilities& caps, std::string_view selector);
+
+} // namespace StellarAlia::Function::Graphics
@@ -2,8 +2,9 @@
 #include "function/graphics/WindowSystem.hpp"
 #include "core/logs/Log.hpp"
 
-#include <set>
+#include <map>
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 
 #include <volk.h>
@@ -21,11 +22,17 @@ namespace StellarAlia::Function::Graphics {
         const std::vector<const char*> VALIDATION_LAYERS = {};
     #endif
 
-    // Required device extensions
+    // Required device extensions (presentation only; headless contexts need none)
     const std::vector<const char*> DEVICE_EXTENSIONS = {
         VK_KHR_SWAPCHAIN_EXTENSION_NAME
     };
 
+    // Upper bound for the configurable frames-in-flight count
+    constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+
+    // Secondary command buffers allocated at once when a recording thread's pool runs out
+    constexpr uint32_t SECONDARY_ALLOCATION_BATCH = 8;
+
     VulkanGraphicsContext::VulkanGraphicsContext() = default;
 
     VulkanGraphicsContext::~VulkanGraphicsContext() {
@@ -38,15 +45,41 @@ namespace StellarAlia::Function::Graphics {
             return false;
         }
 
-        m_width = createInfo.window->GetWidth();
-        m_height = createInfo.window->GetHeight();
+        if (!createInfo.window && !createInfo.headless) {
+            SA_LOG_ERROR("A window is required unless headless mode is requested");
+            return false;
+        }
+
+        m_headless = createInfo.headless;
         m_enableValidation = createInfo.enableValidation;
-        m_window = createInfo.window.get();
+        m_framesInFlight = std::clamp(createInfo.framesInFlight, 1u, MAX_FRAMES_IN_FLIGHT);
+        if (m_framesInFlight != createInfo.framesInFlight) {
+            SA_LOG_WARN("Frames in flight {} out of range; clamped to {}", createInfo.framesInFlight, m_framesInFlight);
+        }
+        m_recordingThreads = std::max(createInfo.recordingThreads, 1u);
+        m_window = m_headless ? nullptr : createInfo.window.get();
+        if (createInfo.window) {
+            m_width = createInfo.window->GetWidth();
+            m_height = createInfo.window->GetHeight();
+        } else {
+            m_width = createInfo.width;
+            m_height = createInfo.height;
+        }
 
         SA_LOG_INFO("Initializing Vulkan graphics context...");
         SA_LOG_INFO("  API: Vulkan");
+        SA_LOG_INFO("  Mode: {}", m_headless ? "Headless (offscreen)" : "Windowed");
         SA_LOG_INFO("  Resolution: {}x{}", m_width, m_height);
         SA_LOG_INFO("  Validation: {}", m_enableValidation ? "Enabled" : "Disabled");
+        SA_LOG_INFO("  Frames in flight: {}", m_framesInFlight);
+        SA_LOG_INFO("  Recording threads: {}", m_recordingThreads);
+        SA_LOG_INFO("  Present mode: {}", PresentModeToString(createInfo.presentPolicy.mode));
+
+        m_allowTimeline = createInfo.allowTimelineSemaphores;
+        m_preferredDevice = createInfo.preferredDevice;
+        m_bindlessRequested = createInfo.enableBindless;
+        m_presentPolicy = createInfo.presentPolicy;
+        m_framePacer.SetTargetFrameRate(m_presentPolicy.targetFrameRate);
 
         // Initialize volk (Vulkan meta-loader)
         VkResult volkResult = volkInitialize();
@@ -66,7 +99,7 @@ namespace StellarAlia::Function::Graphics {
             return false;
         }
 
-        if (!CreateSurface(createInfo)) {
+        if (!m_headless && !CreateSurface(createInfo)) {
             SA_LOG_ERROR("Failed to create surface");
             return false;
         }
@@ -81,33 +114,70 @@ namespace StellarAlia::Function::Graphics {
             return false;
         }
 
-        if (!CreateSwapchain()) {
-            SA_LOG_ERROR("Failed to create swapchain");
+        SA_LOG_INFO("  Frame sync: {}", m_useTimeline ? "timeline semaphore" : "binary fences");
+        SA_LOG_INFO("  Materials: {}", m_bindlessEnabled ? "bindless" : "per-material descriptor sets");
+        SA_LOG_INFO("  Indirect draws: {}{}", m_enabledFeatures.multiDrawIndirect ? "multi-draw" : "single draw",
+                    m_drawIndirectCountEnabled ? " with GPU count" : "");
+
+        // The allocator must exist before offscreen targets are created
+        if (!CreateVMAAllocator()) {
+            SA_LOG_ERROR("Failed to create VMA allocator");
             return false;
         }
 
-        if (!CreateImageViews()) {
-            SA_LOG_ERROR("Failed to create image views");
+        MemoryManagerCreateInfo memoryInfo;
+        memoryInfo.device = m_device;
+        memoryInfo.allocator = m_allocator;
+        memoryInfo.budgetExtension = m_memoryBudgetEnabled;
+        if (!m_memoryManager.Initialize(memoryInfo)) {
+            SA_LOG_ERROR("Failed to create memory manager");
+            return false;
+        }
+
+        UploadRingCreateInfo uploadInfo;
+        uploadInfo.device = m_device;
+        uploadInfo.memoryManager = &m_memoryManager;
+        uploadInfo.transferQueue = GetQueue(QueueType::Transfer);
+        uploadInfo.consumerFamily = GetQueueFamily(QueueType::Graphics);
+        uploadInfo.capacity = createInfo.uploadRingSize;
+        uploadInfo.frameBudget = createInfo.uploadBudgetPerFrame;
+        uploadInfo.copyAlignment = m_deviceCaps.limits.optimalBufferCopyOffsetAlignment;
+        if (!m_uploadRing.Initialize(uploadInfo)) {
+            SA_LOG_ERROR("Failed to create upload ring");
             return false;
         }
 
-        if (!CreateCommandPool()) {
-            SA_LOG_ERROR("Failed to create command pool");
+        DescriptorAllocatorCreateInfo descriptorInfo;
+        descriptorInfo.device = m_device;
+        if (!m_descriptorLayoutCache.Initialize(m_device) || !m_descriptorAllocator.Initialize(descriptorInfo)) {
+            SA_LOG_ERROR("Failed to create descriptor management");
             return false;
         }
 
-        if (!CreateCommandBuffers()) {
-            SA_LOG_ERROR("Failed to create command buffers");
+        if (m_bindlessEnabled && !m_bindless.Initialize(*this, BindlessRegistryCreateInfo{})) {
+            SA_LOG_WARN("Bindless registry unavailable; using per-material descriptor sets");
+        }
+
+        // Shared by offscreen targets and the renderer's depth buffers
+        m_depthFormat = FindDepthFormat();
+
+        if (m_headless) {
+            if (!CreateOffscreenTargets()) {
+                SA_LOG_ERROR("Failed to create offscreen targets");
+                return false;
+            }
+        } else if (!CreateSwapchain()) {
+            SA_LOG_ERROR("Failed to create swapchain");
             return false;
         }
 
-        if (!CreateSyncObjects()) {
-            SA_LOG_ERROR("Failed to create sync objects");
+        if (!CreateImageViews()) {
+            SA_LOG_ERROR("Failed to create image views");
             return false;
         }
 
-        if (!CreateVMAAllocator()) {
-            SA_LOG_ERROR("Failed to create VMA allocator");
+        if (!CreateFrameContexts()) {
+            SA_LOG_ERROR("Failed to create frame contexts");
             return false;
         }
 
@@ -123,27 +193,42 @@ namespace StellarAlia::Function::Graphics {
 
         WaitIdle();
 
+        // Everything retired during resizes is idle now
+        CollectRetiredResources(true);
+
+        m_bindless.Shutdown();
+
+        const UploadStats uploadStats = m_uploadRing.GetStats();
+        SA_LOG_INFO("Upload ring: {} KiB uploaded, {} ring stalls", uploadStats.totalBytes / 1024,
+                    uploadStats.ringStalls);
+        m_uploadRing.Shutdown();
+
+        // Cleanup swapchain or offscreen targets (offscreen images are VMA allocations)
+        DestroySwapchain();
+
+        SA_LOG_INFO("Descriptors: {} set layouts, {} persistent pools",
+                    m_descriptorLayoutCache.GetLayoutCount(), m_descriptorAllocator.GetStats().poolCount);
+        m_descriptorAllocator.Shutdown();
+        m_descriptorLayoutCache.Shutdown();
+
+        // Pools must be empty before the allocator goes
+        const MemoryStats memoryStats = m_memoryManager.GetStats();
+        SA_LOG_INFO("Memory: {} eviction requests, {} KiB moved by defragmentation",
+                    memoryStats.evictionRequests, memoryStats.defragBytesMoved / 1024);
+        m_memoryManager.Shutdown();
+
         // Cleanup VMA allocator
         if (m_allocator != VK_NULL_HANDLE) {
             vmaDestroyAllocator(m_allocator);
             m_allocator = VK_NULL_HANDLE;
         }
 
-        // Cleanup swapchain
-        DestroySwapchain();
-
-        // Cleanup sync objects
-        for (size_t i = 0; i < m_inFlightFences.size(); i++) {
-            vkDestroySemaphore(m_device, m_imageAvailableSemaphores[i], nullptr);
-            vkDestroySemaphore(m_device, m_renderFinishedSemaphores[i], nullptr);
-            vkDestroyFence(m_device, m_inFlightFences[i], nullptr);
-        }
+        // Cleanup per-frame command pools and sync objects
+        DestroyFrameContexts();
 
-        // Cleanup command pool
-        if (m_commandPool != VK_NULL_HANDLE) {
-            vkDestroyCommandPool(m_device, m_commandPool, nullptr);
-            m_commandPool = VK_NULL_HANDLE;
-        }
+        // Queue timelines must go before the device
+        m_queues.fill(nullptr);
+        m_queueStorage.clear();
 
         // Cleanup device
         if (m_device != VK_NULL_HANDLE) {
@@ -182,50 +267,161 @@ namespace StellarAlia::Function::Graphics {
             return;
         }
 
-        // Check if window was resized
+        // CPU frame cap; sleeping before the frame starts keeps input sampling fresh
+        m_framePacer.Wait();
+
+        // Check if window was resized; a minimized window has nothing to render into
         if (m_window) {
             uint32_t newWidth = m_window->GetWidth();
             uint32_t newHeight = m_window->GetHeight();
-            if (newWidth > 0 && newHeight > 0 && (newWidth != m_width || newHeight != m_height)) {
-                Resize(newWidth, newHeight);
+            if (newWidth == 0 || newHeight == 0) {
+                return;
+            }
+            if (newWidth != m_width || newHeight != m_height) {
+                m_width = newWidth;
+                m_height = newHeight;
+                m_swapchainDirty = true;
             }
         }
 
+        FrameContext& frame = m_frames[m_currentFrame];
+
         // Wait for the frame to be finished
-        vkWaitForFences(m_device, 1, &m_inFlightFences[m_currentFrame], VK_TRUE, UINT64_MAX);
+        WaitForFrameContext(frame);
+
+        // Latency limiter: allow at most maxQueuedFrames submitted-but-unfinished frames
+        uint32_t maxQueued = m_presentPolicy.maxQueuedFrames;
+        if (maxQueued > 0 && maxQueued < m_framesInFlight && m_frameNumber >= maxQueued) {
+            WaitForFrame(m_frameNumber + 1 - maxQueued);
+        }
+
+        CollectRetiredResources(false);
+
+        // A failed recreate leaves no swapchain (or offscreen targets) to acquire from; skip the
+        // frame and keep the dirty flag so the next one retries
+        if (m_swapchainDirty && !RecreateSwapchain()) {
+            return;
+        }
 
-        // Acquire next image from swapchain
+        // Acquire next image from swapchain; headless contexts rotate through offscreen targets
         uint32_t imageIndex;
-        VkResult result = vkAcquireNextImageKHR(
-            m_device, m_swapchain, UINT64_MAX,
-            m_imageAvailableSemaphores[m_currentFrame], VK_NULL_HANDLE, &imageIndex);
-
-        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-            // Swapchain is out of date, need to recreate
-            if (m_window) {
-                Resize(m_window->GetWidth(), m_window->GetHeight());
-            } else {
-                Resize(m_width, m_height);
+        if (m_headless) {
+            imageIndex = static_cast<uint32_t>(m_currentFrame % m_swapchainImages.size());
+        } else {
+            VkResult result = vkAcquireNextImageKHR(
+                m_device, m_swapchain, UINT64_MAX,
+                frame.imageAvailable, VK_NULL_HANDLE, &imageIndex);
+
+            if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+                // Nothing was acquired (the semaphore stays unsignaled): recreate and retry once
+                if (!RecreateSwapchain()) {
+                    return;
+                }
+                result = vkAcquireNextImageKHR(
+                    m_device, m_swapchain, UINT64_MAX,
+                    frame.imageAvailable, VK_NULL_HANDLE, &imageIndex);
+            }
+
+            if (result == VK_SUBOPTIMAL_KHR) {
+                // The image is usable and its semaphore will signal; recreate after presenting
+                m_swapchainDirty = true;
+            } else if (result != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to acquire swapchain image: VkResult = {}", static_cast<int>(result));
+                return;
             }
-            return;
-        } else if (result != VK_SUCCESS) {
-            SA_LOG_ERROR("Failed to acquire swapchain image");
-            return;
         }
 
         m_currentImageIndex = imageIndex;
         m_hasAcquiredImage = true;
 
-        // Reset fence
-        vkResetFences(m_device, 1, &m_inFlightFences[m_currentFrame]);
+        // Reset fence (the timeline path has none; its counter only moves forward)
+        if (!m_useTimeline) {
+            vkResetFences(m_device, 1, &frame.inFlightFence);
+        }
+
+        // The GPU is done with this frame, so every buffer and transient set from its pools
+        // can be recycled at once
+        vkResetCommandPool(m_device, frame.commandPool, 0);
+        for (ThreadCommandPool& threadPool : frame.threadPools) {
+            vkResetCommandPool(m_device, threadPool.pool, 0);
+            threadPool.usedSecondaries = 0;
+        }
+        frame.descriptorAllocator->Reset();
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (vkBeginCommandBuffer(frame.commandBuffer, &beginInfo) != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to begin frame command buffer");
+            return;
+        }
+        m_isRecording = true;
 
-        // Reset command buffer
-        vkResetCommandBuffer(m_commandBuffers[m_currentImageIndex], 0);
+        // Make uploads that finished since the last frame visible to this frame's commands
+        m_uploadRing.BeginFrame(frame.commandBuffer);
+
+        if (m_bindless.IsValid()) {
+            m_bindless.FlushMaterials();
+        }
+
+        // Budget check, eviction requests and one incremental defragmentation step
+        m_memoryManager.BeginFrame(frame.commandBuffer, m_frameNumber + 1, m_completedFrame);
     }
 
     void VulkanGraphicsContext::EndFrame() {
-        // This is where you would record commands
-        // For now, it's a placeholder
+        if (!m_initialized || !m_isRecording) {
+            return;
+        }
+
+        if (vkEndCommandBuffer(m_frames[m_currentFrame].commandBuffer) != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to end frame command buffer");
+        }
+        m_isRecording = false;
+    }
+
+    VkCommandBuffer VulkanGraphicsContext::BeginSecondaryCommandBuffer(
+        uint32_t threadIndex, const VkCommandBufferInheritanceInfo& inheritance) {
+        if (!m_isRecording) {
+            SA_LOG_ERROR("Secondary command buffers can only be recorded between BeginFrame and EndFrame");
+            return VK_NULL_HANDLE;
+        }
+        if (threadIndex >= m_recordingThreads) {
+            SA_LOG_ERROR("Recording thread {} out of range; the context was created for {} threads", threadIndex,
+                         m_recordingThreads);
+            return VK_NULL_HANDLE;
+        }
+
+        ThreadCommandPool& threadPool = m_frames[m_currentFrame].threadPools[threadIndex];
+        if (threadPool.usedSecondaries == threadPool.secondaries.size()) {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = threadPool.pool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocInfo.commandBufferCount = SECONDARY_ALLOCATION_BATCH;
+
+            const size_t first = threadPool.secondaries.size();
+            threadPool.secondaries.resize(first + SECONDARY_ALLOCATION_BATCH, VK_NULL_HANDLE);
+            VkResult result = vkAllocateCommandBuffers(m_device, &allocInfo, threadPool.secondaries.data() + first);
+            if (result != VK_SUCCESS) {
+                threadPool.secondaries.resize(first);
+                SA_LOG_ERROR("Failed to allocate secondary command buffers: VkResult = {}", static_cast<int>(result));
+                return VK_NULL_HANDLE;
+            }
+        }
+
+        VkCommandBuffer cmd = threadPool.secondaries[threadPool.usedSecondaries++];
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (inheritance.renderPass != VK_NULL_HANDLE) {
+            beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        }
+        beginInfo.pInheritanceInfo = &inheritance;
+        if (vkBeginCommandBuffer(cmd, &beginInfo) != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to begin secondary command buffer");
+            return VK_NULL_HANDLE;
+        }
+        return cmd;
     }
 
     void VulkanGraphicsContext::Present() {
@@ -233,52 +429,70 @@ namespace StellarAlia::Function::Graphics {
             return;
         }
 
-        VkSubmitInfo submitInfo{};
-        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        // Close the command buffer if the caller skipped EndFrame
+        EndFrame();
 
-        VkSemaphore waitSemaphores[] = { m_imageAvailableSemaphores[m_currentFrame] };
-        VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-        submitInfo.waitSemaphoreCount = 1;
-        submitInfo.pWaitSemaphores = waitSemaphores;
-        submitInfo.pWaitDstStageMask = waitStages;
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &m_commandBuffers[m_currentImageIndex];
+        FrameContext& frame = m_frames[m_currentFrame];
 
-        VkSemaphore signalSemaphores[] = { m_renderFinishedSemaphores[m_currentFrame] };
-        submitInfo.signalSemaphoreCount = 1;
-        submitInfo.pSignalSemaphores = signalSemaphores;
+        // Kick off this frame's copies on the transfer queue before the graphics work
+        m_uploadRing.Flush();
 
-        if (vkQueueSubmit(m_graphicsQueue, 1, &submitInfo, m_inFlightFences[m_currentFrame]) != VK_SUCCESS) {
+        // Headless frames have no acquire/present semaphores; the timeline (or fence) alone
+        // tracks them. On the timeline path the queue also signals this frame's value.
+        const QueueWait imageWait{ frame.imageAvailable, 0, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+        const QueueSignal renderSignal{ frame.renderFinished, 0 };
+
+        QueueSubmitInfo submitInfo;
+        submitInfo.commandBuffers = std::span<const VkCommandBuffer>(&frame.commandBuffer, 1);
+        if (!m_headless) {
+            submitInfo.waits = std::span<const QueueWait>(&imageWait, 1);
+            submitInfo.signals = std::span<const QueueSignal>(&renderSignal, 1);
+        }
+        submitInfo.fence = m_useTimeline ? VK_NULL_HANDLE : frame.inFlightFence;
+        submitInfo.signalTimeline = m_useTimeline;
+
+        uint64_t timelineValue = 0;
+        if (!m_queues[static_cast<size_t>(QueueType::Graphics)]->Submit(submitInfo, &timelineValue)) {
             SA_LOG_ERROR("Failed to submit draw command buffer");
             return;
         }
-
-        VkPresentInfoKHR presentInfo{};
-        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        presentInfo.waitSemaphoreCount = 1;
-        presentInfo.pWaitSemaphores = signalSemaphores;
-        presentInfo.swapchainCount = 1;
-        presentInfo.pSwapchains = &m_swapchain;
-        presentInfo.pImageIndices = &m_currentImageIndex;
-
-        VkResult result = vkQueuePresentKHR(m_presentQueue, &presentInfo);
-        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
-            if (m_window) {
-                Resize(m_window->GetWidth(), m_window->GetHeight());
-            } else {
-                Resize(m_width, m_height);
+        frame.submittedFrame = ++m_frameNumber;
+        frame.timelineValue = timelineValue;
+
+        if (!m_headless) {
+            VkPresentInfoKHR presentInfo{};
+            presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+            presentInfo.waitSemaphoreCount = 1;
+            presentInfo.pWaitSemaphores = &frame.renderFinished;
+            presentInfo.swapchainCount = 1;
+            presentInfo.pSwapchains = &m_swapchain;
+            presentInfo.pImageIndices = &m_currentImageIndex;
+
+            VkResult result = m_queues[static_cast<size_t>(QueueType::Present)]->Present(presentInfo);
+            if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+                m_swapchainDirty = true;
+            } else if (result != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to present swapchain image");
             }
-        } else if (result != VK_SUCCESS) {
-            SA_LOG_ERROR("Failed to present swapchain image");
         }
 
-        m_currentFrame = (m_currentFrame + 1) % m_inFlightFences.size();
+        m_currentFrame = (m_currentFrame + 1) % m_framesInFlight;
         m_hasAcquiredImage = false;
+
+        // Recreate between frames so the next acquire already uses the new swapchain. On failure
+        // the dirty flag stays set and BeginFrame retries before acquiring
+        if (m_swapchainDirty && !RecreateSwapchain()) {
+            SA_LOG_WARN("Swapchain recreation after present failed; retrying next frame");
+        }
+
+        UpdateFrameStats();
     }
 
     void VulkanGraphicsContext::WaitIdle() {
         if (m_device != VK_NULL_HANDLE) {
             vkDeviceWaitIdle(m_device);
+            m_completedFrame = m_frameNumber;
+            CollectRetiredResources(false);
         }
     }
 
@@ -291,26 +505,197 @@ namespace StellarAlia::Function::Graphics {
             return;
         }
 
-        WaitIdle();
-
         m_width = width;
         m_height = height;
+        m_swapchainDirty = true;
 
-        DestroySwapchain();
-        if (!CreateSwapchain()) {
-            SA_LOG_ERROR("Failed to recreate swapchain after resize");
-            return;
+        // Mid-frame resizes are applied by the next BeginFrame
+        if (!m_hasAcquiredImage) {
+            RecreateSwapchain();
         }
-        if (!CreateImageViews()) {
-            SA_LOG_ERROR("Failed to recreate image views after resize");
+    }
+
+    void VulkanGraphicsContext::SetPresentPolicy(const PresentPolicy& policy) {
+        const bool swapchainChanged = policy.mode != m_presentPolicy.mode ||
+                                      policy.imageCount != m_presentPolicy.imageCount;
+        if (policy.targetFrameRate != m_presentPolicy.targetFrameRate) {
+            m_framePacer.SetTargetFrameRate(policy.targetFrameRate);
+        }
+        m_presentPolicy = policy;
+
+        // Present mode and image count are baked into the swapchain; recreate it between frames
+        if (swapchainChanged && !m_headless && m_initialized) {
+            m_swapchainDirty = true;
+        }
+
+        SA_LOG_INFO("Present policy: mode={}, images={}, max queued frames={}, target fps={}",
+                    PresentModeToString(policy.mode), policy.imageCount, policy.maxQueuedFrames,
+                    policy.targetFrameRate);
+    }
+
+    void VulkanGraphicsContext::WaitForFrame(uint64_t frameNumber) {
+        if (frameNumber <= m_completedFrame) {
             return;
         }
-        if (!CreateCommandBuffers()) {
-            SA_LOG_ERROR("Failed to recreate command buffers after resize");
+
+        // Frame contexts are reused round-robin, so index order says nothing about age: wait for
+        // the oldest submission that satisfies the target, not a newer one
+        FrameContext* oldest = nullptr;
+        for (auto& frame : m_frames) {
+            if (frame.submittedFrame >= frameNumber && (!oldest || frame.submittedFrame < oldest->submittedFrame)) {
+                oldest = &frame;
+            }
+        }
+        if (oldest) {
+            WaitForFrameContext(*oldest);  // Waits on its timeline value when timelines are in use
+        }
+    }
+
+    void VulkanGraphicsContext::WaitForFrameContext(FrameContext& frame) {
+        if (frame.submittedFrame <= m_completedFrame) {
             return;
         }
 
-        SA_LOG_INFO("Swapchain resized to {}x{}", width, height);
+        if (m_useTimeline) {
+            GetGraphicsTimeline()->Wait(frame.timelineValue);
+        } else {
+            vkWaitForFences(m_device, 1, &frame.inFlightFence, VK_TRUE, UINT64_MAX);
+        }
+        m_completedFrame = std::max(m_completedFrame, frame.submittedFrame);
+    }
+
+    VulkanBackbuffer VulkanGraphicsContext::GetCurrentBackbuffer() const {
+        VulkanBackbuffer backbuffer;
+        if (!m_hasAcquiredImage) {
+            return backbuffer;
+        }
+        backbuffer.image = m_swapchainImages[m_currentImageIndex];
+        backbuffer.view = m_swapchainImageViews[m_currentImageIndex];
+        backbuffer.format = m_swapchainImageFormat;
+        backbuffer.extent = m_swapchainExtent;
+        if (m_headless) {
+            // Offscreen targets end the frame ready for readback; the previous user of the
+            // target may still be writing or copying it
+            backbuffer.readyStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+            backbuffer.readyAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            backbuffer.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        } else {
+            // The acquire semaphore is waited on at COLOR_ATTACHMENT_OUTPUT
+            backbuffer.readyStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            backbuffer.readyAccess = 0;
+            backbuffer.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        }
+        return backbuffer;
+    }
+
+    bool VulkanGraphicsContext::IsFrameComplete(uint64_t frameNumber) {
+        if (frameNumber > m_completedFrame) {
+            UpdateCompletedFrame();
+        }
+        return frameNumber <= m_completedFrame;
+    }
+
+    void VulkanGraphicsContext::UpdateCompletedFrame() {
+        // A single counter read answers for every frame on the timeline path
+        const uint64_t completedValue = m_useTimeline ? GetGraphicsTimeline()->GetCompletedValue() : 0;
+
+        for (const auto& frame : m_frames) {
+            if (frame.submittedFrame <= m_completedFrame) {
+                continue;
+            }
+            const bool done = m_useTimeline
+                ? frame.timelineValue <= completedValue
+                : vkGetFenceStatus(m_device, frame.inFlightFence) == VK_SUCCESS;
+            if (done) {
+                m_completedFrame = std::max(m_completedFrame, frame.submittedFrame);
+            }
+        }
+    }
+
+    void VulkanGraphicsContext::DeferDestruction(std::function<void()>&& destroy) {
+        // The frame being recorded (or the next one) may still reference the resource
+        m_retiredResources.push_back({ m_frameNumber + 1, std::move(destroy) });
+    }
+
+    bool VulkanGraphicsContext::RecreateSwapchain() {
+        const auto start = std::chrono::steady_clock::now();
+        m_swapchainDirty = false;
+
+        // Old images, views and the old swapchain are retired instead of destroyed; frames
+        // still in flight keep using them until their fences signal
+        std::vector<VkImageView> oldViews = std::move(m_swapchainImageViews);
+        m_swapchainImageViews.clear();
+
+        bool success = false;
+        if (m_headless) {
+            std::vector<OffscreenTarget> oldTargets = std::move(m_offscreenTargets);
+            m_offscreenTargets.clear();
+            m_swapchainImages.clear();
+            DeferDestruction([this, oldTargets = std::move(oldTargets)]() {
+                for (const auto& target : oldTargets) {
+                    DestroyOffscreenTarget(target);
+                }
+            });
+            success = CreateOffscreenTargets();
+        } else {
+            VkSwapchainKHR oldSwapchain = m_swapchain;
+            m_swapchain = VK_NULL_HANDLE;
+            success = CreateSwapchain(oldSwapchain);
+            if (oldSwapchain != VK_NULL_HANDLE) {
+                DeferDestruction([this, oldSwapchain]() {
+                    vkDestroySwapchainKHR(m_device, oldSwapchain, nullptr);
+                });
+            }
+        }
+
+        DeferDestruction([this, oldViews = std::move(oldViews)]() {
+            for (auto view : oldViews) {
+                vkDestroyImageView(m_device, view, nullptr);
+            }
+        });
+
+        if (!success || !CreateImageViews()) {
+            SA_LOG_ERROR("Failed to recreate {} at {}x{}", m_headless ? "offscreen targets" : "swapchain",
+                         m_width, m_height);
+            m_swapchainDirty = true;
+            return false;
+        }
+
+        const double elapsedMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        m_recreateTimeAccumMs += elapsedMs;
+        m_frameStats.swapchainRecreateCount++;
+
+        SA_LOG_INFO("{} recreated at {}x{} in {:.3f} ms", m_headless ? "Offscreen targets" : "Swapchain",
+                    m_swapchainExtent.width, m_swapchainExtent.height, elapsedMs);
+        return true;
+    }
+
+    void VulkanGraphicsContext::CollectRetiredResources(bool force) {
+        if (!force && !m_retiredResources.empty()) {
+            UpdateCompletedFrame();
+        }
+
+        while (!m_retiredResources.empty()) {
+            RetiredResource& retired = m_retiredResources.front();
+            if (!force && retired.retireFrame > m_completedFrame) {
+                break;
+            }
+            retired.destroy();
+            m_retiredResources.pop_front();
+        }
+    }
+
+    void VulkanGraphicsContext::UpdateFrameStats() {
+        const auto now = std::chrono::steady_clock::now();
+        if (m_frameNumber > 1) {
+            m_frameStats.cpuFrameTimeMs = std::chrono::duration<double, std::milli>(now - m_lastFrameTime).count();
+        }
+        m_lastFrameTime = now;
+
+        m_frameStats.frameNumber = m_frameNumber;
+        m_frameStats.swapchainRecreateMs = m_recreateTimeAccumMs;
+        m_recreateTimeAccumMs = 0.0;
     }
 
     bool VulkanGraphicsContext::CreateInstance(const GraphicsContextCreateInfo& createInfo) {
@@ -320,20 +705,27 @@ namespace StellarAlia::Function::Graphics {
         appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
         appInfo.pEngineName = "StellarAlia";
         appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-        appInfo.apiVersion = VK_API_VERSION_1_0;
+        // Request up to Vulkan 1.2 (timeline semaphores); older loaders stay on 1.0
+        uint32_t loaderVersion = VK_API_VERSION_1_0;
+        if (vkEnumerateInstanceVersion != nullptr) {
+            vkEnumerateInstanceVersion(&loaderVersion);
+        }
+        m_apiVersion = std::min(VK_API_VERSION_1_2, VK_MAKE_API_VERSION(0, VK_API_VERSION_MAJOR(loaderVersion),
+                                                                        VK_API_VERSION_MINOR(loaderVersion), 0));
+        appInfo.apiVersion = m_apiVersion;
 
         VkInstanceCreateInfo createInstanceInfo{};
         createInstanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
         createInstanceInfo.pApplicationInfo = &appInfo;
 
         auto extensions = GetRequiredExtensions(createInfo);
-        if (extensions.empty()) {
+        if (extensions.empty() && !m_headless) {
             SA_LOG_ERROR("No Vulkan instance extensions available");
             return false;
         }
 
         createInstanceInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
-        createInstanceInfo.ppEnabledExtensionNames = extensions.data();
+        createInstanceInfo.ppEnabledExtensionNames = extensions.empty() ? nullptr : extensions.data();
 
         VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo{};
         if (m_enableValidation && VALIDATION_LAYERS.size() > 0) {
@@ -411,43 +803,160 @@ namespace StellarAlia::Function::Graphics {
             return false;
         }
 
-        // Pick the first suitable device
+        // Score every suitable device; a matching user selector wins over the score
+        VkPhysicalDevice bestDevice = VK_NULL_HANDLE;
+        DeviceCapabilities bestCaps;
+        uint64_t bestScore = 0;
+        bool bestIsPreferred = false;
+
         for (const auto& device : devices) {
-            if (FindQueueFamilies(device).IsComplete()) {
-                m_physicalDevice = device;
-                return true;
+            DeviceCapabilities caps;
+            QueryDeviceCapabilities(device, m_apiVersion, caps);
+
+            if (!IsDeviceSuitable(device, caps)) {
+                SA_LOG_INFO("  GPU candidate: {} (unsuitable)", caps.deviceName);
+                continue;
+            }
+
+            const uint64_t score = ScoreDevice(caps);
+            const bool preferred = MatchesDeviceSelector(caps, m_preferredDevice);
+            SA_LOG_INFO("  GPU candidate: {} (score {}, {} MiB VRAM, uuid {}){}", caps.deviceName, score,
+                        caps.deviceLocalHeapSize / (1024 * 1024), caps.GetDeviceUUIDString(),
+                        preferred ? " [preferred]" : "");
+
+            const bool better = bestDevice == VK_NULL_HANDLE ||
+                                (preferred && !bestIsPreferred) ||
+                                (preferred == bestIsPreferred && score > bestScore);
+            if (better) {
+                bestDevice = device;
+                bestCaps = std::move(caps);
+                bestScore = score;
+                bestIsPreferred = preferred;
+            }
+        }
+
+        if (bestDevice == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("No suitable physical device found");
+            return false;
+        }
+
+        if (!m_preferredDevice.empty() && !bestIsPreferred) {
+            SA_LOG_WARN("No suitable GPU matches '{}'; falling back to the highest-scoring device",
+                        m_preferredDevice);
+        }
+
+        m_physicalDevice = bestDevice;
+        m_deviceCaps = std::move(bestCaps);
+        m_apiVersion = m_deviceCaps.apiVersion;
+        m_useTimeline = m_allowTimeline && m_deviceCaps.timelineSemaphore;
+
+        SA_LOG_INFO("  GPU: {} (Vulkan {}.{})", m_deviceCaps.deviceName,
+                    VK_API_VERSION_MAJOR(m_apiVersion), VK_API_VERSION_MINOR(m_apiVersion));
+        return true;
+    }
+
+    bool VulkanGraphicsContext::IsDeviceSuitable(VkPhysicalDevice device, const DeviceCapabilities& caps) {
+        if (!FindQueueFamilies(device).IsComplete()) {
+            return false;
+        }
+
+        if (!m_headless) {
+            for (const char* extension : DEVICE_EXTENSIONS) {
+                if (!caps.HasExtension(extension)) {
+                    return false;
+                }
             }
         }
 
-        SA_LOG_ERROR("No suitable physical device found");
-        return false;
+        return true;
     }
 
     bool VulkanGraphicsContext::CreateLogicalDevice() {
         QueueFamilyIndices indices = FindQueueFamilies(m_physicalDevice);
 
-        std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-        std::set<uint32_t> uniqueQueueFamilies = { indices.graphics, indices.present };
+        // Give each role its own queue while the family has spare queues; once it runs
+        // out, the role shares the family's last queue (and with it, lock and timeline)
+        std::map<uint32_t, uint32_t> familyQueueCounts;
+        auto reserveQueue = [&](uint32_t family) {
+            const uint32_t available = m_deviceCaps.queueFamilies[family].queueCount;
+            uint32_t& used = familyQueueCounts[family];
+            const uint32_t index = std::min(used, available - 1);
+            used = std::min(used + 1, available);
+            return QueueSlot{ family, index };
+        };
+
+        m_queueSlots[static_cast<size_t>(QueueType::Graphics)] = reserveQueue(indices.graphics);
+        m_queueSlots[static_cast<size_t>(QueueType::Compute)] = reserveQueue(indices.compute);
+        m_queueSlots[static_cast<size_t>(QueueType::Transfer)] = reserveQueue(indices.transfer);
+        m_queueSlots[static_cast<size_t>(QueueType::Present)] = indices.present == indices.graphics
+            ? m_queueSlots[static_cast<size_t>(QueueType::Graphics)]
+            : reserveQueue(indices.present);
 
-        float queuePriority = 1.0f;
-        for (uint32_t queueFamily : uniqueQueueFamilies) {
+        std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
+        uint32_t maxQueueCount = 1;
+        for (const auto& [family, count] : familyQueueCounts) {
+            maxQueueCount = std::max(maxQueueCount, count);
+        }
+        const std::vector<float> queuePriorities(maxQueueCount, 1.0f);
+        for (const auto& [family, count] : familyQueueCounts) {
             VkDeviceQueueCreateInfo queueCreateInfo{};
             queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-            queueCreateInfo.queueFamilyIndex = queueFamily;
-            queueCreateInfo.queueCount = 1;
-            queueCreateInfo.pQueuePriorities = &queuePriority;
+            queueCreateInfo.queueFamilyIndex = family;
+            queueCreateInfo.queueCount = count;
+            queueCreateInfo.pQueuePriorities = queuePriorities.data();
             queueCreateInfos.push_back(queueCreateInfo);
         }
 
+        // Indirect drawing for the GPU-driven path: many draws per call, with firstInstance
+        // carrying the instance index
         VkPhysicalDeviceFeatures deviceFeatures{};
+        deviceFeatures.multiDrawIndirect = m_deviceCaps.features.multiDrawIndirect;
+        deviceFeatures.drawIndirectFirstInstance = m_deviceCaps.features.drawIndirectFirstInstance;
+        m_enabledFeatures = deviceFeatures;
 
         VkDeviceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
         createInfo.pEnabledFeatures = &deviceFeatures;
-        createInfo.enabledExtensionCount = static_cast<uint32_t>(DEVICE_EXTENSIONS.size());
-        createInfo.ppEnabledExtensionNames = DEVICE_EXTENSIONS.data();
+
+        VkPhysicalDeviceVulkan12Features features12{};
+        features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        if (m_useTimeline) {
+            features12.timelineSemaphore = VK_TRUE;
+            createInfo.pNext = &features12;
+        }
+
+        m_drawIndirectCountEnabled = m_deviceCaps.drawIndirectCount && m_apiVersion >= VK_API_VERSION_1_2;
+        if (m_drawIndirectCountEnabled) {
+            features12.drawIndirectCount = VK_TRUE;
+            createInfo.pNext = &features12;
+        }
+
+        m_bindlessEnabled = m_bindlessRequested && m_deviceCaps.descriptorIndexing &&
+                            m_apiVersion >= VK_API_VERSION_1_2;
+        if (m_bindlessEnabled) {
+            features12.runtimeDescriptorArray = VK_TRUE;
+            features12.descriptorBindingPartiallyBound = VK_TRUE;
+            features12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            features12.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+            features12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+            createInfo.pNext = &features12;
+        } else if (m_bindlessRequested) {
+            SA_LOG_WARN("Bindless textures requested but descriptor indexing is unsupported");
+        }
+
+        std::vector<const char*> deviceExtensions;
+        if (!m_headless) {
+            deviceExtensions = DEVICE_EXTENSIONS;
+        }
+        // Real per-heap budgets for the memory manager (needs properties2, core in 1.1)
+        m_memoryBudgetEnabled = m_deviceCaps.memoryBudget && m_apiVersion >= VK_API_VERSION_1_1;
+        if (m_memoryBudgetEnabled) {
+            deviceExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        }
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
+        createInfo.ppEnabledExtensionNames = deviceExtensions.empty() ? nullptr : deviceExtensions.data();
 
         if (m_enableValidation) {
             createInfo.enabledLayerCount = static_cast<uint32_t>(VALIDATION_LAYERS.size());
@@ -465,23 +974,57 @@ namespace StellarAlia::Function::Graphics {
         // Load device functions using volk
         volkLoadDevice(m_device);
 
-        vkGetDeviceQueue(m_device, indices.graphics, 0, &m_graphicsQueue);
-        vkGetDeviceQueue(m_device, indices.present, 0, &m_presentQueue);
-        m_graphicsQueueFamily = indices.graphics;
-        m_presentQueueFamily = indices.present;
-
-        if (m_graphicsQueue == VK_NULL_HANDLE || m_presentQueue == VK_NULL_HANDLE) {
-            SA_LOG_ERROR("Failed to get device queues");
-            vkDestroyDevice(m_device, nullptr);
-            m_device = VK_NULL_HANDLE;
-            return false;
+        if (!CreateQueues()) {
+            // Retry without timelines before giving up on the device
+            if (m_useTimeline) {
+                SA_LOG_WARN("Timeline semaphore creation failed; using fence-based frame sync");
+                m_useTimeline = false;
+            }
+            if (!CreateQueues()) {
+                SA_LOG_ERROR("Failed to get device queues");
+                vkDestroyDevice(m_device, nullptr);
+                m_device = VK_NULL_HANDLE;
+                return false;
+            }
         }
 
         SA_LOG_INFO("Vulkan logical device created and loaded successfully");
         return true;
     }
 
-    bool VulkanGraphicsContext::CreateSwapchain() {
+    bool VulkanGraphicsContext::CreateQueues() {
+        m_queues.fill(nullptr);
+        m_queueStorage.clear();
+
+        // One VulkanQueue per distinct (family, index); aliased roles point at the same object
+        std::map<std::pair<uint32_t, uint32_t>, VulkanQueue*> created;
+        for (size_t i = 0; i < m_queueSlots.size(); i++) {
+            const QueueSlot& slot = m_queueSlots[i];
+            const auto key = std::make_pair(slot.family, slot.index);
+
+            auto it = created.find(key);
+            if (it == created.end()) {
+                auto queue = std::make_unique<VulkanQueue>();
+                if (!queue->Initialize(m_device, slot.family, slot.index, m_useTimeline)) {
+                    m_queues.fill(nullptr);
+                    m_queueStorage.clear();
+                    return false;
+                }
+                it = created.emplace(key, queue.get()).first;
+                m_queueStorage.push_back(std::move(queue));
+            }
+            m_queues[i] = it->second;
+
+            const auto type = static_cast<QueueType>(i);
+            const bool aliased = type != QueueType::Graphics && type != QueueType::Present &&
+                                 m_queues[i] == m_queues[static_cast<size_t>(QueueType::Graphics)];
+            SA_LOG_INFO("  Queue {}: family {}, index {}{}", QueueTypeToString(type), slot.family, slot.index,
+                        aliased ? " (shared with graphics)" : "");
+        }
+        return true;
+    }
+
+    bool VulkanGraphicsContext::CreateSwapchain(VkSwapchainKHR oldSwapchain) {
         if (m_physicalDevice == VK_NULL_HANDLE || m_surface == VK_NULL_HANDLE) {
             SA_LOG_ERROR("Cannot create swapchain: physical device or surface is invalid");
             return false;
@@ -533,12 +1076,16 @@ namespace StellarAlia::Function::Graphics {
             m_swapchainExtent.height = std::clamp(m_height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
         }
 
-        // Choose image count
-        uint32_t imageCount = capabilities.minImageCount + 1;
+        // Choose image count (policy override, clamped to what the surface allows)
+        uint32_t imageCount = m_presentPolicy.imageCount > 0 ? m_presentPolicy.imageCount
+                                                             : capabilities.minImageCount + 1;
+        imageCount = std::max(imageCount, capabilities.minImageCount);
         if (capabilities.maxImageCount > 0 && imageCount > capabilities.maxImageCount) {
             imageCount = capabilities.maxImageCount;
         }
 
+        m_swapchainPresentMode = ChoosePresentMode();
+
         // Create swapchain
         VkSwapchainCreateInfoKHR createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
@@ -550,8 +1097,10 @@ namespace StellarAlia::Function::Graphics {
         createInfo.imageArrayLayers = 1;
         createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 
-        uint32_t queueFamilyIndices[] = { m_graphicsQueueFamily, m_presentQueueFamily };
-        if (m_graphicsQueueFamily != m_presentQueueFamily) {
+        const uint32_t graphicsFamily = GetQueueFamily(QueueType::Graphics);
+        const uint32_t presentFamily = GetQueueFamily(QueueType::Present);
+        uint32_t queueFamilyIndices[] = { graphicsFamily, presentFamily };
+        if (graphicsFamily != presentFamily) {
             createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
             createInfo.queueFamilyIndexCount = 2;
             createInfo.pQueueFamilyIndices = queueFamilyIndices;
@@ -563,9 +1112,9 @@ namespace StellarAlia::Function::Graphics {
 
         createInfo.preTransform = capabilities.currentTransform;
         createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-        createInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+        createInfo.presentMode = m_swapchainPresentMode;
         createInfo.clipped = VK_TRUE;
-        createInfo.oldSwapchain = VK_NULL_HANDLE;
+        createInfo.oldSwapchain = oldSwapchain;
 
         result = vkCreateSwapchainKHR(m_device, &createInfo, nullptr, &m_swapchain);
         if (result != VK_SUCCESS) {
@@ -592,21 +1141,171 @@ namespace StellarAlia::Function::Graphics {
             return false;
         }
 
+        SA_LOG_DEBUG("Swapchain created: {} images, present mode {}", imageCount,
+                     static_cast<int>(m_swapchainPresentMode));
         return true;
     }
 
+    VkPresentModeKHR VulkanGraphicsContext::ChoosePresentMode() const {
+        VkPresentModeKHR requested = VK_PRESENT_MODE_FIFO_KHR;
+        switch (m_presentPolicy.mode) {
+            case PresentMode::Fifo:        requested = VK_PRESENT_MODE_FIFO_KHR; break;
+            case PresentMode::FifoRelaxed: requested = VK_PRESENT_MODE_FIFO_RELAXED_KHR; break;
+            case PresentMode::Mailbox:     requested = VK_PRESENT_MODE_MAILBOX_KHR; break;
+            case PresentMode::Immediate:   requested = VK_PRESENT_MODE_IMMEDIATE_KHR; break;
+        }
+        if (requested == VK_PRESENT_MODE_FIFO_KHR) {
+            return requested;
+        }
+
+        uint32_t modeCount = 0;
+        vkGetPhysicalDeviceSurfacePresentModesKHR(m_physicalDevice, m_surface, &modeCount, nullptr);
+        std::vector<VkPresentModeKHR> modes(modeCount);
+        vkGetPhysicalDeviceSurfacePresentModesKHR(m_physicalDevice, m_surface, &modeCount, modes.data());
+
+        if (std::find(modes.begin(), modes.end(), requested) != modes.end()) {
+            return requested;
+        }
+
+        // FIFO is the only mode every surface must support
+        SA_LOG_WARN("Present mode '{}' not supported by the surface; falling back to fifo",
+                    PresentModeToString(m_presentPolicy.mode));
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+
     void VulkanGraphicsContext::DestroySwapchain() {
         for (auto imageView : m_swapchainImageViews) {
             vkDestroyImageView(m_device, imageView, nullptr);
         }
         m_swapchainImageViews.clear();
 
+        if (m_headless) {
+            DestroyOffscreenTargets();
+            return;
+        }
+
         if (m_swapchain != VK_NULL_HANDLE) {
             vkDestroySwapchainKHR(m_device, m_swapchain, nullptr);
             m_swapchain = VK_NULL_HANDLE;
         }
     }
 
+    bool VulkanGraphicsContext::CreateOffscreenTargets() {
+        if (m_allocator == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("Cannot create offscreen targets: VMA allocator is invalid");
+            return false;
+        }
+
+        m_swapchainImageFormat = VK_FORMAT_B8G8R8A8_SRGB;
+        m_swapchainExtent = { m_width, m_height };
+        if (m_depthFormat == VK_FORMAT_UNDEFINED) {
+            SA_LOG_ERROR("No supported depth attachment format found");
+            return false;
+        }
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = { m_swapchainExtent.width, m_swapchainExtent.height, 1 };
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+        m_offscreenTargets.resize(m_framesInFlight);
+        m_swapchainImages.resize(m_framesInFlight);
+
+        for (uint32_t i = 0; i < m_framesInFlight; i++) {
+            OffscreenTarget& target = m_offscreenTargets[i];
+
+            // Color target can be read back or sampled by later passes
+            imageInfo.format = m_swapchainImageFormat;
+            imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                              VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                              VK_IMAGE_USAGE_SAMPLED_BIT;
+            if (!m_memoryManager.CreateImage(MemoryCategory::RenderTarget, imageInfo, allocInfo,
+                                             target.colorImage, target.colorAllocation)) {
+                SA_LOG_ERROR("Failed to create offscreen color image {}", i);
+                DestroyOffscreenTargets();
+                return false;
+            }
+            m_swapchainImages[i] = target.colorImage;
+
+            imageInfo.format = m_depthFormat;
+            imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+            if (!m_memoryManager.CreateImage(MemoryCategory::RenderTarget, imageInfo, allocInfo,
+                                             target.depthImage, target.depthAllocation)) {
+                SA_LOG_ERROR("Failed to create offscreen depth image {}", i);
+                DestroyOffscreenTargets();
+                return false;
+            }
+
+            VkImageViewCreateInfo viewInfo{};
+            viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.image = target.depthImage;
+            viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format = m_depthFormat;
+            viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+            viewInfo.subresourceRange.baseMipLevel = 0;
+            viewInfo.subresourceRange.levelCount = 1;
+            viewInfo.subresourceRange.baseArrayLayer = 0;
+            viewInfo.subresourceRange.layerCount = 1;
+
+            VkResult result = vkCreateImageView(m_device, &viewInfo, nullptr, &target.depthImageView);
+            if (result != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to create offscreen depth view {}: VkResult = {}", i, static_cast<int>(result));
+                DestroyOffscreenTargets();
+                return false;
+            }
+        }
+
+        SA_LOG_INFO("Created {} offscreen targets ({}x{})", m_framesInFlight,
+                    m_swapchainExtent.width, m_swapchainExtent.height);
+        return true;
+    }
+
+    void VulkanGraphicsContext::DestroyOffscreenTargets() {
+        for (const auto& target : m_offscreenTargets) {
+            DestroyOffscreenTarget(target);
+        }
+        m_offscreenTargets.clear();
+        m_swapchainImages.clear();
+    }
+
+    void VulkanGraphicsContext::DestroyOffscreenTarget(const OffscreenTarget& target) {
+        if (target.depthImageView != VK_NULL_HANDLE) {
+            vkDestroyImageView(m_device, target.depthImageView, nullptr);
+        }
+        if (target.depthImage != VK_NULL_HANDLE) {
+            m_memoryManager.DestroyImage(target.depthImage, target.depthAllocation);
+        }
+        if (target.colorImage != VK_NULL_HANDLE) {
+            m_memoryManager.DestroyImage(target.colorImage, target.colorAllocation);
+        }
+    }
+
+    VkFormat VulkanGraphicsContext::FindDepthFormat() const {
+        const VkFormat candidates[] = {
+            VK_FORMAT_D32_SFLOAT,
+            VK_FORMAT_D32_SFLOAT_S8_UINT,
+            VK_FORMAT_D24_UNORM_S8_UINT
+        };
+
+        for (VkFormat format : candidates) {
+            VkFormatProperties props;
+            vkGetPhysicalDeviceFormatProperties(m_physicalDevice, format, &props);
+            if (props.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT) {
+                return format;
+            }
+        }
+        return VK_FORMAT_UNDEFINED;
+    }
+
     bool VulkanGraphicsContext::CreateImageViews() {
         if (m_swapchainImages.empty()) {
             SA_LOG_ERROR("Cannot create image views: no swapchain images");
@@ -646,111 +1345,121 @@ namespace StellarAlia::Function::Graphics {
         return true;
     }
 
-    bool VulkanGraphicsContext::CreateCommandPool() {
+    bool VulkanGraphicsContext::CreateFrameContexts() {
+        m_frames.resize(m_framesInFlight);
+
         VkCommandPoolCreateInfo poolInfo{};
         poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-        poolInfo.queueFamilyIndex = m_graphicsQueueFamily;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = GetQueueFamily(QueueType::Graphics);
 
-        VkResult result = vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_commandPool);
-        if (result != VK_SUCCESS) {
-            SA_LOG_ERROR("Failed to create command pool: VkResult = {}", static_cast<int>(result));
-            return false;
-        }
-
-        return true;
-    }
-
-    bool VulkanGraphicsContext::CreateCommandBuffers() {
-        if (m_swapchainImages.empty()) {
-            SA_LOG_ERROR("Cannot create command buffers: no swapchain images");
-            return false;
-        }
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-        m_commandBuffers.resize(m_swapchainImages.size());
+        // Fences are only needed on the fallback path; the timeline tracks frames otherwise
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-        VkCommandBufferAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-        allocInfo.commandPool = m_commandPool;
-        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-        allocInfo.commandBufferCount = static_cast<uint32_t>(m_commandBuffers.size());
+        DescriptorAllocatorCreateInfo descriptorInfo;
+        descriptorInfo.device = m_device;
 
-        VkResult result = vkAllocateCommandBuffers(m_device, &allocInfo, m_commandBuffers.data());
-        if (result != VK_SUCCESS) {
-            SA_LOG_ERROR("Failed to allocate command buffers: VkResult = {}", static_cast<int>(result));
-            m_commandBuffers.clear();
-            return false;
-        }
+        for (uint32_t i = 0; i < m_framesInFlight; i++) {
+            FrameContext& frame = m_frames[i];
 
-        return true;
-    }
+            frame.descriptorAllocator = std::make_unique<VulkanDescriptorAllocator>();
+            if (!frame.descriptorAllocator->Initialize(descriptorInfo)) {
+                SA_LOG_ERROR("Failed to create descriptor allocator for frame {}", i);
+                DestroyFrameContexts();
+                return false;
+            }
 
-    bool VulkanGraphicsContext::CreateSyncObjects() {
-        const size_t maxFramesInFlight = 2;
-        m_imageAvailableSemaphores.resize(maxFramesInFlight);
-        m_renderFinishedSemaphores.resize(maxFramesInFlight);
-        m_inFlightFences.resize(maxFramesInFlight);
+            VkResult result = vkCreateCommandPool(m_device, &poolInfo, nullptr, &frame.commandPool);
+            if (result != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to create command pool for frame {}: VkResult = {}", i, static_cast<int>(result));
+                DestroyFrameContexts();
+                return false;
+            }
 
-        VkSemaphoreCreateInfo semaphoreInfo{};
-        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = frame.commandPool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandBufferCount = 1;
 
-        VkFenceCreateInfo fenceInfo{};
-        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+            result = vkAllocateCommandBuffers(m_device, &allocInfo, &frame.commandBuffer);
+            if (result != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to allocate command buffer for frame {}: VkResult = {}", i, static_cast<int>(result));
+                DestroyFrameContexts();
+                return false;
+            }
 
-        for (size_t i = 0; i < maxFramesInFlight; i++) {
-            VkResult result1 = vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_imageAvailableSemaphores[i]);
-            if (result1 != VK_SUCCESS) {
-                SA_LOG_ERROR("Failed to create image available semaphore {}: VkResult = {}", i, static_cast<int>(result1));
-                // Cleanup already created semaphores
-                for (size_t j = 0; j < i; j++) {
-                    vkDestroySemaphore(m_device, m_imageAvailableSemaphores[j], nullptr);
-                    vkDestroySemaphore(m_device, m_renderFinishedSemaphores[j], nullptr);
-                    vkDestroyFence(m_device, m_inFlightFences[j], nullptr);
+            frame.threadPools = std::vector<ThreadCommandPool>(m_recordingThreads);
+            for (uint32_t t = 0; t < m_recordingThreads; t++) {
+                result = vkCreateCommandPool(m_device, &poolInfo, nullptr, &frame.threadPools[t].pool);
+                if (result != VK_SUCCESS) {
+                    SA_LOG_ERROR("Failed to create command pool for frame {}, thread {}: VkResult = {}", i, t,
+                                 static_cast<int>(result));
+                    DestroyFrameContexts();
+                    return false;
                 }
-                m_imageAvailableSemaphores.clear();
-                m_renderFinishedSemaphores.clear();
-                m_inFlightFences.clear();
+            }
+
+            result = vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &frame.imageAvailable);
+            if (result != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to create image available semaphore {}: VkResult = {}", i, static_cast<int>(result));
+                DestroyFrameContexts();
                 return false;
             }
 
-            VkResult result2 = vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_renderFinishedSemaphores[i]);
-            if (result2 != VK_SUCCESS) {
-                SA_LOG_ERROR("Failed to create render finished semaphore {}: VkResult = {}", i, static_cast<int>(result2));
-                // Cleanup
-                vkDestroySemaphore(m_device, m_imageAvailableSemaphores[i], nullptr);
-                for (size_t j = 0; j < i; j++) {
-                    vkDestroySemaphore(m_device, m_imageAvailableSemaphores[j], nullptr);
-                    vkDestroySemaphore(m_device, m_renderFinishedSemaphores[j], nullptr);
-                    vkDestroyFence(m_device, m_inFlightFences[j], nullptr);
-                }
-                m_imageAvailableSemaphores.clear();
-                m_renderFinishedSemaphores.clear();
-                m_inFlightFences.clear();
+            result = vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &frame.renderFinished);
+            if (result != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to create render finished semaphore {}: VkResult = {}", i, static_cast<int>(result));
+                DestroyFrameContexts();
                 return false;
             }
 
-            VkResult result3 = vkCreateFence(m_device, &fenceInfo, nullptr, &m_inFlightFences[i]);
-            if (result3 != VK_SUCCESS) {
-                SA_LOG_ERROR("Failed to create fence {}: VkResult = {}", i, static_cast<int>(result3));
-                // Cleanup
-                vkDestroySemaphore(m_device, m_imageAvailableSemaphores[i], nullptr);
-                vkDestroySemaphore(m_device, m_renderFinishedSemaphores[i], nullptr);
-                for (size_t j = 0; j < i; j++) {
-                    vkDestroySemaphore(m_device, m_imageAvailableSemaphores[j], nullptr);
-                    vkDestroySemaphore(m_device, m_renderFinishedSemaphores[j], nullptr);
-                    vkDestroyFence(m_device, m_inFlightFences[j], nullptr);
-                }
-                m_imageAvailableSemaphores.clear();
-                m_renderFinishedSemaphores.clear();
-                m_inFlightFences.clear();
+            if (m_useTimeline) {
+                continue;
+            }
+
+            result = vkCreateFence(m_device, &fenceInfo, nullptr, &frame.inFlightFence);
+            if (result != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to create fence {}: VkResult = {}", i, static_cast<int>(result));
+                DestroyFrameContexts();
                 return false;
             }
         }
 
+        m_currentFrame = 0;
         return true;
     }
 
+    void VulkanGraphicsContext::DestroyFrameContexts() {
+        for (auto& frame : m_frames) {
+            // Destroying the pool frees its command buffers
+            if (frame.commandPool != VK_NULL_HANDLE) {
+                vkDestroyCommandPool(m_device, frame.commandPool, nullptr);
+            }
+            for (const ThreadCommandPool& threadPool : frame.threadPools) {
+                if (threadPool.pool != VK_NULL_HANDLE) {
+                    vkDestroyCommandPool(m_device, threadPool.pool, nullptr);
+                }
+            }
+            frame.descriptorAllocator.reset();
+            if (frame.imageAvailable != VK_NULL_HANDLE) {
+                vkDestroySemaphore(m_device, frame.imageAvailable, nullptr);
+            }
+            if (frame.renderFinished != VK_NULL_HANDLE) {
+                vkDestroySemaphore(m_device, frame.renderFinished, nullptr);
+            }
+            if (frame.inFlightFence != VK_NULL_HANDLE) {
+                vkDestroyFence(m_device, frame.inFlightFence, nullptr);
+            }
+        }
+        m_frames.clear();
+    }
+
     bool VulkanGraphicsContext::CheckValidationLayerSupport() {
         // vkEnumerateInstanceLayerProperties is a global function available from the loader
         // It doesn't require an instance, but we need to make sure the loader is loaded
@@ -791,6 +1500,14 @@ namespace StellarAlia::Function::Graphics {
     std::vector<const char*> VulkanGraphicsContext::GetRequiredExtensions(const GraphicsContextCreateInfo& createInfo) {
         std::vector<const char*> extensions;
 
+        // Headless contexts need no surface extensions
+        if (m_headless) {
+            if (m_enableValidation) {
+                extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+            }
+            return extensions;
+        }
+
         // Get required extensions using GLFW
         if (!createInfo.window) {
             SA_LOG_ERROR("Window is required to get Vulkan instance extensions");
@@ -833,22 +1550,46 @@ namespace StellarAlia::Function::Graphics {
         std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
         vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
 
+        uint32_t dedicatedCompute = UINT32_MAX;
+        uint32_t dedicatedTransfer = UINT32_MAX;
         for (uint32_t i = 0; i < queueFamilyCount; i++) {
-            if (queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
-                indices.graphics = i;
+            const VkQueueFlags flags = queueFamilies[i].queueFlags;
+            if (queueFamilies[i].queueCount == 0) {
+                continue;
             }
 
-            VkBool32 presentSupport = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &presentSupport);
-            if (presentSupport) {
-                indices.present = i;
+            if ((flags & VK_QUEUE_GRAPHICS_BIT) && indices.graphics == UINT32_MAX) {
+                indices.graphics = i;
+            }
+            if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT) &&
+                dedicatedCompute == UINT32_MAX) {
+                dedicatedCompute = i;
+            }
+            if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) &&
+                dedicatedTransfer == UINT32_MAX) {
+                dedicatedTransfer = i;
             }
 
-            if (indices.IsComplete()) {
-                break;
+            // Prefer presenting from the graphics family so the swapchain stays exclusive
+            if (!m_headless) {
+                VkBool32 presentSupport = false;
+                vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &presentSupport);
+                if (presentSupport && (indices.present == UINT32_MAX || i == indices.graphics)) {
+                    indices.present = i;
+                }
             }
         }
 
+        // Without a surface nothing is presented; alias present to graphics
+        if (m_headless) {
+            indices.present = indices.graphics;
+        }
+
+        // Compute falls back to graphics; transfer to the async compute family (compute
+        // queues always support transfers), then to graphics
+        indices.compute = dedicatedCompute != UINT32_MAX ? dedicatedCompute : indices.graphics;
+        indices.transfer = dedicatedTransfer != UINT32_MAX ? dedicatedTransfer : indices.compute;
+
         return indices;
     }
 
@@ -871,7 +1612,7 @@ namespace StellarAlia::Function::Graphics {
         allocatorInfo.physicalDevice = m_physicalDevice;
         allocatorInfo.device = m_device;
         allocatorInfo.instance = m_instance;
-        allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_0;
+        allocatorInfo.vulkanApiVersion = m_apiVersion;
 
         // Provide explicit function pointers for volk compatibility
         // VMA needs vkGetInstanceProcAddr and vkGetDeviceProcAddr to load other functions
@@ -885,6 +1626,9 @@ namespace StellarAlia::Function::Graphics {
 
         // Optional: Enable VMA features
         // allocatorInfo.flags = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+        if (m_memoryBudgetEnabled) {
+            allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+        }
 
         VkResult result = vmaCreateAllocator(&allocatorInfo, &m_allocator);
         if (result != VK_SUCCESS) {
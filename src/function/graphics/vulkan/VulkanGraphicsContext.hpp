@@ -5,6 +5,8 @@
  * @brief Vulkan implementation of GraphicsContext
  * 
  * This implementation uses the window system for window and surface management (GLFW-only).
+ * In headless mode no surface or swapchain is created; frames are rendered into
+ * VMA-allocated offscreen color/depth images instead.
  */
 
 #ifndef VK_NO_PROTOTYPES
@@ -14,12 +16,39 @@
 #include <volk.h>
 
 #include "function/graphics/GraphicsContext.hpp"
+#include "function/graphics/FramePacer.hpp"
+#include "function/graphics/vulkan/VulkanBindlessRegistry.hpp"
+#include "function/graphics/vulkan/VulkanDescriptorAllocator.hpp"
+#include "function/graphics/vulkan/VulkanDescriptorLayoutCache.hpp"
+#include "function/graphics/vulkan/VulkanDeviceCapabilities.hpp"
+#include "function/graphics/vulkan/VulkanMemoryManager.hpp"
+#include "function/graphics/vulkan/VulkanQueue.hpp"
+#include "function/graphics/vulkan/VulkanTimeline.hpp"
+#include "function/graphics/vulkan/VulkanUploadRing.hpp"
 #include <vma/vk_mem_alloc.h>
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <string>
 
 namespace StellarAlia::Function::Graphics {
 
+    /**
+     * @brief Image the current frame renders into (swapchain image or offscreen target)
+     */
+    struct VulkanBackbuffer {
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkFormat format = VK_FORMAT_UNDEFINED;
+        VkExtent2D extent = {};
+        VkPipelineStageFlags readyStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;  // First stage allowed to touch it
+        VkAccessFlags readyAccess = 0;                                        // Writes to make available first
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;          // Layout expected by Present()
+    };
+
     /**
      * @brief Vulkan graphics context implementation
      */
@@ -36,9 +65,13 @@ namespace StellarAlia::Function::Graphics {
         void WaitIdle() override;
         GraphicsAPI GetAPI() const override { return GraphicsAPI::Vulkan; }
         bool IsInitialized() const override { return m_initialized; }
+        bool IsHeadless() const override { return m_headless; }
         uint32_t GetWidth() const override { return m_width; }
         uint32_t GetHeight() const override { return m_height; }
         void Resize(uint32_t width, uint32_t height) override;
+        const FrameStats& GetFrameStats() const override { return m_frameStats; }
+        void SetPresentPolicy(const PresentPolicy& policy) override;
+        const PresentPolicy& GetPresentPolicy() const override { return m_presentPolicy; }
 
         /**
          * @brief Get the VMA allocator
@@ -56,23 +89,218 @@ namespace StellarAlia::Function::Graphics {
          * @brief Get the graphics queue family index
          * @return Queue family index
          */
-        uint32_t GetGraphicsQueueFamily() const { return m_graphicsQueueFamily; }
+        uint32_t GetGraphicsQueueFamily() const { return GetQueueFamily(QueueType::Graphics); }
 
         /**
          * @brief Get the graphics queue
          * @return VkQueue handle
          */
-        VkQueue GetGraphicsQueue() const { return m_graphicsQueue; }
+        VkQueue GetGraphicsQueue() const { return GetQueue(QueueType::Graphics)->GetHandle(); }
+
+        /**
+         * @brief Get the queue serving a role
+         * Compute and transfer alias the graphics queue when the device has no spare queue for them.
+         * @param type Queue role
+         * @return Queue (shared between aliased roles)
+         */
+        VulkanQueue* GetQueue(QueueType type) const { return m_queues[static_cast<size_t>(type)]; }
+
+        /**
+         * @brief Get the queue family index serving a role
+         * @param type Queue role
+         * @return Queue family index
+         */
+        uint32_t GetQueueFamily(QueueType type) const { return m_queueSlots[static_cast<size_t>(type)].family; }
+
+        /**
+         * @brief Check whether a role runs on its own queue
+         * @param type Queue role
+         * @return True if work submitted to this role can overlap with graphics
+         */
+        bool HasDedicatedQueue(QueueType type) const { return GetQueue(type) != GetQueue(QueueType::Graphics); }
+
+        /**
+         * @brief Check whether resources shared between two roles need ownership transfers
+         * @param src Releasing role
+         * @param dst Acquiring role
+         * @return True if the roles use different queue families
+         */
+        bool RequiresOwnershipTransfer(QueueType src, QueueType dst) const {
+            return GetQueueFamily(src) != GetQueueFamily(dst);
+        }
+
+        /**
+         * @brief Get the number of frames that may be in flight on the GPU
+         * @return Frames-in-flight count
+         */
+        uint32_t GetFramesInFlight() const { return m_framesInFlight; }
+
+        /**
+         * @brief Get the index of the frame context currently being recorded
+         * @return Frame index in [0, GetFramesInFlight())
+         */
+        uint32_t GetCurrentFrameIndex() const { return m_currentFrame; }
+
+        /**
+         * @brief Get the primary command buffer of the current frame
+         * @return VkCommandBuffer in the recording state between BeginFrame and EndFrame
+         */
+        VkCommandBuffer GetCurrentCommandBuffer() const { return m_frames[m_currentFrame].commandBuffer; }
+
+        /**
+         * @brief Get the number of threads that may record secondary command buffers
+         * @return Recording thread count; valid thread indices are [0, count)
+         */
+        uint32_t GetRecordingThreadCount() const { return m_recordingThreads; }
+
+        /**
+         * @brief Begin a secondary command buffer from a recording thread's pool of the current frame
+         * Every thread index has its own command pool per frame in flight, so different
+         * indices may record concurrently; one index must not be used by two threads at once.
+         * The buffers are recycled when this frame context is reused. End them with
+         * vkEndCommandBuffer.
+         * @param threadIndex Recording thread in [0, GetRecordingThreadCount())
+         * @param inheritance Render pass, subpass and framebuffer the buffer executes in
+         * @return Command buffer in the recording state, or VK_NULL_HANDLE on failure
+         */
+        VkCommandBuffer BeginSecondaryCommandBuffer(uint32_t threadIndex,
+                                                    const VkCommandBufferInheritanceInfo& inheritance);
+
+        /**
+         * @brief Check whether BeginFrame opened a command buffer for this frame
+         * False when the window is minimized or the swapchain image could not be acquired.
+         * @return True between a successful BeginFrame and EndFrame
+         */
+        bool IsFrameActive() const { return m_isRecording; }
+
+        /**
+         * @brief Get the image the current frame renders into
+         * @return Backbuffer; image is VK_NULL_HANDLE when no image was acquired
+         */
+        VulkanBackbuffer GetCurrentBackbuffer() const;
+
+        /**
+         * @brief Get the depth attachment format supported by the device
+         * @return Depth format
+         */
+        VkFormat GetDepthFormat() const { return m_depthFormat; }
+
+        /**
+         * @brief Get the memory manager (category pools, budget, defragmentation)
+         * @return Memory manager
+         */
+        VulkanMemoryManager& GetMemoryManager() { return m_memoryManager; }
+
+        /**
+         * @brief Get the staging ring for asynchronous buffer and image uploads
+         * Copies run on the transfer queue; finished uploads are acquired by the graphics
+         * queue at the next BeginFrame.
+         * @return Upload ring
+         */
+        VulkanUploadRing& GetUploadRing() { return m_uploadRing; }
+
+        /**
+         * @brief Get the shared descriptor set layout cache
+         * @return Layout cache
+         */
+        VulkanDescriptorLayoutCache& GetDescriptorLayoutCache() { return m_descriptorLayoutCache; }
+
+        /**
+         * @brief Get the allocator for long-lived descriptor sets (materials, static resources)
+         * Not thread-safe; sets stay valid until shutdown.
+         * @return Persistent descriptor allocator
+         */
+        VulkanDescriptorAllocator& GetDescriptorAllocator() { return m_descriptorAllocator; }
+
+        /**
+         * @brief Get the current frame's transient descriptor allocator
+         * Sets are recycled when this frame context is reused, framesInFlight frames later.
+         * @return Per-frame descriptor allocator
+         */
+        VulkanDescriptorAllocator& GetFrameDescriptorAllocator() { return *m_frames[m_currentFrame].descriptorAllocator; }
+
+        /**
+         * @brief Get the bindless texture/material registry
+         * @return Registry, or nullptr when bindless was not requested or is unsupported
+         *         (use per-material descriptor sets instead)
+         */
+        VulkanBindlessRegistry* GetBindlessRegistry() { return m_bindless.IsValid() ? &m_bindless : nullptr; }
+
+        /**
+         * @brief Get the capabilities of the selected physical device
+         * @return Capabilities cached at initialization
+         */
+        const DeviceCapabilities& GetDeviceCapabilities() const { return m_deviceCaps; }
+
+        /**
+         * @brief Get the core features enabled on the device
+         * @return Enabled features (a subset of GetDeviceCapabilities().features)
+         */
+        const VkPhysicalDeviceFeatures& GetEnabledFeatures() const { return m_enabledFeatures; }
+
+        /**
+         * @brief Check whether vkCmdDraw*IndirectCount may be used
+         * @return True if the Vulkan 1.2 drawIndirectCount feature was enabled
+         */
+        bool IsDrawIndirectCountEnabled() const { return m_drawIndirectCountEnabled; }
+
+        /**
+         * @brief Get the Vulkan API version the instance and device were created with
+         * @return VK_API_VERSION_* value (major.minor, patch cleared)
+         */
+        uint32_t GetApiVersion() const { return m_apiVersion; }
+
+        /**
+         * @brief Check whether frame synchronization runs on timeline semaphores
+         * @return True on the Vulkan 1.2 timeline path, false on the binary fence fallback
+         */
+        bool UsesTimelineSemaphores() const { return m_useTimeline; }
+
+        /**
+         * @brief Get the graphics queue timeline
+         * @return Timeline, or nullptr on the fence fallback path
+         */
+        VulkanTimeline* GetGraphicsTimeline() { return m_useTimeline ? GetQueue(QueueType::Graphics)->GetTimeline() : nullptr; }
+
+        /**
+         * @brief Get the number of frames submitted so far
+         * @return Frame number of the most recent submission (frames start at 1)
+         */
+        uint64_t GetFrameNumber() const { return m_frameNumber; }
+
+        /**
+         * @brief Check whether the GPU has finished a frame
+         * Queries the timeline counter (or the frame fences on the fallback path); never blocks.
+         * @param frameNumber Frame number as returned by GetFrameNumber
+         * @return True if the frame and every earlier frame have completed
+         */
+        bool IsFrameComplete(uint64_t frameNumber);
+
+        /**
+         * @brief Destroy a resource once no in-flight frame can still reference it
+         * @param destroy Callback that releases the resource; runs after the GPU has finished
+         *                every frame submitted up to and including the current one
+         */
+        void DeferDestruction(std::function<void()>&& destroy);
 
     private:
         // Vulkan instance and device
         VkInstance m_instance = VK_NULL_HANDLE;
         VkDevice m_device = VK_NULL_HANDLE;
         VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
-        VkQueue m_graphicsQueue = VK_NULL_HANDLE;
-        VkQueue m_presentQueue = VK_NULL_HANDLE;
-        uint32_t m_graphicsQueueFamily = UINT32_MAX;
-        uint32_t m_presentQueueFamily = UINT32_MAX;
+
+        // Device queues: one object per distinct VkQueue, indexed by role through m_queues
+        struct QueueSlot {
+            uint32_t family = UINT32_MAX;
+            uint32_t index = 0;
+        };
+        std::array<QueueSlot, static_cast<size_t>(QueueType::Count)> m_queueSlots{};
+        std::array<VulkanQueue*, static_cast<size_t>(QueueType::Count)> m_queues{};
+        std::vector<std::unique_ptr<VulkanQueue>> m_queueStorage;
+
+        // Physical device selection
+        DeviceCapabilities m_deviceCaps;
+        std::string m_preferredDevice;
 
         // Swapchain
         VkSwapchainKHR m_swapchain = VK_NULL_HANDLE;
@@ -80,18 +308,76 @@ namespace StellarAlia::Function::Graphics {
         std::vector<VkImageView> m_swapchainImageViews;
         VkFormat m_swapchainImageFormat = VK_FORMAT_UNDEFINED;
         VkExtent2D m_swapchainExtent = {};
+        VkPresentModeKHR m_swapchainPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+
+        // Presentation policy and CPU frame cap
+        PresentPolicy m_presentPolicy;
+        FramePacer m_framePacer;
+
+        // Offscreen targets (headless mode). Color images are also listed in
+        // m_swapchainImages so image views and frame indexing are shared.
+        struct OffscreenTarget {
+            VkImage colorImage = VK_NULL_HANDLE;
+            VmaAllocation colorAllocation = VK_NULL_HANDLE;
+            VkImage depthImage = VK_NULL_HANDLE;
+            VmaAllocation depthAllocation = VK_NULL_HANDLE;
+            VkImageView depthImageView = VK_NULL_HANDLE;
+        };
+        std::vector<OffscreenTarget> m_offscreenTargets;
+        VkFormat m_depthFormat = VK_FORMAT_UNDEFINED;
 
-        // Command buffers
-        VkCommandPool m_commandPool = VK_NULL_HANDLE;
-        std::vector<VkCommandBuffer> m_commandBuffers;
+        // Command pool of one recording thread in one frame; secondary buffers are allocated on
+        // demand and kept across resets. Padded so threads never share a cache line.
+        struct alignas(64) ThreadCommandPool {
+            VkCommandPool pool = VK_NULL_HANDLE;
+            std::vector<VkCommandBuffer> secondaries;
+            uint32_t usedSecondaries = 0;
+        };
 
-        // Synchronization
-        std::vector<VkSemaphore> m_imageAvailableSemaphores;
-        std::vector<VkSemaphore> m_renderFinishedSemaphores;
-        std::vector<VkFence> m_inFlightFences;
-        size_t m_currentFrame = 0;
+        // Per-frame-in-flight context. Each frame owns transient command pools (the primary
+        // buffer's plus one per recording thread) and a descriptor allocator that are reset
+        // in one call each once the frame's fence has signaled.
+        struct FrameContext {
+            VkCommandPool commandPool = VK_NULL_HANDLE;
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            std::vector<ThreadCommandPool> threadPools;
+            std::unique_ptr<VulkanDescriptorAllocator> descriptorAllocator;
+            VkSemaphore imageAvailable = VK_NULL_HANDLE;
+            VkSemaphore renderFinished = VK_NULL_HANDLE;
+            VkFence inFlightFence = VK_NULL_HANDLE;  // Fallback path only
+            uint64_t submittedFrame = 0;  // Frame number of the last submission using this context
+            uint64_t timelineValue = 0;   // Graphics timeline value signaled by that submission
+        };
+        std::vector<FrameContext> m_frames;
+        uint32_t m_framesInFlight = 2;
+        uint32_t m_recordingThreads = 1;
+        uint32_t m_currentFrame = 0;
         uint32_t m_currentImageIndex = 0;
         bool m_hasAcquiredImage = false;
+        bool m_isRecording = false;
+
+        // Frame numbering: m_frameNumber counts submissions, m_completedFrame is the newest
+        // frame known to have finished on the GPU
+        uint64_t m_frameNumber = 0;
+        uint64_t m_completedFrame = 0;
+
+        // Vulkan 1.2 timeline path (one timeline per queue); falls back to per-frame fences
+        uint32_t m_apiVersion = VK_API_VERSION_1_0;
+        bool m_allowTimeline = true;
+        bool m_useTimeline = false;
+
+        // Resources retired by swapchain recreation, destroyed once their frame completes
+        struct RetiredResource {
+            uint64_t retireFrame = 0;
+            std::function<void()> destroy;
+        };
+        std::deque<RetiredResource> m_retiredResources;
+        bool m_swapchainDirty = false;
+
+        // Frame timing
+        FrameStats m_frameStats;
+        std::chrono::steady_clock::time_point m_lastFrameTime;
+        double m_recreateTimeAccumMs = 0.0;
 
         // Surface (platform-specific)
         VkSurfaceKHR m_surface = VK_NULL_HANDLE;
@@ -102,6 +388,26 @@ namespace StellarAlia::Function::Graphics {
         // Vulkan Memory Allocator
         VmaAllocator m_allocator = VK_NULL_HANDLE;
 
+        // Category pools, heap budget and defragmentation on top of the allocator
+        VulkanMemoryManager m_memoryManager;
+        bool m_memoryBudgetEnabled = false;
+
+        // Asynchronous staging uploads
+        VulkanUploadRing m_uploadRing;
+
+        // Shared descriptor set layouts and long-lived descriptor sets
+        VulkanDescriptorLayoutCache m_descriptorLayoutCache;
+        VulkanDescriptorAllocator m_descriptorAllocator;
+
+        // Optional bindless path (descriptor indexing)
+        VulkanBindlessRegistry m_bindless;
+        bool m_bindlessRequested = false;
+        bool m_bindlessEnabled = false;
+
+        // Optional device features enabled at creation
+        VkPhysicalDeviceFeatures m_enabledFeatures = {};
+        bool m_drawIndirectCountEnabled = false;
+
         // Window reference (for checking resize)
         WindowSystem* m_window = nullptr;
 
@@ -110,6 +416,7 @@ namespace StellarAlia::Function::Graphics {
         uint32_t m_width = 0;
         uint32_t m_height = 0;
         bool m_enableValidation = false;
+        bool m_headless = false;
 
         // Helper functions
         bool CreateInstance(const GraphicsContextCreateInfo& createInfo);
@@ -117,13 +424,25 @@ namespace StellarAlia::Function::Graphics {
         bool CreateSurface(const GraphicsContextCreateInfo& createInfo);
         bool CreateSurfaceFromWindow(const GraphicsContextCreateInfo& createInfo);
         bool PickPhysicalDevice();
+        bool IsDeviceSuitable(VkPhysicalDevice device, const DeviceCapabilities& caps);
         bool CreateLogicalDevice();
-        bool CreateSwapchain();
+        bool CreateQueues();
+        bool CreateSwapchain(VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE);
         void DestroySwapchain();
+        bool RecreateSwapchain();
+        bool CreateOffscreenTargets();
+        void DestroyOffscreenTargets();
+        void DestroyOffscreenTarget(const OffscreenTarget& target);
+        VkPresentModeKHR ChoosePresentMode() const;
+        void WaitForFrame(uint64_t frameNumber);
+        void WaitForFrameContext(FrameContext& frame);
+        void UpdateCompletedFrame();
+        void CollectRetiredResources(bool force);
+        void UpdateFrameStats();
+        VkFormat FindDepthFormat() const;
         bool CreateImageViews();
-        bool CreateCommandPool();
-        bool CreateCommandBuffers();
-        bool CreateSyncObjects();
+        bool CreateFrameContexts();
+        void DestroyFrameContexts();
         bool CreateVMAAllocator();
 
         // Validation layer support
@@ -135,6 +454,8 @@ namespace StellarAlia::Function::Graphics {
         struct QueueFamilyIndices {
             uint32_t graphics = UINT32_MAX;
             uint32_t present = UINT32_MAX;
+            uint32_t compute = UINT32_MAX;   // Dedicated compute family, else graphics
+            uint32_t transfer = UINT32_MAX;  // Dedicated transfer family, else compute
             bool IsComplete() const { return graphics != UINT32_MAX && present != UINT32_MAX; }
         };
         QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device);
@@ -0,0 +1,574 @@
+#include "function/graphics/vulkan/VulkanMemoryManager.hpp"
+#include "core/logs/Log.hpp"
+
+#include <algorithm>
+
+namespace StellarAlia::Function::Graphics {
+
+    const char* MemoryCategoryToString(MemoryCategory category) {
+        switch (category) {
+            case MemoryCategory::RenderTarget: return "render targets";
+            case MemoryCategory::Geometry:     return "geometry";
+            case MemoryCategory::Texture:      return "textures";
+            case MemoryCategory::Staging:      return "staging";
+            default:                           return "unknown";
+        }
+    }
+
+    VulkanMemoryManager::~VulkanMemoryManager() {
+        Shutdown();
+    }
+
+    bool VulkanMemoryManager::Initialize(const MemoryManagerCreateInfo& createInfo) {
+        if (m_allocator != VK_NULL_HANDLE) {
+            SA_LOG_WARN("VulkanMemoryManager already initialized");
+            return false;
+        }
+        if (createInfo.device == VK_NULL_HANDLE || createInfo.allocator == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("Invalid memory manager create info");
+            return false;
+        }
+
+        m_device = createInfo.device;
+        m_allocator = createInfo.allocator;
+        m_settings = createInfo;
+
+        const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+        vmaGetMemoryProperties(m_allocator, &memoryProperties);
+        m_heapCount = memoryProperties->memoryHeapCount;
+        for (uint32_t i = 0; i < m_heapCount; i++) {
+            if (memoryProperties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+                m_deviceLocalHeapMask |= 1u << i;
+            }
+        }
+
+        if (!CreatePools()) {
+            Shutdown();
+            return false;
+        }
+
+        SA_LOG_INFO("Memory manager: {} heaps, budget source: {}", m_heapCount,
+                    m_settings.budgetExtension ? "VK_EXT_memory_budget" : "estimate");
+        return true;
+    }
+
+    void VulkanMemoryManager::Shutdown() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_allocator == VK_NULL_HANDLE) {
+            return;
+        }
+
+        // The GPU is idle at shutdown, so an open pass can be closed immediately
+        if (m_passActive) {
+            EndPass();
+        }
+        if (m_defragContext != VK_NULL_HANDLE) {
+            FinishDefragmentation();
+        }
+
+        if (!m_buffers.empty() || !m_images.empty()) {
+            SA_LOG_WARN("Memory manager shut down with {} buffers and {} images still allocated",
+                        m_buffers.size(), m_images.size());
+        }
+        for (auto& [allocation, record] : m_buffers) {
+            vmaDestroyBuffer(m_allocator, record.buffer, allocation);
+        }
+        m_buffers.clear();
+        m_images.clear();  // Owners still hold the images; VMA reports them as leaks
+
+        for (VmaPool& pool : m_pools) {
+            if (pool != VK_NULL_HANDLE) {
+                vmaDestroyPool(m_allocator, pool);
+                pool = VK_NULL_HANDLE;
+            }
+        }
+
+        m_evictionCallbacks.clear();
+        m_allocator = VK_NULL_HANDLE;
+        m_device = VK_NULL_HANDLE;
+    }
+
+    bool VulkanMemoryManager::CreateBuffer(MemoryCategory category, const VkBufferCreateInfo& bufferInfo,
+                                           const VmaAllocationCreateInfo& allocInfo, VkBuffer& outBuffer,
+                                           VmaAllocation& outAllocation, BufferMovedCallback onMoved) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Movable buffers are copied by defragmentation, which needs both transfer usages
+        VkBufferCreateInfo info = bufferInfo;
+        if (onMoved) {
+            info.usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        }
+
+        const size_t index = static_cast<size_t>(category);
+        VmaAllocationCreateInfo poolAllocInfo = allocInfo;
+        const bool wantsHostAccess = (allocInfo.flags & (VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                                                         VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT)) != 0;
+        const bool poolHostVisible = (m_poolMemoryFlags[index] & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+        if (poolAllocInfo.pool == VK_NULL_HANDLE && (!wantsHostAccess || poolHostVisible)) {
+            poolAllocInfo.pool = m_pools[index];
+        }
+
+        VkResult result = vmaCreateBuffer(m_allocator, &info, &poolAllocInfo, &outBuffer, &outAllocation, nullptr);
+        if (result != VK_SUCCESS && poolAllocInfo.pool != allocInfo.pool) {
+            // The pool's memory type may not fit this resource; fall back to the default pools
+            result = vmaCreateBuffer(m_allocator, &info, &allocInfo, &outBuffer, &outAllocation, nullptr);
+        }
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create {} buffer ({} bytes): VkResult = {}", MemoryCategoryToString(category),
+                         info.size, static_cast<int>(result));
+            outBuffer = VK_NULL_HANDLE;
+            outAllocation = VK_NULL_HANDLE;
+            return false;
+        }
+
+        BufferRecord& record = m_buffers[outAllocation];
+        record.category = category;
+        record.buffer = outBuffer;
+        record.createInfo = info;
+        record.createInfo.pNext = nullptr;  // Not retained; chained structs would dangle
+        record.onMoved = std::move(onMoved);
+        return true;
+    }
+
+    void VulkanMemoryManager::DestroyBuffer(VkBuffer buffer, VmaAllocation allocation) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto it = m_buffers.find(allocation);
+        if (it == m_buffers.end()) {
+            vmaDestroyBuffer(m_allocator, buffer, allocation);
+            return;
+        }
+
+        // Frees inside a pool that is mid-pass are applied once the pass ends
+        if (m_passActive && it->second.category == m_defragCategory) {
+            m_freeAfterPass.push_back(allocation);
+            return;
+        }
+
+        FreeBuffer(allocation);
+    }
+
+    bool VulkanMemoryManager::CreateImage(MemoryCategory category, const VkImageCreateInfo& imageInfo,
+                                          const VmaAllocationCreateInfo& allocInfo, VkImage& outImage,
+                                          VmaAllocation& outAllocation) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Skip the category pool when it lacks required properties (e.g. lazily allocated memory)
+        const size_t index = static_cast<size_t>(category);
+        VmaAllocationCreateInfo poolAllocInfo = allocInfo;
+        if (poolAllocInfo.pool == VK_NULL_HANDLE &&
+            (m_poolMemoryFlags[index] & allocInfo.requiredFlags) == allocInfo.requiredFlags) {
+            poolAllocInfo.pool = m_pools[index];
+        }
+
+        VkResult result = vmaCreateImage(m_allocator, &imageInfo, &poolAllocInfo, &outImage, &outAllocation, nullptr);
+        if (result != VK_SUCCESS && poolAllocInfo.pool != allocInfo.pool) {
+            // Some formats (e.g. depth on certain drivers) need a different memory type than the pool's
+            result = vmaCreateImage(m_allocator, &imageInfo, &allocInfo, &outImage, &outAllocation, nullptr);
+        }
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create {} image ({}x{}): VkResult = {}", MemoryCategoryToString(category),
+                         imageInfo.extent.width, imageInfo.extent.height, static_cast<int>(result));
+            outImage = VK_NULL_HANDLE;
+            outAllocation = VK_NULL_HANDLE;
+            return false;
+        }
+
+        m_images[outAllocation] = category;
+        return true;
+    }
+
+    void VulkanMemoryManager::DestroyImage(VkImage image, VmaAllocation allocation) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_images.erase(allocation);
+        vmaDestroyImage(m_allocator, image, allocation);
+    }
+
+    bool VulkanMemoryManager::AllocateMemory(MemoryCategory category, const VkMemoryRequirements& requirements,
+                                             const VmaAllocationCreateInfo& allocInfo, VmaAllocation& outAllocation) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Skip the category pool when it lacks required properties (e.g. lazily allocated memory)
+        const size_t index = static_cast<size_t>(category);
+        VmaAllocationCreateInfo poolAllocInfo = allocInfo;
+        if (poolAllocInfo.pool == VK_NULL_HANDLE &&
+            (m_poolMemoryFlags[index] & allocInfo.requiredFlags) == allocInfo.requiredFlags) {
+            poolAllocInfo.pool = m_pools[index];
+        }
+
+        VkResult result = vmaAllocateMemory(m_allocator, &requirements, &poolAllocInfo, &outAllocation, nullptr);
+        if (result != VK_SUCCESS && poolAllocInfo.pool != allocInfo.pool) {
+            // The pool's memory type may not be in the requirements' memoryTypeBits
+            result = vmaAllocateMemory(m_allocator, &requirements, &allocInfo, &outAllocation, nullptr);
+        }
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to allocate {} memory ({} bytes): VkResult = {}", MemoryCategoryToString(category),
+                         requirements.size, static_cast<int>(result));
+            outAllocation = VK_NULL_HANDLE;
+            return false;
+        }
+
+        m_images[outAllocation] = category;
+        return true;
+    }
+
+    void VulkanMemoryManager::FreeMemory(VmaAllocation allocation) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_images.erase(allocation);
+        vmaFreeMemory(m_allocator, allocation);
+    }
+
+    uint32_t VulkanMemoryManager::AddEvictionCallback(EvictionCallback callback) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const uint32_t id = m_nextCallbackId++;
+        m_evictionCallbacks.emplace_back(id, std::move(callback));
+        return id;
+    }
+
+    void VulkanMemoryManager::RemoveEvictionCallback(uint32_t id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::erase_if(m_evictionCallbacks, [id](const auto& entry) { return entry.first == id; });
+    }
+
+    bool VulkanMemoryManager::RequestDefragmentation(MemoryCategory category) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return StartDefragmentation(category);
+    }
+
+    void VulkanMemoryManager::BeginFrame(VkCommandBuffer cmd, uint64_t recordingFrame, uint64_t completedFrame) {
+        MovedBuffers moved;
+        std::vector<EvictionCallback> callbacks;
+        VkDeviceSize evictionRequest = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_allocator == VK_NULL_HANDLE) {
+                return;
+            }
+
+            // Lets VMA refresh its budget cache once per frame
+            vmaSetCurrentFrameIndex(m_allocator, static_cast<uint32_t>(recordingFrame));
+
+            evictionRequest = ComputeEvictionRequest();
+            if (evictionRequest > 0) {
+                m_evictionRequests++;
+                for (const auto& entry : m_evictionCallbacks) {
+                    callbacks.push_back(entry.second);
+                }
+            }
+
+            CheckFragmentation(recordingFrame);
+            StepDefragmentation(cmd, recordingFrame, completedFrame, moved);
+        }
+
+        // Callbacks run unlocked so they can destroy resources through this manager
+        for (auto& [callback, buffer] : moved) {
+            callback(buffer);
+        }
+
+        VkDeviceSize released = 0;
+        for (auto& callback : callbacks) {
+            if (released >= evictionRequest) {
+                break;
+            }
+            released += callback(evictionRequest - released);
+        }
+        if (evictionRequest > 0) {
+            SA_LOG_DEBUG("Memory budget pressure: requested {} KiB, eviction released {} KiB",
+                         evictionRequest / 1024, released / 1024);
+        }
+    }
+
+    MemoryStats VulkanMemoryManager::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        MemoryStats stats;
+        if (m_allocator == VK_NULL_HANDLE) {
+            return stats;
+        }
+
+        for (size_t i = 0; i < m_pools.size(); i++) {
+            if (m_pools[i] == VK_NULL_HANDLE) {
+                continue;
+            }
+            VmaDetailedStatistics poolStats{};
+            vmaCalculatePoolStatistics(m_allocator, m_pools[i], &poolStats);
+            stats.allocationBytes[i] = poolStats.statistics.allocationBytes;
+            stats.blockBytes[i] = poolStats.statistics.blockBytes;
+            stats.allocationCount[i] = poolStats.statistics.allocationCount;
+        }
+
+        VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+        vmaGetHeapBudgets(m_allocator, budgets);
+        stats.heaps.resize(m_heapCount);
+        for (uint32_t i = 0; i < m_heapCount; i++) {
+            stats.heaps[i].usage = budgets[i].usage;
+            stats.heaps[i].budget = budgets[i].budget;
+            stats.heaps[i].deviceLocal = (m_deviceLocalHeapMask & (1u << i)) != 0;
+        }
+
+        stats.evictionRequests = m_evictionRequests;
+        stats.defragBytesMoved = m_defragBytesMoved;
+        stats.defragAllocationsMoved = m_defragAllocationsMoved;
+        stats.defragActive = m_defragContext != VK_NULL_HANDLE;
+        return stats;
+    }
+
+    bool VulkanMemoryManager::CreatePools() {
+        for (size_t i = 0; i < m_pools.size(); i++) {
+            const auto category = static_cast<MemoryCategory>(i);
+
+            // Representative resources pick each pool's memory type
+            VmaAllocationCreateInfo allocInfo{};
+            allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+            uint32_t memoryTypeIndex = UINT32_MAX;
+            VkResult result = VK_SUCCESS;
+            if (category == MemoryCategory::RenderTarget || category == MemoryCategory::Texture) {
+                VkImageCreateInfo imageInfo{};
+                imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+                imageInfo.imageType = VK_IMAGE_TYPE_2D;
+                imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+                imageInfo.extent = { 1024, 1024, 1 };
+                imageInfo.mipLevels = 1;
+                imageInfo.arrayLayers = 1;
+                imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+                imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+                imageInfo.usage = category == MemoryCategory::RenderTarget
+                    ? VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+                    : VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+                imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                result = vmaFindMemoryTypeIndexForImageInfo(m_allocator, &imageInfo, &allocInfo, &memoryTypeIndex);
+            } else {
+                VkBufferCreateInfo bufferInfo{};
+                bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                bufferInfo.size = 65536;
+                bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+                if (category == MemoryCategory::Geometry) {
+                    bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                                       VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                       VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+                } else {
+                    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+                    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+                    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+                }
+                result = vmaFindMemoryTypeIndexForBufferInfo(m_allocator, &bufferInfo, &allocInfo, &memoryTypeIndex);
+            }
+
+            if (result != VK_SUCCESS) {
+                SA_LOG_WARN("No memory type for the {} pool; using default pools", MemoryCategoryToString(category));
+                continue;
+            }
+
+            VmaPoolCreateInfo poolInfo{};
+            poolInfo.memoryTypeIndex = memoryTypeIndex;
+            result = vmaCreatePool(m_allocator, &poolInfo, &m_pools[i]);
+            if (result != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to create the {} pool: VkResult = {}", MemoryCategoryToString(category),
+                             static_cast<int>(result));
+                return false;
+            }
+            vmaSetPoolName(m_allocator, m_pools[i], MemoryCategoryToString(category));
+            vmaGetMemoryTypeProperties(m_allocator, memoryTypeIndex, &m_poolMemoryFlags[i]);
+        }
+        return true;
+    }
+
+    VkDeviceSize VulkanMemoryManager::ComputeEvictionRequest() const {
+        VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+        vmaGetHeapBudgets(m_allocator, budgets);
+
+        // Only device-local heaps are worth evicting for; system memory pages out gracefully
+        VkDeviceSize request = 0;
+        for (uint32_t i = 0; i < m_heapCount; i++) {
+            if (!(m_deviceLocalHeapMask & (1u << i)) || budgets[i].budget == 0) {
+                continue;
+            }
+            const double budget = static_cast<double>(budgets[i].budget);
+            const double usage = static_cast<double>(budgets[i].usage);
+            if (usage > budget * m_settings.evictionThreshold) {
+                request = std::max(request, static_cast<VkDeviceSize>(usage - budget * m_settings.evictionTarget));
+            }
+        }
+        return request;
+    }
+
+    void VulkanMemoryManager::CheckFragmentation(uint64_t recordingFrame) {
+        if (m_settings.autoDefragFragmentation <= 0.0f || m_defragContext != VK_NULL_HANDLE ||
+            recordingFrame < m_lastFragmentationCheck + m_settings.autoDefragIntervalFrames) {
+            return;
+        }
+        m_lastFragmentationCheck = recordingFrame;
+
+        VmaPool pool = m_pools[static_cast<size_t>(MemoryCategory::Geometry)];
+        if (pool == VK_NULL_HANDLE) {
+            return;
+        }
+
+        VmaDetailedStatistics poolStats{};
+        vmaCalculatePoolStatistics(m_allocator, pool, &poolStats);
+        const VmaStatistics& s = poolStats.statistics;
+
+        // A single block cannot be compacted into fewer blocks; nothing to gain
+        const VkDeviceSize freeBytes = s.blockBytes - s.allocationBytes;
+        if (s.blockCount > 1 && freeBytes > s.blockBytes * m_settings.autoDefragFragmentation) {
+            SA_LOG_INFO("Geometry pool fragmented ({} KiB free of {} KiB); starting defragmentation",
+                        freeBytes / 1024, s.blockBytes / 1024);
+            StartDefragmentation(MemoryCategory::Geometry);
+        }
+    }
+
+    bool VulkanMemoryManager::StartDefragmentation(MemoryCategory category) {
+        if (m_defragContext != VK_NULL_HANDLE || category != MemoryCategory::Geometry) {
+            return false;
+        }
+
+        VmaPool pool = m_pools[static_cast<size_t>(category)];
+        if (pool == VK_NULL_HANDLE) {
+            return false;
+        }
+
+        VmaDefragmentationInfo defragInfo{};
+        defragInfo.flags = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+        defragInfo.pool = pool;
+        defragInfo.maxBytesPerPass = m_settings.defragBytesPerFrame;
+        defragInfo.maxAllocationsPerPass = m_settings.defragMovesPerFrame;
+
+        VkResult result = vmaBeginDefragmentation(m_allocator, &defragInfo, &m_defragContext);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to begin defragmentation: VkResult = {}", static_cast<int>(result));
+            m_defragContext = VK_NULL_HANDLE;
+            return false;
+        }
+        m_defragCategory = category;
+        return true;
+    }
+
+    void VulkanMemoryManager::StepDefragmentation(VkCommandBuffer cmd, uint64_t recordingFrame,
+                                                  uint64_t completedFrame, MovedBuffers& outMoved) {
+        if (m_defragContext == VK_NULL_HANDLE) {
+            return;
+        }
+
+        // A pass ends once the frame carrying its copies (and every frame that could still
+        // read the old buffers) has finished on the GPU
+        if (m_passActive) {
+            if (completedFrame < m_passFrame) {
+                return;
+            }
+            EndPass();
+            if (m_defragContext == VK_NULL_HANDLE) {
+                return;
+            }
+        }
+
+        BeginPass(cmd, recordingFrame, outMoved);
+    }
+
+    void VulkanMemoryManager::BeginPass(VkCommandBuffer cmd, uint64_t recordingFrame, MovedBuffers& outMoved) {
+        VkResult result = vmaBeginDefragmentationPass(m_allocator, m_defragContext, &m_passInfo);
+        if (result == VK_SUCCESS) {
+            FinishDefragmentation();
+            return;
+        }
+        if (result != VK_INCOMPLETE) {
+            SA_LOG_ERROR("Defragmentation pass failed: VkResult = {}", static_cast<int>(result));
+            FinishDefragmentation();
+            return;
+        }
+
+        // Copies run at the start of the frame, after all earlier work on this queue
+        VkMemoryBarrier before{};
+        before.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        before.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+        before.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                             1, &before, 0, nullptr, 0, nullptr);
+
+        for (uint32_t i = 0; i < m_passInfo.moveCount; i++) {
+            VmaDefragmentationMove& move = m_passInfo.pMoves[i];
+
+            // Only buffers whose owner can follow a handle change are moved
+            auto it = m_buffers.find(move.srcAllocation);
+            if (it == m_buffers.end() || !it->second.onMoved) {
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+            BufferRecord& record = it->second;
+
+            VkBuffer newBuffer = VK_NULL_HANDLE;
+            if (vkCreateBuffer(m_device, &record.createInfo, nullptr, &newBuffer) != VK_SUCCESS) {
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+            if (vmaBindBufferMemory(m_allocator, move.dstTmpAllocation, newBuffer) != VK_SUCCESS) {
+                vkDestroyBuffer(m_device, newBuffer, nullptr);
+                move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+                continue;
+            }
+
+            VkBufferCopy region{};
+            region.size = record.createInfo.size;
+            vkCmdCopyBuffer(cmd, record.buffer, newBuffer, 1, &region);
+
+            m_pendingMoves.push_back({ move.srcAllocation, record.buffer });
+            record.buffer = newBuffer;
+            outMoved.emplace_back(record.onMoved, newBuffer);
+        }
+
+        VkMemoryBarrier after{};
+        after.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        after.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        after.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+                             1, &after, 0, nullptr, 0, nullptr);
+
+        m_passActive = true;
+        m_passFrame = recordingFrame;
+    }
+
+    void VulkanMemoryManager::EndPass() {
+        for (const PendingMove& move : m_pendingMoves) {
+            vkDestroyBuffer(m_device, move.oldBuffer, nullptr);
+        }
+        m_defragAllocationsMoved += static_cast<uint32_t>(m_pendingMoves.size());
+        m_pendingMoves.clear();
+
+        VkResult result = vmaEndDefragmentationPass(m_allocator, m_defragContext, &m_passInfo);
+        m_passActive = false;
+        m_passInfo = {};
+
+        for (VmaAllocation allocation : m_freeAfterPass) {
+            FreeBuffer(allocation);
+        }
+        m_freeAfterPass.clear();
+
+        if (result != VK_INCOMPLETE) {
+            FinishDefragmentation();
+        }
+    }
+
+    void VulkanMemoryManager::FinishDefragmentation() {
+        VmaDefragmentationStats defragStats{};
+        vmaEndDefragmentation(m_allocator, m_defragContext, &defragStats);
+        m_defragContext = VK_NULL_HANDLE;
+        m_defragBytesMoved += defragStats.bytesMoved;
+
+        SA_LOG_INFO("Defragmentation of {} finished: {} KiB moved, {} KiB released",
+                    MemoryCategoryToString(m_defragCategory), defragStats.bytesMoved / 1024,
+                    defragStats.bytesFreed / 1024);
+    }
+
+    void VulkanMemoryManager::FreeBuffer(VmaAllocation allocation) {
+        auto it = m_buffers.find(allocation);
+        if (it == m_buffers.end()) {
+            return;
+        }
+        vmaDestroyBuffer(m_allocator, it->second.buffer, allocation);
+        m_buffers.erase(it);
+    }
+
+} // namespace StellarAlia::Function::Graphics
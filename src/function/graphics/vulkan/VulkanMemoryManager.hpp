@@ -0,0 +1,295 @@
+#pragma once
+
+/**
+ * @file VulkanMemoryManager.hpp
+ * @brief Categorized VMA pools, heap budget tracking and incremental defragmentation
+ *
+ * Every long-lived GPU resource belongs to a MemoryCategory backed by its own VMA pool,
+ * so usage can be reported per category and fragmentation stays contained. Heap usage is
+ * compared against the VK_EXT_memory_budget budget every frame; when it gets close,
+ * registered eviction callbacks are asked to release memory.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace StellarAlia::Function::Graphics {
+
+    /**
+     * @brief Resource categories with dedicated VMA pools
+     */
+    enum class MemoryCategory : uint32_t {
+        RenderTarget = 0,  // Attachments and storage images written by the GPU
+        Geometry,          // Vertex, index and storage buffers
+        Texture,           // Sampled images
+        Staging,           // Host-visible upload/readback buffers
+        Count
+    };
+
+    /**
+     * @brief Get a printable category name
+     * @param category Memory category
+     * @return Static string
+     */
+    const char* MemoryCategoryToString(MemoryCategory category);
+
+    /**
+     * @brief Called when a buffer was moved by defragmentation
+     * The old handle stays valid for frames already submitted; the new one must be used
+     * by every command recorded from now on.
+     */
+    using BufferMovedCallback = std::function<void(VkBuffer newBuffer)>;
+
+    /**
+     * @brief Asked to free device memory when a heap approaches its budget
+     * @param bytesRequested Bytes the manager would like released
+     * @return Bytes actually scheduled for release
+     */
+    using EvictionCallback = std::function<VkDeviceSize(VkDeviceSize bytesRequested)>;
+
+    /**
+     * @brief Per-heap usage against the driver-reported budget
+     */
+    struct HeapBudget {
+        VkDeviceSize usage = 0;   // Bytes used by this process (all allocations, not just ours)
+        VkDeviceSize budget = 0;  // Bytes the process may use before the OS starts paging
+        bool deviceLocal = false;
+    };
+
+    /**
+     * @brief Memory statistics snapshot
+     */
+    struct MemoryStats {
+        std::array<VkDeviceSize, static_cast<size_t>(MemoryCategory::Count)> allocationBytes{};
+        std::array<VkDeviceSize, static_cast<size_t>(MemoryCategory::Count)> blockBytes{};
+        std::array<uint32_t, static_cast<size_t>(MemoryCategory::Count)> allocationCount{};
+        std::vector<HeapBudget> heaps;
+        uint64_t evictionRequests = 0;
+        uint64_t defragBytesMoved = 0;
+        uint32_t defragAllocationsMoved = 0;
+        bool defragActive = false;
+    };
+
+    /**
+     * @brief Memory manager tuning
+     */
+    struct MemoryManagerCreateInfo {
+        VkDevice device = VK_NULL_HANDLE;
+        VmaAllocator allocator = VK_NULL_HANDLE;
+        bool budgetExtension = false;                     // VK_EXT_memory_budget enabled on the device
+        float evictionThreshold = 0.9f;                   // Fraction of budget that triggers eviction
+        float evictionTarget = 0.8f;                      // Fraction of budget eviction aims for
+        VkDeviceSize defragBytesPerFrame = 8ull * 1024 * 1024;
+        uint32_t defragMovesPerFrame = 64;
+        float autoDefragFragmentation = 0.25f;            // Free-in-block ratio that starts a defrag; 0 = manual
+        uint32_t autoDefragIntervalFrames = 600;          // Frames between fragmentation checks
+    };
+
+    /**
+     * @brief VMA pool, budget and defragmentation manager
+     *
+     * Thread-safe. BeginFrame must be called by the owning context with the primary
+     * command buffer of the frame being recorded; defragmentation copies are recorded
+     * there, ahead of any rendering work.
+     */
+    class VulkanMemoryManager {
+    public:
+        VulkanMemoryManager() = default;
+        ~VulkanMemoryManager();
+
+        VulkanMemoryManager(const VulkanMemoryManager&) = delete;
+        VulkanMemoryManager& operator=(const VulkanMemoryManager&) = delete;
+
+        /**
+         * @brief Create the category pools
+         * @param createInfo Creation parameters
+         * @return True on success
+         */
+        bool Initialize(const MemoryManagerCreateInfo& createInfo);
+
+        /**
+         * @brief Destroy the pools (every allocation must have been freed)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Create a buffer in a category pool
+         * @param category Memory category
+         * @param bufferInfo Buffer description
+         * @param allocInfo Allocation flags and usage (the pool is filled in)
+         * @param outBuffer Receives the buffer
+         * @param outAllocation Receives the allocation
+         * @param onMoved Makes the buffer movable by defragmentation; empty = pinned
+         * @return True on success
+         */
+        bool CreateBuffer(MemoryCategory category, const VkBufferCreateInfo& bufferInfo,
+                          const VmaAllocationCreateInfo& allocInfo, VkBuffer& outBuffer,
+                          VmaAllocation& outAllocation, BufferMovedCallback onMoved = {});
+
+        /**
+         * @brief Destroy a buffer created by CreateBuffer
+         * The GPU must no longer use it (see VulkanGraphicsContext::DeferDestruction).
+         * @param buffer Current buffer handle
+         * @param allocation Allocation
+         */
+        void DestroyBuffer(VkBuffer buffer, VmaAllocation allocation);
+
+        /**
+         * @brief Create an image in a category pool
+         * Images are never moved by defragmentation.
+         * @param category Memory category
+         * @param imageInfo Image description
+         * @param allocInfo Allocation flags and usage (the pool is filled in)
+         * @param outImage Receives the image
+         * @param outAllocation Receives the allocation
+         * @return True on success
+         */
+        bool CreateImage(MemoryCategory category, const VkImageCreateInfo& imageInfo,
+                         const VmaAllocationCreateInfo& allocInfo, VkImage& outImage, VmaAllocation& outAllocation);
+
+        /**
+         * @brief Destroy an image created by CreateImage
+         * @param image Image
+         * @param allocation Allocation
+         */
+        void DestroyImage(VkImage image, VmaAllocation allocation);
+
+        /**
+         * @brief Allocate unbound memory in a category pool
+         * Used to alias several resources in one allocation; bind them with
+         * vmaBindImageMemory / vmaBindBufferMemory.
+         * @param category Memory category
+         * @param requirements Combined requirements of every resource placed in the memory
+         * @param allocInfo Allocation flags and usage (the pool is filled in)
+         * @param outAllocation Receives the allocation
+         * @return True on success
+         */
+        bool AllocateMemory(MemoryCategory category, const VkMemoryRequirements& requirements,
+                            const VmaAllocationCreateInfo& allocInfo, VmaAllocation& outAllocation);
+
+        /**
+         * @brief Free memory from AllocateMemory (resources bound to it must be destroyed)
+         * @param allocation Allocation
+         */
+        void FreeMemory(VmaAllocation allocation);
+
+        /**
+         * @brief Register an eviction callback
+         * @param callback Called with the number of bytes to release
+         * @return Id for RemoveEvictionCallback
+         */
+        uint32_t AddEvictionCallback(EvictionCallback callback);
+
+        /**
+         * @brief Unregister an eviction callback
+         * @param id Id returned by AddEvictionCallback
+         */
+        void RemoveEvictionCallback(uint32_t id);
+
+        /**
+         * @brief Start incremental defragmentation of a buffer category
+         * Only Geometry is supported: images are never moved, and moving staging memory
+         * would invalidate persistent mappings.
+         * @param category Memory category
+         * @return True if started (false if already running or the category is unsupported)
+         */
+        bool RequestDefragmentation(MemoryCategory category);
+
+        /**
+         * @brief Per-frame hook: budget check, eviction and one defragmentation step
+         * @param cmd Primary command buffer of the frame being recorded
+         * @param recordingFrame Frame number this command buffer will be submitted as
+         * @param completedFrame Newest frame known to have finished on the GPU
+         */
+        void BeginFrame(VkCommandBuffer cmd, uint64_t recordingFrame, uint64_t completedFrame);
+
+        /**
+         * @brief Get memory statistics (computes pool statistics; not free)
+         * @return Snapshot
+         */
+        MemoryStats GetStats() const;
+
+        /**
+         * @brief Get the VMA pool backing a category
+         * @param category Memory category
+         * @return Pool, or VK_NULL_HANDLE if it could not be created
+         */
+        VmaPool GetPool(MemoryCategory category) const { return m_pools[static_cast<size_t>(category)]; }
+
+        /**
+         * @brief Get the underlying allocator
+         * @return VMA allocator
+         */
+        VmaAllocator GetAllocator() const { return m_allocator; }
+
+    private:
+        struct BufferRecord {
+            MemoryCategory category = MemoryCategory::Geometry;
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkBufferCreateInfo createInfo = {};
+            BufferMovedCallback onMoved;
+        };
+
+        // Buffer bound to the source allocation of a move; destroyed when the pass ends
+        struct PendingMove {
+            VmaAllocation allocation = VK_NULL_HANDLE;
+            VkBuffer oldBuffer = VK_NULL_HANDLE;
+        };
+
+        VkDevice m_device = VK_NULL_HANDLE;
+        VmaAllocator m_allocator = VK_NULL_HANDLE;
+        MemoryManagerCreateInfo m_settings;
+        uint32_t m_heapCount = 0;
+        uint32_t m_deviceLocalHeapMask = 0;
+
+        std::array<VmaPool, static_cast<size_t>(MemoryCategory::Count)> m_pools{};
+        std::array<VkMemoryPropertyFlags, static_cast<size_t>(MemoryCategory::Count)> m_poolMemoryFlags{};
+        std::unordered_map<VmaAllocation, BufferRecord> m_buffers;
+        std::unordered_map<VmaAllocation, MemoryCategory> m_images;  // Includes raw aliasing memory
+
+        std::vector<std::pair<uint32_t, EvictionCallback>> m_evictionCallbacks;
+        uint32_t m_nextCallbackId = 1;
+        uint64_t m_evictionRequests = 0;
+
+        // Incremental defragmentation
+        VmaDefragmentationContext m_defragContext = VK_NULL_HANDLE;
+        MemoryCategory m_defragCategory = MemoryCategory::Geometry;
+        VmaDefragmentationPassMoveInfo m_passInfo = {};
+        bool m_passActive = false;
+        uint64_t m_passFrame = 0;  // Frame whose completion ends the pass
+        std::vector<PendingMove> m_pendingMoves;
+        std::vector<VmaAllocation> m_freeAfterPass;  // Destroyed by owners mid-pass
+        uint64_t m_defragBytesMoved = 0;
+        uint32_t m_defragAllocationsMoved = 0;
+        uint64_t m_lastFragmentationCheck = 0;
+
+        mutable std::mutex m_mutex;
+
+        using MovedBuffers = std::vector<std::pair<BufferMovedCallback, VkBuffer>>;
+
+        bool CreatePools();
+        VkDeviceSize ComputeEvictionRequest() const;
+        void CheckFragmentation(uint64_t recordingFrame);
+        bool StartDefragmentation(MemoryCategory category);
+        void StepDefragmentation(VkCommandBuffer cmd, uint64_t recordingFrame, uint64_t completedFrame,
+                                 MovedBuffers& outMoved);
+        void BeginPass(VkCommandBuffer cmd, uint64_t recordingFrame, MovedBuffers& outMoved);
+        void EndPass();
+        void FinishDefragmentation();
+        void FreeBuffer(VmaAllocation allocation);
+    };
+
+} // namespace StellarAlia::Function::Graphics
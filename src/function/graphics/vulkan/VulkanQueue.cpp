@@ -0,0 +1,210 @@
+#include "function/graphics/vulkan/VulkanQueue.hpp"
+#include "core/logs/Log.hpp"
+
+#include <vector>
+
+namespace StellarAlia::Function::Graphics {
+
+    const char* QueueTypeToString(QueueType type) {
+        switch (type) {
+            case QueueType::Graphics: return "graphics";
+            case QueueType::Compute:  return "compute";
+            case QueueType::Transfer: return "transfer";
+            case QueueType::Present:  return "present";
+            default:                  return "unknown";
+        }
+    }
+
+    VulkanQueue::~VulkanQueue() {
+        Shutdown();
+    }
+
+    bool VulkanQueue::Initialize(VkDevice device, uint32_t family, uint32_t index, bool useTimeline) {
+        vkGetDeviceQueue(device, family, index, &m_queue);
+        if (m_queue == VK_NULL_HANDLE) {
+            SA_LOG_ERROR("Failed to get device queue (family {}, index {})", family, index);
+            return false;
+        }
+
+        m_family = family;
+        m_index = index;
+
+        if (useTimeline && !m_timeline.Initialize(device)) {
+            return false;
+        }
+        return true;
+    }
+
+    void VulkanQueue::Shutdown() {
+        m_timeline.Shutdown();
+        m_queue = VK_NULL_HANDLE;
+        m_family = UINT32_MAX;
+        m_index = 0;
+    }
+
+    bool VulkanQueue::Submit(const QueueSubmitInfo& submitInfo, uint64_t* outTimelineValue) {
+        std::vector<VkSemaphore> waitSemaphores;
+        std::vector<uint64_t> waitValues;
+        std::vector<VkPipelineStageFlags> waitStages;
+        waitSemaphores.reserve(submitInfo.waits.size());
+        waitValues.reserve(submitInfo.waits.size());
+        waitStages.reserve(submitInfo.waits.size());
+        for (const QueueWait& wait : submitInfo.waits) {
+            waitSemaphores.push_back(wait.semaphore);
+            waitValues.push_back(wait.value);
+            waitStages.push_back(wait.stageMask);
+        }
+
+        std::vector<VkSemaphore> signalSemaphores;
+        std::vector<uint64_t> signalValues;
+        signalSemaphores.reserve(submitInfo.signals.size() + 1);
+        signalValues.reserve(submitInfo.signals.size() + 1);
+        for (const QueueSignal& signal : submitInfo.signals) {
+            signalSemaphores.push_back(signal.semaphore);
+            signalValues.push_back(signal.value);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        uint64_t timelineValue = 0;
+        const bool signalTimeline = submitInfo.signalTimeline && m_timeline.IsValid();
+        if (signalTimeline) {
+            timelineValue = m_timeline.AcquireNextValue();
+            signalSemaphores.push_back(m_timeline.GetHandle());
+            signalValues.push_back(timelineValue);
+        }
+
+        VkSubmitInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        info.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+        info.pWaitSemaphores = waitSemaphores.data();
+        info.pWaitDstStageMask = waitStages.data();
+        info.commandBufferCount = static_cast<uint32_t>(submitInfo.commandBuffers.size());
+        info.pCommandBuffers = submitInfo.commandBuffers.data();
+        info.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+        info.pSignalSemaphores = signalSemaphores.data();
+
+        // Values are ignored for binary semaphores, so one value per semaphore is always valid
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        if (m_timeline.IsValid()) {
+            timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size());
+            timelineInfo.pWaitSemaphoreValues = waitValues.data();
+            timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+            timelineInfo.pSignalSemaphoreValues = signalValues.data();
+            info.pNext = &timelineInfo;
+        }
+
+        VkResult result = vkQueueSubmit(m_queue, 1, &info, submitInfo.fence);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("vkQueueSubmit failed on family {}: VkResult = {}", m_family, static_cast<int>(result));
+            return false;
+        }
+
+        if (outTimelineValue) {
+            *outTimelineValue = timelineValue;
+        }
+        return true;
+    }
+
+    VkResult VulkanQueue::Present(const VkPresentInfoKHR& presentInfo) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return vkQueuePresentKHR(m_queue, &presentInfo);
+    }
+
+    void VulkanQueue::WaitIdle() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        vkQueueWaitIdle(m_queue);
+    }
+
+    void RecordBufferRelease(VkCommandBuffer cmd, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                             uint32_t srcFamily, uint32_t dstFamily,
+                             VkPipelineStageFlags srcStage, VkAccessFlags srcAccess) {
+        if (srcFamily == dstFamily) {
+            return;
+        }
+
+        VkBufferMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstAccessMask = 0;  // Ignored on release
+        barrier.srcQueueFamilyIndex = srcFamily;
+        barrier.dstQueueFamilyIndex = dstFamily;
+        barrier.buffer = buffer;
+        barrier.offset = offset;
+        barrier.size = size;
+
+        vkCmdPipelineBarrier(cmd, srcStage, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                             0, nullptr, 1, &barrier, 0, nullptr);
+    }
+
+    void RecordBufferAcquire(VkCommandBuffer cmd, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                             uint32_t srcFamily, uint32_t dstFamily,
+                             VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+        if (srcFamily == dstFamily) {
+            return;
+        }
+
+        VkBufferMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;  // Ignored on acquire
+        barrier.dstAccessMask = dstAccess;
+        barrier.srcQueueFamilyIndex = srcFamily;
+        barrier.dstQueueFamilyIndex = dstFamily;
+        barrier.buffer = buffer;
+        barrier.offset = offset;
+        barrier.size = size;
+
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStage, 0,
+                             0, nullptr, 1, &barrier, 0, nullptr);
+    }
+
+    void RecordImageRelease(VkCommandBuffer cmd, VkImage image, const VkImageSubresourceRange& range,
+                            VkImageLayout oldLayout, VkImageLayout newLayout,
+                            uint32_t srcFamily, uint32_t dstFamily,
+                            VkPipelineStageFlags srcStage, VkAccessFlags srcAccess) {
+        // With a shared family the acquire side performs the layout transition alone
+        if (srcFamily == dstFamily) {
+            return;
+        }
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstAccessMask = 0;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = srcFamily;
+        barrier.dstQueueFamilyIndex = dstFamily;
+        barrier.image = image;
+        barrier.subresourceRange = range;
+
+        vkCmdPipelineBarrier(cmd, srcStage, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                             0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    void RecordImageAcquire(VkCommandBuffer cmd, VkImage image, const VkImageSubresourceRange& range,
+                            VkImageLayout oldLayout, VkImageLayout newLayout,
+                            uint32_t srcFamily, uint32_t dstFamily,
+                            VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+        const bool sameFamily = srcFamily == dstFamily;
+        if (sameFamily && oldLayout == newLayout) {
+            return;
+        }
+
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = dstAccess;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = sameFamily ? VK_QUEUE_FAMILY_IGNORED : srcFamily;
+        barrier.dstQueueFamilyIndex = sameFamily ? VK_QUEUE_FAMILY_IGNORED : dstFamily;
+        barrier.image = image;
+        barrier.subresourceRange = range;
+
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStage, 0,
+                             0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+} // namespace StellarAlia::Function::Graphics
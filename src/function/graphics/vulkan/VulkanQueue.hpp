@@ -0,0 +1,221 @@
+#pragma once
+
+/**
+ * @file VulkanQueue.hpp
+ * @brief Device queue wrapper with per-queue timeline and submission lock
+ *
+ * The context creates one VulkanQueue per distinct VkQueue. When a device has no
+ * dedicated compute or transfer family, those queue types alias an existing queue
+ * object, so callers can always submit to QueueType::Compute/Transfer and share
+ * that queue's lock and timeline transparently.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include "function/graphics/vulkan/VulkanTimeline.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <span>
+
+namespace StellarAlia::Function::Graphics {
+
+    /**
+     * @brief Logical queue roles
+     */
+    enum class QueueType : uint32_t {
+        Graphics = 0,
+        Compute,   // Async compute; aliases Graphics without a dedicated family
+        Transfer,  // DMA/copy; aliases Compute or Graphics without a dedicated family
+        Present,
+        Count
+    };
+
+    /**
+     * @brief Get a printable queue type name
+     * @param type Queue type
+     * @return Static string
+     */
+    const char* QueueTypeToString(QueueType type);
+
+    /**
+     * @brief Semaphore wait for a queue submission
+     */
+    struct QueueWait {
+        VkSemaphore semaphore = VK_NULL_HANDLE;
+        uint64_t value = 0;  // Ignored for binary semaphores
+        VkPipelineStageFlags stageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    };
+
+    /**
+     * @brief Extra semaphore signal for a queue submission
+     */
+    struct QueueSignal {
+        VkSemaphore semaphore = VK_NULL_HANDLE;
+        uint64_t value = 0;  // Ignored for binary semaphores
+    };
+
+    /**
+     * @brief Parameters of a single vkQueueSubmit batch
+     */
+    struct QueueSubmitInfo {
+        std::span<const VkCommandBuffer> commandBuffers;
+        std::span<const QueueWait> waits;
+        std::span<const QueueSignal> signals;
+        VkFence fence = VK_NULL_HANDLE;
+        bool signalTimeline = true;  // Also signal the queue's own timeline (when available)
+    };
+
+    /**
+     * @brief Thread-safe wrapper around a VkQueue
+     */
+    class VulkanQueue {
+    public:
+        VulkanQueue() = default;
+        ~VulkanQueue();
+
+        VulkanQueue(const VulkanQueue&) = delete;
+        VulkanQueue& operator=(const VulkanQueue&) = delete;
+
+        /**
+         * @brief Retrieve the queue and create its timeline
+         * @param device Logical device
+         * @param family Queue family index
+         * @param index Queue index within the family
+         * @param useTimeline Create a timeline semaphore for this queue
+         * @return True on success
+         */
+        bool Initialize(VkDevice device, uint32_t family, uint32_t index, bool useTimeline);
+
+        /**
+         * @brief Destroy the timeline (the queue must be idle)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Get the queue handle
+         * @return VkQueue
+         */
+        VkQueue GetHandle() const { return m_queue; }
+
+        /**
+         * @brief Get the queue family index
+         * @return Family index
+         */
+        uint32_t GetFamily() const { return m_family; }
+
+        /**
+         * @brief Get the queue index within its family
+         * @return Queue index
+         */
+        uint32_t GetIndex() const { return m_index; }
+
+        /**
+         * @brief Get the queue's timeline
+         * @return Timeline, or nullptr on the fence fallback path
+         */
+        VulkanTimeline* GetTimeline() { return m_timeline.IsValid() ? &m_timeline : nullptr; }
+
+        /**
+         * @brief Submit a batch under the queue lock
+         * Timeline values are allocated under the same lock, so they are signaled in
+         * submission order.
+         * @param submitInfo Batch description
+         * @param outTimelineValue Receives the timeline value this batch signals (0 if none)
+         * @return True if vkQueueSubmit succeeded
+         */
+        bool Submit(const QueueSubmitInfo& submitInfo, uint64_t* outTimelineValue = nullptr);
+
+        /**
+         * @brief Present under the queue lock
+         * @param presentInfo Present parameters
+         * @return vkQueuePresentKHR result
+         */
+        VkResult Present(const VkPresentInfoKHR& presentInfo);
+
+        /**
+         * @brief Block until the queue is idle
+         */
+        void WaitIdle();
+
+    private:
+        VkQueue m_queue = VK_NULL_HANDLE;
+        uint32_t m_family = UINT32_MAX;
+        uint32_t m_index = 0;
+        VulkanTimeline m_timeline;
+        std::mutex m_mutex;
+    };
+
+    /**
+     * @brief Record the release half of a buffer queue-family ownership transfer
+     * No-op when both families are equal.
+     * @param cmd Command buffer on the source queue
+     * @param buffer Buffer being transferred
+     * @param offset Byte offset of the range
+     * @param size Byte size of the range (VK_WHOLE_SIZE allowed)
+     * @param srcFamily Releasing queue family
+     * @param dstFamily Acquiring queue family
+     * @param srcStage Stages that last wrote the buffer on the source queue
+     * @param srcAccess Accesses that must be made available
+     */
+    void RecordBufferRelease(VkCommandBuffer cmd, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                             uint32_t srcFamily, uint32_t dstFamily,
+                             VkPipelineStageFlags srcStage, VkAccessFlags srcAccess);
+
+    /**
+     * @brief Record the acquire half of a buffer queue-family ownership transfer
+     * No-op when both families are equal (the semaphore wait already orders the work).
+     * @param cmd Command buffer on the destination queue
+     * @param buffer Buffer being transferred
+     * @param offset Byte offset of the range
+     * @param size Byte size of the range
+     * @param srcFamily Releasing queue family
+     * @param dstFamily Acquiring queue family
+     * @param dstStage Stages that will consume the buffer
+     * @param dstAccess Accesses that will consume the buffer
+     */
+    void RecordBufferAcquire(VkCommandBuffer cmd, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size,
+                             uint32_t srcFamily, uint32_t dstFamily,
+                             VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+    /**
+     * @brief Record the release half of an image queue-family ownership transfer
+     * Layouts must match the acquire call. Skipped when both families are equal.
+     * @param cmd Command buffer on the source queue
+     * @param image Image being transferred
+     * @param range Subresource range
+     * @param oldLayout Layout on the source queue
+     * @param newLayout Layout on the destination queue
+     * @param srcFamily Releasing queue family
+     * @param dstFamily Acquiring queue family
+     * @param srcStage Stages that last accessed the image
+     * @param srcAccess Accesses that must be made available
+     */
+    void RecordImageRelease(VkCommandBuffer cmd, VkImage image, const VkImageSubresourceRange& range,
+                            VkImageLayout oldLayout, VkImageLayout newLayout,
+                            uint32_t srcFamily, uint32_t dstFamily,
+                            VkPipelineStageFlags srcStage, VkAccessFlags srcAccess);
+
+    /**
+     * @brief Record the acquire half of an image queue-family ownership transfer
+     * When both families are equal this degrades to a plain layout transition.
+     * @param cmd Command buffer on the destination queue
+     * @param image Image being transferred
+     * @param range Subresource range
+     * @param oldLayout Layout on the source queue
+     * @param newLayout Layout on the destination queue
+     * @param srcFamily Releasing queue family
+     * @param dstFamily Acquiring queue family
+     * @param dstStage Stages that will consume the image
+     * @param dstAccess Accesses that will consume the image
+     */
+    void RecordImageAcquire(VkCommandBuffer cmd, VkImage image, const VkImageSubresourceRange& range,
+                            VkImageLayout oldLayout, VkImageLayout newLayout,
+                            uint32_t srcFamily, uint32_t dstFamily,
+                            VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,95 @@
+#include "function/graphics/vulkan/VulkanTimeline.hpp"
+#include "core/logs/Log.hpp"
+
+namespace StellarAlia::Function::Graphics {
+
+    VulkanTimeline::~VulkanTimeline() {
+        Shutdown();
+    }
+
+    bool VulkanTimeline::Initialize(VkDevice device, uint64_t initialValue) {
+        if (m_semaphore != VK_NULL_HANDLE) {
+            SA_LOG_WARN("VulkanTimeline already initialized");
+            return false;
+        }
+
+        VkSemaphoreTypeCreateInfo typeInfo{};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = initialValue;
+
+        VkSemaphoreCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        createInfo.pNext = &typeInfo;
+
+        VkResult result = vkCreateSemaphore(device, &createInfo, nullptr, &m_semaphore);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create timeline semaphore: VkResult = {}", static_cast<int>(result));
+            m_semaphore = VK_NULL_HANDLE;
+            return false;
+        }
+
+        m_device = device;
+        m_lastAllocatedValue.store(initialValue, std::memory_order_release);
+        m_completedValue.store(initialValue, std::memory_order_release);
+        return true;
+    }
+
+    void VulkanTimeline::Shutdown() {
+        if (m_semaphore != VK_NULL_HANDLE) {
+            vkDestroySemaphore(m_device, m_semaphore, nullptr);
+            m_semaphore = VK_NULL_HANDLE;
+        }
+        m_device = VK_NULL_HANDLE;
+    }
+
+    uint64_t VulkanTimeline::GetCompletedValue() {
+        if (m_semaphore == VK_NULL_HANDLE) {
+            return m_completedValue.load(std::memory_order_acquire);
+        }
+
+        uint64_t value = 0;
+        if (vkGetSemaphoreCounterValue(m_device, m_semaphore, &value) != VK_SUCCESS) {
+            return m_completedValue.load(std::memory_order_acquire);
+        }
+        UpdateCompleted(value);
+        return value;
+    }
+
+    bool VulkanTimeline::IsComplete(uint64_t value) {
+        if (value <= m_completedValue.load(std::memory_order_acquire)) {
+            return true;
+        }
+        return value <= GetCompletedValue();
+    }
+
+    bool VulkanTimeline::Wait(uint64_t value, uint64_t timeoutNs) {
+        if (IsComplete(value)) {
+            return true;
+        }
+
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &m_semaphore;
+        waitInfo.pValues = &value;
+
+        VkResult result = vkWaitSemaphores(m_device, &waitInfo, timeoutNs);
+        if (result == VK_SUCCESS) {
+            UpdateCompleted(value);
+            return true;
+        }
+        if (result != VK_TIMEOUT) {
+            SA_LOG_ERROR("vkWaitSemaphores failed: VkResult = {}", static_cast<int>(result));
+        }
+        return false;
+    }
+
+    void VulkanTimeline::UpdateCompleted(uint64_t value) {
+        uint64_t current = m_completedValue.load(std::memory_order_relaxed);
+        while (value > current &&
+               !m_completedValue.compare_exchange_weak(current, value, std::memory_order_acq_rel)) {
+        }
+    }
+
+} // namespace StellarAlia::Function::Graphics
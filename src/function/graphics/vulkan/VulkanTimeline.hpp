@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * @file VulkanTimeline.hpp
+ * @brief Timeline semaphore wrapper (Vulkan 1.2 / VK_KHR_timeline_semaphore)
+ *
+ * One timeline per queue: every tracked submission signals the next value, so any
+ * subsystem can ask whether the GPU has passed a given point without owning a fence.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace StellarAlia::Function::Graphics {
+
+    /**
+     * @brief Monotonic GPU progress counter backed by a timeline semaphore
+     *
+     * Value allocation and completion queries are lock-free and may be called from any
+     * thread; the submission that signals an allocated value must still be externally
+     * synchronized with the queue it is submitted to.
+     */
+    class VulkanTimeline {
+    public:
+        VulkanTimeline() = default;
+        ~VulkanTimeline();
+
+        VulkanTimeline(const VulkanTimeline&) = delete;
+        VulkanTimeline& operator=(const VulkanTimeline&) = delete;
+
+        /**
+         * @brief Create the timeline semaphore
+         * @param device Logical device with the timelineSemaphore feature enabled
+         * @param initialValue Starting counter value
+         * @return True if creation succeeded
+         */
+        bool Initialize(VkDevice device, uint64_t initialValue = 0);
+
+        /**
+         * @brief Destroy the semaphore (the GPU must no longer reference it)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the semaphore has been created
+         * @return True if valid
+         */
+        bool IsValid() const { return m_semaphore != VK_NULL_HANDLE; }
+
+        /**
+         * @brief Get the semaphore handle for submit/wait infos
+         * @return VkSemaphore of type VK_SEMAPHORE_TYPE_TIMELINE
+         */
+        VkSemaphore GetHandle() const { return m_semaphore; }
+
+        /**
+         * @brief Reserve the value the next submission will signal
+         * @return Strictly increasing value
+         */
+        uint64_t AcquireNextValue() { return m_lastAllocatedValue.fetch_add(1, std::memory_order_acq_rel) + 1; }
+
+        /**
+         * @brief Get the most recently reserved signal value
+         * @return Last value returned by AcquireNextValue (or the initial value)
+         */
+        uint64_t GetLastAllocatedValue() const { return m_lastAllocatedValue.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Query the value the GPU has reached
+         * @return Current counter value (also refreshes the cached value)
+         */
+        uint64_t GetCompletedValue();
+
+        /**
+         * @brief Check whether the GPU has passed a value
+         * Answers from the cached value when possible and only queries the driver otherwise.
+         * @param value Timeline value
+         * @return True if the counter is at or beyond the value
+         */
+        bool IsComplete(uint64_t value);
+
+        /**
+         * @brief Block until the counter reaches a value
+         * @param value Timeline value to wait for
+         * @param timeoutNs Timeout in nanoseconds
+         * @return True if the value was reached, false on timeout or error
+         */
+        bool Wait(uint64_t value, uint64_t timeoutNs = UINT64_MAX);
+
+    private:
+        VkDevice m_device = VK_NULL_HANDLE;
+        VkSemaphore m_semaphore = VK_NULL_HANDLE;
+        std::atomic<uint64_t> m_lastAllocatedValue{ 0 };
+        std::atomic<uint64_t> m_completedValue{ 0 };
+
+        void UpdateCompleted(uint64_t value);
+    };
+
+} // namespace StellarAlia::Function::Graphics
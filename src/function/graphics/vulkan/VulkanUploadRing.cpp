@@ -0,0 +1,524 @@
+#include "function/graphics/vulkan/VulkanUploadRing.hpp"
+#include "function/graphics/vulkan/VulkanMemoryManager.hpp"
+#include "function/graphics/vulkan/VulkanQueue.hpp"
+#include "core/logs/Log.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace StellarAlia::Function::Graphics {
+
+    namespace {
+        VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    VulkanUploadRing::~VulkanUploadRing() {
+        Shutdown();
+    }
+
+    bool VulkanUploadRing::Initialize(const UploadRingCreateInfo& createInfo) {
+        if (m_buffer != VK_NULL_HANDLE) {
+            SA_LOG_WARN("VulkanUploadRing already initialized");
+            return false;
+        }
+        if (createInfo.device == VK_NULL_HANDLE || createInfo.memoryManager == nullptr ||
+            createInfo.transferQueue == nullptr || createInfo.capacity == 0) {
+            SA_LOG_ERROR("Invalid upload ring create info");
+            return false;
+        }
+
+        m_device = createInfo.device;
+        m_memoryManager = createInfo.memoryManager;
+        m_queue = createInfo.transferQueue;
+        m_consumerFamily = createInfo.consumerFamily;
+        m_capacity = createInfo.capacity;
+        m_frameBudget = createInfo.frameBudget;
+        // 16 bytes covers every uncompressed texel size and BC block size for image copies
+        m_alignment = std::max<VkDeviceSize>(createInfo.copyAlignment, 16);
+
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = m_capacity;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo allocInfo{};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                          VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+        // Pinned (no move callback): defragmentation would invalidate the persistent mapping
+        if (!m_memoryManager->CreateBuffer(MemoryCategory::Staging, bufferInfo, allocInfo, m_buffer, m_allocation)) {
+            SA_LOG_ERROR("Failed to create upload ring buffer");
+            return false;
+        }
+        VmaAllocationInfo allocationInfo{};
+        vmaGetAllocationInfo(m_memoryManager->GetAllocator(), m_allocation, &allocationInfo);
+        m_mapped = static_cast<uint8_t*>(allocationInfo.pMappedData);
+
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = m_queue->GetFamily();
+        VkResult result = vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_commandPool);
+        if (result != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to create upload command pool: VkResult = {}", static_cast<int>(result));
+            Shutdown();
+            return false;
+        }
+
+        SA_LOG_INFO("Upload ring: {} MiB, budget {} MiB/frame, transfer family {}", m_capacity / (1024 * 1024),
+                    m_frameBudget / (1024 * 1024), m_queue->GetFamily());
+        return true;
+    }
+
+    void VulkanUploadRing::Shutdown() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_device == VK_NULL_HANDLE) {
+            return;
+        }
+
+        // Command buffers are freed with the pool; only fences need explicit cleanup
+        for (const Batch& batch : m_inFlight) {
+            if (batch.fence != VK_NULL_HANDLE) {
+                vkDestroyFence(m_device, batch.fence, nullptr);
+            }
+        }
+        for (VkFence fence : m_freeFences) {
+            vkDestroyFence(m_device, fence, nullptr);
+        }
+        m_inFlight.clear();
+        m_freeFences.clear();
+        m_freeCommandBuffers.clear();
+        m_readyAcquires.clear();
+        m_failedBatches.clear();
+        m_openBatch = {};
+        m_batchOpen = false;
+
+        if (m_commandPool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(m_device, m_commandPool, nullptr);
+            m_commandPool = VK_NULL_HANDLE;
+        }
+        if (m_buffer != VK_NULL_HANDLE) {
+            m_memoryManager->DestroyBuffer(m_buffer, m_allocation);
+            m_buffer = VK_NULL_HANDLE;
+            m_allocation = VK_NULL_HANDLE;
+        }
+
+        m_mapped = nullptr;
+        m_head = m_tail = 0;
+        m_device = VK_NULL_HANDLE;
+        m_memoryManager = nullptr;
+        m_queue = nullptr;
+    }
+
+    UploadTicket VulkanUploadRing::UploadBuffer(VkBuffer buffer, VkDeviceSize offset, const void* data,
+                                                VkDeviceSize size, VkPipelineStageFlags dstStage,
+                                                VkAccessFlags dstAccess) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        VkDeviceSize ringOffset = 0;
+        if (!m_buffer || size == 0 || !AdmitRequest(size) || !Allocate(size, ringOffset) || !OpenBatch()) {
+            return {};
+        }
+
+        std::memcpy(m_mapped + ringOffset, data, static_cast<size_t>(size));
+
+        VkBufferCopy region{};
+        region.srcOffset = ringOffset;
+        region.dstOffset = offset;
+        region.size = size;
+        vkCmdCopyBuffer(m_openBatch.commandBuffer, m_buffer, buffer, 1, &region);
+
+        PendingAcquire acquire;
+        acquire.buffer = buffer;
+        acquire.offset = offset;
+        acquire.size = size;
+        acquire.dstStage = dstStage;
+        acquire.dstAccess = dstAccess;
+        m_openBatch.acquires.push_back(acquire);
+
+        m_stats.bytesThisFrame += size;
+        m_stats.totalBytes += size;
+        m_copiesThisFrame++;
+        return UploadTicket{ m_openBatch.id };
+    }
+
+    UploadTicket VulkanUploadRing::UploadImage(VkImage image, const VkImageSubresourceLayers& subresource,
+                                               VkOffset3D offset, VkExtent3D extent, const void* data,
+                                               VkDeviceSize size, VkImageLayout finalLayout,
+                                               VkPipelineStageFlags dstStage, VkAccessFlags dstAccess) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        VkDeviceSize ringOffset = 0;
+        if (!m_buffer || size == 0 || !AdmitRequest(size) || !Allocate(size, ringOffset) || !OpenBatch()) {
+            return {};
+        }
+
+        std::memcpy(m_mapped + ringOffset, data, static_cast<size_t>(size));
+
+        VkImageSubresourceRange range{};
+        range.aspectMask = subresource.aspectMask;
+        range.baseMipLevel = subresource.mipLevel;
+        range.levelCount = 1;
+        range.baseArrayLayer = subresource.baseArrayLayer;
+        range.layerCount = subresource.layerCount;
+
+        // Contents are replaced, so the old layout can be discarded
+        VkImageMemoryBarrier toTransfer{};
+        toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.srcAccessMask = 0;
+        toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image = image;
+        toTransfer.subresourceRange = range;
+        vkCmdPipelineBarrier(m_openBatch.commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+        VkBufferImageCopy region{};
+        region.bufferOffset = ringOffset;
+        region.imageSubresource = subresource;
+        region.imageOffset = offset;
+        region.imageExtent = extent;
+        vkCmdCopyBufferToImage(m_openBatch.commandBuffer, m_buffer, image,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+        PendingAcquire acquire;
+        acquire.image = image;
+        acquire.range = range;
+        acquire.finalLayout = finalLayout;
+        acquire.dstStage = dstStage;
+        acquire.dstAccess = dstAccess;
+        m_openBatch.acquires.push_back(acquire);
+
+        m_stats.bytesThisFrame += size;
+        m_stats.totalBytes += size;
+        m_copiesThisFrame++;
+        return UploadTicket{ m_openBatch.id };
+    }
+
+    void VulkanUploadRing::Flush() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FlushLocked();
+    }
+
+    void VulkanUploadRing::BeginFrame(VkCommandBuffer consumerCmd) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_buffer) {
+            return;
+        }
+
+        CollectCompleted();
+
+        const uint32_t srcFamily = m_queue->GetFamily();
+        for (const PendingAcquire& acquire : m_readyAcquires) {
+            RecordAcquire(consumerCmd, acquire, srcFamily);
+        }
+        m_readyAcquires.clear();
+        m_residentBatch = m_completedBatch;
+
+        m_stats.bytesLastFrame = m_stats.bytesThisFrame;
+        m_stats.copiesLastFrame = m_copiesThisFrame;
+        m_stats.deferredLastFrame = m_deferredThisFrame;
+        m_stats.bytesThisFrame = 0;
+        m_copiesThisFrame = 0;
+        m_deferredThisFrame = 0;
+    }
+
+    bool VulkanUploadRing::IsComplete(UploadTicket ticket) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return ticket.IsValid() && ticket.batch <= m_residentBatch && !IsFailed(ticket.batch);
+    }
+
+    bool VulkanUploadRing::Wait(UploadTicket ticket, uint64_t timeoutNs) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!ticket.IsValid() || IsFailed(ticket.batch)) {
+            return false;
+        }
+        if (ticket.batch <= m_completedBatch) {
+            return true;
+        }
+
+        if (m_batchOpen && m_openBatch.id == ticket.batch) {
+            FlushLocked();
+        }
+
+        for (const Batch& batch : m_inFlight) {
+            if (batch.id == ticket.batch) {
+                if (!WaitForBatch(batch, timeoutNs)) {
+                    return false;
+                }
+                break;
+            }
+        }
+
+        CollectCompleted();
+        return ticket.batch <= m_completedBatch && !IsFailed(ticket.batch);
+    }
+
+    void VulkanUploadRing::SetFrameBudget(VkDeviceSize bytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_frameBudget = bytes;
+    }
+
+    VkDeviceSize VulkanUploadRing::GetRemainingFrameBudget() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_frameBudget == 0) {
+            return UINT64_MAX;
+        }
+        return m_stats.bytesThisFrame >= m_frameBudget ? 0 : m_frameBudget - m_stats.bytesThisFrame;
+    }
+
+    UploadStats VulkanUploadRing::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        UploadStats stats = m_stats;
+        stats.batchesInFlight = static_cast<uint32_t>(m_inFlight.size());
+        stats.ringUsed = m_head - m_tail;
+        return stats;
+    }
+
+    bool VulkanUploadRing::AdmitRequest(VkDeviceSize size) {
+        // The first request of a frame is always admitted so oversized assets still progress
+        if (m_frameBudget == 0 || m_stats.bytesThisFrame == 0 ||
+            m_stats.bytesThisFrame + size <= m_frameBudget) {
+            return true;
+        }
+        m_deferredThisFrame++;
+        return false;
+    }
+
+    bool VulkanUploadRing::Allocate(VkDeviceSize size, VkDeviceSize& outOffset) {
+        if (size > m_capacity) {
+            SA_LOG_ERROR("Upload of {} bytes exceeds the {} byte staging ring", size, m_capacity);
+            return false;
+        }
+
+        for (;;) {
+            const VkDeviceSize physical = m_head % m_capacity;
+            const VkDeviceSize aligned = AlignUp(physical, m_alignment);
+
+            // Allocations never straddle the end of the ring; wrap to offset 0 instead
+            uint64_t start = m_head + (aligned - physical);
+            if (aligned + size > m_capacity) {
+                start = m_head + (m_capacity - physical);
+            }
+
+            if (start + size - m_tail <= m_capacity) {
+                m_head = start + size;
+                outOffset = start % m_capacity;
+                return true;
+            }
+
+            // Ring full: submit pending copies and wait for the oldest batch to free space
+            FlushLocked();
+            if (m_inFlight.empty()) {
+                SA_LOG_ERROR("Upload ring exhausted with no batches in flight");
+                return false;
+            }
+            m_stats.ringStalls++;
+            if (!WaitForBatch(m_inFlight.front(), UINT64_MAX)) {
+                return false;
+            }
+            CollectCompleted();
+        }
+    }
+
+    bool VulkanUploadRing::OpenBatch() {
+        if (m_batchOpen) {
+            return true;
+        }
+
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        if (!m_freeCommandBuffers.empty()) {
+            cmd = m_freeCommandBuffers.back();
+            m_freeCommandBuffers.pop_back();
+        } else {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = m_commandPool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocInfo.commandBufferCount = 1;
+            if (vkAllocateCommandBuffers(m_device, &allocInfo, &cmd) != VK_SUCCESS) {
+                SA_LOG_ERROR("Failed to allocate upload command buffer");
+                return false;
+            }
+        }
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (vkBeginCommandBuffer(cmd, &beginInfo) != VK_SUCCESS) {
+            SA_LOG_ERROR("Failed to begin upload command buffer");
+            m_freeCommandBuffers.push_back(cmd);
+            return false;
+        }
+
+        m_openBatch = {};
+        m_openBatch.id = m_nextBatchId++;
+        m_openBatch.commandBuffer = cmd;
+        m_batchOpen = true;
+        return true;
+    }
+
+    void VulkanUploadRing::FlushLocked() {
+        if (!m_batchOpen) {
+            return;
+        }
+        m_batchOpen = false;
+
+        Batch batch = std::move(m_openBatch);
+        m_openBatch = {};
+
+        const uint32_t srcFamily = m_queue->GetFamily();
+        for (const PendingAcquire& acquire : batch.acquires) {
+            RecordRelease(batch.commandBuffer, acquire, srcFamily);
+        }
+        bool recorded = vkEndCommandBuffer(batch.commandBuffer) == VK_SUCCESS;
+        if (!recorded) {
+            SA_LOG_ERROR("Failed to end upload batch {}", batch.id);
+        }
+
+        const bool useTimeline = m_queue->GetTimeline() != nullptr;
+        if (recorded && !useTimeline) {
+            if (!m_freeFences.empty()) {
+                batch.fence = m_freeFences.back();
+                m_freeFences.pop_back();
+            } else {
+                VkFenceCreateInfo fenceInfo{};
+                fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+                if (vkCreateFence(m_device, &fenceInfo, nullptr, &batch.fence) != VK_SUCCESS) {
+                    SA_LOG_ERROR("Failed to create a fence for upload batch {}", batch.id);
+                    batch.fence = VK_NULL_HANDLE;
+                    recorded = false;
+                }
+            }
+        }
+
+        QueueSubmitInfo submitInfo;
+        submitInfo.commandBuffers = std::span<const VkCommandBuffer>(&batch.commandBuffer, 1);
+        submitInfo.fence = batch.fence;
+        batch.ringEnd = m_head;
+
+        if (recorded && !m_queue->Submit(submitInfo, &batch.timelineValue)) {
+            SA_LOG_ERROR("Failed to submit upload batch {}", batch.id);
+            recorded = false;
+        }
+        if (!recorded) {
+            // The copies never ran, so its tickets never complete. Its ring region can only be
+            // reclaimed once the earlier batches, which may still be reading theirs, retire
+            batch.failed = true;
+            batch.acquires.clear();
+            m_failedBatches.push_back(batch.id);
+        }
+
+        m_inFlight.push_back(std::move(batch));
+    }
+
+    void VulkanUploadRing::CollectCompleted() {
+        VulkanTimeline* timeline = m_queue->GetTimeline();
+
+        // Batches complete in submission order on a single queue
+        while (!m_inFlight.empty()) {
+            Batch& batch = m_inFlight.front();
+            const bool done = batch.failed || (timeline ? timeline->IsComplete(batch.timelineValue)
+                                                        : vkGetFenceStatus(m_device, batch.fence) == VK_SUCCESS);
+            if (!done) {
+                break;
+            }
+
+            m_tail = batch.ringEnd;
+            m_completedBatch = batch.id;
+            m_readyAcquires.insert(m_readyAcquires.end(), batch.acquires.begin(), batch.acquires.end());
+            RetireBatch(batch);
+            m_inFlight.pop_front();
+        }
+    }
+
+    bool VulkanUploadRing::WaitForBatch(const Batch& batch, uint64_t timeoutNs) {
+        if (batch.failed) {
+            return true;  // Nothing was submitted; CollectCompleted retires it once it is the oldest
+        }
+        if (VulkanTimeline* timeline = m_queue->GetTimeline()) {
+            return timeline->Wait(batch.timelineValue, timeoutNs);
+        }
+        return vkWaitForFences(m_device, 1, &batch.fence, VK_TRUE, timeoutNs) == VK_SUCCESS;
+    }
+
+    bool VulkanUploadRing::IsFailed(uint64_t batch) const {
+        return std::find(m_failedBatches.begin(), m_failedBatches.end(), batch) != m_failedBatches.end();
+    }
+
+    void VulkanUploadRing::RetireBatch(Batch& batch) {
+        vkResetCommandBuffer(batch.commandBuffer, 0);
+        m_freeCommandBuffers.push_back(batch.commandBuffer);
+        batch.commandBuffer = VK_NULL_HANDLE;
+
+        if (batch.fence != VK_NULL_HANDLE) {
+            vkResetFences(m_device, 1, &batch.fence);
+            m_freeFences.push_back(batch.fence);
+            batch.fence = VK_NULL_HANDLE;
+        }
+    }
+
+    void VulkanUploadRing::RecordRelease(VkCommandBuffer cmd, const PendingAcquire& acquire,
+                                         uint32_t srcFamily) const {
+        if (acquire.buffer != VK_NULL_HANDLE) {
+            RecordBufferRelease(cmd, acquire.buffer, acquire.offset, acquire.size, srcFamily, m_consumerFamily,
+                                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+        } else {
+            RecordImageRelease(cmd, acquire.image, acquire.range, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               acquire.finalLayout, srcFamily, m_consumerFamily,
+                               VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+        }
+    }
+
+    void VulkanUploadRing::RecordAcquire(VkCommandBuffer cmd, const PendingAcquire& acquire,
+                                         uint32_t srcFamily) const {
+        if (srcFamily != m_consumerFamily) {
+            if (acquire.buffer != VK_NULL_HANDLE) {
+                RecordBufferAcquire(cmd, acquire.buffer, acquire.offset, acquire.size, srcFamily, m_consumerFamily,
+                                    acquire.dstStage, acquire.dstAccess);
+            } else {
+                RecordImageAcquire(cmd, acquire.image, acquire.range, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                   acquire.finalLayout, srcFamily, m_consumerFamily,
+                                   acquire.dstStage, acquire.dstAccess);
+            }
+            return;
+        }
+
+        // Same family (possibly the same queue): a regular barrier against the copy
+        if (acquire.buffer != VK_NULL_HANDLE) {
+            VkBufferMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = acquire.dstAccess;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.buffer = acquire.buffer;
+            barrier.offset = acquire.offset;
+            barrier.size = acquire.size;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, acquire.dstStage, 0,
+                                 0, nullptr, 1, &barrier, 0, nullptr);
+        } else {
+            VkImageMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = acquire.dstAccess;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = acquire.finalLayout;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = acquire.image;
+            barrier.subresourceRange = acquire.range;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, acquire.dstStage, 0,
+                                 0, nullptr, 0, nullptr, 1, &barrier);
+        }
+    }
+
+} // namespace StellarAlia::Function::Graphics
@@ -0,0 +1,247 @@
+#pragma once
+
+/**
+ * @file VulkanUploadRing.hpp
+ * @brief Asynchronous staging uploads through a persistently mapped ring buffer
+ *
+ * Upload requests copy their data into a host-visible VMA ring and record the GPU copy
+ * into an open batch. Batches are submitted to the transfer queue (once per frame, or
+ * earlier when the ring fills) and tracked by the transfer timeline, or a fence on the
+ * fallback path. Callers receive a ticket instead of blocking on the queue.
+ */
+
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+
+#include <volk.h>
+
+#include <vma/vk_mem_alloc.h>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace StellarAlia::Function::Graphics {
+
+    class VulkanMemoryManager;
+    class VulkanQueue;
+
+    /**
+     * @brief Handle to a pending upload
+     */
+    struct UploadTicket {
+        uint64_t batch = 0;  // Batch id; 0 = rejected or failed request
+        bool IsValid() const { return batch != 0; }
+    };
+
+    /**
+     * @brief Upload bandwidth and ring usage statistics
+     */
+    struct UploadStats {
+        uint64_t bytesThisFrame = 0;
+        uint64_t bytesLastFrame = 0;
+        uint64_t totalBytes = 0;
+        uint32_t copiesLastFrame = 0;
+        uint32_t deferredLastFrame = 0;  // Requests rejected by the per-frame budget
+        uint32_t batchesInFlight = 0;
+        uint32_t ringStalls = 0;         // Times a full ring waited for the oldest batch
+        VkDeviceSize ringUsed = 0;       // Bytes still referenced by unfinished batches
+    };
+
+    /**
+     * @brief Upload ring creation parameters
+     */
+    struct UploadRingCreateInfo {
+        VkDevice device = VK_NULL_HANDLE;
+        VulkanMemoryManager* memoryManager = nullptr;  // Ring memory comes from the Staging pool
+        VulkanQueue* transferQueue = nullptr;
+        uint32_t consumerFamily = UINT32_MAX;         // Queue family that uses the uploaded data (graphics)
+        VkDeviceSize capacity = 64ull * 1024 * 1024;  // Ring size in bytes
+        VkDeviceSize frameBudget = 16ull * 1024 * 1024;  // Bytes accepted per frame; 0 = unlimited
+        VkDeviceSize copyAlignment = 16;              // optimalBufferCopyOffsetAlignment
+    };
+
+    /**
+     * @brief Staging ring with batched transfer-queue submission
+     *
+     * All methods are thread-safe. Uploaded data becomes usable by the consumer queue in
+     * the first frame whose BeginFrame observed the ticket as complete; that call also
+     * records the matching queue-family acquire barriers.
+     */
+    class VulkanUploadRing {
+    public:
+        VulkanUploadRing() = default;
+        ~VulkanUploadRing();
+
+        VulkanUploadRing(const VulkanUploadRing&) = delete;
+        VulkanUploadRing& operator=(const VulkanUploadRing&) = delete;
+
+        /**
+         * @brief Allocate the ring and command pool
+         * @param createInfo Creation parameters
+         * @return True on success
+         */
+        bool Initialize(const UploadRingCreateInfo& createInfo);
+
+        /**
+         * @brief Release all resources (the transfer queue must be idle)
+         */
+        void Shutdown();
+
+        /**
+         * @brief Check if the ring has been created
+         * @return True if valid
+         */
+        bool IsValid() const { return m_buffer != VK_NULL_HANDLE; }
+
+        /**
+         * @brief Upload bytes into a buffer region
+         * @param buffer Destination buffer (TRANSFER_DST usage)
+         * @param offset Destination offset
+         * @param data Source data, copied before the call returns
+         * @param size Byte count
+         * @param dstStage Stages that will read the buffer
+         * @param dstAccess Accesses that will read the buffer
+         * @return Ticket, invalid if the request was deferred by the frame budget or failed
+         */
+        UploadTicket UploadBuffer(VkBuffer buffer, VkDeviceSize offset, const void* data, VkDeviceSize size,
+                                  VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+        /**
+         * @brief Upload tightly packed texels into an image region
+         * Previous contents of the subresource are discarded.
+         * @param image Destination image (TRANSFER_DST usage)
+         * @param subresource Mip level and layers to write
+         * @param offset Texel offset
+         * @param extent Texel extent
+         * @param data Source texels, copied before the call returns
+         * @param size Byte count
+         * @param finalLayout Layout the consumer expects
+         * @param dstStage Stages that will read the image
+         * @param dstAccess Accesses that will read the image
+         * @return Ticket, invalid if the request was deferred by the frame budget or failed
+         */
+        UploadTicket UploadImage(VkImage image, const VkImageSubresourceLayers& subresource,
+                                 VkOffset3D offset, VkExtent3D extent, const void* data, VkDeviceSize size,
+                                 VkImageLayout finalLayout, VkPipelineStageFlags dstStage, VkAccessFlags dstAccess);
+
+        /**
+         * @brief Submit the open batch to the transfer queue
+         */
+        void Flush();
+
+        /**
+         * @brief Per-frame hook, called by the context at the start of each frame
+         * Retires finished batches, records their acquire barriers into the consumer
+         * command buffer and rolls the per-frame budget over.
+         * @param consumerCmd Command buffer recording on the consumer queue family
+         */
+        void BeginFrame(VkCommandBuffer consumerCmd);
+
+        /**
+         * @brief Check whether an upload is usable by the consumer queue
+         * @param ticket Ticket returned by an upload call
+         * @return True once the copy finished and its acquire barrier was recorded
+         */
+        bool IsComplete(UploadTicket ticket) const;
+
+        /**
+         * @brief Block until an upload's copy has finished on the GPU
+         * Flushes the open batch if needed. Waits on the batch only, never on the queue.
+         * @param ticket Ticket returned by an upload call
+         * @param timeoutNs Timeout in nanoseconds
+         * @return True if the copy finished
+         */
+        bool Wait(UploadTicket ticket, uint64_t timeoutNs = UINT64_MAX);
+
+        /**
+         * @brief Change the per-frame upload cap
+         * @param bytes Bytes accepted per frame; 0 = unlimited
+         */
+        void SetFrameBudget(VkDeviceSize bytes);
+
+        /**
+         * @brief Get the bytes still accepted this frame
+         * @return Remaining budget (UINT64_MAX when unlimited)
+         */
+        VkDeviceSize GetRemainingFrameBudget() const;
+
+        /**
+         * @brief Get upload statistics
+         * @return Snapshot of the counters
+         */
+        UploadStats GetStats() const;
+
+    private:
+        // Consumer-side barrier recorded once the copy is complete
+        struct PendingAcquire {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceSize offset = 0;
+            VkDeviceSize size = 0;
+            VkImage image = VK_NULL_HANDLE;
+            VkImageSubresourceRange range = {};
+            VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            VkPipelineStageFlags dstStage = 0;
+            VkAccessFlags dstAccess = 0;
+        };
+
+        struct Batch {
+            uint64_t id = 0;
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            VkFence fence = VK_NULL_HANDLE;  // Fallback path only
+            uint64_t timelineValue = 0;
+            uint64_t ringEnd = 0;            // Ring head when the batch was submitted
+            bool failed = false;             // Submit failed; retired in order without running
+            std::vector<PendingAcquire> acquires;
+        };
+
+        VkDevice m_device = VK_NULL_HANDLE;
+        VulkanMemoryManager* m_memoryManager = nullptr;
+        VulkanQueue* m_queue = nullptr;
+        uint32_t m_consumerFamily = UINT32_MAX;
+
+        // Ring storage; head and tail are monotonic byte offsets (physical = offset % capacity)
+        VkBuffer m_buffer = VK_NULL_HANDLE;
+        VmaAllocation m_allocation = VK_NULL_HANDLE;
+        uint8_t* m_mapped = nullptr;
+        VkDeviceSize m_capacity = 0;
+        VkDeviceSize m_alignment = 16;
+        uint64_t m_head = 0;
+        uint64_t m_tail = 0;
+
+        // Batches
+        VkCommandPool m_commandPool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> m_freeCommandBuffers;
+        std::vector<VkFence> m_freeFences;
+        Batch m_openBatch;
+        bool m_batchOpen = false;
+        std::deque<Batch> m_inFlight;
+        std::vector<PendingAcquire> m_readyAcquires;
+        uint64_t m_nextBatchId = 1;
+        uint64_t m_completedBatch = 0;  // Newest batch finished on the GPU
+        uint64_t m_residentBatch = 0;   // Newest batch whose acquires were recorded
+        std::vector<uint64_t> m_failedBatches;  // Batches whose tickets never complete
+
+        // Budget and statistics
+        VkDeviceSize m_frameBudget = 0;
+        uint32_t m_copiesThisFrame = 0;
+        uint32_t m_deferredThisFrame = 0;
+        UploadStats m_stats;
+
+        mutable std::mutex m_mutex;
+
+        bool AdmitRequest(VkDeviceSize size);
+        bool Allocate(VkDeviceSize size, VkDeviceSize& outOffset);
+        bool OpenBatch();
+        void FlushLocked();
+        void CollectCompleted();
+        bool WaitForBatch(const Batch& batch, uint64_t timeoutNs);
+        bool IsFailed(uint64_t batch) const;
+        void RetireBatch(Batch& batch);
+        void RecordRelease(VkCommandBuffer cmd, const PendingAcquire& acquire, uint32_t srcFamily) const;
+        void RecordAcquire(VkCommandBuffer cmd, const PendingAcquire& acquire, uint32_t srcFamily) const;
+    };
+
+} // namespace StellarAlia::Function::Graphics
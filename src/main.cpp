@@ -1,4 +1,5 @@
 #include <iostream>
+#include "core/jobs/JobSystem.hpp"
 #include "core/logs/Log.hpp"
 
 int main() {
@@ -6,14 +7,23 @@ int main() {
     StellarAlia::Core::Log::Initialize();
     
     SA_LOG_INFO("StellarAlia Engine - Starting...");
+
+    // Worker pool shared by every system; this thread becomes job thread 0
+    StellarAlia::Core::Jobs::JobSystem jobSystem;
+    if (!jobSystem.Initialize()) {
+        SA_LOG_ERROR("Failed to start the job system");
+        StellarAlia::Core::Log::Shutdown();
+        return 1;
+    }
     
     // Engine initialization code goes here
     
     SA_LOG_INFO("StellarAlia Engine - Shutting down...");
+
+    jobSystem.Shutdown();
     
     // Shutdown logging
     StellarAlia::Core::Log::Shutdown();
     
     return 0;
 }
-
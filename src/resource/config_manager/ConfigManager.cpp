@@ -2,6 +2,7 @@
 
 #include "core/logs/Log.hpp"
 
+#include <charconv>
 #include <fstream>
 #include <vector>
 
@@ -20,6 +21,43 @@ std::string Trim(const std::string& input) {
     return input.substr(start, end - start + 1);
 }
 
+bool ParseUInt(const std::string& key, const std::string& value, uint32_t& out) {
+    uint32_t parsed = 0;
+    const auto* end = value.data() + value.size();
+    const auto [ptr, ec] = std::from_chars(value.data(), end, parsed);
+    if (ec != std::errc{} || ptr != end) {
+        SA_LOG_WARN("Config key '{}' expects an unsigned integer, got '{}'", key, value);
+        return false;
+    }
+    out = parsed;
+    return true;
+}
+
+bool ParseFloat(const std::string& key, const std::string& value, float& out) {
+    float parsed = 0.0f;
+    const auto* end = value.data() + value.size();
+    const auto [ptr, ec] = std::from_chars(value.data(), end, parsed);
+    if (ec != std::errc{} || ptr != end) {
+        SA_LOG_WARN("Config key '{}' expects a number, got '{}'", key, value);
+        return false;
+    }
+    out = parsed;
+    return true;
+}
+
+bool ParseBool(const std::string& key, const std::string& value, bool& out) {
+    if (value == "true" || value == "1" || value == "on" || value == "yes") {
+        out = true;
+        return true;
+    }
+    if (value == "false" || value == "0" || value == "off" || value == "no") {
+        out = false;
+        return true;
+    }
+    SA_LOG_WARN("Config key '{}' expects true or false, got '{}'", key, value);
+    return false;
+}
+
 void ParseConfigStream(std::istream& stream, ConfigData& cfg) {
     std::string line;
     while (std::getline(stream, line)) {
@@ -47,6 +85,26 @@ void ParseConfigStream(std::istream& stream, ConfigData& cfg) {
             cfg.engineName = value;
         } else if (key == "window_title") {
             cfg.windowTitle = value;
+        } else if (key == "gpu_device") {
+            cfg.gpuDevice = value;
+        } else if (key == "frames_in_flight") {
+            ParseUInt(key, value, cfg.framesInFlight);
+        } else if (key == "present_mode") {
+            cfg.presentMode = value;
+        } else if (key == "swapchain_image_count") {
+            ParseUInt(key, value, cfg.swapchainImageCount);
+        } else if (key == "max_queued_frames") {
+            ParseUInt(key, value, cfg.maxQueuedFrames);
+        } else if (key == "target_frame_rate") {
+            ParseFloat(key, value, cfg.targetFrameRate);
+        } else if (key == "upload_ring_mb") {
+            ParseUInt(key, value, cfg.uploadRingMB);
+        } else if (key == "upload_budget_mb") {
+            ParseUInt(key, value, cfg.uploadBudgetMB);
+        } else if (key == "pipeline_cache_path") {
+            cfg.pipelineCachePath = value;
+        } else if (key == "bindless_textures") {
+            ParseBool(key, value, cfg.bindlessTextures);
         }
     }
 }
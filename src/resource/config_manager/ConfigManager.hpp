@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
 
@@ -9,6 +10,16 @@ struct ConfigData {
     std::string applicationName = "StellarAlia-Renderer";
     std::string engineName = "StellarAlia";
     std::string windowTitle = "StellarAlia";
+    std::string gpuDevice;             // GPU name substring or device UUID; empty = auto
+    uint32_t framesInFlight = 2;
+    std::string presentMode = "fifo";  // fifo, fifo_relaxed, mailbox, immediate
+    uint32_t swapchainImageCount = 0;  // 0 = surface minimum + 1
+    uint32_t maxQueuedFrames = 0;      // 0 = frames in flight
+    float targetFrameRate = 0.0f;      // 0 = uncapped
+    uint32_t uploadRingMB = 64;        // Staging ring size
+    uint32_t uploadBudgetMB = 16;      // Upload cap per frame; 0 = unlimited
+    std::string pipelineCachePath = "cache/pipeline_cache.bin";  // Empty = disabled
+    bool bindlessTextures = false;     // Descriptor-indexing material path when supported
 };
 
 void Load(const std::filesystem::path& customPath = {});